@@ -0,0 +1,284 @@
+// AllDays.cpp : Runs every day's solutions at once on a shared pool of threads.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/CpuFeatures.h"
+#include "Common/Input.h"
+#include "Common/Trace.h"
+#include "Common/WorkStealingPool.h"
+
+#include "Day1.h"
+#include "Day2.h"
+#include "Day3.h"
+#include "Day4.h"
+#include "Day5.h"
+#include "Day6.h"
+#include "Day7.h"
+#include "Day8.h"
+#include "Day9.h"
+#include "Day10.h"
+#include "Day11.h"
+#include "Day12.h"
+#include "Day13.h"
+#include "Day14.h"
+#include "Day15.h"
+#include "Day16.h"
+#include "Day17.h"
+#include "Day18.h"
+#include "Day19.h"
+#include "Day20.h"
+#include "Day21.h"
+#include "Day22.h"
+#include "Day23.h"
+#include "Day24.h"
+#include "Day25.h"
+
+using Clock = std::chrono::steady_clock;
+
+struct Part
+{
+    int number;
+    std::function<std::string()> solve;
+};
+
+// Parsing hands back the parts, already bound to the parsed input.
+struct Day
+{
+    int number;
+    std::function<std::vector<Part>(std::string_view)> parse;
+};
+
+// Pass nullptr for a part the day doesn't have.
+template<typename Read, typename One, typename Two>
+Day MakeDay(int number, Read read, One partOne, Two partTwo)
+{
+    return { number, [=](std::string_view text)
+        {
+            using Input = decltype(read(text));
+            auto input = std::make_shared<Input>(read(text));
+
+            std::vector<Part> parts;
+            if constexpr (!std::is_null_pointer_v<One>)
+            {
+                parts.push_back({ 1, [=] { return Common::ToText(partOne(*input)); } });
+            }
+            if constexpr (!std::is_null_pointer_v<Two>)
+            {
+                parts.push_back({ 2, [=] { return Common::ToText(partTwo(*input)); } });
+            }
+            return parts;
+        } };
+}
+
+std::vector<Day> AllDays()
+{
+    return {
+        MakeDay(1, Day1::ReadInput, Day1::PartOne, Day1::PartTwo),
+        MakeDay(2, Day2::ReadInput, nullptr, Day2::PartTwo),
+        MakeDay(3, Day3::ReadInput, Day3::PartOne, Day3::PartTwo),
+        MakeDay(4, Day4::ReadInput, Day4::PartOne, Day4::PartTwo),
+        MakeDay(5, Day5::ReadInput, nullptr, Day5::PartTwo),
+        MakeDay(6, Day6::ReadInput, Day6::PartOne, Day6::PartTwo),
+        MakeDay(7, Day7::ReadInput, Day7::PartOne, Day7::PartTwo),
+        MakeDay(8, Day8::ReadInput, Day8::PartOne, Day8::PartTwo),
+        MakeDay(9, Day9::ReadInput, Day9::PartOne, Day9::PartTwo),
+        MakeDay(10, Day10::ReadInput, Day10::PartOne, Day10::PartTwo),
+        MakeDay(11, Day11::ReadInput, Day11::PartOne, Day11::PartTwo),
+        MakeDay(12, Day12::ReadInput, Day12::PartOne, Day12::PartTwo),
+        MakeDay(13, Day13::ReadInput, Day13::PartOne, Day13::PartTwo),
+        MakeDay(14, Day14::ReadInput, Day14::PartOne, Day14::PartTwo),
+        MakeDay(15, Day15::ReadInput, Day15::PartOne, Day15::PartTwo),
+        MakeDay(16, Day16::ReadInput, Day16::PartOne, Day16::PartTwo),
+        MakeDay(17, Day17::ReadInput, Day17::PartOne, Day17::PartTwo),
+        MakeDay(18, Day18::ReadInput, Day18::PartOne, Day18::PartTwo),
+        MakeDay(19, Day19::ReadInput, Day19::PartOne, Day19::PartTwo),
+        MakeDay(20, Day20::ReadInput, Day20::PartOne, Day20::PartTwo),
+        MakeDay(21, Day21::ReadInput, Day21::PartOne, Day21::PartTwo),
+        MakeDay(22, Day22::ReadInput, Day22::PartOne, Day22::PartTwo),
+        MakeDay(23, Day23::ReadInput, Day23::PartOne, Day23::PartTwo),
+        MakeDay(24, Day24::ReadInput, Day24::PartOne, Day24::PartTwo),
+        MakeDay(25, Day25::ReadInput, Day25::PartOne, nullptr),
+    };
+}
+
+struct TaskRecord
+{
+    int day;
+    int part; // 0 for parsing
+    int worker;
+    Clock::duration start;
+    Clock::duration latency;
+    std::string answer;
+    std::string error;
+};
+
+std::string TaskName(TaskRecord const& task)
+{
+    auto name = "Day " + std::to_string(task.day);
+    return task.part == 0 ? name + " parse" : name + " part " + std::to_string(task.part);
+}
+
+int main(int argc, char* argv[])
+{
+    std::string inputDir = "inputs";
+    unsigned threads = 0;
+    std::string traceFile;
+    Common::ReadSimdOption(argc, argv);
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view arg{ argv[i] };
+        if (arg.starts_with("--threads="))
+        {
+            threads = Common::ToNumber<unsigned>(arg.substr(10));
+        }
+        else if (arg == "--trace")
+        {
+            traceFile = "trace.json";
+        }
+        else if (arg.starts_with("--trace="))
+        {
+            traceFile = arg.substr(8);
+        }
+        else if (!arg.starts_with("-"))
+        {
+            inputDir = arg;
+        }
+    }
+
+    // map all of the inputs before starting the clock
+    struct Loaded
+    {
+        Day day;
+        Common::InputBuffer buffer;
+    };
+    std::vector<Loaded> loaded;
+    for (auto& day : AllDays())
+    {
+        auto path = std::filesystem::path(inputDir) / ("Day" + std::to_string(day.number) + ".txt");
+        if (!std::filesystem::exists(path))
+        {
+            std::cout << "Skipping day " << day.number << ", no input at " << path.string() << "\n";
+            continue;
+        }
+        loaded.push_back({ std::move(day), Common::InputBuffer::FromFile(path.string()) });
+    }
+
+    if (!traceFile.empty())
+    {
+        Common::EnableTracing();
+    }
+
+    Common::WorkStealingPool pool{ threads };
+    std::mutex recordsMutex;
+    std::vector<TaskRecord> records;
+
+    auto startTime = Clock::now();
+    auto timed = [&](int day, int part, auto&& work)
+    {
+        TaskRecord record{ day, part, pool.CurrentWorker(), {}, {}, {}, {} };
+        auto start = Clock::now();
+        try
+        {
+            record.answer = work();
+        }
+        catch (std::exception const& e)
+        {
+            record.error = e.what();
+        }
+        auto end = Clock::now();
+        record.start = start - startTime;
+        record.latency = end - start;
+        Common::TraceSpan(TaskName(record), start, end);
+
+        std::lock_guard lock(recordsMutex);
+        records.push_back(std::move(record));
+    };
+
+    for (auto const& entry : loaded)
+    {
+        pool.Submit([&]
+            {
+                std::vector<Part> parts;
+                timed(entry.day.number, 0, [&]
+                    {
+                        parts = entry.day.parse(entry.buffer.Text());
+                        return std::string{};
+                    });
+                for (auto const& part : parts)
+                {
+                    pool.Submit([&timed, &entry, part] { timed(entry.day.number, part.number, part.solve); });
+                }
+            });
+    }
+    pool.Wait();
+    auto makespan = Clock::now() - startTime;
+
+    std::sort(records.begin(), records.end(), [](auto const& a, auto const& b)
+        {
+            return std::make_pair(a.day, a.part) < std::make_pair(b.day, b.part);
+        });
+
+    bool failed = false;
+    for (auto const& r : records)
+    {
+        if (!r.error.empty())
+        {
+            failed = true;
+            std::cout << TaskName(r) << " failed: " << r.error << "\n";
+        }
+        else if (r.part != 0)
+        {
+            // some answers, like day 13's, are drawn over several lines
+            auto multiLine = r.answer.find('\n') != std::string::npos;
+            std::cout << TaskName(r) << ":" << (multiLine ? "\n" : " ") << r.answer << (multiLine ? "" : "\n");
+        }
+    }
+
+    char line[160];
+    std::snprintf(line, sizeof(line), "\n%-16s %6s %11s %11s\n", "Task", "Worker", "Start", "Latency");
+    std::cout << line;
+    Clock::duration totalWork{ 0 };
+    for (auto const& r : records)
+    {
+        totalWork += r.latency;
+        std::snprintf(line, sizeof(line), "%-16s %6d %11s %11s\n",
+            TaskName(r).c_str(),
+            r.worker,
+            Common::FormatDuration(r.start).c_str(),
+            Common::FormatDuration(r.latency).c_str());
+        std::cout << line;
+    }
+
+    auto seconds = [](Clock::duration d) { return std::chrono::duration<double>(d).count(); };
+    std::snprintf(line, sizeof(line), "\nMakespan %s on %u threads, %s of work (%.2fx)\n",
+        Common::FormatDuration(makespan).c_str(),
+        pool.Size(),
+        Common::FormatDuration(totalWork).c_str(),
+        seconds(makespan) > 0.0 ? seconds(totalWork) / seconds(makespan) : 0.0);
+    std::cout << line;
+
+    if (!traceFile.empty())
+    {
+        Common::ReportTrace(std::cout);
+        Common::WriteChromeTrace(traceFile);
+        std::cout << "\nTrace written to " << traceFile << "\n";
+    }
+
+    return failed ? 1 : 0;
+}
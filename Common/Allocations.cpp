@@ -0,0 +1,204 @@
+#include "Common/Allocations.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace Common
+{
+    namespace
+    {
+        struct Counters
+        {
+            std::atomic<std::uint64_t> allocations{ 0 };
+            std::atomic<std::uint64_t> frees{ 0 };
+            std::atomic<std::uint64_t> bytes{ 0 };
+            std::atomic<std::uint64_t> live{ 0 };
+            std::atomic<std::uint64_t> peak{ 0 };
+        };
+
+        // Constant initialised, so it is ready before any static constructor allocates.
+        constinit Counters counters;
+    }
+
+    AllocationCounter::AllocationCounter() noexcept
+        : start_{ counters.allocations.load(), counters.frees.load(), counters.bytes.load(), 0 },
+        liveAtStart_{ counters.live.load() }
+    {
+        counters.peak.store(liveAtStart_);
+    }
+
+    AllocationStats AllocationCounter::Stop() const noexcept
+    {
+        auto peak = counters.peak.load();
+        return {
+            counters.allocations.load() - start_.allocations,
+            counters.frees.load() - start_.frees,
+            counters.bytes.load() - start_.bytes,
+            peak > liveAtStart_ ? peak - liveAtStart_ : 0
+        };
+    }
+
+#ifdef AOC_ALLOC_STATS
+    namespace
+    {
+        // Every block carries its size and where malloc put it just in front
+        // of the pointer handed out, as unsized and aligned deletes don't say.
+        struct Header
+        {
+            void* block;
+            std::size_t size;
+        };
+
+        void* Allocate(std::size_t size, std::size_t alignment) noexcept
+        {
+            alignment = std::max(alignment, alignof(std::max_align_t));
+            auto block = std::malloc(size + sizeof(Header) + alignment);
+            if (!block)
+            {
+                return nullptr;
+            }
+            auto address = reinterpret_cast<std::uintptr_t>(block) + sizeof(Header);
+            address = (address + alignment - 1) & ~(alignment - 1);
+            auto result = reinterpret_cast<void*>(address);
+            reinterpret_cast<Header*>(result)[-1] = { block, size };
+
+            counters.allocations.fetch_add(1, std::memory_order_relaxed);
+            counters.bytes.fetch_add(size, std::memory_order_relaxed);
+            auto live = counters.live.fetch_add(size, std::memory_order_relaxed) + size;
+            auto peak = counters.peak.load(std::memory_order_relaxed);
+            while (live > peak && !counters.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+            {
+            }
+            return result;
+        }
+
+        void* AllocateOrThrow(std::size_t size, std::size_t alignment)
+        {
+            // new has to hand back a unique pointer even for nothing
+            auto result = Allocate(std::max<std::size_t>(size, 1), alignment);
+            if (!result)
+            {
+                throw std::bad_alloc{};
+            }
+            return result;
+        }
+
+        void Free(void* p) noexcept
+        {
+            if (!p)
+            {
+                return;
+            }
+            auto header = reinterpret_cast<Header*>(p)[-1];
+            counters.frees.fetch_add(1, std::memory_order_relaxed);
+            counters.live.fetch_sub(header.size, std::memory_order_relaxed);
+            std::free(header.block);
+        }
+    }
+#endif
+}
+
+#ifdef AOC_ALLOC_STATS
+void* operator new(std::size_t size)
+{
+    return Common::AllocateOrThrow(size, 0);
+}
+
+void* operator new[](std::size_t size)
+{
+    return Common::AllocateOrThrow(size, 0);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return Common::AllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return Common::AllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept
+{
+    return Common::Allocate(std::max<std::size_t>(size, 1), 0);
+}
+
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept
+{
+    return Common::Allocate(std::max<std::size_t>(size, 1), 0);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, std::nothrow_t const&) noexcept
+{
+    return Common::Allocate(std::max<std::size_t>(size, 1), static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, std::nothrow_t const&) noexcept
+{
+    return Common::Allocate(std::max<std::size_t>(size, 1), static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept
+{
+    Common::Free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    Common::Free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    Common::Free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    Common::Free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    Common::Free(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+    Common::Free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    Common::Free(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+    Common::Free(p);
+}
+
+void operator delete(void* p, std::nothrow_t const&) noexcept
+{
+    Common::Free(p);
+}
+
+void operator delete[](void* p, std::nothrow_t const&) noexcept
+{
+    Common::Free(p);
+}
+
+void operator delete(void* p, std::align_val_t, std::nothrow_t const&) noexcept
+{
+    Common::Free(p);
+}
+
+void operator delete[](void* p, std::align_val_t, std::nothrow_t const&) noexcept
+{
+    Common::Free(p);
+}
+#endif
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Common
+{
+    // Configuring with -DAOC_ALLOC_STATS=ON replaces the global operator new
+    // and delete with ones that count every allocation, so that each phase of
+    // a day can report how much it allocated.
+#ifdef AOC_ALLOC_STATS
+    bool constexpr CountingAllocations = true;
+#else
+    bool constexpr CountingAllocations = false;
+#endif
+
+    struct AllocationStats
+    {
+        std::uint64_t allocations{ 0 };
+        std::uint64_t frees{ 0 };
+        std::uint64_t bytes{ 0 };
+        // The most the live heap grew by, over what was live at the start.
+        std::uint64_t peakBytes{ 0 };
+    };
+
+    // Counts the allocations from construction until Stop(). The counts are
+    // for the whole process, so other threads allocating at the same time
+    // show up in them too. Only one should be running at a time, as each one
+    // resets the peak.
+    class AllocationCounter
+    {
+    public:
+        AllocationCounter() noexcept;
+
+        AllocationStats Stop() const noexcept;
+
+    private:
+        AllocationStats start_;
+        std::uint64_t liveAtStart_;
+    };
+}
@@ -0,0 +1,85 @@
+#include "Common/Arena.h"
+
+namespace Common
+{
+    Arena::Arena(Arena&& other) noexcept
+        : blocks_{ std::move(other.blocks_) },
+        current_{ std::exchange(other.current_, 0) },
+        usedBefore_{ std::exchange(other.usedBefore_, 0) },
+        next_{ std::exchange(other.next_, nullptr) },
+        end_{ std::exchange(other.end_, nullptr) },
+        blockBytes_{ other.blockBytes_ }
+    {
+        other.blocks_.clear();
+    }
+
+    Arena& Arena::operator=(Arena&& other) noexcept
+    {
+        if (this != &other)
+        {
+            blocks_ = std::move(other.blocks_);
+            other.blocks_.clear();
+            current_ = std::exchange(other.current_, 0);
+            usedBefore_ = std::exchange(other.usedBefore_, 0);
+            next_ = std::exchange(other.next_, nullptr);
+            end_ = std::exchange(other.end_, nullptr);
+            blockBytes_ = other.blockBytes_;
+        }
+        return *this;
+    }
+
+    void* Arena::AllocateSlow(std::size_t bytes, std::size_t alignment)
+    {
+        // Move on to the next kept block big enough, or add one. Whatever is
+        // left at the end of the one being passed over waits for a Reset().
+        auto needed = bytes + alignment - 1;
+        auto index = next_ ? current_ + 1 : current_;
+        while (index < blocks_.size() && blocks_[index].size < needed)
+        {
+            ++index;
+        }
+        if (index == blocks_.size())
+        {
+            auto size = std::max(blockBytes_, needed);
+            blocks_.push_back({ std::make_unique_for_overwrite<std::byte[]>(size), size });
+        }
+        if (next_)
+        {
+            usedBefore_ += static_cast<std::size_t>(next_ - blocks_[current_].memory.get());
+        }
+        StartBlock(index);
+        return Allocate(bytes, alignment);
+    }
+
+    void Arena::StartBlock(std::size_t index) noexcept
+    {
+        current_ = index;
+        next_ = blocks_[index].memory.get();
+        end_ = next_ + blocks_[index].size;
+    }
+
+    void Arena::Reset() noexcept
+    {
+        usedBefore_ = 0;
+        if (blocks_.empty())
+        {
+            return;
+        }
+        StartBlock(0);
+    }
+
+    std::size_t Arena::BytesUsed() const noexcept
+    {
+        return next_ ? usedBefore_ + static_cast<std::size_t>(next_ - blocks_[current_].memory.get()) : 0;
+    }
+
+    std::size_t Arena::BytesReserved() const noexcept
+    {
+        std::size_t bytes = 0;
+        for (auto const& block : blocks_)
+        {
+            bytes += block.size;
+        }
+        return bytes;
+    }
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Common
+{
+    // Hands out memory by bumping a pointer through large blocks, for trees
+    // and other structures whose nodes all die together. Nothing is given
+    // back one node at a time: Reset() forgets everything in one go and keeps
+    // the blocks to hand out again, and the destructor frees them. No
+    // destructors are ever run, so only trivially destructible types can be
+    // made in an arena. Moving an arena leaves everything in it where it is.
+    class Arena
+    {
+    public:
+        static std::size_t constexpr DefaultBlockBytes = 64 * 1024;
+
+        explicit Arena(std::size_t blockBytes = DefaultBlockBytes) noexcept
+            : blockBytes_{ blockBytes }
+        {}
+        Arena(Arena&& other) noexcept;
+        Arena& operator=(Arena&& other) noexcept;
+        Arena(Arena const&) = delete;
+        Arena& operator=(Arena const&) = delete;
+        ~Arena() = default;
+
+        void* Allocate(std::size_t bytes, std::size_t alignment)
+        {
+            auto address = reinterpret_cast<std::uintptr_t>(next_);
+            auto aligned = (address + alignment - 1) & ~(alignment - 1);
+            if (next_ && aligned + bytes <= reinterpret_cast<std::uintptr_t>(end_))
+            {
+                next_ = reinterpret_cast<std::byte*>(aligned + bytes);
+                return reinterpret_cast<void*>(aligned);
+            }
+            return AllocateSlow(bytes, alignment);
+        }
+
+        template<typename T, typename... Args>
+        T* Create(Args&&... args)
+        {
+            static_assert(std::is_trivially_destructible_v<T>, "An arena never runs destructors");
+            return ::new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        // A copy of values, living as long as the arena's contents.
+        template<typename T>
+        std::span<T> CopyOf(std::span<T const> values)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Arena arrays are copied bytewise");
+            if (values.empty())
+            {
+                return {};
+            }
+            auto copy = static_cast<T*>(Allocate(values.size_bytes(), alignof(T)));
+            std::copy(values.begin(), values.end(), copy);
+            return { copy, values.size() };
+        }
+
+        // Throws away everything made in the arena, keeping its blocks.
+        void Reset() noexcept;
+
+        // What's been handed out since the last Reset(), give or take padding.
+        std::size_t BytesUsed() const noexcept;
+        // What the blocks add up to.
+        std::size_t BytesReserved() const noexcept;
+
+    private:
+        struct Block
+        {
+            std::unique_ptr<std::byte[]> memory;
+            std::size_t size;
+        };
+
+        void* AllocateSlow(std::size_t bytes, std::size_t alignment);
+        void StartBlock(std::size_t index) noexcept;
+
+        std::vector<Block> blocks_;
+        // The block being bumped through, and what was used in those before it.
+        std::size_t current_{ 0 };
+        std::size_t usedBefore_{ 0 };
+        std::byte* next_{ nullptr };
+        std::byte* end_{ nullptr };
+        std::size_t blockBytes_;
+    };
+}
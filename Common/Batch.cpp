@@ -0,0 +1,127 @@
+#include "Common/Batch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <stdexcept>
+
+#include "Common/Input.h"
+#include "Common/WorkStealingPool.h"
+
+namespace Common
+{
+    namespace
+    {
+        std::vector<std::string> ListInputs(std::string const& source)
+        {
+            std::vector<std::string> inputs;
+            if (std::filesystem::is_directory(source))
+            {
+                for (auto const& entry : std::filesystem::directory_iterator(source))
+                {
+                    if (entry.is_regular_file())
+                    {
+                        inputs.push_back(entry.path().string());
+                    }
+                }
+                std::sort(inputs.begin(), inputs.end());
+                return inputs;
+            }
+
+            auto manifest = InputBuffer::FromFile(source);
+            auto folder = std::filesystem::path(source).parent_path();
+            LineReader lines{ manifest.Text() };
+            std::string_view line;
+            while (lines.Next(line))
+            {
+                SkipSpaces(line);
+                while (!line.empty() && IsSpace(line.back()))
+                {
+                    line.remove_suffix(1);
+                }
+                if (line.empty() || line.front() == '#')
+                {
+                    continue;
+                }
+                inputs.push_back((folder / line).string());
+            }
+            return inputs;
+        }
+
+        std::string SolveOne(std::string const& path, std::function<std::string(std::string_view)> const& solve, std::atomic<bool>& failed)
+        {
+            try
+            {
+                auto buffer = InputBuffer::FromFile(path);
+                return path + solve(buffer.Text()) + "\n";
+            }
+            catch (std::exception const& e)
+            {
+                failed = true;
+                return path + "\terror: " + e.what() + "\n";
+            }
+        }
+    }
+
+    BatchOptions ReadBatchOptions(int argc, char* argv[])
+    {
+        BatchOptions options;
+        std::string source;
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view arg{ argv[i] };
+            if (arg == "--batch" && i + 1 < argc)
+            {
+                source = argv[++i];
+            }
+            else if (arg.starts_with("--batch="))
+            {
+                source = arg.substr(8);
+            }
+            else if (arg.starts_with("--threads="))
+            {
+                options.threads = ToNumber<unsigned>(arg.substr(10));
+            }
+        }
+        if (!source.empty())
+        {
+            options.enabled = true;
+            options.inputs = ListInputs(source);
+        }
+        return options;
+    }
+
+    int SolveBatch(BatchOptions const& options, std::function<std::string(std::string_view)> const& solve)
+    {
+        std::atomic<bool> failed{ false };
+        std::vector<std::string> results(options.inputs.size());
+        if (options.threads == 1)
+        {
+            for (std::size_t i = 0; i < results.size(); ++i)
+            {
+                results[i] = SolveOne(options.inputs[i], solve, failed);
+            }
+        }
+        else
+        {
+            WorkStealingPool pool{ options.threads };
+            for (std::size_t i = 0; i < results.size(); ++i)
+            {
+                pool.Submit([&, i] { results[i] = SolveOne(options.inputs[i], solve, failed); });
+            }
+            pool.Wait();
+        }
+
+        // one write for the lot, rather than a flush per input
+        std::string output;
+        for (auto const& result : results)
+        {
+            output += result;
+        }
+        std::fwrite(output.data(), 1, output.size(), stdout);
+        std::fflush(stdout);
+        return failed ? 1 : 0;
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <functional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Common
+{
+    template<typename T>
+    std::string ToText(T const& value)
+    {
+        std::ostringstream out;
+        out << value;
+        return out.str();
+    }
+
+    // --batch <dir|manifest> (or --batch=...) solves many inputs in one run:
+    // every file in a folder, or every file listed one per line in a manifest
+    // (relative to the manifest, blank lines and # comments skipped).
+    // --threads=N spreads them over N threads, 0 meaning one per hardware thread.
+    struct BatchOptions
+    {
+        std::vector<std::string> inputs;
+        unsigned threads{ 1 };
+        bool enabled{ false };
+    };
+
+    BatchOptions ReadBatchOptions(int argc, char* argv[]);
+
+    // Prints "path<TAB>answer..." for each input, in the order given. An input
+    // that throws gets "path<TAB>error: ..." and makes the result 1, else 0.
+    int SolveBatch(BatchOptions const& options, std::function<std::string(std::string_view)> const& solve);
+
+    // The answers of each part, tab separated, with the lines of an answer
+    // drawn over several lines joined by '/'.
+    template<typename Read, typename... Parts>
+    int RunBatch(BatchOptions const& options, Read read, Parts... parts)
+    {
+        return SolveBatch(options, [=](std::string_view text)
+            {
+                auto input = read(text);
+                std::string line;
+                auto append = [&line](std::string answer)
+                {
+                    while (!answer.empty() && answer.back() == '\n')
+                    {
+                        answer.pop_back();
+                    }
+                    for (auto& c : answer)
+                    {
+                        c = c == '\n' ? '/' : c;
+                    }
+                    line += '\t';
+                    line += answer;
+                };
+                (append(ToText(parts(input))), ...);
+                return line;
+            });
+    }
+}
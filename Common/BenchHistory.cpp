@@ -0,0 +1,266 @@
+#include "Common/BenchHistory.h"
+
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include "Common/Input.h"
+
+namespace Common
+{
+    namespace
+    {
+        void AppendString(std::string& out, std::string_view text)
+        {
+            out += '"';
+            for (char c : text)
+            {
+                switch (c)
+                {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                        out += escaped;
+                    }
+                    else
+                    {
+                        out += c;
+                    }
+                }
+            }
+            out += '"';
+        }
+
+        bool ReadString(std::string_view& text, std::string& value)
+        {
+            if (text.empty() || text.front() != '"')
+            {
+                return false;
+            }
+            text.remove_prefix(1);
+            value.clear();
+            while (!text.empty())
+            {
+                char c = text.front();
+                text.remove_prefix(1);
+                if (c == '"')
+                {
+                    return true;
+                }
+                if (c != '\\')
+                {
+                    value += c;
+                    continue;
+                }
+                if (text.empty())
+                {
+                    return false;
+                }
+                char escaped = text.front();
+                text.remove_prefix(1);
+                switch (escaped)
+                {
+                case 'n': value += '\n'; break;
+                case 'r': value += '\r'; break;
+                case 't': value += '\t'; break;
+                case 'u':
+                    // only ever written for control characters
+                    if (text.size() < 4)
+                    {
+                        return false;
+                    }
+                    value += static_cast<char>(std::stoi(std::string{ text.substr(0, 4) }, nullptr, 16));
+                    text.remove_prefix(4);
+                    break;
+                default: value += escaped; break;
+                }
+            }
+            return false;
+        }
+
+        struct TextField
+        {
+            char const* name;
+            std::string HistoryRecord::* member;
+        };
+        TextField const textFields[] = {
+            { "time", &HistoryRecord::time },
+            { "label", &HistoryRecord::label },
+            { "day", &HistoryRecord::day },
+            { "input", &HistoryRecord::input },
+            { "phase", &HistoryRecord::phase },
+            { "simd", &HistoryRecord::simd },
+        };
+
+        struct NumberField
+        {
+            char const* name;
+            std::uint64_t HistoryRecord::* member;
+        };
+        NumberField const numberFields[] = {
+            { "runs", &HistoryRecord::runs },
+            { "min_ns", &HistoryRecord::minNs },
+            { "median_ns", &HistoryRecord::medianNs },
+            { "p99_ns", &HistoryRecord::p99Ns },
+        };
+
+        bool Expect(std::string_view& text, char c)
+        {
+            SkipSpaces(text);
+            if (text.empty() || text.front() != c)
+            {
+                return false;
+            }
+            text.remove_prefix(1);
+            SkipSpaces(text);
+            return true;
+        }
+    }
+
+    std::string ToJsonLine(HistoryRecord const& record)
+    {
+        std::string line{ "{" };
+        for (auto const& field : textFields)
+        {
+            if (line.size() > 1)
+            {
+                line += ',';
+            }
+            AppendString(line, field.name);
+            line += ':';
+            AppendString(line, record.*field.member);
+        }
+        for (auto const& field : numberFields)
+        {
+            line += ',';
+            AppendString(line, field.name);
+            line += ':';
+            line += std::to_string(record.*field.member);
+        }
+        line += '}';
+        return line;
+    }
+
+    // Only the flat objects ToJsonLine writes are understood.
+    std::optional<HistoryRecord> ParseHistoryLine(std::string_view line)
+    {
+        HistoryRecord record;
+        if (!Expect(line, '{'))
+        {
+            return {};
+        }
+        std::string name;
+        std::string value;
+        while (!line.empty() && line.front() != '}')
+        {
+            if (!ReadString(line, name) || !Expect(line, ':'))
+            {
+                return {};
+            }
+            if (!line.empty() && line.front() == '"')
+            {
+                if (!ReadString(line, value))
+                {
+                    return {};
+                }
+                for (auto const& field : textFields)
+                {
+                    if (name == field.name)
+                    {
+                        record.*field.member = value;
+                    }
+                }
+            }
+            else
+            {
+                std::uint64_t number{ 0 };
+                auto [end, error] = std::from_chars(line.data(), line.data() + line.size(), number);
+                if (error != std::errc{})
+                {
+                    return {};
+                }
+                line.remove_prefix(static_cast<std::size_t>(end - line.data()));
+                for (auto const& field : numberFields)
+                {
+                    if (name == field.name)
+                    {
+                        record.*field.member = number;
+                    }
+                }
+            }
+            SkipSpaces(line);
+            if (!line.empty() && line.front() == ',')
+            {
+                Expect(line, ',');
+            }
+        }
+        if (!Expect(line, '}') || record.day.empty() || record.phase.empty())
+        {
+            return {};
+        }
+        return record;
+    }
+
+    void AppendHistory(std::string const& path, std::vector<HistoryRecord> const& records)
+    {
+        auto folder = std::filesystem::path(path).parent_path();
+        if (!folder.empty())
+        {
+            std::filesystem::create_directories(folder);
+        }
+        std::ofstream out{ path, std::ios::app | std::ios::binary };
+        for (auto const& record : records)
+        {
+            out << ToJsonLine(record) << '\n';
+        }
+        if (!out)
+        {
+            throw std::runtime_error("Could not write benchmark history to " + path);
+        }
+    }
+
+    std::vector<HistoryRecord> ReadHistory(std::string const& path)
+    {
+        std::vector<HistoryRecord> records;
+        if (!std::filesystem::exists(path))
+        {
+            return records;
+        }
+        auto buffer = InputBuffer::FromFile(path);
+        LineReader lines{ buffer.Text() };
+        std::string_view line;
+        while (lines.Next(line))
+        {
+            if (auto record = ParseHistoryLine(line))
+            {
+                records.push_back(std::move(*record));
+            }
+        }
+        return records;
+    }
+
+    std::string CurrentUtcTime()
+    {
+        auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        std::tm utc{};
+#ifdef _WIN32
+        gmtime_s(&utc, &now);
+#else
+        gmtime_r(&now, &utc);
+#endif
+        char text[32];
+        std::strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%SZ", &utc);
+        return text;
+    }
+}
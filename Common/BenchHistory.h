@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Common
+{
+    // One phase of one benchmarked run, as kept in a history file: a JSON
+    // object per line, appended to by --history=<file> and read back by
+    // aoc_history to spot regressions.
+    struct HistoryRecord
+    {
+        // UTC, as 2021-12-01T05:00:00Z.
+        std::string time;
+        // Whatever the run was tagged with by --history-label, often a commit.
+        std::string label;
+        std::string day;
+        std::string input;
+        std::string phase;
+        std::string simd;
+        std::uint64_t runs{ 0 };
+        std::uint64_t minNs{ 0 };
+        std::uint64_t medianNs{ 0 };
+        std::uint64_t p99Ns{ 0 };
+    };
+
+    std::string ToJsonLine(HistoryRecord const& record);
+
+    // Empty if the line isn't a record, so files can hold blank lines or
+    // records from a later version with fields this one doesn't know.
+    std::optional<HistoryRecord> ParseHistoryLine(std::string_view line);
+
+    // Throws if the file can't be written.
+    void AppendHistory(std::string const& path, std::vector<HistoryRecord> const& records);
+    // Records in the order they were written. A missing file has none.
+    std::vector<HistoryRecord> ReadHistory(std::string const& path);
+
+    std::string CurrentUtcTime();
+}
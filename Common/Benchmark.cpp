@@ -0,0 +1,371 @@
+#include "Common/Benchmark.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <string_view>
+
+#include "Common/BenchHistory.h"
+#include "Common/CpuFeatures.h"
+#include "Common/Input.h"
+
+namespace Common
+{
+    namespace
+    {
+        std::string FormatRate(double perSecond, char const* unit)
+        {
+            char text[32];
+            if (perSecond >= 1e9)
+            {
+                std::snprintf(text, sizeof(text), "%.2fG%s/s", perSecond / 1e9, unit);
+            }
+            else if (perSecond >= 1e6)
+            {
+                std::snprintf(text, sizeof(text), "%.2fM%s/s", perSecond / 1e6, unit);
+            }
+            else if (perSecond >= 1e3)
+            {
+                std::snprintf(text, sizeof(text), "%.2fk%s/s", perSecond / 1e3, unit);
+            }
+            else
+            {
+                std::snprintf(text, sizeof(text), "%.2f%s/s", perSecond, unit);
+            }
+            return text;
+        }
+
+        std::string FormatCount(double count)
+        {
+            char text[32];
+            if (count >= 1e9)
+            {
+                std::snprintf(text, sizeof(text), "%.2fG", count / 1e9);
+            }
+            else if (count >= 1e6)
+            {
+                std::snprintf(text, sizeof(text), "%.2fM", count / 1e6);
+            }
+            else if (count >= 1e3)
+            {
+                std::snprintf(text, sizeof(text), "%.2fk", count / 1e3);
+            }
+            else
+            {
+                std::snprintf(text, sizeof(text), "%.0f", count);
+            }
+            return text;
+        }
+
+        // "-" when either count is missing, as not every CPU has every event.
+        std::string FormatRatio(PerfCounts const& counts, PerfEvent top, PerfEvent bottom, bool percent)
+        {
+            if (!counts.Has(top) || !counts.Has(bottom) || counts[bottom] == 0)
+            {
+                return "-";
+            }
+            char text[32];
+            auto ratio = static_cast<double>(counts[top]) / static_cast<double>(counts[bottom]);
+            std::snprintf(text, sizeof(text), percent ? "%.2f%%" : "%.2f", percent ? ratio * 100.0 : ratio);
+            return text;
+        }
+
+        std::string FormatBytes(std::uint64_t bytes)
+        {
+            char text[32];
+            auto b = static_cast<double>(bytes);
+            if (b >= 1024.0 * 1024.0 * 1024.0)
+            {
+                std::snprintf(text, sizeof(text), "%.2fGB", b / (1024.0 * 1024.0 * 1024.0));
+            }
+            else if (b >= 1024.0 * 1024.0)
+            {
+                std::snprintf(text, sizeof(text), "%.2fMB", b / (1024.0 * 1024.0));
+            }
+            else if (b >= 1024.0)
+            {
+                std::snprintf(text, sizeof(text), "%.2fKB", b / 1024.0);
+            }
+            else
+            {
+                std::snprintf(text, sizeof(text), "%lluB", static_cast<unsigned long long>(bytes));
+            }
+            return text;
+        }
+    }
+
+    std::string FormatDuration(std::chrono::nanoseconds d)
+    {
+        char text[32];
+        auto ns = static_cast<double>(d.count());
+        if (ns < 1e3)
+        {
+            std::snprintf(text, sizeof(text), "%.0fns", ns);
+        }
+        else if (ns < 1e6)
+        {
+            std::snprintf(text, sizeof(text), "%.2fus", ns / 1e3);
+        }
+        else if (ns < 1e9)
+        {
+            std::snprintf(text, sizeof(text), "%.2fms", ns / 1e6);
+        }
+        else
+        {
+            std::snprintf(text, sizeof(text), "%.2fs", ns / 1e9);
+        }
+        return text;
+    }
+
+    PhaseSummary Summarise(PhaseTimings const& timings)
+    {
+        PhaseSummary summary;
+        if (timings.samples.empty())
+        {
+            return summary;
+        }
+
+        auto sorted = timings.samples;
+        std::sort(sorted.begin(), sorted.end());
+
+        // nearest rank percentiles
+        auto percentile = [&sorted](double p)
+        {
+            auto rank = static_cast<std::size_t>(p * static_cast<double>(sorted.size()) + 0.999999);
+            return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+        };
+        summary.min = sorted.front();
+        summary.median = percentile(0.5);
+        summary.p99 = percentile(0.99);
+
+        auto seconds = std::chrono::duration<double>(summary.median).count();
+        if (seconds > 0.0)
+        {
+            summary.bytesPerSecond = static_cast<double>(timings.work.bytes) / seconds;
+            summary.itemsPerSecond = static_cast<double>(timings.work.items) / seconds;
+        }
+        return summary;
+    }
+
+    Benchmark::Benchmark(int argc, char* argv[])
+    {
+        if (argc > 0)
+        {
+            day_ = std::filesystem::path(argv[0]).stem().string();
+        }
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view arg{ argv[i] };
+            if (!arg.empty() && arg.front() != '-' && input_.empty())
+            {
+                input_ = arg;
+            }
+            else if (arg == "--bench")
+            {
+                repetitions_ = DefaultRepetitions;
+            }
+            else if (arg.starts_with("--bench="))
+            {
+                repetitions_ = std::max(1, static_cast<int>(OptionNumber(arg.substr(8), "--bench takes a number of runs, like --bench=20", 0, INT_MAX)));
+            }
+            else if (arg == "--trace")
+            {
+                traceFile_ = "trace.json";
+            }
+            else if (arg.starts_with("--trace="))
+            {
+                traceFile_ = arg.substr(8);
+            }
+            else if (arg == "--perf")
+            {
+                perf_ = std::make_unique<PerfCounters>();
+            }
+            else if (arg == "--memory-report")
+            {
+                memoryReport_ = true;
+            }
+            else if (arg.starts_with("--history="))
+            {
+                historyFile_ = arg.substr(10);
+            }
+            else if (arg.starts_with("--history-label="))
+            {
+                historyLabel_ = arg.substr(16);
+            }
+        }
+        if (!traceFile_.empty())
+        {
+            EnableTracing();
+        }
+        if (memoryReport_)
+        {
+            EnableMemoryReport();
+        }
+        ReadSimdOption(argc, argv);
+    }
+
+    void Benchmark::Report(std::ostream& out) const
+    {
+        if (!traceFile_.empty())
+        {
+            ReportTrace(out);
+            WriteChromeTrace(traceFile_);
+            out << "\nTrace written to " << traceFile_ << "\n";
+        }
+        if (Enabled())
+        {
+            ReportTimings(out);
+            if (!historyFile_.empty())
+            {
+                AppendToHistory(out);
+            }
+        }
+        if (CountingAllocations)
+        {
+            ReportAllocations(out);
+        }
+        if (perf_)
+        {
+            ReportPerfCounters(out);
+        }
+        if (memoryReport_)
+        {
+            ReportMemory(out);
+        }
+    }
+
+    void Benchmark::ReportTimings(std::ostream& out) const
+    {
+        out << "\nSIMD kernels: " << ToString(ActiveSimdLevel()) << "\n";
+        char line[160];
+        std::snprintf(line, sizeof(line), "%-12s %6s %11s %11s %11s  %s\n", "Phase", "Runs", "Min", "Median", "P99", "Throughput");
+        out << line;
+        for (auto const& phase : phases_)
+        {
+            auto summary = Summarise(phase);
+            std::string throughput;
+            if (phase.work.bytes > 0)
+            {
+                throughput += FormatRate(summary.bytesPerSecond, "B");
+            }
+            if (phase.work.items > 0)
+            {
+                if (!throughput.empty())
+                {
+                    throughput += "  ";
+                }
+                throughput += FormatRate(summary.itemsPerSecond, " items");
+            }
+            std::snprintf(line, sizeof(line), "%-12s %6zu %11s %11s %11s  %s\n",
+                phase.name.c_str(),
+                phase.samples.size(),
+                FormatDuration(summary.min).c_str(),
+                FormatDuration(summary.median).c_str(),
+                FormatDuration(summary.p99).c_str(),
+                throughput.c_str());
+            out << line;
+        }
+    }
+
+    void Benchmark::ReportAllocations(std::ostream& out) const
+    {
+        char line[160];
+        std::snprintf(line, sizeof(line), "\n%-12s %11s %11s %11s %11s\n", "Phase", "Allocations", "Frees", "Allocated", "Peak heap");
+        out << line;
+        for (auto const& phase : phases_)
+        {
+            auto const& a = phase.allocations;
+            std::snprintf(line, sizeof(line), "%-12s %11llu %11llu %11s %11s\n",
+                phase.name.c_str(),
+                static_cast<unsigned long long>(a.allocations),
+                static_cast<unsigned long long>(a.frees),
+                FormatBytes(a.bytes).c_str(),
+                FormatBytes(a.peakBytes).c_str());
+            out << line;
+        }
+    }
+
+    void Benchmark::ReportPerfCounters(std::ostream& out) const
+    {
+        if (!perf_->Available())
+        {
+            out << "\nHardware counters unavailable: " << perf_->Problem() << "\n";
+            return;
+        }
+
+        char line[160];
+        std::snprintf(line, sizeof(line), "\n%-12s %11s %13s %6s %9s %9s %12s\n", "Phase", "Cycles/run", "Instrs/run", "IPC", "L1D miss", "LLC miss", "Branch miss");
+        out << line;
+        for (auto const& phase : phases_)
+        {
+            auto const& p = phase.perf;
+            auto runs = static_cast<double>(std::max<std::size_t>(phase.samples.size(), 1));
+            auto perRun = [&p, runs](PerfEvent event)
+            {
+                return p.Has(event) ? FormatCount(static_cast<double>(p[event]) / runs) : std::string{ "-" };
+            };
+            std::snprintf(line, sizeof(line), "%-12s %11s %13s %6s %9s %9s %12s\n",
+                phase.name.c_str(),
+                perRun(PerfEvent::Cycles).c_str(),
+                perRun(PerfEvent::Instructions).c_str(),
+                FormatRatio(p, PerfEvent::Instructions, PerfEvent::Cycles, false).c_str(),
+                FormatRatio(p, PerfEvent::L1DReadMisses, PerfEvent::L1DReads, true).c_str(),
+                FormatRatio(p, PerfEvent::LLCMisses, PerfEvent::LLCReferences, true).c_str(),
+                FormatRatio(p, PerfEvent::BranchMisses, PerfEvent::Branches, true).c_str());
+            out << line;
+        }
+    }
+
+    void Benchmark::AppendToHistory(std::ostream& out) const
+    {
+        auto time = CurrentUtcTime();
+        auto simd = std::string{ ToString(ActiveSimdLevel()) };
+        std::vector<HistoryRecord> records;
+        for (auto const& phase : phases_)
+        {
+            auto summary = Summarise(phase);
+            records.push_back({ time, historyLabel_, day_, input_.empty() ? "stdin" : input_, phase.name, simd,
+                phase.samples.size(),
+                static_cast<std::uint64_t>(summary.min.count()),
+                static_cast<std::uint64_t>(summary.median.count()),
+                static_cast<std::uint64_t>(summary.p99.count()) });
+        }
+        try
+        {
+            AppendHistory(historyFile_, records);
+            out << "\nAppended " << records.size() << " phases to " << historyFile_ << "\n";
+        }
+        catch (std::exception const& e)
+        {
+            out << "\n" << e.what() << "\n";
+        }
+    }
+
+    void Benchmark::ReportMemory(std::ostream& out) const
+    {
+        char line[160];
+        bool const perPhase = std::all_of(phases_.begin(), phases_.end(), [](auto const& phase) { return phase.memory.peakIsForPhase; });
+        std::snprintf(line, sizeof(line), "\n%-12s %11s %11s  %s\n", "Phase", "RSS at end", perPhase ? "Peak RSS" : "Peak so far", "Structures");
+        out << line;
+        for (auto const& phase : phases_)
+        {
+            auto const& m = phase.memory;
+            std::string structures;
+            for (auto const& [name, bytes] : m.footprints)
+            {
+                if (!structures.empty())
+                {
+                    structures += ", ";
+                }
+                structures += name + " " + FormatBytes(bytes);
+            }
+            std::snprintf(line, sizeof(line), "%-12s %11s %11s  ",
+                phase.name.c_str(),
+                m.rssBytes > 0 ? FormatBytes(m.rssBytes).c_str() : "-",
+                m.peakRssBytes > 0 ? FormatBytes(m.peakRssBytes).c_str() : "-");
+            out << line << structures << "\n";
+        }
+    }
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Common/Allocations.h"
+#include "Common/MemoryReport.h"
+#include "Common/PerfCounters.h"
+#include "Common/Trace.h"
+
+namespace Common
+{
+    // How much input a phase chews through, used to report throughput.
+    struct Work
+    {
+        std::size_t bytes{ 0 };
+        std::size_t items{ 0 };
+    };
+
+    struct PhaseTimings
+    {
+        std::string name;
+        Work work;
+        std::vector<std::chrono::nanoseconds> samples;
+        // From the last run.
+        AllocationStats allocations;
+        // Summed over every run.
+        PerfCounts perf;
+        // From the last run, with --memory-report.
+        MemoryUsage memory;
+    };
+
+    struct PhaseSummary
+    {
+        std::chrono::nanoseconds min{ 0 };
+        std::chrono::nanoseconds median{ 0 };
+        std::chrono::nanoseconds p99{ 0 };
+        double bytesPerSecond{ 0.0 };
+        double itemsPerSecond{ 0.0 };
+    };
+
+    PhaseSummary Summarise(PhaseTimings const& timings);
+
+    // Picks a unit to suit, e.g. "532ns", "1.25ms" or "3.10s".
+    std::string FormatDuration(std::chrono::nanoseconds d);
+
+    // Runs the phases of a day. Normally each phase runs once, but with
+    // --bench[=N] on the command line each one is repeated N times and timed.
+    // --trace[=file] switches on tracing and writes a Chrome trace of the
+    // phases, and of any AOC_TRACE_SCOPEs they run, to file (trace.json).
+    // Built with AOC_ALLOC_STATS, it also counts each phase's allocations.
+    // --perf reads the CPU's performance counters around each phase.
+    // --simd=<level> forces the SIMD kernels down to that level.
+    // --memory-report gives each phase's RSS and the structures it noted.
+    // --history=<file> appends the timings of a benchmarked run to a history
+    // file (see BenchHistory.h), tagged with --history-label=<text> if given.
+    class Benchmark
+    {
+    public:
+        static int constexpr DefaultRepetitions = 10;
+
+        Benchmark(int argc, char* argv[]);
+        explicit Benchmark(int repetitions) noexcept
+            : repetitions_{ repetitions }
+        {}
+
+        bool Enabled() const noexcept
+        {
+            return repetitions_ > 0;
+        }
+
+        // Returns the result of the last run of the phase.
+        template<typename Phase>
+        auto Measure(std::string name, Phase&& phase, Work work = {})
+        {
+            using Clock = std::chrono::steady_clock;
+            using Result = std::invoke_result_t<Phase&>;
+
+            if (!Enabled() && !CountingAllocations && !perf_ && !memoryReport_)
+            {
+                ScopedTraceSpan span{ name };
+                return phase();
+            }
+
+            PhaseTimings timings{ std::move(name), work, {}, {}, {}, {} };
+            timings.samples.reserve(std::max(repetitions_, 1));
+            if (perf_)
+            {
+                perf_->Start();
+            }
+            for (int i = 1; i < repetitions_; ++i)
+            {
+                auto start = Clock::now();
+                if constexpr (std::is_void_v<Result>)
+                {
+                    phase();
+                }
+                else
+                {
+                    [[maybe_unused]] auto discard = phase();
+                }
+                auto end = Clock::now();
+                TraceSpan(timings.name, start, end);
+                timings.samples.push_back(end - start);
+            }
+
+            if (memoryReport_)
+            {
+                StartMemoryPhase();
+            }
+            AllocationCounter allocations;
+            auto start = Clock::now();
+            if constexpr (std::is_void_v<Result>)
+            {
+                phase();
+                auto end = Clock::now();
+                StopPerfCounters(timings);
+                timings.allocations = allocations.Stop();
+                StopMemoryReport(timings);
+                TraceSpan(timings.name, start, end);
+                timings.samples.push_back(end - start);
+                phases_.push_back(std::move(timings));
+            }
+            else
+            {
+                Result result = phase();
+                auto end = Clock::now();
+                StopPerfCounters(timings);
+                timings.allocations = allocations.Stop();
+                StopMemoryReport(timings);
+                TraceSpan(timings.name, start, end);
+                timings.samples.push_back(end - start);
+                phases_.push_back(std::move(timings));
+                return result;
+            }
+        }
+
+        // Prints a table of the measured phases when benchmarking, the trace
+        // summary when tracing, the allocations of each phase when counting
+        // them, the performance counters with --perf and the memory use with
+        // --memory-report. Does nothing otherwise.
+        void Report(std::ostream& out) const;
+
+        std::vector<PhaseTimings> const& Phases() const noexcept
+        {
+            return phases_;
+        }
+
+    private:
+        void StopPerfCounters(PhaseTimings& timings) noexcept
+        {
+            if (perf_)
+            {
+                timings.perf = perf_->Stop();
+            }
+        }
+
+        void StopMemoryReport(PhaseTimings& timings)
+        {
+            if (memoryReport_)
+            {
+                timings.memory = StopMemoryPhase();
+            }
+        }
+
+        void ReportTimings(std::ostream& out) const;
+        void ReportAllocations(std::ostream& out) const;
+        void ReportPerfCounters(std::ostream& out) const;
+        void ReportMemory(std::ostream& out) const;
+        void AppendToHistory(std::ostream& out) const;
+
+        int repetitions_{ 0 };
+        bool memoryReport_{ false };
+        std::string traceFile_;
+        std::string historyFile_;
+        std::string historyLabel_;
+        // From the command line, for the history.
+        std::string day_;
+        std::string input_;
+        std::unique_ptr<PerfCounters> perf_;
+        std::vector<PhaseTimings> phases_;
+    };
+}
@@ -0,0 +1,118 @@
+#include "Common/CpuFeatures.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+
+#if defined(AOC_SIMD_X86) && defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace Common
+{
+    namespace
+    {
+        SimdLevel Detect() noexcept
+        {
+#if defined(AOC_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+            {
+                return SimdLevel::Avx512;
+            }
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return SimdLevel::Avx2;
+            }
+            if (__builtin_cpu_supports("sse4.2"))
+            {
+                return SimdLevel::Sse42;
+            }
+            return SimdLevel::Scalar;
+#elif defined(AOC_SIMD_X86) && defined(_MSC_VER)
+            int regs[4];
+            __cpuid(regs, 1);
+            bool const sse42 = (regs[2] & (1 << 20)) != 0;
+            bool const osSavesYmm = (regs[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+            bool const osSavesZmm = osSavesYmm && (_xgetbv(0) & 0xe0) == 0xe0;
+            __cpuidex(regs, 7, 0);
+            bool const avx2 = osSavesYmm && (regs[1] & (1 << 5)) != 0;
+            bool const avx512 = osSavesZmm && (regs[1] & (1 << 16)) != 0 && (regs[1] & (1 << 30)) != 0;
+            return avx512 ? SimdLevel::Avx512 : avx2 ? SimdLevel::Avx2 : sse42 ? SimdLevel::Sse42 : SimdLevel::Scalar;
+#else
+            return SimdLevel::Scalar;
+#endif
+        }
+
+        // -1 until something is forced.
+        std::atomic<int> forcedLevel{ -1 };
+    }
+
+    std::string_view ToString(SimdLevel level) noexcept
+    {
+        switch (level)
+        {
+        case SimdLevel::Scalar: return "scalar";
+        case SimdLevel::Sse42: return "sse4.2";
+        case SimdLevel::Avx2: return "avx2";
+        case SimdLevel::Avx512: return "avx512";
+        }
+        return "unknown";
+    }
+
+    std::optional<SimdLevel> ParseSimdLevel(std::string_view text) noexcept
+    {
+        for (auto level : { SimdLevel::Scalar, SimdLevel::Sse42, SimdLevel::Avx2, SimdLevel::Avx512 })
+        {
+            if (text == ToString(level))
+            {
+                return level;
+            }
+        }
+        return {};
+    }
+
+    SimdLevel DetectedSimdLevel() noexcept
+    {
+        static SimdLevel const detected = Detect();
+        return detected;
+    }
+
+    SimdLevel ActiveSimdLevel() noexcept
+    {
+        auto forced = forcedLevel.load(std::memory_order_relaxed);
+        return forced < 0 ? DetectedSimdLevel() : static_cast<SimdLevel>(forced);
+    }
+
+    SimdLevel ForceSimdLevel(SimdLevel level) noexcept
+    {
+        level = std::min(level, DetectedSimdLevel());
+        forcedLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+        return level;
+    }
+
+    void ReadSimdOption(int argc, char* argv[])
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view arg{ argv[i] };
+            if (!arg.starts_with("--simd="))
+            {
+                continue;
+            }
+            auto name = arg.substr(7);
+            auto level = ParseSimdLevel(name);
+            if (!level)
+            {
+                std::cerr << "Unknown --simd level " << name << ", use scalar, sse4.2, avx2 or avx512\n";
+                continue;
+            }
+            auto used = ForceSimdLevel(*level);
+            if (used != *level)
+            {
+                std::cerr << "This CPU doesn't support " << name << ", using " << ToString(used) << "\n";
+            }
+        }
+    }
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <optional>
+#include <string_view>
+
+// Kernels for a particular instruction set are built with these in front of
+// them, so one binary can hold every variant and pick one at run time.
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define AOC_SIMD_X86 1
+#if defined(__GNUC__) || defined(__clang__)
+#define AOC_TARGET_SSE42 __attribute__((target("sse4.2")))
+#define AOC_TARGET_AVX2 __attribute__((target("avx2")))
+#define AOC_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+#else
+#define AOC_TARGET_SSE42
+#define AOC_TARGET_AVX2
+#define AOC_TARGET_AVX512
+#endif
+#endif
+
+namespace Common
+{
+    // In order, each one implying the ones before it.
+    enum class SimdLevel
+    {
+        Scalar,
+        Sse42,
+        Avx2,
+        Avx512
+    };
+
+    std::string_view ToString(SimdLevel level) noexcept;
+    // "scalar", "sse4.2", "avx2" or "avx512".
+    std::optional<SimdLevel> ParseSimdLevel(std::string_view text) noexcept;
+
+    // The best level this CPU (and OS) supports, found the first time it's asked.
+    SimdLevel DetectedSimdLevel() noexcept;
+
+    // The level kernels are picked for: the detected one unless forced lower.
+    SimdLevel ActiveSimdLevel() noexcept;
+
+    // For testing and timing each variant. A level the CPU doesn't have is
+    // brought down to the detected one, which is returned.
+    SimdLevel ForceSimdLevel(SimdLevel level) noexcept;
+
+    // --simd=<level> on the command line forces that level, with a warning
+    // on stderr if it had to be lowered or wasn't recognised.
+    void ReadSimdOption(int argc, char* argv[]);
+
+    // A kernel with a variant for each level; nullptr for those it hasn't got,
+    // but the scalar one is required. Calls go to the best variant the active
+    // level allows, looked up on each call so that forcing takes effect at once.
+    template<typename Fn>
+    struct SimdKernel
+    {
+        Fn* scalar;
+        Fn* sse42{ nullptr };
+        Fn* avx2{ nullptr };
+        Fn* avx512{ nullptr };
+
+        Fn* Select() const noexcept
+        {
+            auto level = ActiveSimdLevel();
+            if (level >= SimdLevel::Avx512 && avx512)
+            {
+                return avx512;
+            }
+            if (level >= SimdLevel::Avx2 && avx2)
+            {
+                return avx2;
+            }
+            if (level >= SimdLevel::Sse42 && sse42)
+            {
+                return sse42;
+            }
+            return scalar;
+        }
+
+        template<typename... Args>
+        decltype(auto) operator()(Args&&... args) const
+        {
+            return Select()(static_cast<Args&&>(args)...);
+        }
+    };
+}
@@ -0,0 +1,394 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Common
+{
+    // splitmix64's finaliser, so that keys differing in a few low bits still
+    // spread over the whole table.
+    constexpr std::uint64_t MixHash(std::uint64_t h) noexcept
+    {
+        h ^= h >> 30;
+        h *= 0xbf58476d1ce4e5b9ull;
+        h ^= h >> 27;
+        h *= 0x94d049bb133111ebull;
+        h ^= h >> 31;
+        return h;
+    }
+
+    constexpr std::uint64_t HashCombine(std::uint64_t seed, std::uint64_t value) noexcept
+    {
+        return MixHash(seed + 0x9e3779b97f4a7c15ull + value);
+    }
+
+    // Hashes numbers, enums, pairs and arrays of them, and plain structs with
+    // no padding, like the days' Points, by their bytes. Anything else needs
+    // a specialisation.
+    template<typename T, typename = void>
+    struct Hash
+    {
+        static_assert(std::has_unique_object_representations_v<T>, "Hash by bytes needs a type with no padding, specialise Common::Hash for it");
+
+        std::uint64_t operator()(T const& value) const noexcept
+        {
+            std::uint64_t h = sizeof(T);
+            auto bytes = reinterpret_cast<unsigned char const*>(&value);
+            std::size_t i = 0;
+            for (; i + sizeof(std::uint64_t) <= sizeof(T); i += sizeof(std::uint64_t))
+            {
+                std::uint64_t word;
+                std::memcpy(&word, bytes + i, sizeof(word));
+                h = HashCombine(h, word);
+            }
+            if (i < sizeof(T))
+            {
+                std::uint64_t word = 0;
+                std::memcpy(&word, bytes + i, sizeof(T) - i);
+                h = HashCombine(h, word);
+            }
+            return h;
+        }
+    };
+
+    template<typename T>
+    struct Hash<T, std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>>>
+    {
+        std::uint64_t operator()(T value) const noexcept
+        {
+            return MixHash(static_cast<std::uint64_t>(value));
+        }
+    };
+
+    template<typename A, typename B>
+    struct Hash<std::pair<A, B>>
+    {
+        std::uint64_t operator()(std::pair<A, B> const& value) const noexcept
+        {
+            return HashCombine(Hash<A>{}(value.first), Hash<B>{}(value.second));
+        }
+    };
+
+    template<typename T, std::size_t N>
+    struct Hash<std::array<T, N>>
+    {
+        std::uint64_t operator()(std::array<T, N> const& value) const noexcept
+        {
+            std::uint64_t h = N;
+            for (auto const& element : value)
+            {
+                h = HashCombine(h, Hash<T>{}(element));
+            }
+            return h;
+        }
+    };
+
+    namespace Detail
+    {
+        template<typename Key>
+        struct SetTraits
+        {
+            using value_type = Key;
+            static Key const& KeyOf(value_type const& value) noexcept
+            {
+                return value;
+            }
+        };
+
+        template<typename Key, typename Value>
+        struct MapTraits
+        {
+            using value_type = std::pair<Key, Value>;
+            static Key const& KeyOf(value_type const& value) noexcept
+            {
+                return value.first;
+            }
+        };
+
+        // Open addressing with linear probing in a power of two sized table,
+        // kept at most half full. There is no erase, none of the days need it.
+        template<typename Key, typename Traits, typename HashFn, typename Equal>
+        class FlatTable
+        {
+        public:
+            using key_type = Key;
+            using value_type = typename Traits::value_type;
+            using size_type = std::size_t;
+
+            template<bool Const>
+            class Iterator
+            {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = typename Traits::value_type;
+                using difference_type = std::ptrdiff_t;
+                using reference = std::conditional_t<Const, value_type const&, value_type&>;
+                using pointer = std::conditional_t<Const, value_type const*, value_type*>;
+                using Table = std::conditional_t<Const, FlatTable const, FlatTable>;
+
+                Iterator() = default;
+                Iterator(Table* table, std::size_t slot) noexcept
+                    : table_{ table },
+                    slot_{ slot }
+                {
+                    SkipEmpty();
+                }
+                operator Iterator<true>() const noexcept requires (!Const)
+                {
+                    return { table_, slot_ };
+                }
+
+                reference operator*() const noexcept
+                {
+                    return table_->slots_[slot_];
+                }
+                pointer operator->() const noexcept
+                {
+                    return &table_->slots_[slot_];
+                }
+
+                Iterator& operator++() noexcept
+                {
+                    ++slot_;
+                    SkipEmpty();
+                    return *this;
+                }
+                Iterator operator++(int) noexcept
+                {
+                    auto before = *this;
+                    ++*this;
+                    return before;
+                }
+
+                bool operator==(Iterator const& other) const noexcept
+                {
+                    return slot_ == other.slot_;
+                }
+
+            private:
+                void SkipEmpty() noexcept
+                {
+                    while (slot_ < table_->used_.size() && !table_->used_[slot_])
+                    {
+                        ++slot_;
+                    }
+                }
+
+                Table* table_{ nullptr };
+                std::size_t slot_{ 0 };
+            };
+
+            using iterator = Iterator<false>;
+            using const_iterator = Iterator<true>;
+
+            iterator begin() noexcept
+            {
+                return { this, 0 };
+            }
+            iterator end() noexcept
+            {
+                return { this, used_.size() };
+            }
+            const_iterator begin() const noexcept
+            {
+                return { this, 0 };
+            }
+            const_iterator end() const noexcept
+            {
+                return { this, used_.size() };
+            }
+
+            std::size_t size() const noexcept
+            {
+                return size_;
+            }
+            bool empty() const noexcept
+            {
+                return size_ == 0;
+            }
+            // Slots in the table, used or not.
+            std::size_t bucket_count() const noexcept
+            {
+                return used_.size();
+            }
+
+            // Keeps the table's memory for the next use.
+            void clear() noexcept
+            {
+                std::fill(used_.begin(), used_.end(), 0);
+                size_ = 0;
+            }
+
+            void reserve(std::size_t count)
+            {
+                if (count * 2 <= used_.size())
+                {
+                    return;
+                }
+                std::size_t wanted = std::bit_ceil(std::max<std::size_t>(count * 2, 16));
+                if (wanted > used_.size())
+                {
+                    Rehash(wanted);
+                }
+            }
+
+            iterator find(Key const& key) noexcept
+            {
+                return { this, Find(key) };
+            }
+            const_iterator find(Key const& key) const noexcept
+            {
+                return { this, Find(key) };
+            }
+
+            bool contains(Key const& key) const noexcept
+            {
+                return Find(key) != used_.size();
+            }
+
+            // Leaves an existing element alone, like std::set::insert.
+            std::pair<iterator, bool> insert(value_type value)
+            {
+                reserve(size_ + 1);
+                auto slot = SlotFor(Traits::KeyOf(value));
+                if (used_[slot])
+                {
+                    return { { this, slot }, false };
+                }
+                slots_[slot] = std::move(value);
+                used_[slot] = 1;
+                ++size_;
+                return { { this, slot }, true };
+            }
+
+            template<typename... Args>
+            std::pair<iterator, bool> emplace(Args&&... args)
+            {
+                return insert(value_type(std::forward<Args>(args)...));
+            }
+
+            // The hint is ignored, it's only here to match the std containers.
+            iterator insert(const_iterator, value_type value)
+            {
+                return insert(std::move(value)).first;
+            }
+
+            template<typename InputIt>
+            void insert(InputIt first, InputIt last)
+            {
+                for (; first != last; ++first)
+                {
+                    insert(*first);
+                }
+            }
+
+        protected:
+            // The slot holding key, or the empty one it would go in.
+            std::size_t SlotFor(Key const& key) const noexcept
+            {
+                std::size_t const mask = used_.size() - 1;
+                auto slot = static_cast<std::size_t>(HashFn{}(key)) & mask;
+                while (used_[slot] && !Equal{}(Traits::KeyOf(slots_[slot]), key))
+                {
+                    slot = (slot + 1) & mask;
+                }
+                return slot;
+            }
+
+            // The slot holding key, or used_.size() if it isn't there.
+            std::size_t Find(Key const& key) const noexcept
+            {
+                if (size_ == 0)
+                {
+                    return used_.size();
+                }
+                auto slot = SlotFor(key);
+                return used_[slot] ? slot : used_.size();
+            }
+
+            void Rehash(std::size_t capacity)
+            {
+                std::vector<value_type> oldSlots(capacity);
+                std::vector<std::uint8_t> oldUsed(capacity, 0);
+                std::swap(oldSlots, slots_);
+                std::swap(oldUsed, used_);
+                for (std::size_t i = 0; i < oldUsed.size(); ++i)
+                {
+                    if (oldUsed[i])
+                    {
+                        auto slot = SlotFor(Traits::KeyOf(oldSlots[i]));
+                        slots_[slot] = std::move(oldSlots[i]);
+                        used_[slot] = 1;
+                    }
+                }
+            }
+
+            std::vector<value_type> slots_;
+            std::vector<std::uint8_t> used_;
+            std::size_t size_{ 0 };
+        };
+    }
+
+    // Drop in for std::set/std::unordered_set where nothing is erased and the
+    // order doesn't matter. Elements live in one array, so lookups don't
+    // chase pointers; inserting can move them and invalidates iterators.
+    template<typename Key, typename HashFn = Hash<Key>, typename Equal = std::equal_to<Key>>
+    class FlatSet : public Detail::FlatTable<Key, Detail::SetTraits<Key>, HashFn, Equal>
+    {
+    public:
+        FlatSet() = default;
+
+        template<typename InputIt>
+        FlatSet(InputIt first, InputIt last)
+        {
+            this->insert(first, last);
+        }
+
+        bool operator==(FlatSet const& other) const
+        {
+            return this->size() == other.size()
+                && std::all_of(this->begin(), this->end(), [&other](Key const& key) { return other.contains(key); });
+        }
+    };
+
+    // Drop in for std::map/std::unordered_map with the same limits as FlatSet.
+    // Iterating gives std::pair<Key, Value>, whose key mustn't be changed.
+    template<typename Key, typename Value, typename HashFn = Hash<Key>, typename Equal = std::equal_to<Key>>
+    class FlatMap : public Detail::FlatTable<Key, Detail::MapTraits<Key, Value>, HashFn, Equal>
+    {
+    public:
+        using mapped_type = Value;
+
+        Value& operator[](Key const& key)
+        {
+            this->reserve(this->size_ + 1);
+            auto slot = this->SlotFor(key);
+            if (!this->used_[slot])
+            {
+                this->slots_[slot] = { key, Value{} };
+                this->used_[slot] = 1;
+                ++this->size_;
+            }
+            return this->slots_[slot].second;
+        }
+
+        bool operator==(FlatMap const& other) const
+        {
+            return this->size() == other.size()
+                && std::all_of(this->begin(), this->end(), [&other](auto const& element)
+                    {
+                        auto it = other.find(element.first);
+                        return it != other.end() && it->second == element.second;
+                    });
+        }
+    };
+}
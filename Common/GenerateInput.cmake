@@ -0,0 +1,10 @@
+# Runs one day's generator into a file, used by the scaled_inputs target.
+#   cmake -DGEN_EXE=<path> -DOUTPUT=<file> -DSCALE=<factor> -P GenerateInput.cmake
+message (STATUS "Generating ${OUTPUT}")
+execute_process (
+    COMMAND "${GEN_EXE}" "--scale=${SCALE}"
+    OUTPUT_FILE "${OUTPUT}"
+    RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+    message (FATAL_ERROR "${GEN_EXE} failed: ${result}")
+endif ()
@@ -0,0 +1,44 @@
+#include "Common/Generator.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "Common/Input.h"
+
+namespace Common
+{
+    Generator::Generator(int argc, char* argv[], std::size_t defaultSize)
+        : size_{ defaultSize }
+    {
+        // generated inputs can run to hundreds of megabytes
+        std::ios::sync_with_stdio(false);
+
+        std::uint64_t seed = DefaultSeed;
+        double scale = 1.0;
+        bool sizeGiven = false;
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view arg{ argv[i] };
+            if (arg.starts_with("--seed="))
+            {
+                seed = ToNumber<std::uint64_t>(arg.substr(7));
+            }
+            else if (arg.starts_with("--scale="))
+            {
+                scale = std::stod(std::string{ arg.substr(8) });
+            }
+            else if (!arg.starts_with("-"))
+            {
+                size_ = ToNumber<std::size_t>(arg);
+                sizeGiven = true;
+            }
+        }
+        if (!sizeGiven)
+        {
+            size_ = std::max<std::size_t>(1, static_cast<std::size_t>(std::llround(static_cast<double>(defaultSize) * scale)));
+        }
+        random_.seed(seed);
+    }
+}
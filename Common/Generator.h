@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace Common
+{
+    // Shared command line and random numbers for the DayN_gen input generators:
+    //   DayN_gen [size] [--scale=F] [--seed=N]
+    // size is whatever grows the input for that day (lines, cards, the side of
+    // a grid...). Without it the puzzle's own size is used, multiplied by F.
+    // The same seed always gives the same input.
+    class Generator
+    {
+    public:
+        static std::uint64_t constexpr DefaultSeed = 2021;
+
+        Generator(int argc, char* argv[], std::size_t defaultSize);
+
+        std::size_t Size() const noexcept
+        {
+            return size_;
+        }
+
+        // Inclusive at both ends.
+        template<typename T>
+        T Uniform(T low, T high)
+        {
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                return std::uniform_real_distribution<T>{ low, high }(random_);
+            }
+            else
+            {
+                return std::uniform_int_distribution<T>{ low, high }(random_);
+            }
+        }
+
+        bool Chance(double probability)
+        {
+            return std::bernoulli_distribution{ probability }(random_);
+        }
+
+        template<typename T>
+        T const& Pick(std::vector<T> const& values)
+        {
+            return values[Uniform<std::size_t>(0, values.size() - 1)];
+        }
+
+        template<typename Range>
+        void Shuffle(Range& values)
+        {
+            std::shuffle(std::begin(values), std::end(values), random_);
+        }
+
+        std::mt19937_64& Random() noexcept
+        {
+            return random_;
+        }
+
+    private:
+        std::size_t size_;
+        std::mt19937_64 random_;
+    };
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace Common
+{
+    // For a Grid2D whose width is only known at run time.
+    int constexpr DynamicWidth = -1;
+
+    // A rectangle of cells inside a Grid2D, indexed from its own top left.
+    template<typename T>
+    class GridView
+    {
+    public:
+        GridView(T* origin, int width, int height, std::ptrdiff_t stride) noexcept
+            : origin_{ origin },
+            width_{ width },
+            height_{ height },
+            stride_{ stride }
+        {}
+
+        int Width() const noexcept
+        {
+            return width_;
+        }
+        int Height() const noexcept
+        {
+            return height_;
+        }
+
+        T& operator()(int x, int y) const noexcept
+        {
+            return origin_[y * stride_ + x];
+        }
+
+        std::span<T> Row(int y) const noexcept
+        {
+            return { origin_ + y * stride_, static_cast<std::size_t>(width_) };
+        }
+
+    private:
+        T* origin_;
+        int width_;
+        int height_;
+        std::ptrdiff_t stride_;
+    };
+
+    // A width x height grid stored row by row in one block, indexed (x, y).
+    // Border adds that many cells all the way round, which can be read and
+    // written at x or y from -Border to Width() + Border - 1, so a neighbour
+    // lookup at the edge can land in the border instead of needing a bounds
+    // check. With FixedWidth the stride is a compile time constant.
+    template<typename T, int Border = 0, int FixedWidth = DynamicWidth>
+    class Grid2D
+    {
+        static_assert(!std::is_same_v<T, bool>, "vector<bool> can't hand out references to cells, use char");
+        static_assert(Border >= 0);
+        static_assert(FixedWidth == DynamicWidth || FixedWidth > 0);
+
+    public:
+        Grid2D() = default;
+
+        // With a FixedWidth the width here is ignored.
+        Grid2D(int width, int height, T const& fill = T{})
+            : width_{ FixedWidth == DynamicWidth ? width : FixedWidth },
+            height_{ height },
+            cells_(static_cast<std::size_t>(width_ + 2 * Border) * (height + 2 * Border), fill)
+        {}
+
+        int Width() const noexcept
+        {
+            if constexpr (FixedWidth != DynamicWidth)
+            {
+                return FixedWidth;
+            }
+            else
+            {
+                return width_;
+            }
+        }
+        int Height() const noexcept
+        {
+            return height_;
+        }
+        // Cells in the grid itself, not counting the border.
+        std::size_t Size() const noexcept
+        {
+            return static_cast<std::size_t>(Width()) * height_;
+        }
+
+        // Distance in cells from one row to the next.
+        std::ptrdiff_t Stride() const noexcept
+        {
+            return Width() + 2 * Border;
+        }
+
+        bool Contains(int x, int y) const noexcept
+        {
+            return x >= 0 && x < Width() && y >= 0 && y < height_;
+        }
+
+        // Offset of (x, y) in Cells(), for walking the grid with plain offsets.
+        std::size_t Index(int x, int y) const noexcept
+        {
+            return static_cast<std::size_t>((y + Border) * Stride() + x + Border);
+        }
+
+        T& operator()(int x, int y) noexcept
+        {
+            return cells_[Index(x, y)];
+        }
+        T const& operator()(int x, int y) const noexcept
+        {
+            return cells_[Index(x, y)];
+        }
+
+        // Row y without the border.
+        std::span<T> Row(int y) noexcept
+        {
+            return { cells_.data() + Index(0, y), static_cast<std::size_t>(Width()) };
+        }
+        std::span<T const> Row(int y) const noexcept
+        {
+            return { cells_.data() + Index(0, y), static_cast<std::size_t>(Width()) };
+        }
+
+        GridView<T> Tile(int x, int y, int width, int height) noexcept
+        {
+            return { cells_.data() + Index(x, y), width, height, Stride() };
+        }
+        GridView<T const> Tile(int x, int y, int width, int height) const noexcept
+        {
+            return { cells_.data() + Index(x, y), width, height, Stride() };
+        }
+
+        // Every cell, border included, in storage order.
+        std::span<T> Cells() noexcept
+        {
+            return cells_;
+        }
+        std::span<T const> Cells() const noexcept
+        {
+            return cells_;
+        }
+
+        void FillBorder(T const& value)
+        {
+            if constexpr (Border > 0)
+            {
+                auto stride = static_cast<std::size_t>(Stride());
+                std::fill_n(cells_.begin(), Border * stride, value);
+                std::fill(cells_.end() - Border * stride, cells_.end(), value);
+                for (int y = 0; y < height_; ++y)
+                {
+                    auto row = cells_.begin() + Index(0, y);
+                    std::fill(row - Border, row, value);
+                    std::fill(row + Width(), row + Width() + Border, value);
+                }
+            }
+        }
+
+        bool operator==(Grid2D const&) const = default;
+
+    private:
+        int width_{ 0 };
+        int height_{ 0 };
+        std::vector<T> cells_;
+    };
+}
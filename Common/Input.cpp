@@ -0,0 +1,387 @@
+#include "Common/Input.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Common
+{
+    namespace
+    {
+        std::string ReadWholeStream(std::FILE* in)
+        {
+            std::string result;
+            std::size_t constexpr chunkSize = 1 << 20;
+            std::size_t used = 0;
+            while (true)
+            {
+                result.resize(used + chunkSize);
+                auto got = std::fread(result.data() + used, 1, chunkSize, in);
+                used += got;
+                if (got < chunkSize)
+                {
+                    break;
+                }
+            }
+            result.resize(used);
+            return result;
+        }
+    }
+
+    InputBuffer::InputBuffer(InputBuffer&& other) noexcept
+        : data_{ std::exchange(other.data_, nullptr) },
+        size_{ std::exchange(other.size_, 0) },
+        mapping_{ std::exchange(other.mapping_, nullptr) },
+        owned_{ std::move(other.owned_) }
+    {
+        if (!mapping_)
+        {
+            data_ = owned_.data();
+        }
+    }
+
+    InputBuffer& InputBuffer::operator=(InputBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Release();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            mapping_ = std::exchange(other.mapping_, nullptr);
+            owned_ = std::move(other.owned_);
+            if (!mapping_)
+            {
+                data_ = owned_.data();
+            }
+        }
+        return *this;
+    }
+
+    InputBuffer::~InputBuffer()
+    {
+        Release();
+    }
+
+    void InputBuffer::Release() noexcept
+    {
+        if (mapping_)
+        {
+#ifdef _WIN32
+            UnmapViewOfFile(mapping_);
+#else
+            munmap(mapping_, size_);
+#endif
+        }
+        mapping_ = nullptr;
+        data_ = nullptr;
+        size_ = 0;
+        owned_.clear();
+    }
+
+    InputBuffer InputBuffer::FromString(std::string text)
+    {
+        InputBuffer result;
+        result.owned_ = std::move(text);
+        result.data_ = result.owned_.data();
+        result.size_ = result.owned_.size();
+        return result;
+    }
+
+    InputBuffer InputBuffer::FromStdin()
+    {
+        return FromString(ReadWholeStream(stdin));
+    }
+
+#ifdef _WIN32
+    InputBuffer InputBuffer::FromFile(std::string const& path)
+    {
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            throw std::runtime_error("Could not open input file: " + path);
+        }
+
+        LARGE_INTEGER fileSize{};
+        GetFileSizeEx(file, &fileSize);
+        if (fileSize.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return {};
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping)
+        {
+            throw std::runtime_error("Could not map input file: " + path);
+        }
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (!view)
+        {
+            throw std::runtime_error("Could not map input file: " + path);
+        }
+
+        InputBuffer result;
+        result.mapping_ = view;
+        result.data_ = static_cast<char const*>(view);
+        result.size_ = static_cast<std::size_t>(fileSize.QuadPart);
+        return result;
+    }
+#else
+    InputBuffer InputBuffer::FromFile(std::string const& path)
+    {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw std::runtime_error("Could not open input file: " + path);
+        }
+
+        struct stat info{};
+        if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+        {
+            // pipes and devices can't be mapped, so just read them
+            std::FILE* in = fdopen(fd, "rb");
+            if (!in)
+            {
+                close(fd);
+                throw std::runtime_error("Could not open input file: " + path);
+            }
+            auto text = ReadWholeStream(in);
+            std::fclose(in);
+            return FromString(std::move(text));
+        }
+        if (info.st_size == 0)
+        {
+            close(fd);
+            return {};
+        }
+
+        auto size = static_cast<std::size_t>(info.st_size);
+        void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (view == MAP_FAILED)
+        {
+            throw std::runtime_error("Could not map input file: " + path);
+        }
+        madvise(view, size, MADV_SEQUENTIAL);
+
+        InputBuffer result;
+        result.mapping_ = view;
+        result.data_ = static_cast<char const*>(view);
+        result.size_ = size;
+        return result;
+    }
+#endif
+
+    InputBuffer InputBuffer::FromCommandLine(int argc, char* argv[])
+    {
+        if (StreamRequested(argc, argv))
+        {
+            // the days that can stream never get here
+            std::cerr << "This day can't --stream its input, reading it all\n";
+        }
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view arg{ argv[i] };
+            if (arg.empty() || arg.front() == '-')
+            {
+                continue;
+            }
+            return FromFile(argv[i]);
+        }
+        return FromStdin();
+    }
+
+    LineStream::LineStream(std::FILE* file, std::size_t blockSize)
+        : file_{ file },
+        block_(std::max<std::size_t>(blockSize, 16))
+    {}
+
+    LineStream::LineStream(LineStream&& other) noexcept
+        : file_{ std::exchange(other.file_, nullptr) },
+        block_{ std::move(other.block_) },
+        begin_{ other.begin_ },
+        end_{ other.end_ },
+        bytesRead_{ other.bytesRead_ },
+        atEnd_{ other.atEnd_ }
+    {}
+
+    LineStream::~LineStream()
+    {
+        if (file_ && file_ != stdin)
+        {
+            std::fclose(file_);
+        }
+    }
+
+    LineStream LineStream::FromFile(std::string const& path)
+    {
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        if (!file)
+        {
+            throw std::runtime_error("Could not open input file: " + path);
+        }
+        return LineStream{ file };
+    }
+
+    LineStream LineStream::FromCommandLine(int argc, char* argv[])
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view arg{ argv[i] };
+            if (arg.empty() || arg.front() == '-')
+            {
+                continue;
+            }
+            return FromFile(argv[i]);
+        }
+        return LineStream{ stdin };
+    }
+
+    bool LineStream::Next(std::string_view& line)
+    {
+        std::size_t searched = begin_;
+        while (true)
+        {
+            auto first = block_.data() + searched;
+            auto newline = static_cast<char const*>(std::memchr(first, '\n', end_ - searched));
+            if (newline)
+            {
+                line = { block_.data() + begin_, static_cast<std::size_t>(newline - block_.data()) - begin_ };
+                begin_ = static_cast<std::size_t>(newline - block_.data()) + 1;
+                break;
+            }
+            if (atEnd_)
+            {
+                if (begin_ == end_)
+                {
+                    return false;
+                }
+                // the last line has no newline
+                line = { block_.data() + begin_, end_ - begin_ };
+                begin_ = end_;
+                break;
+            }
+            searched = end_ - begin_;
+            Refill();
+        }
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.remove_suffix(1);
+        }
+        return true;
+    }
+
+    bool LineStream::Refill()
+    {
+        auto unread = end_ - begin_;
+        if (begin_ > 0)
+        {
+            std::memmove(block_.data(), block_.data() + begin_, unread);
+            begin_ = 0;
+            end_ = unread;
+        }
+        if (end_ == block_.size())
+        {
+            // a line longer than the block
+            block_.resize(block_.size() * 2);
+        }
+        auto got = std::fread(block_.data() + end_, 1, block_.size() - end_, file_);
+        end_ += got;
+        bytesRead_ += got;
+        if (got == 0)
+        {
+            atEnd_ = true;
+        }
+        return got > 0;
+    }
+
+    bool StreamRequested(int argc, char* argv[]) noexcept
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            if (std::string_view{ argv[i] } == "--stream")
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool EmbeddedRequested(int argc, char* argv[]) noexcept
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            if (std::string_view{ argv[i] } == "--embedded")
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::optional<std::string_view> OptionValue(int argc, char* argv[], std::string_view name)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view arg{ argv[i] };
+            if (!arg.starts_with(name))
+            {
+                continue;
+            }
+            arg.remove_prefix(name.size());
+            if (arg.empty())
+            {
+                return arg;
+            }
+            if (arg.front() == '=')
+            {
+                return arg.substr(1);
+            }
+        }
+        return std::nullopt;
+    }
+
+    void UsageError(std::string_view usage)
+    {
+        std::cerr << usage << "\n";
+        std::exit(1);
+    }
+
+    std::size_t OptionNumber(std::string_view value, std::string_view usage, std::size_t atLeast, std::size_t atMost)
+    {
+        std::size_t number = 0;
+        auto [ptr, ec] = FromChars(value.data(), value.data() + value.size(), number);
+        if (value.empty() || ec != std::errc{} || ptr != value.data() + value.size() || number < atLeast || number > atMost)
+        {
+            UsageError(usage);
+        }
+        return number;
+    }
+
+    std::vector<std::size_t> OptionNumbers(std::string_view value, std::string_view usage, std::size_t atLeast, std::size_t atMost)
+    {
+        std::vector<std::size_t> numbers;
+        do
+        {
+            numbers.push_back(OptionNumber(NextField(value, ','), usage, atLeast, atMost));
+        } while (!value.empty());
+        return numbers;
+    }
+}
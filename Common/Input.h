@@ -0,0 +1,330 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+namespace Common
+{
+    // Holds the whole of a puzzle input in one block of memory. Files are
+    // memory mapped where the platform supports it, stdin is read in one go.
+    class InputBuffer
+    {
+    public:
+        InputBuffer() = default;
+        InputBuffer(InputBuffer&& other) noexcept;
+        InputBuffer& operator=(InputBuffer&& other) noexcept;
+        InputBuffer(InputBuffer const&) = delete;
+        InputBuffer& operator=(InputBuffer const&) = delete;
+        ~InputBuffer();
+
+        static InputBuffer FromFile(std::string const& path);
+        static InputBuffer FromStdin();
+        static InputBuffer FromString(std::string text);
+
+        // Reads the first argument that isn't an option as a file, otherwise stdin.
+        // Warns if --stream was asked for, as a day that reads it all can't.
+        static InputBuffer FromCommandLine(int argc, char* argv[]);
+
+        std::string_view Text() const noexcept
+        {
+            return { data_, size_ };
+        }
+        std::size_t Size() const noexcept
+        {
+            return size_;
+        }
+
+    private:
+        void Release() noexcept;
+
+        char const* data_{ nullptr };
+        std::size_t size_{ 0 };
+        void* mapping_{ nullptr };
+        std::string owned_;
+    };
+
+    // Reads a file or stdin a block at a time and hands out its lines, for
+    // input too big to hold at once. Memory use is the block plus the longest
+    // line. Lines are dropped of a trailing '\r' like LineReader's, and each
+    // is only valid until the next call to Next.
+    class LineStream
+    {
+    public:
+        static std::size_t constexpr DefaultBlockSize = 1 << 16;
+
+        // Takes ownership of file, closing it when done unless it's stdin.
+        explicit LineStream(std::FILE* file, std::size_t blockSize = DefaultBlockSize);
+        LineStream(LineStream&& other) noexcept;
+        LineStream& operator=(LineStream&&) = delete;
+        LineStream(LineStream const&) = delete;
+        LineStream& operator=(LineStream const&) = delete;
+        ~LineStream();
+
+        static LineStream FromFile(std::string const& path);
+        // Like InputBuffer's, the first argument that isn't an option, else stdin.
+        static LineStream FromCommandLine(int argc, char* argv[]);
+
+        bool Next(std::string_view& line);
+
+        std::uint64_t BytesRead() const noexcept
+        {
+            return bytesRead_;
+        }
+
+    private:
+        // Moves the unread part to the front and reads more after it.
+        bool Refill();
+
+        std::FILE* file_{ nullptr };
+        std::vector<char> block_;
+        std::size_t begin_{ 0 };
+        std::size_t end_{ 0 };
+        std::uint64_t bytesRead_{ 0 };
+        bool atEnd_{ false };
+    };
+
+    // --stream on the command line asks a day that can to read its input with
+    // a LineStream, keeping only what it needs of it.
+    bool StreamRequested(int argc, char* argv[]) noexcept;
+
+    // --embedded on the command line asks a day built with AOC_EMBED_INPUTS
+    // for the answers the compiler worked out for its embedded input.
+    bool EmbeddedRequested(int argc, char* argv[]) noexcept;
+
+    // The value of --name=<value> on the command line, empty for a bare
+    // --name, or nothing if it isn't there.
+    std::optional<std::string_view> OptionValue(int argc, char* argv[], std::string_view name);
+
+    // Prints usage to std::cerr and exits with status 1, for an option
+    // that can't be read.
+    [[noreturn]] void UsageError(std::string_view usage);
+
+    // An option's value as a whole number from atLeast to atMost, or a
+    // UsageError. OptionNumbers reads a list of them separated by commas.
+    std::size_t OptionNumber(std::string_view value, std::string_view usage,
+        std::size_t atLeast = 0, std::size_t atMost = std::numeric_limits<std::size_t>::max());
+    std::vector<std::size_t> OptionNumbers(std::string_view value, std::string_view usage,
+        std::size_t atLeast = 0, std::size_t atMost = std::numeric_limits<std::size_t>::max());
+
+    // Walks through text a line at a time without copying. A trailing '\r' is
+    // dropped so files with Windows line endings read the same everywhere.
+    class LineReader
+    {
+    public:
+        constexpr explicit LineReader(std::string_view text) noexcept
+            : text_{ text }
+        {}
+
+        constexpr bool Next(std::string_view& line) noexcept
+        {
+            if (text_.empty())
+            {
+                return false;
+            }
+            auto end = text_.find('\n');
+            if (end == std::string_view::npos)
+            {
+                line = text_;
+                text_ = {};
+            }
+            else
+            {
+                line = text_.substr(0, end);
+                text_.remove_prefix(end + 1);
+            }
+            if (!line.empty() && line.back() == '\r')
+            {
+                line.remove_suffix(1);
+            }
+            return true;
+        }
+
+        constexpr std::string_view Remaining() const noexcept
+        {
+            return text_;
+        }
+
+    private:
+        std::string_view text_;
+    };
+
+    // std::from_chars for integers, which the compiler can run too. It can't
+    // run std::from_chars itself before C++23, so while it's evaluating this
+    // reads the digits one by one instead.
+    template<typename T>
+    constexpr std::from_chars_result FromChars(char const* first, char const* last, T& value, int base = 10) noexcept
+    {
+        static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "FromChars reads integers");
+        if (!std::is_constant_evaluated())
+        {
+            return std::from_chars(first, last, value, base);
+        }
+
+        auto next = first;
+        bool negative = false;
+        if constexpr (std::is_signed_v<T>)
+        {
+            if (next != last && *next == '-')
+            {
+                negative = true;
+                ++next;
+            }
+        }
+        using Unsigned = std::make_unsigned_t<T>;
+        Unsigned limit = std::numeric_limits<T>::max();
+        if (negative)
+        {
+            ++limit;
+        }
+
+        auto digits = next;
+        Unsigned magnitude = 0;
+        bool overflow = false;
+        for (; next != last; ++next)
+        {
+            char c = *next;
+            int digit = c >= '0' && c <= '9' ? c - '0'
+                : c >= 'a' && c <= 'z' ? c - 'a' + 10
+                : c >= 'A' && c <= 'Z' ? c - 'A' + 10
+                : base;
+            if (digit >= base)
+            {
+                break;
+            }
+            if (magnitude > (limit - static_cast<Unsigned>(digit)) / static_cast<Unsigned>(base))
+            {
+                overflow = true;
+            }
+            else
+            {
+                magnitude = magnitude * static_cast<Unsigned>(base) + static_cast<Unsigned>(digit);
+            }
+        }
+        if (next == digits)
+        {
+            return { first, std::errc::invalid_argument };
+        }
+        if (overflow)
+        {
+            return { next, std::errc::result_out_of_range };
+        }
+        value = static_cast<T>(negative ? static_cast<Unsigned>(~magnitude + 1) : magnitude);
+        return { next, std::errc{} };
+    }
+
+    constexpr bool IsSpace(char c) noexcept
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    constexpr void SkipSpaces(std::string_view& text) noexcept
+    {
+        while (!text.empty() && IsSpace(text.front()))
+        {
+            text.remove_prefix(1);
+        }
+    }
+
+    // Removes and returns everything up to the next delimiter, which is skipped.
+    constexpr std::string_view NextField(std::string_view& text, char delim) noexcept
+    {
+        auto end = text.find(delim);
+        auto field = text.substr(0, end);
+        text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+        return field;
+    }
+
+    // Removes and returns the next whitespace separated word.
+    constexpr std::string_view NextWord(std::string_view& text) noexcept
+    {
+        SkipSpaces(text);
+        std::size_t end = 0;
+        while (end < text.size() && !IsSpace(text[end]))
+        {
+            ++end;
+        }
+        auto word = text.substr(0, end);
+        text.remove_prefix(end);
+        return word;
+    }
+
+    // Reads a number from the front of text after any whitespace, like operator>>.
+    template<typename T = int>
+    constexpr T NextNumber(std::string_view& text, int base = 10)
+    {
+        SkipSpaces(text);
+        T value{};
+        auto [ptr, ec] = FromChars(text.data(), text.data() + text.size(), value, base);
+        if (ec != std::errc{})
+        {
+            throw std::runtime_error("Expected a number in input: " + std::string{ text.substr(0, 16) });
+        }
+        text.remove_prefix(static_cast<std::size_t>(ptr - text.data()));
+        return value;
+    }
+
+    // Converts a whole field to a number. Surrounding whitespace is allowed.
+    template<typename T = int>
+    constexpr T ToNumber(std::string_view field, int base = 10)
+    {
+        auto value = NextNumber<T>(field, base);
+        SkipSpaces(field);
+        if (!field.empty())
+        {
+            throw std::runtime_error("Unexpected characters after number: " + std::string{ field });
+        }
+        return value;
+    }
+
+    // Reads the numbers in text one at a time, separated by separator and any
+    // spaces, the way Numbers in Common/Sequence.h yields them. A separator of
+    // ' ' means just spaces. Stops at the first thing that doesn't fit. Unlike
+    // a coroutine, the compiler can run it.
+    template<typename T = int>
+    class NumberReader
+    {
+    public:
+        constexpr explicit NumberReader(std::string_view text, char separator = ',') noexcept
+            : text_{ text },
+            separator_{ separator }
+        {
+            SkipSpaces(text_);
+        }
+
+        constexpr bool Next(T& value)
+        {
+            if (text_.empty())
+            {
+                return false;
+            }
+            value = NextNumber<T>(text_);
+            if (separator_ == ' ')
+            {
+                SkipSpaces(text_);
+            }
+            else if (!text_.empty() && text_.front() == separator_)
+            {
+                text_.remove_prefix(1);
+            }
+            else
+            {
+                text_ = {};
+            }
+            return true;
+        }
+
+    private:
+        std::string_view text_;
+        char separator_;
+    };
+}
@@ -0,0 +1,122 @@
+#include "Common/MemoryReport.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace Common
+{
+    namespace
+    {
+        std::atomic<bool> enabled{ false };
+
+        std::mutex footprintsMutex;
+        std::vector<std::pair<std::string, std::uint64_t>> footprints;
+
+#if defined(__linux__)
+        // The second number in statm is the resident pages.
+        std::uint64_t ReadRss()
+        {
+            std::ifstream statm{ "/proc/self/statm" };
+            std::uint64_t size{ 0 };
+            std::uint64_t resident{ 0 };
+            if (!(statm >> size >> resident))
+            {
+                return 0;
+            }
+            return resident * static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+        }
+
+        // VmHWM is the high water mark of the RSS, in kB.
+        std::uint64_t ReadPeakRss()
+        {
+            std::ifstream status{ "/proc/self/status" };
+            std::string line;
+            while (std::getline(status, line))
+            {
+                if (line.starts_with("VmHWM:"))
+                {
+                    return std::stoull(line.substr(6)) * 1024;
+                }
+            }
+            return 0;
+        }
+
+        // Writing 5 to clear_refs resets VmHWM to the current RSS. Not every
+        // kernel allows it, in which case the peak is for the run so far.
+        bool ResetPeakRss()
+        {
+            std::ofstream clearRefs{ "/proc/self/clear_refs" };
+            clearRefs << "5";
+            clearRefs.flush();
+            return clearRefs.good();
+        }
+#else
+        std::uint64_t ReadRss()
+        {
+            return 0;
+        }
+        std::uint64_t ReadPeakRss()
+        {
+            return 0;
+        }
+        bool ResetPeakRss()
+        {
+            return false;
+        }
+#endif
+
+        bool peakReset{ false };
+    }
+
+    bool MemoryReportEnabled() noexcept
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    void EnableMemoryReport() noexcept
+    {
+        enabled.store(true, std::memory_order_relaxed);
+    }
+
+    void StartMemoryPhase() noexcept
+    {
+        {
+            std::lock_guard lock{ footprintsMutex };
+            footprints.clear();
+        }
+        peakReset = ResetPeakRss();
+    }
+
+    MemoryUsage StopMemoryPhase()
+    {
+        MemoryUsage usage;
+        usage.rssBytes = ReadRss();
+        usage.peakRssBytes = std::max(ReadPeakRss(), usage.rssBytes);
+        usage.peakIsForPhase = peakReset;
+        std::lock_guard lock{ footprintsMutex };
+        usage.footprints = std::move(footprints);
+        footprints.clear();
+        return usage;
+    }
+
+    void NoteFootprint(std::string_view name, std::uint64_t bytes)
+    {
+        std::lock_guard lock{ footprintsMutex };
+        auto found = std::find_if(footprints.begin(), footprints.end(), [name](auto const& f) { return f.first == name; });
+        if (found == footprints.end())
+        {
+            footprints.emplace_back(name, bytes);
+        }
+        else
+        {
+            found->second = std::max(found->second, bytes);
+        }
+    }
+}
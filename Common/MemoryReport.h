@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Common/Arena.h"
+#include "Common/FlatHash.h"
+#include "Common/Grid2D.h"
+
+namespace Common
+{
+    // --memory-report makes each phase of a day report its resident set
+    // size at the end, the peak during it and the sizes of the structures
+    // the day noted with AOC_NOTE_FOOTPRINT. The RSS figures come from
+    // /proc/self, so elsewhere than Linux only the structure sizes show.
+    struct MemoryUsage
+    {
+        std::uint64_t rssBytes{ 0 };
+        std::uint64_t peakRssBytes{ 0 };
+        // Whether the peak is just for the phase, which needs a kernel that
+        // can reset it, rather than for the whole run so far.
+        bool peakIsForPhase{ false };
+        // The largest size noted under each name, in the order first noted.
+        std::vector<std::pair<std::string, std::uint64_t>> footprints;
+    };
+
+    bool MemoryReportEnabled() noexcept;
+    void EnableMemoryReport() noexcept;
+
+    // Resets the peak RSS, if it can, and forgets the noted footprints.
+    void StartMemoryPhase() noexcept;
+    MemoryUsage StopMemoryPhase();
+
+    // Keeps the largest bytes seen for name during this phase. Thread safe.
+    void NoteFootprint(std::string_view name, std::uint64_t bytes);
+
+    // Roughly how many bytes a value holds, counting what its containers point
+    // to. Node based containers are guessed at three pointers of overhead per
+    // element, which is about what the standard libraries use.
+    template<typename T>
+    std::uint64_t Footprint(T const& value);
+
+    namespace Detail
+    {
+        std::uint64_t constexpr NodeOverhead = 3 * sizeof(void*);
+
+        template<typename T>
+        std::uint64_t HeapFootprint(T const&)
+        {
+            return 0;
+        }
+
+        template<typename T, typename A>
+        std::uint64_t HeapFootprint(std::vector<T, A> const& v)
+        {
+            std::uint64_t bytes = v.capacity() * sizeof(T);
+            if constexpr (!std::is_trivially_copyable_v<T>)
+            {
+                for (auto const& element : v)
+                {
+                    bytes += HeapFootprint(element);
+                }
+            }
+            return bytes;
+        }
+
+        inline std::uint64_t HeapFootprint(std::string const& s)
+        {
+            // short strings live inside the string itself
+            return s.capacity() > 15 ? s.capacity() + 1 : 0;
+        }
+
+        inline std::uint64_t HeapFootprint(Arena const& arena)
+        {
+            return arena.BytesReserved();
+        }
+
+        template<typename K, typename C, typename A>
+        std::uint64_t HeapFootprint(std::set<K, C, A> const& s)
+        {
+            return s.size() * (sizeof(K) + NodeOverhead);
+        }
+
+        template<typename K, typename V, typename C, typename A>
+        std::uint64_t HeapFootprint(std::map<K, V, C, A> const& m)
+        {
+            return m.size() * (sizeof(std::pair<K const, V>) + NodeOverhead);
+        }
+
+        template<typename K, typename H, typename E>
+        std::uint64_t HeapFootprint(FlatSet<K, H, E> const& s)
+        {
+            return s.bucket_count() * (sizeof(K) + 1);
+        }
+
+        template<typename K, typename V, typename H, typename E>
+        std::uint64_t HeapFootprint(FlatMap<K, V, H, E> const& m)
+        {
+            return m.bucket_count() * (sizeof(std::pair<K, V>) + 1);
+        }
+
+        template<typename T, int Border, int FixedWidth>
+        std::uint64_t HeapFootprint(Grid2D<T, Border, FixedWidth> const& grid)
+        {
+            return grid.Cells().size_bytes();
+        }
+    }
+
+    template<typename T>
+    std::uint64_t Footprint(T const& value)
+    {
+        return sizeof(T) + Detail::HeapFootprint(value);
+    }
+}
+
+// Notes the footprint of a structure under name when --memory-report is on,
+// without working it out otherwise.
+#define AOC_NOTE_FOOTPRINT(name, value) \
+    do \
+    { \
+        if (::Common::MemoryReportEnabled()) \
+        { \
+            ::Common::NoteFootprint(name, ::Common::Footprint(value)); \
+        } \
+    } while (false)
@@ -0,0 +1,138 @@
+#include "Common/ParseCache.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace Common
+{
+    namespace
+    {
+        struct FileHeader
+        {
+            char magic[8];
+            std::uint32_t formatVersion;
+            std::uint32_t typeSize;
+            std::uint64_t typeHash;
+            std::uint64_t inputHash;
+            std::uint64_t inputSize;
+            std::uint64_t payloadSize;
+        };
+
+        char constexpr Magic[8] = { 'A', 'O', 'C', 'P', 'A', 'R', 'S', 'E' };
+    }
+
+    ParseCache::ParseCache(int argc, char* argv[])
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view arg{ argv[i] };
+            if (arg == "--cache")
+            {
+                directory_ = ".aoc_cache";
+            }
+            else if (arg.starts_with("--cache="))
+            {
+                directory_ = arg.substr(8);
+            }
+        }
+    }
+
+    std::uint64_t ParseCache::HashBytes(std::string_view bytes) noexcept
+    {
+        // eight bytes at a time, each mixed in with a multiply and a shift
+        std::uint64_t constexpr Multiplier = 0x9E3779B97F4A7C15ull;
+        std::uint64_t hash = bytes.size() * Multiplier;
+        auto mix = [&hash](std::uint64_t word)
+        {
+            hash = (hash ^ word) * Multiplier;
+            hash ^= hash >> 29;
+        };
+
+        std::size_t i = 0;
+        for (; i + sizeof(std::uint64_t) <= bytes.size(); i += sizeof(std::uint64_t))
+        {
+            std::uint64_t word;
+            std::memcpy(&word, bytes.data() + i, sizeof(word));
+            mix(word);
+        }
+        if (i < bytes.size())
+        {
+            std::uint64_t word = 0;
+            std::memcpy(&word, bytes.data() + i, bytes.size() - i);
+            mix(word);
+        }
+        return hash;
+    }
+
+    std::string ParseCache::PathFor(Key const& key) const
+    {
+        char hash[17];
+        std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(key.inputHash));
+        auto file = std::string{ key.name } + "-" + hash + ".bin";
+        return (std::filesystem::path(directory_) / file).string();
+    }
+
+    bool ParseCache::Find(Key const& key, InputBuffer& file, std::string_view& payload) const
+    {
+        auto path = PathFor(key);
+        std::error_code ec;
+        if (!std::filesystem::is_regular_file(path, ec))
+        {
+            return false;
+        }
+        file = InputBuffer::FromFile(path);
+
+        auto text = file.Text();
+        FileHeader header;
+        if (text.size() < sizeof(header))
+        {
+            return false;
+        }
+        std::memcpy(&header, text.data(), sizeof(header));
+        text.remove_prefix(sizeof(header));
+
+        // the same hash from a different input, or a different type of the
+        // same name, are unlikely but cheap to rule out
+        bool matches = std::memcmp(header.magic, Magic, sizeof(Magic)) == 0
+            && header.formatVersion == FormatVersion
+            && header.typeSize == key.typeSize
+            && header.typeHash == HashBytes(key.type)
+            && header.inputHash == key.inputHash
+            && header.inputSize == key.inputSize
+            && header.payloadSize == text.size();
+        if (matches)
+        {
+            payload = text;
+        }
+        return matches;
+    }
+
+    void ParseCache::Store(Key const& key, std::string const& payload) const
+    {
+        std::filesystem::create_directories(directory_);
+
+        FileHeader header{};
+        std::memcpy(header.magic, Magic, sizeof(Magic));
+        header.formatVersion = FormatVersion;
+        header.typeSize = static_cast<std::uint32_t>(key.typeSize);
+        header.typeHash = HashBytes(key.type);
+        header.inputHash = key.inputHash;
+        header.inputSize = key.inputSize;
+        header.payloadSize = payload.size();
+
+        // written to the side and renamed, so no run ever sees half an entry
+        auto path = PathFor(key);
+        auto partial = path + ".partial";
+        {
+            std::ofstream out(partial, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+            out.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+            if (!out)
+            {
+                throw std::runtime_error("Could not write parse cache to " + partial);
+            }
+        }
+        std::filesystem::rename(partial, path);
+    }
+}
@@ -0,0 +1,308 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+#include "Common/Grid2D.h"
+#include "Common/Input.h"
+
+namespace Common
+{
+    namespace Detail
+    {
+        template<typename T>
+        struct IsGrid2D : std::false_type {};
+        template<typename T, int Border, int FixedWidth>
+        struct IsGrid2D<Grid2D<T, Border, FixedWidth>> : std::true_type {};
+
+        template<typename T>
+        struct IsPair : std::false_type {};
+        template<typename A, typename B>
+        struct IsPair<std::pair<A, B>> : std::true_type {};
+
+        template<typename T>
+        concept Container = requires(T const& c) { c.size(); c.begin(); c.end(); };
+
+        template<typename T>
+        concept Contiguous = Container<T> && requires(T& c) { c.data(); c.resize(0); };
+
+        template<typename T>
+        concept Associative = Container<T> && requires { typename T::key_type; };
+
+        template<typename T>
+        concept Mapping = Associative<T> && requires { typename T::mapped_type; };
+    }
+
+    // Writes values out as raw bytes for the parse cache. Plain data is
+    // copied as it is; vectors, strings, arrays, maps, sets, pairs and
+    // Grid2Ds are handled here; any other type needs a
+    //   template<typename Archive> void Serialise(Archive& archive, T& value)
+    // next to it (found by ADL) that passes its fields to archive(...).
+    // The same function is used to read the fields back in.
+    class CacheWriter
+    {
+    public:
+        template<typename... T>
+        void operator()(T const&... values)
+        {
+            (Write(values), ...);
+        }
+
+        std::string const& Bytes() const noexcept
+        {
+            return bytes_;
+        }
+
+    private:
+        void WriteBytes(void const* data, std::size_t size)
+        {
+            bytes_.append(static_cast<char const*>(data), size);
+        }
+
+        template<typename T>
+        void Write(T const& value)
+        {
+            if constexpr (Detail::IsGrid2D<T>::value)
+            {
+                Write(value.Width());
+                Write(value.Height());
+                auto cells = value.Cells();
+                WriteBytes(cells.data(), cells.size_bytes());
+            }
+            else if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                WriteBytes(&value, sizeof(T));
+            }
+            else if constexpr (Detail::IsPair<T>::value)
+            {
+                Write(value.first);
+                Write(value.second);
+            }
+            else if constexpr (Detail::Container<T>)
+            {
+                Write(static_cast<std::uint64_t>(value.size()));
+                if constexpr (Detail::Contiguous<T> && std::is_trivially_copyable_v<typename T::value_type>)
+                {
+                    WriteBytes(value.data(), value.size() * sizeof(typename T::value_type));
+                }
+                else
+                {
+                    for (auto const& element : value)
+                    {
+                        Write(element);
+                    }
+                }
+            }
+            else
+            {
+                Serialise(*this, const_cast<T&>(value));
+            }
+        }
+
+        std::string bytes_;
+    };
+
+    // Reads back what a CacheWriter wrote, throwing if it runs out of bytes.
+    class CacheReader
+    {
+    public:
+        explicit CacheReader(std::string_view bytes) noexcept
+            : bytes_{ bytes }
+        {}
+
+        template<typename... T>
+        void operator()(T&... values)
+        {
+            (Read(values), ...);
+        }
+
+        bool AtEnd() const noexcept
+        {
+            return bytes_.empty();
+        }
+
+    private:
+        void ReadBytes(void* data, std::size_t size)
+        {
+            if (size > bytes_.size())
+            {
+                throw std::runtime_error("Parse cache entry is truncated");
+            }
+            std::memcpy(data, bytes_.data(), size);
+            bytes_.remove_prefix(size);
+        }
+
+        std::size_t ReadSize()
+        {
+            std::uint64_t size = 0;
+            ReadBytes(&size, sizeof(size));
+            // every element takes at least a byte, which catches a corrupt size
+            if (size > bytes_.size())
+            {
+                throw std::runtime_error("Parse cache entry is truncated");
+            }
+            return static_cast<std::size_t>(size);
+        }
+
+        template<typename T>
+        void Read(T& value)
+        {
+            if constexpr (Detail::IsGrid2D<T>::value)
+            {
+                int width = 0;
+                int height = 0;
+                Read(width);
+                Read(height);
+                value = T(width, height);
+                auto cells = value.Cells();
+                ReadBytes(cells.data(), cells.size_bytes());
+            }
+            else if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                ReadBytes(&value, sizeof(T));
+            }
+            else if constexpr (Detail::IsPair<T>::value)
+            {
+                Read(value.first);
+                Read(value.second);
+            }
+            else if constexpr (Detail::Mapping<T>)
+            {
+                auto size = ReadSize();
+                value.clear();
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    std::pair<typename T::key_type, typename T::mapped_type> element;
+                    Read(element);
+                    value.insert(value.end(), std::move(element));
+                }
+            }
+            else if constexpr (Detail::Associative<T>)
+            {
+                auto size = ReadSize();
+                value.clear();
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    typename T::key_type element;
+                    Read(element);
+                    value.insert(value.end(), std::move(element));
+                }
+            }
+            else if constexpr (Detail::Contiguous<T>)
+            {
+                value.resize(ReadSize());
+                if constexpr (std::is_trivially_copyable_v<typename T::value_type>)
+                {
+                    ReadBytes(value.data(), value.size() * sizeof(typename T::value_type));
+                }
+                else
+                {
+                    for (auto& element : value)
+                    {
+                        Read(element);
+                    }
+                }
+            }
+            else if constexpr (Detail::Container<T>)
+            {
+                // fixed size, like a std::array of strings
+                if (ReadSize() != value.size())
+                {
+                    throw std::runtime_error("Parse cache entry has the wrong number of elements");
+                }
+                for (auto& element : value)
+                {
+                    Read(element);
+                }
+            }
+            else
+            {
+                Serialise(*this, value);
+            }
+        }
+
+        std::string_view bytes_;
+    };
+
+    // --cache[=dir] on the command line keeps each day's parsed input in dir
+    // (.aoc_cache by default), in a file named after a hash of the input text.
+    // Later runs on the same input read that back instead of parsing it.
+    // Entries are tied to the name and size of the parsed type and to
+    // FormatVersion; bump that if a day's Input changes shape but not name.
+    class ParseCache
+    {
+    public:
+        static std::uint32_t constexpr FormatVersion = 1;
+
+        ParseCache(int argc, char* argv[]);
+
+        bool Enabled() const noexcept
+        {
+            return !directory_.empty();
+        }
+
+        // parse(text) on a miss, which is then saved for next time.
+        template<typename Parse>
+        auto Read(std::string_view name, std::string_view text, Parse&& parse)
+        {
+            using Result = std::invoke_result_t<Parse&, std::string_view>;
+            if (!Enabled())
+            {
+                return parse(text);
+            }
+
+            Key key{ name, typeid(Result).name(), sizeof(Result), HashBytes(text), text.size() };
+            InputBuffer file;
+            std::string_view payload;
+            if (Find(key, file, payload))
+            {
+                try
+                {
+                    Result result{};
+                    CacheReader reader{ payload };
+                    reader(result);
+                    if (reader.AtEnd())
+                    {
+                        return result;
+                    }
+                }
+                catch (std::runtime_error const&)
+                {
+                    // a damaged entry is just a miss, and gets written again
+                }
+            }
+
+            Result result = parse(text);
+            CacheWriter writer;
+            writer(result);
+            Store(key, writer.Bytes());
+            return result;
+        }
+
+        // 64 bit hash of the input text. Not cryptographic, just quick.
+        static std::uint64_t HashBytes(std::string_view bytes) noexcept;
+
+    private:
+        struct Key
+        {
+            std::string_view name;
+            std::string_view type;
+            std::size_t typeSize;
+            std::uint64_t inputHash;
+            std::size_t inputSize;
+        };
+
+        std::string PathFor(Key const& key) const;
+        bool Find(Key const& key, InputBuffer& file, std::string_view& payload) const;
+        void Store(Key const& key, std::string const& payload) const;
+
+        std::string directory_;
+    };
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#include "Common/Input.h"
+
+namespace Common
+{
+    // The text of a pattern for Match, given as a template argument.
+    template<std::size_t N>
+    struct Pattern
+    {
+        constexpr Pattern(char const (&text)[N]) noexcept
+        {
+            std::copy_n(text, N, chars);
+        }
+
+        constexpr std::string_view View() const noexcept
+        {
+            return { chars, N - 1 };
+        }
+
+        constexpr std::size_t FieldCount() const noexcept
+        {
+            std::size_t count = 0;
+            for (auto pos = View().find("{}"); pos != std::string_view::npos; pos = View().find("{}", pos + 2))
+            {
+                ++count;
+            }
+            return count;
+        }
+
+        char chars[N]{};
+    };
+
+    namespace Detail
+    {
+        // The literal text around the fields: before the first, between each, after the last.
+        template<Pattern P>
+        constexpr auto Literals() noexcept
+        {
+            std::array<std::string_view, P.FieldCount() + 1> result{};
+            auto text = P.View();
+            for (auto& literal : result)
+            {
+                auto field = text.find("{}");
+                literal = text.substr(0, field);
+                text.remove_prefix(field == std::string_view::npos ? text.size() : field + 2);
+            }
+            return result;
+        }
+
+        template<Pattern P>
+        inline constexpr auto literals = Literals<P>();
+
+        // Reads one field from the front of text. follows is the literal that
+        // comes after it, which is where a string_view field stops.
+        template<typename T>
+        constexpr bool ReadField(std::string_view& text, T& field, std::string_view follows) noexcept
+        {
+            if constexpr (std::is_same_v<T, char>)
+            {
+                if (text.empty())
+                {
+                    return false;
+                }
+                field = text.front();
+                text.remove_prefix(1);
+                return true;
+            }
+            else if constexpr (std::is_same_v<T, std::string_view>)
+            {
+                auto end = follows.empty() ? text.size() : text.find(follows);
+                if (end == 0 || end == std::string_view::npos)
+                {
+                    return false;
+                }
+                field = text.substr(0, end);
+                text.remove_prefix(end);
+                return true;
+            }
+            else
+            {
+                static_assert(std::is_arithmetic_v<T>, "Match fields are numbers, chars or string_views");
+                std::from_chars_result result{};
+                if constexpr (std::is_integral_v<T>)
+                {
+                    result = FromChars(text.data(), text.data() + text.size(), field);
+                }
+                else
+                {
+                    result = std::from_chars(text.data(), text.data() + text.size(), field);
+                }
+                auto [ptr, ec] = result;
+                if (ec != std::errc{})
+                {
+                    return false;
+                }
+                text.remove_prefix(static_cast<std::size_t>(ptr - text.data()));
+                return true;
+            }
+        }
+    }
+
+    // Matches the whole of text against a pattern where each {} is a field,
+    // read in to the next argument, e.g.
+    //   Match<"fold along {}={}">(line, axis, value)
+    // A char field takes one character, a number field as many as make up
+    // the number, and a string_view field runs up to the text that follows it
+    // in the pattern (or to the end). Returns false if text doesn't fit, in
+    // which case the fields may have been partly filled. Integer fields can
+    // be matched by the compiler too.
+    template<Pattern P, typename... Fields>
+    constexpr bool Match(std::string_view text, Fields&... fields) noexcept
+    {
+        static_assert(P.FieldCount() == sizeof...(Fields), "Match needs one argument for each {} in the pattern");
+        auto const& literals = Detail::literals<P>;
+
+        std::size_t next = 0;
+        auto read = [&](auto& field)
+        {
+            if (!text.starts_with(literals[next]))
+            {
+                return false;
+            }
+            text.remove_prefix(literals[next].size());
+            ++next;
+            return Detail::ReadField(text, field, literals[next]);
+        };
+        return (read(fields) && ...) && text == literals.back();
+    }
+}
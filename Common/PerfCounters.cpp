@@ -0,0 +1,179 @@
+#include "Common/PerfCounters.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Common
+{
+    PerfCounts& PerfCounts::operator+=(PerfCounts const& other) noexcept
+    {
+        for (std::size_t i = 0; i < PerfEventCount; ++i)
+        {
+            values[i] += other.values[i];
+            counted[i] = counted[i] || other.counted[i];
+        }
+        return *this;
+    }
+
+#ifdef __linux__
+    namespace
+    {
+        struct EventConfig
+        {
+            std::uint32_t type;
+            std::uint64_t config;
+        };
+
+        std::uint64_t constexpr CacheEvent(std::uint64_t cache, std::uint64_t op, std::uint64_t result) noexcept
+        {
+            return cache | (op << 8) | (result << 16);
+        }
+
+        // In the order of PerfEvent.
+        std::array<EventConfig, PerfEventCount> constexpr Events{ {
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+            { PERF_TYPE_HW_CACHE, CacheEvent(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_ACCESS) },
+            { PERF_TYPE_HW_CACHE, CacheEvent(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS) },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+        } };
+
+        int OpenEvent(EventConfig const& event) noexcept
+        {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = event.type;
+            attr.config = event.config;
+            attr.disabled = 1;
+            // user space only, which perf_event_paranoid 2 still allows
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+
+        std::string Explain(int error)
+        {
+            std::string problem = "perf_event_open failed: ";
+            problem += std::strerror(error);
+            if (error == EACCES || error == EPERM)
+            {
+                problem += " (try lowering /proc/sys/kernel/perf_event_paranoid)";
+            }
+            else if (error == ENOENT || error == EOPNOTSUPP)
+            {
+                problem += " (no hardware counters, a VM without a virtual PMU?)";
+            }
+            return problem;
+        }
+    }
+
+    PerfCounters::PerfCounters()
+    {
+        int firstError = 0;
+        for (std::size_t i = 0; i < PerfEventCount; ++i)
+        {
+            fds_[i] = OpenEvent(Events[i]);
+            if (fds_[i] < 0 && firstError == 0)
+            {
+                firstError = errno;
+            }
+        }
+        if (!Available())
+        {
+            problem_ = Explain(firstError);
+        }
+    }
+
+    PerfCounters::~PerfCounters()
+    {
+        for (auto fd : fds_)
+        {
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+        }
+    }
+
+    bool PerfCounters::Available() const noexcept
+    {
+        return std::any_of(fds_.begin(), fds_.end(), [](int fd) { return fd >= 0; });
+    }
+
+    void PerfCounters::Start() noexcept
+    {
+        for (auto fd : fds_)
+        {
+            if (fd >= 0)
+            {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+
+    PerfCounts PerfCounters::Stop() noexcept
+    {
+        for (auto fd : fds_)
+        {
+            if (fd >= 0)
+            {
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+
+        PerfCounts counts;
+        for (std::size_t i = 0; i < PerfEventCount; ++i)
+        {
+            // value, time enabled, time running
+            std::uint64_t data[3] = {};
+            if (fds_[i] < 0 || read(fds_[i], data, sizeof(data)) != sizeof(data) || data[2] == 0)
+            {
+                continue;
+            }
+            auto value = static_cast<double>(data[0]);
+            if (data[2] < data[1])
+            {
+                value *= static_cast<double>(data[1]) / static_cast<double>(data[2]);
+            }
+            counts.values[i] = static_cast<std::uint64_t>(value);
+            counts.counted[i] = true;
+        }
+        return counts;
+    }
+#else
+    PerfCounters::PerfCounters()
+        : problem_{ "hardware counters are only read on Linux" }
+    {
+        fds_.fill(-1);
+    }
+
+    PerfCounters::~PerfCounters() = default;
+
+    bool PerfCounters::Available() const noexcept
+    {
+        return false;
+    }
+
+    void PerfCounters::Start() noexcept
+    {}
+
+    PerfCounts PerfCounters::Stop() noexcept
+    {
+        return {};
+    }
+#endif
+}
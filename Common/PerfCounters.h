@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Common
+{
+    enum class PerfEvent
+    {
+        Cycles,
+        Instructions,
+        Branches,
+        BranchMisses,
+        L1DReads,
+        L1DReadMisses,
+        LLCReferences,
+        LLCMisses,
+        Count
+    };
+
+    std::size_t constexpr PerfEventCount = static_cast<std::size_t>(PerfEvent::Count);
+
+    struct PerfCounts
+    {
+        std::array<std::uint64_t, PerfEventCount> values{};
+        // Whether each event was counted at all, as not every CPU has them all.
+        std::array<bool, PerfEventCount> counted{};
+
+        bool Has(PerfEvent event) const noexcept
+        {
+            return counted[static_cast<std::size_t>(event)];
+        }
+        std::uint64_t operator[](PerfEvent event) const noexcept
+        {
+            return values[static_cast<std::size_t>(event)];
+        }
+
+        PerfCounts& operator+=(PerfCounts const& other) noexcept;
+    };
+
+    // The Linux hardware performance counters of the calling thread, user
+    // space only, through perf_event_open. Opens whichever of the events the
+    // kernel, the CPU and perf_event_paranoid allow; if none of them can be
+    // opened (or this isn't Linux) Available() is false, Problem() says why,
+    // and Stop() returns counts with nothing counted.
+    class PerfCounters
+    {
+    public:
+        PerfCounters();
+        ~PerfCounters();
+        PerfCounters(PerfCounters const&) = delete;
+        PerfCounters& operator=(PerfCounters const&) = delete;
+
+        bool Available() const noexcept;
+        std::string const& Problem() const noexcept
+        {
+            return problem_;
+        }
+
+        void Start() noexcept;
+        // The counts since Start(), scaled up for any time the kernel had
+        // to share the counters out between events.
+        PerfCounts Stop() noexcept;
+
+    private:
+        std::array<int, PerfEventCount> fds_;
+        std::string problem_;
+    };
+}
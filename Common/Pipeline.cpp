@@ -0,0 +1,16 @@
+#include "Common/Pipeline.h"
+
+namespace Common
+{
+    bool PipelineRequested(int argc, char* argv[]) noexcept
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            if (std::string_view{ argv[i] } == "--pipeline")
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Common/Input.h"
+
+namespace Common
+{
+    // A bounded queue for exactly one producer thread and one consumer thread,
+    // needing no locks. Each side keeps a copy of the other's position and only
+    // reloads it when the ring looks full or empty, so they rarely share a
+    // cache line.
+    template<typename T>
+    class SpscRing
+    {
+    public:
+        // Rounded up to a power of two.
+        explicit SpscRing(std::size_t capacity)
+            : slots_(std::bit_ceil(std::max<std::size_t>(capacity, 2))),
+            mask_{ slots_.size() - 1 }
+        {}
+        SpscRing(SpscRing const&) = delete;
+        SpscRing& operator=(SpscRing const&) = delete;
+
+        // Producer only. Leaves value alone if the ring is full.
+        bool TryPush(T& value)
+        {
+            auto tail = tail_.load(std::memory_order_relaxed);
+            if (tail - headCache_ == slots_.size())
+            {
+                headCache_ = head_.load(std::memory_order_acquire);
+                if (tail - headCache_ == slots_.size())
+                {
+                    return false;
+                }
+            }
+            slots_[tail & mask_] = std::move(value);
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer only.
+        bool TryPop(T& value)
+        {
+            auto head = head_.load(std::memory_order_relaxed);
+            if (head == tailCache_)
+            {
+                tailCache_ = tail_.load(std::memory_order_acquire);
+                if (head == tailCache_)
+                {
+                    return false;
+                }
+            }
+            value = std::move(slots_[head & mask_]);
+            head_.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Waits for room. False if the ring was closed first, by the consumer
+        // giving up.
+        bool Push(T value)
+        {
+            for (int spins = 0; !TryPush(value); ++spins)
+            {
+                if (closed_.load(std::memory_order_acquire))
+                {
+                    return false;
+                }
+                Pause(spins);
+            }
+            return true;
+        }
+
+        // Waits for a value. False once the ring is closed and empty.
+        bool Pop(T& value)
+        {
+            for (int spins = 0; !TryPop(value); ++spins)
+            {
+                if (closed_.load(std::memory_order_acquire))
+                {
+                    // anything pushed before closing is still wanted
+                    return TryPop(value);
+                }
+                Pause(spins);
+            }
+            return true;
+        }
+
+        // The producer closes it when it has no more, the consumer when it
+        // wants no more.
+        void Close() noexcept
+        {
+            closed_.store(true, std::memory_order_release);
+        }
+
+    private:
+        static void Pause(int spins) noexcept
+        {
+            if (spins > 64)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        std::vector<T> slots_;
+        std::size_t mask_;
+
+        // consumer's side
+        alignas(64) std::atomic<std::size_t> head_{ 0 };
+        std::size_t tailCache_{ 0 };
+
+        // producer's side
+        alignas(64) std::atomic<std::size_t> tail_{ 0 };
+        std::size_t headCache_{ 0 };
+
+        alignas(64) std::atomic<bool> closed_{ false };
+    };
+
+    // --pipeline on the command line asks a day that can to parse and solve
+    // at the same time, with RunPipeline.
+    bool PipelineRequested(int argc, char* argv[]) noexcept;
+
+    struct PipelineOptions
+    {
+        // Records handed over at a time, to keep the ring traffic down.
+        std::size_t chunkRecords{ 4096 };
+        // Chunks parsed ahead of the consumer before the reader waits.
+        std::size_t chunksInFlight{ 16 };
+    };
+
+    // Parses the lines of text on a reader thread while the calling thread
+    // consumes the records, so the time taken is about the slower of the two
+    // rather than their sum. parse(line) returns an optional record, empty to
+    // skip the line; blank lines are skipped without asking it. consume(record)
+    // sees the records in input order. An exception from either side stops
+    // both and is rethrown here.
+    template<typename Parse, typename Consume>
+    void RunPipeline(std::string_view text, Parse parse, Consume consume, PipelineOptions options = {})
+    {
+        using Record = typename std::invoke_result_t<Parse&, std::string_view>::value_type;
+        using Chunk = std::vector<Record>;
+
+        SpscRing<Chunk> ring{ options.chunksInFlight };
+        std::exception_ptr parseError;
+        std::thread reader{ [&]
+            {
+                try
+                {
+                    Chunk chunk;
+                    chunk.reserve(options.chunkRecords);
+                    LineReader lines{ text };
+                    std::string_view line;
+                    while (lines.Next(line))
+                    {
+                        if (line.empty())
+                        {
+                            continue;
+                        }
+                        if (auto record = parse(line))
+                        {
+                            chunk.push_back(std::move(*record));
+                            if (chunk.size() == options.chunkRecords)
+                            {
+                                if (!ring.Push(std::move(chunk)))
+                                {
+                                    return;
+                                }
+                                chunk = {};
+                                chunk.reserve(options.chunkRecords);
+                            }
+                        }
+                    }
+                    if (!chunk.empty())
+                    {
+                        ring.Push(std::move(chunk));
+                    }
+                }
+                catch (...)
+                {
+                    parseError = std::current_exception();
+                }
+                ring.Close();
+            } };
+
+        try
+        {
+            Chunk chunk;
+            while (ring.Pop(chunk))
+            {
+                for (auto& record : chunk)
+                {
+                    consume(record);
+                }
+            }
+        }
+        catch (...)
+        {
+            ring.Close();
+            reader.join();
+            throw;
+        }
+        reader.join();
+        if (parseError)
+        {
+            std::rethrow_exception(parseError);
+        }
+    }
+}
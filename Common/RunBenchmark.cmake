@@ -0,0 +1,35 @@
+# Runs one day in benchmark mode, used by the bench target.
+#   cmake -DDAY_EXE=<path> -DINPUT=<file> -DREPETITIONS=<n>
+#         [-DHISTORY=<file>] [-DLABEL=<text>] [-DSOURCE_DIR=<repo>] -P RunBenchmark.cmake
+# With a HISTORY file the timings are appended to it, labelled with LABEL or
+# else the commit checked out in SOURCE_DIR.
+if (NOT EXISTS "${INPUT}")
+    message (STATUS "Skipping ${DAY_EXE}: no input at ${INPUT}")
+    return ()
+endif ()
+
+set (historyArgs)
+if (HISTORY)
+    if (NOT LABEL AND SOURCE_DIR)
+        find_package (Git QUIET)
+        if (GIT_FOUND)
+            execute_process (
+                COMMAND "${GIT_EXECUTABLE}" -C "${SOURCE_DIR}" rev-parse --short HEAD
+                OUTPUT_VARIABLE LABEL
+                OUTPUT_STRIP_TRAILING_WHITESPACE
+                ERROR_QUIET)
+        endif ()
+    endif ()
+    list (APPEND historyArgs "--history=${HISTORY}")
+    if (LABEL)
+        list (APPEND historyArgs "--history-label=${LABEL}")
+    endif ()
+endif ()
+
+message (STATUS "Benchmarking ${DAY_EXE} on ${INPUT}")
+execute_process (
+    COMMAND "${DAY_EXE}" "--bench=${REPETITIONS}" ${historyArgs} "${INPUT}"
+    RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+    message (FATAL_ERROR "${DAY_EXE} failed: ${result}")
+endif ()
@@ -0,0 +1,30 @@
+# Generates an input for every day from each seed, then checks the optimised
+# solutions against the reference ones on them, used by the diff_check target.
+#   cmake -DDIFF_EXE=<path> -DGEN_EXES=<list> -DSEEDS=<list> -DSCALE=<factor> -DOUTPUT_DIR=<dir> -P RunDifferential.cmake
+# GEN_EXES holds the DayN_gen paths in day order; both lists are separated by |.
+string (REPLACE "|" ";" GEN_EXES "${GEN_EXES}")
+string (REPLACE "|" ";" SEEDS "${SEEDS}")
+
+file (REMOVE_RECURSE "${OUTPUT_DIR}")
+file (MAKE_DIRECTORY "${OUTPUT_DIR}")
+
+set (day 0)
+foreach (genExe IN LISTS GEN_EXES)
+    math (EXPR day "${day} + 1")
+    foreach (seed IN LISTS SEEDS)
+        execute_process (
+            COMMAND "${genExe}" "--scale=${SCALE}" "--seed=${seed}"
+            OUTPUT_FILE "${OUTPUT_DIR}/Day${day}-seed${seed}.txt"
+            RESULT_VARIABLE result)
+        if (NOT result EQUAL 0)
+            message (FATAL_ERROR "${genExe} failed: ${result}")
+        endif ()
+    endforeach ()
+endforeach ()
+
+execute_process (
+    COMMAND "${DIFF_EXE}" "${OUTPUT_DIR}"
+    RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+    message (FATAL_ERROR "The optimised and reference solutions disagree")
+endif ()
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <array>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Common/Input.h"
+
+namespace Common
+{
+    // A lazily produced sequence of values, written as a coroutine that
+    // co_yields them, like C++23's std::generator. Nothing runs until the
+    // first value is asked for, and a loop that stops early leaves the rest
+    // unmade. It can be walked once, with a range for or begin()/end().
+    // An exception thrown in the coroutine comes out of the increment.
+    template<typename T>
+    class Sequence
+    {
+    public:
+        struct promise_type
+        {
+            // Points at the yielded value, which lives in the coroutine until it resumes.
+            T const* current{ nullptr };
+            std::exception_ptr error;
+
+            Sequence get_return_object() noexcept
+            {
+                return Sequence{ Handle::from_promise(*this) };
+            }
+            std::suspend_always initial_suspend() const noexcept
+            {
+                return {};
+            }
+            std::suspend_always final_suspend() const noexcept
+            {
+                return {};
+            }
+            std::suspend_always yield_value(T const& value) noexcept
+            {
+                current = std::addressof(value);
+                return {};
+            }
+            void return_void() const noexcept
+            {}
+            void unhandled_exception() noexcept
+            {
+                error = std::current_exception();
+            }
+
+            // No co_await inside a Sequence.
+            void await_transform() = delete;
+        };
+
+        using Handle = std::coroutine_handle<promise_type>;
+
+        class Iterator
+        {
+        public:
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+
+            Iterator() = default;
+            explicit Iterator(Handle coroutine) noexcept
+                : coroutine_{ coroutine }
+            {}
+
+            T const& operator*() const noexcept
+            {
+                return *coroutine_.promise().current;
+            }
+            T const* operator->() const noexcept
+            {
+                return coroutine_.promise().current;
+            }
+
+            Iterator& operator++()
+            {
+                Resume(coroutine_);
+                return *this;
+            }
+            void operator++(int)
+            {
+                ++*this;
+            }
+
+            friend bool operator==(Iterator const& it, std::default_sentinel_t) noexcept
+            {
+                return !it.coroutine_ || it.coroutine_.done();
+            }
+
+        private:
+            Handle coroutine_{};
+        };
+
+        Sequence(Sequence&& other) noexcept
+            : coroutine_{ std::exchange(other.coroutine_, {}) }
+        {}
+        Sequence& operator=(Sequence&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Destroy();
+                coroutine_ = std::exchange(other.coroutine_, {});
+            }
+            return *this;
+        }
+        Sequence(Sequence const&) = delete;
+        Sequence& operator=(Sequence const&) = delete;
+        ~Sequence()
+        {
+            Destroy();
+        }
+
+        // Runs up to the first value.
+        Iterator begin()
+        {
+            if (coroutine_ && !started_)
+            {
+                started_ = true;
+                Resume(coroutine_);
+            }
+            return Iterator{ coroutine_ };
+        }
+        std::default_sentinel_t end() const noexcept
+        {
+            return {};
+        }
+
+    private:
+        explicit Sequence(Handle coroutine) noexcept
+            : coroutine_{ coroutine }
+        {}
+
+        static void Resume(Handle coroutine)
+        {
+            coroutine.resume();
+            if (coroutine.done() && coroutine.promise().error)
+            {
+                std::rethrow_exception(std::exchange(coroutine.promise().error, {}));
+            }
+        }
+
+        void Destroy() noexcept
+        {
+            if (coroutine_)
+            {
+                coroutine_.destroy();
+                coroutine_ = {};
+            }
+        }
+
+        Handle coroutine_{};
+        bool started_{ false };
+    };
+
+    // Collects what's left of a sequence.
+    template<typename T>
+    std::vector<T> ToVector(Sequence<T> values)
+    {
+        std::vector<T> result;
+        for (auto const& value : values)
+        {
+            result.push_back(value);
+        }
+        return result;
+    }
+
+    // The numbers in text, separated by separator and any spaces. A separator
+    // of ' ' means just spaces. Stops at the first thing that doesn't fit, so
+    // "3,4,5\n..." gives 3, 4 and 5.
+    template<typename T = int>
+    Sequence<T> Numbers(std::string_view text, char separator = ',')
+    {
+        NumberReader<T> numbers{ text, separator };
+        T value{};
+        while (numbers.Next(value))
+        {
+            co_yield value;
+        }
+    }
+
+    // Each value with the one after it: (a, b), (b, c), ...
+    template<typename T>
+    Sequence<std::pair<T, T>> Pairwise(Sequence<T> values)
+    {
+        auto it = values.begin();
+        if (it == values.end())
+        {
+            co_return;
+        }
+        T previous = *it;
+        for (++it; it != values.end(); ++it)
+        {
+            std::pair<T, T> pair{ previous, *it };
+            co_yield pair;
+            previous = *it;
+        }
+    }
+
+    // Every run of N values in a row, oldest first: [a, b, c], [b, c, d], ...
+    template<std::size_t N, typename T>
+    Sequence<std::array<T, N>> Windowed(Sequence<T> values)
+    {
+        static_assert(N > 0);
+        std::array<T, N> window{};
+        std::size_t filled = 0;
+        for (auto const& value : values)
+        {
+            if (filled < N)
+            {
+                window[filled++] = value;
+            }
+            else
+            {
+                std::move(window.begin() + 1, window.end(), window.begin());
+                window[N - 1] = value;
+            }
+            if (filled == N)
+            {
+                co_yield window;
+            }
+        }
+    }
+
+    // The values size at a time, the last chunk holding whatever is left.
+    // Each span is only good until the next one is asked for.
+    template<typename T>
+    Sequence<std::span<T const>> Chunked(Sequence<T> values, std::size_t size)
+    {
+        std::vector<T> chunk;
+        chunk.reserve(size);
+        for (auto const& value : values)
+        {
+            chunk.push_back(value);
+            if (chunk.size() == size)
+            {
+                co_yield std::span<T const>{ chunk };
+                chunk.clear();
+            }
+        }
+        if (!chunk.empty())
+        {
+            co_yield std::span<T const>{ chunk };
+        }
+    }
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace Common
+{
+    namespace Detail
+    {
+        // The values of a window that could still be its extreme, oldest
+        // first, each one Better than those behind it. A value that's beaten
+        // by a newer one can never be the extreme again, so it's dropped as
+        // the newer one comes in, and the front leaves when the window
+        // passes it. Every value goes in and out once: O(1) amortised.
+        template<typename T, typename Better>
+        class MonotonicQueue
+        {
+        public:
+            explicit MonotonicQueue(std::size_t capacity)
+                : entries_(capacity)
+            {}
+
+            void Push(std::size_t position, T value)
+            {
+                while (count_ > 0 && !Better{}(entries_[Before(tail_)].value, value))
+                {
+                    tail_ = Before(tail_);
+                    --count_;
+                }
+                entries_[tail_] = { position, value };
+                tail_ = After(tail_);
+                ++count_;
+            }
+
+            // Drops the front if it's at or before position.
+            void Expire(std::size_t position) noexcept
+            {
+                if (count_ > 0 && entries_[head_].position <= position)
+                {
+                    head_ = After(head_);
+                    --count_;
+                }
+            }
+
+            T Front() const noexcept
+            {
+                return entries_[head_].value;
+            }
+
+        private:
+            struct Entry
+            {
+                std::size_t position;
+                T value;
+            };
+
+            // Steps round the ring without dividing.
+            std::size_t After(std::size_t slot) const noexcept
+            {
+                return slot + 1 == entries_.size() ? 0 : slot + 1;
+            }
+            std::size_t Before(std::size_t slot) const noexcept
+            {
+                return slot == 0 ? entries_.size() - 1 : slot - 1;
+            }
+
+            std::vector<Entry> entries_;
+            std::size_t head_{ 0 };
+            // where the next value goes
+            std::size_t tail_{ 0 };
+            std::size_t count_{ 0 };
+        };
+    }
+
+    // The last size values of a stream, with their minimum, maximum, sum and
+    // mean kept up to date in O(1) amortised per value. The sum is the
+    // difference of two prefix sums, kept as a running total that adds the
+    // new value and takes off the one leaving. Memory is O(size).
+    template<typename T>
+    class SlidingWindow
+    {
+    public:
+        using Sum = std::conditional_t<std::is_integral_v<T>, std::int64_t, double>;
+
+        explicit SlidingWindow(std::size_t size)
+            : values_(size),
+            lowest_{ size },
+            highest_{ size }
+        {
+            if (size == 0)
+            {
+                throw std::invalid_argument("A sliding window needs at least one value");
+            }
+        }
+
+        void Push(T value)
+        {
+            if (Full())
+            {
+                sum_ -= values_[next_];
+                lowest_.Expire(pushed_ - values_.size());
+                highest_.Expire(pushed_ - values_.size());
+            }
+            values_[next_] = value;
+            next_ = next_ + 1 == values_.size() ? 0 : next_ + 1;
+            sum_ += value;
+            lowest_.Push(pushed_, value);
+            highest_.Push(pushed_, value);
+            ++pushed_;
+        }
+
+        std::size_t Size() const noexcept
+        {
+            return values_.size();
+        }
+        // Until it's full the window holds everything pushed so far.
+        bool Full() const noexcept
+        {
+            return pushed_ >= values_.size();
+        }
+        std::size_t Pushed() const noexcept
+        {
+            return pushed_;
+        }
+
+        // The value the next Push will push out, once Full().
+        T Leaving() const noexcept
+        {
+            return values_[next_];
+        }
+
+        // These need at least one value pushed.
+        T Min() const noexcept
+        {
+            return lowest_.Front();
+        }
+        T Max() const noexcept
+        {
+            return highest_.Front();
+        }
+        Sum Total() const noexcept
+        {
+            return sum_;
+        }
+        double Mean() const noexcept
+        {
+            return static_cast<double>(sum_) / static_cast<double>(Full() ? values_.size() : pushed_);
+        }
+
+    private:
+        std::vector<T> values_;
+        // the slot of the oldest value, where the next one goes
+        std::size_t next_{ 0 };
+        std::size_t pushed_{ 0 };
+        Sum sum_{};
+        Detail::MonotonicQueue<T, std::less<T>> lowest_;
+        Detail::MonotonicQueue<T, std::greater<T>> highest_;
+    };
+}
@@ -0,0 +1,312 @@
+#include "Common/Trace.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include "Common/Benchmark.h"
+
+namespace Common
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        struct Event
+        {
+            char const* name;
+            std::int64_t start;
+            std::int64_t duration;
+        };
+
+        // Each thread logs to its own buffer so recording never waits on a lock.
+        // The registry keeps them alive after the thread has gone.
+        struct ThreadEvents
+        {
+            int thread{ 0 };
+            std::vector<Event> events;
+            std::uint64_t dropped{ 0 };
+        };
+
+        // Enough for any sensible scope, without letting a scope left in a hot
+        // loop eat all of the memory. Later events are counted but not kept.
+        std::size_t constexpr MaxEventsPerThread = std::size_t{ 1 } << 20;
+
+        struct Registry
+        {
+            std::mutex mutex;
+            TraceSite* sites{ nullptr };
+            TraceCounter* counters{ nullptr };
+            std::vector<std::shared_ptr<ThreadEvents>> threads;
+            std::set<std::string, std::less<>> spanNames;
+            Clock::time_point epoch{ Clock::now() };
+        };
+
+        Registry& TheRegistry()
+        {
+            static Registry registry;
+            return registry;
+        }
+
+        ThreadEvents& LocalEvents()
+        {
+            thread_local std::shared_ptr<ThreadEvents> local = []
+            {
+                auto& registry = TheRegistry();
+                std::lock_guard lock(registry.mutex);
+                auto events = std::make_shared<ThreadEvents>();
+                events->thread = static_cast<int>(registry.threads.size());
+                registry.threads.push_back(events);
+                return events;
+            }();
+            return *local;
+        }
+
+        std::int64_t Nanoseconds(Clock::duration d)
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+        }
+
+        void Record(char const* name, Clock::time_point start, Clock::time_point end)
+        {
+            auto& local = LocalEvents();
+            if (local.events.size() >= MaxEventsPerThread)
+            {
+                ++local.dropped;
+                return;
+            }
+            local.events.push_back({ name, Nanoseconds(start - TheRegistry().epoch), Nanoseconds(end - start) });
+        }
+
+        void WriteJsonString(std::ostream& out, char const* text)
+        {
+            out << '"';
+            for (; *text != '\0'; ++text)
+            {
+                if (*text == '"' || *text == '\\')
+                {
+                    out << '\\';
+                }
+                out << *text;
+            }
+            out << '"';
+        }
+
+        // Chrome wants microseconds.
+        std::string Microseconds(std::int64_t ns)
+        {
+            char text[32];
+            std::snprintf(text, sizeof(text), "%.3f", static_cast<double>(ns) / 1e3);
+            return text;
+        }
+    }
+
+    void EnableTracing()
+    {
+        auto& registry = TheRegistry();
+        {
+            std::lock_guard lock(registry.mutex);
+            registry.epoch = Clock::now();
+        }
+        tracingEnabled.store(true);
+    }
+
+    TraceSite::TraceSite(char const* siteName)
+        : name{ siteName }
+    {
+        auto& registry = TheRegistry();
+        std::lock_guard lock(registry.mutex);
+        next = registry.sites;
+        registry.sites = this;
+    }
+
+    TraceCounter::TraceCounter(char const* counterName)
+        : name{ counterName }
+    {
+        auto& registry = TheRegistry();
+        std::lock_guard lock(registry.mutex);
+        next = registry.counters;
+        registry.counters = this;
+    }
+
+    TraceScope::TraceScope(TraceSite& site) noexcept
+        : site_{ TracingEnabled() ? &site : nullptr }
+    {
+        if (site_)
+        {
+            start_ = Clock::now();
+        }
+    }
+
+    TraceScope::~TraceScope()
+    {
+        if (!site_)
+        {
+            return;
+        }
+        auto end = Clock::now();
+        auto ns = static_cast<std::uint64_t>(Nanoseconds(end - start_));
+        site_->calls.fetch_add(1, std::memory_order_relaxed);
+        site_->totalNanoseconds.fetch_add(ns, std::memory_order_relaxed);
+        auto max = site_->maxNanoseconds.load(std::memory_order_relaxed);
+        while (ns > max && !site_->maxNanoseconds.compare_exchange_weak(max, ns, std::memory_order_relaxed))
+        {
+        }
+        Record(site_->name, start_, end);
+    }
+
+    void TraceSpan(std::string_view name, Clock::time_point start, Clock::time_point end)
+    {
+        if (!TracingEnabled())
+        {
+            return;
+        }
+
+        // events hold on to their name, so keep one copy of each for good
+        auto& registry = TheRegistry();
+        char const* stored = nullptr;
+        {
+            std::lock_guard lock(registry.mutex);
+            auto it = registry.spanNames.find(name);
+            if (it == registry.spanNames.end())
+            {
+                it = registry.spanNames.emplace(name).first;
+            }
+            stored = it->c_str();
+        }
+        Record(stored, start, end);
+    }
+
+    void ReportTrace(std::ostream& out)
+    {
+        auto& registry = TheRegistry();
+        std::lock_guard lock(registry.mutex);
+
+        // sites and counters that share a name, like a scope in a template, add up
+        struct SiteTotals
+        {
+            std::uint64_t calls{ 0 };
+            std::uint64_t total{ 0 };
+            std::uint64_t max{ 0 };
+        };
+        std::map<std::string_view, SiteTotals> sites;
+        for (auto site = registry.sites; site; site = site->next)
+        {
+            if (auto calls = site->calls.load(); calls > 0)
+            {
+                auto& totals = sites[site->name];
+                totals.calls += calls;
+                totals.total += site->totalNanoseconds.load();
+                totals.max = std::max(totals.max, site->maxNanoseconds.load());
+            }
+        }
+        std::map<std::string_view, std::uint64_t> counters;
+        for (auto counter = registry.counters; counter; counter = counter->next)
+        {
+            if (auto value = counter->value.load(); value > 0)
+            {
+                counters[counter->name] += value;
+            }
+        }
+
+        char line[160];
+        if (!sites.empty())
+        {
+            std::snprintf(line, sizeof(line), "\n%-28s %10s %11s %11s %11s\n", "Trace scope", "Calls", "Total", "Mean", "Max");
+            out << line;
+            for (auto const& [name, totals] : sites)
+            {
+                std::snprintf(line, sizeof(line), "%-28.*s %10llu %11s %11s %11s\n",
+                    static_cast<int>(name.size()), name.data(),
+                    static_cast<unsigned long long>(totals.calls),
+                    FormatDuration(std::chrono::nanoseconds(totals.total)).c_str(),
+                    FormatDuration(std::chrono::nanoseconds(totals.total / totals.calls)).c_str(),
+                    FormatDuration(std::chrono::nanoseconds(totals.max)).c_str());
+                out << line;
+            }
+        }
+
+        if (!counters.empty())
+        {
+            std::snprintf(line, sizeof(line), "\n%-28s %10s\n", "Trace counter", "Count");
+            out << line;
+            for (auto const& [name, value] : counters)
+            {
+                std::snprintf(line, sizeof(line), "%-28.*s %10llu\n", static_cast<int>(name.size()), name.data(), static_cast<unsigned long long>(value));
+                out << line;
+            }
+        }
+
+        std::uint64_t dropped = 0;
+        for (auto const& thread : registry.threads)
+        {
+            dropped += thread->dropped;
+        }
+        if (dropped > 0)
+        {
+            out << "\n" << dropped << " trace events were dropped once a thread had logged " << MaxEventsPerThread << "\n";
+        }
+    }
+
+    void WriteChromeTrace(std::ostream& out)
+    {
+        auto& registry = TheRegistry();
+        std::lock_guard lock(registry.mutex);
+
+        out << "{\"traceEvents\":[\n";
+        bool first = true;
+        auto separator = [&] { out << (first ? "" : ",\n"); first = false; };
+
+        std::int64_t end = 0;
+        for (auto const& thread : registry.threads)
+        {
+            for (auto const& e : thread->events)
+            {
+                separator();
+                out << "{\"name\":";
+                WriteJsonString(out, e.name);
+                out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread->thread
+                    << ",\"ts\":" << Microseconds(e.start)
+                    << ",\"dur\":" << Microseconds(e.duration) << "}";
+                end = std::max(end, e.start + e.duration);
+            }
+        }
+
+        // counters only have their final value, so show them at the end of the run
+        std::map<std::string_view, std::pair<char const*, std::uint64_t>> counters;
+        for (auto counter = registry.counters; counter; counter = counter->next)
+        {
+            auto& [name, value] = counters[counter->name];
+            name = counter->name;
+            value += counter->value.load();
+        }
+        for (auto const& [key, counter] : counters)
+        {
+            if (counter.second == 0)
+            {
+                continue;
+            }
+            separator();
+            out << "{\"name\":";
+            WriteJsonString(out, counter.first);
+            out << ",\"ph\":\"C\",\"pid\":1,\"ts\":" << Microseconds(end) << ",\"args\":{\"value\":" << counter.second << "}}";
+        }
+        out << "\n]}\n";
+    }
+
+    void WriteChromeTrace(std::string const& path)
+    {
+        std::ofstream out(path);
+        if (!out)
+        {
+            throw std::runtime_error("Could not write trace to " + path);
+        }
+        WriteChromeTrace(out);
+    }
+}
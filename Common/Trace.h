@@ -0,0 +1,161 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Scoped timers and counters for the inner loops of a day, e.g.
+//   AOC_TRACE_SCOPE("generation");
+//   AOC_TRACE_COUNT("explodes", 1);
+// They are only built when AOC_TRACE is defined (cmake -DAOC_TRACE=ON), and
+// otherwise compile to nothing. Even when built they record nothing until
+// tracing is switched on, which --trace on the command line does.
+// A constexpr function can't hold AOC_TRACE_COUNT's static counter, so uses
+// AOC_TRACE_COUNT_CONSTEXPR, which counts nothing while the compiler runs it.
+#ifdef AOC_TRACE
+#define AOC_TRACE_JOIN_(a, b) a##b
+#define AOC_TRACE_JOIN(a, b) AOC_TRACE_JOIN_(a, b)
+#define AOC_TRACE_SCOPE(name) \
+    static ::Common::TraceSite AOC_TRACE_JOIN(traceSite_, __LINE__){ name }; \
+    ::Common::TraceScope AOC_TRACE_JOIN(traceScope_, __LINE__){ AOC_TRACE_JOIN(traceSite_, __LINE__) }
+#define AOC_TRACE_COUNT(name, amount) \
+    do \
+    { \
+        static ::Common::TraceCounter traceCounter_{ name }; \
+        traceCounter_.Add(amount); \
+    } while (false)
+#define AOC_TRACE_COUNT_CONSTEXPR(name, amount) \
+    do \
+    { \
+        if (!std::is_constant_evaluated()) \
+        { \
+            ::Common::CountTrace<name>(amount); \
+        } \
+    } while (false)
+#else
+#define AOC_TRACE_SCOPE(name) static_cast<void>(0)
+#define AOC_TRACE_COUNT(name, amount) static_cast<void>(0)
+#define AOC_TRACE_COUNT_CONSTEXPR(name, amount) static_cast<void>(0)
+#endif
+
+namespace Common
+{
+    inline std::atomic<bool> tracingEnabled{ false };
+
+    inline bool TracingEnabled() noexcept
+    {
+        return tracingEnabled.load(std::memory_order_relaxed);
+    }
+
+    void EnableTracing();
+
+    // One for each AOC_TRACE_SCOPE in the source, totalling every time it runs.
+    struct TraceSite
+    {
+        explicit TraceSite(char const* siteName);
+
+        char const* name;
+        std::atomic<std::uint64_t> calls{ 0 };
+        std::atomic<std::uint64_t> totalNanoseconds{ 0 };
+        std::atomic<std::uint64_t> maxNanoseconds{ 0 };
+        TraceSite* next{ nullptr };
+    };
+
+    // One for each AOC_TRACE_COUNT in the source.
+    struct TraceCounter
+    {
+        explicit TraceCounter(char const* counterName);
+
+        void Add(std::uint64_t amount) noexcept
+        {
+            if (TracingEnabled())
+            {
+                value.fetch_add(amount, std::memory_order_relaxed);
+            }
+        }
+
+        char const* name;
+        std::atomic<std::uint64_t> value{ 0 };
+        TraceCounter* next{ nullptr };
+    };
+
+    // A counter's name as a template argument.
+    template<std::size_t N>
+    struct TraceName
+    {
+        constexpr TraceName(char const (&text)[N]) noexcept
+        {
+            std::copy_n(text, N, chars);
+        }
+
+        char chars[N]{};
+    };
+
+    // Keeps the counter for AOC_TRACE_COUNT_CONSTEXPR, one per name.
+    template<TraceName Name>
+    void CountTrace(std::uint64_t amount) noexcept
+    {
+        static TraceCounter counter{ Name.chars };
+        counter.Add(amount);
+    }
+
+    // Times the enclosing scope against a site and logs it as a trace event.
+    class TraceScope
+    {
+    public:
+        explicit TraceScope(TraceSite& site) noexcept;
+        TraceScope(TraceScope const&) = delete;
+        TraceScope& operator=(TraceScope const&) = delete;
+        ~TraceScope();
+
+    private:
+        TraceSite* site_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    // Logs a trace event under a name only known at run time, like a
+    // benchmark phase. Available whether or not AOC_TRACE is defined.
+    void TraceSpan(std::string_view name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+
+    // Logs the enclosing scope under a run time name when tracing is on.
+    class ScopedTraceSpan
+    {
+    public:
+        explicit ScopedTraceSpan(std::string_view name) noexcept
+            : name_{ name },
+            active_{ TracingEnabled() }
+        {
+            if (active_)
+            {
+                start_ = std::chrono::steady_clock::now();
+            }
+        }
+        ScopedTraceSpan(ScopedTraceSpan const&) = delete;
+        ScopedTraceSpan& operator=(ScopedTraceSpan const&) = delete;
+        ~ScopedTraceSpan()
+        {
+            if (active_)
+            {
+                TraceSpan(name_, start_, std::chrono::steady_clock::now());
+            }
+        }
+
+    private:
+        std::string_view name_;
+        bool active_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    // A table of every site and counter that has recorded something.
+    void ReportTrace(std::ostream& out);
+
+    // Every event so far in Chrome's trace event format, for chrome://tracing or Perfetto.
+    void WriteChromeTrace(std::ostream& out);
+    void WriteChromeTrace(std::string const& path);
+}
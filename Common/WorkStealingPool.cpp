@@ -0,0 +1,157 @@
+#include "Common/WorkStealingPool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace Common
+{
+    namespace
+    {
+        thread_local WorkStealingPool const* currentPool = nullptr;
+        thread_local int currentWorker = -1;
+    }
+
+    WorkStealingPool::WorkStealingPool(unsigned threads)
+    {
+        if (threads == 0)
+        {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        queues_.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i)
+        {
+            queues_.push_back(std::make_unique<Queue>());
+        }
+        threads_.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i)
+        {
+            threads_.emplace_back([this, i] { WorkerLoop(i); });
+        }
+    }
+
+    WorkStealingPool::~WorkStealingPool()
+    {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        workAvailable_.notify_all();
+        for (auto& t : threads_)
+        {
+            t.join();
+        }
+    }
+
+    int WorkStealingPool::CurrentWorker() const noexcept
+    {
+        return currentPool == this ? currentWorker : -1;
+    }
+
+    void WorkStealingPool::Submit(Task task)
+    {
+        ++pending_;
+        auto worker = CurrentWorker();
+        if (worker < 0)
+        {
+            worker = static_cast<int>(nextQueue_++ % Size());
+        }
+        Push(static_cast<unsigned>(worker), std::move(task));
+    }
+
+    void WorkStealingPool::Push(unsigned worker, Task task)
+    {
+        // count it first so a worker can never take it before it's counted
+        {
+            std::lock_guard lock(mutex_);
+            ++queued_;
+        }
+        {
+            std::lock_guard lock(queues_[worker]->mutex);
+            queues_[worker]->tasks.push_back(std::move(task));
+        }
+        workAvailable_.notify_one();
+    }
+
+    bool WorkStealingPool::TryPop(unsigned worker, Task& task)
+    {
+        auto& queue = *queues_[worker];
+        std::lock_guard lock(queue.mutex);
+        if (queue.tasks.empty())
+        {
+            return false;
+        }
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool WorkStealingPool::TrySteal(unsigned worker, Task& task)
+    {
+        for (unsigned i = 1; i < Size(); ++i)
+        {
+            auto& victim = *queues_[(worker + i) % Size()];
+            std::lock_guard lock(victim.mutex);
+            if (!victim.tasks.empty())
+            {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void WorkStealingPool::WorkerLoop(unsigned worker)
+    {
+        currentPool = this;
+        currentWorker = static_cast<int>(worker);
+
+        while (true)
+        {
+            Task task;
+            if (TryPop(worker, task) || TrySteal(worker, task))
+            {
+                {
+                    std::lock_guard lock(mutex_);
+                    --queued_;
+                }
+                try
+                {
+                    task();
+                }
+                catch (...)
+                {
+                    std::lock_guard lock(mutex_);
+                    if (!error_)
+                    {
+                        error_ = std::current_exception();
+                    }
+                }
+                if (--pending_ == 0)
+                {
+                    std::lock_guard lock(mutex_);
+                    allDone_.notify_all();
+                }
+                continue;
+            }
+
+            std::unique_lock lock(mutex_);
+            workAvailable_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+            if (stopping_ && queued_ == 0)
+            {
+                return;
+            }
+        }
+    }
+
+    void WorkStealingPool::Wait()
+    {
+        std::unique_lock lock(mutex_);
+        allDone_.wait(lock, [this] { return pending_ == 0; });
+        if (error_)
+        {
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+    }
+}
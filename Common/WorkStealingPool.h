@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Common
+{
+    // A fixed set of worker threads, each with its own queue of tasks. Workers
+    // take the newest task from their own queue and when that runs dry they
+    // steal the oldest task from someone else's, so a worker stuck on a long
+    // task doesn't hold up the ones queued behind it.
+    class WorkStealingPool
+    {
+    public:
+        using Task = std::function<void()>;
+
+        // threads == 0 means one per hardware thread.
+        explicit WorkStealingPool(unsigned threads = 0);
+        WorkStealingPool(WorkStealingPool const&) = delete;
+        WorkStealingPool& operator=(WorkStealingPool const&) = delete;
+        ~WorkStealingPool();
+
+        // Tasks submitted from inside a task go on the running worker's own
+        // queue, anything else is spread round the workers in turn.
+        void Submit(Task task);
+
+        // Blocks until every submitted task, including ones they submit, has
+        // finished. Rethrows the first exception thrown by a task.
+        void Wait();
+
+        unsigned Size() const noexcept
+        {
+            return static_cast<unsigned>(threads_.size());
+        }
+
+        // Index of the worker running the calling thread, or -1 if it isn't one of ours.
+        int CurrentWorker() const noexcept;
+
+    private:
+        struct Queue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        bool TryPop(unsigned worker, Task& task);
+        bool TrySteal(unsigned worker, Task& task);
+        void Push(unsigned worker, Task task);
+        void WorkerLoop(unsigned worker);
+
+        std::vector<std::unique_ptr<Queue>> queues_;
+        std::vector<std::thread> threads_;
+
+        std::mutex mutex_;
+        std::condition_variable workAvailable_;
+        std::condition_variable allDone_;
+        std::size_t queued_{ 0 };
+        std::atomic<std::size_t> pending_{ 0 };
+        std::atomic<unsigned> nextQueue_{ 0 };
+        bool stopping_{ false };
+        std::exception_ptr error_;
+    };
+}
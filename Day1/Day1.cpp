@@ -1,60 +1,375 @@
-﻿// Day1.cpp : Defines the entry point for the application.
+﻿// Day1.cpp : Sonar Sweep solutions.
 //
 
 #include "Day1.h"
 
-std::vector<int> ReadInput()
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <numeric>
+
+#include "Common/CpuFeatures.h"
+#include "Common/Input.h"
+#include "Common/Pipeline.h"
+#include "Common/Trace.h"
+
+#ifdef AOC_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace Day1
 {
-    std::vector<int> input;
+    Input ReadInput(std::string_view text)
+    {
+        std::vector<int> input;
+
+        Common::LineReader lines{ text };
+        std::string_view line;
+        while (lines.Next(line))
+        {
+            if (line.empty())
+            {
+                continue;
+            }
+            int val = Common::ToNumber(line);
+            input.push_back(val);
+        }
+        return input;
+    }
+
+    using CountKernel = std::ptrdiff_t(std::span<int const> depths, std::size_t window);
 
-    std::string text;
-    while (std::getline(std::cin, text))
+    std::ptrdiff_t CountIncreasesScalar(std::span<int const> depths, std::size_t window)
     {
-        if (text.empty())
+        std::ptrdiff_t increases = 0;
+        for (std::size_t i = 0; i + window < depths.size(); ++i)
         {
-            continue;
+            increases += depths[i + window] > depths[i] ? 1 : 0;
         }
-        int val = std::stoi(text);
-        input.push_back(val);
+        return increases;
     }
-    return input;
-}
 
-auto CountIncreases(std::vector<int> const& data)
-{
-    std::vector<int> differences(data.size());
+#ifdef AOC_SIMD_X86
+    // Each lane counts at most one rise per step, so its 32 bits are safe for
+    // this many comparisons before they have to be added to the total.
+    std::size_t constexpr ComparisonsPerFlush = std::size_t{ 1 } << 30;
 
-    std::adjacent_difference(std::begin(data), std::end(data), std::begin(differences));
+    // A comparison gives -1 in the lanes that rose, so subtracting counts them.
+    AOC_TARGET_SSE42 std::ptrdiff_t CountIncreasesSse42(std::span<int const> depths, std::size_t window)
+    {
+        auto const comparisons = depths.size() > window ? depths.size() - window : 0;
+        auto const data = depths.data();
+        std::ptrdiff_t increases = 0;
+        std::size_t i = 0;
+        while (i + 4 <= comparisons)
+        {
+            auto const flushAt = std::min(comparisons, i + ComparisonsPerFlush);
+            __m128i rises = _mm_setzero_si128();
+            for (; i + 4 <= flushAt; i += 4)
+            {
+                auto earlier = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i));
+                auto later = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i + window));
+                rises = _mm_sub_epi32(rises, _mm_cmpgt_epi32(later, earlier));
+            }
+            alignas(16) std::uint32_t lanes[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), rises);
+            for (auto lane : lanes)
+            {
+                increases += lane;
+            }
+        }
+        return increases + CountIncreasesScalar(depths.subspan(i), window);
+    }
 
-    auto increases = std::count_if(std::next(std::begin(differences)), std::end(differences),
-        [](int v) { return v > 0; });
+    AOC_TARGET_AVX2 std::ptrdiff_t CountIncreasesAvx2(std::span<int const> depths, std::size_t window)
+    {
+        auto const comparisons = depths.size() > window ? depths.size() - window : 0;
+        auto const data = depths.data();
+        std::ptrdiff_t increases = 0;
+        std::size_t i = 0;
+        while (i + 16 <= comparisons)
+        {
+            // two counts on the go, so the loads of one overlap the other's compare
+            auto const flushAt = std::min(comparisons, i + ComparisonsPerFlush);
+            __m256i rises[2] = { _mm256_setzero_si256(), _mm256_setzero_si256() };
+            for (; i + 16 <= flushAt; i += 16)
+            {
+                for (std::size_t v = 0; v < 2; ++v)
+                {
+                    auto earlier = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data + i + 8 * v));
+                    auto later = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data + i + 8 * v + window));
+                    rises[v] = _mm256_sub_epi32(rises[v], _mm256_cmpgt_epi32(later, earlier));
+                }
+            }
+            alignas(32) std::uint32_t lanes[8];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi32(rises[0], rises[1]));
+            for (auto lane : lanes)
+            {
+                increases += lane;
+            }
+        }
+        return increases + CountIncreasesScalar(depths.subspan(i), window);
+    }
 
-    return increases;
-}
+    AOC_TARGET_AVX512 std::ptrdiff_t CountIncreasesAvx512(std::span<int const> depths, std::size_t window)
+    {
+        auto const comparisons = depths.size() > window ? depths.size() - window : 0;
+        auto const data = depths.data();
+        __m512i const one = _mm512_set1_epi32(1);
+        std::ptrdiff_t increases = 0;
+        std::size_t i = 0;
+        while (i + 32 <= comparisons)
+        {
+            auto const flushAt = std::min(comparisons, i + ComparisonsPerFlush);
+            __m512i rises[2] = { _mm512_setzero_si512(), _mm512_setzero_si512() };
+            for (; i + 32 <= flushAt; i += 32)
+            {
+                for (std::size_t v = 0; v < 2; ++v)
+                {
+                    auto earlier = _mm512_loadu_si512(data + i + 16 * v);
+                    auto later = _mm512_loadu_si512(data + i + 16 * v + window);
+                    rises[v] = _mm512_mask_add_epi32(rises[v], _mm512_cmpgt_epi32_mask(later, earlier), rises[v], one);
+                }
+            }
+            alignas(64) std::uint32_t lanes[16];
+            _mm512_store_si512(lanes, _mm512_add_epi32(rises[0], rises[1]));
+            for (auto lane : lanes)
+            {
+                increases += lane;
+            }
+        }
+        return increases + CountIncreasesScalar(depths.subspan(i), window);
+    }
+#endif
 
-auto SumSlidingWindow(std::vector<int> const& data)
-{
-    std::vector<int> windowSums;
-    windowSums.reserve(data.size() - 2);
+    std::ptrdiff_t CountIncreases(std::span<int const> depths, std::size_t window)
+    {
+        AOC_TRACE_SCOPE("Day1 CountIncreases");
+        AOC_TRACE_COUNT("Day1 depths compared", depths.size());
+#ifdef AOC_SIMD_X86
+        static Common::SimdKernel<CountKernel> const kernel{
+            CountIncreasesScalar, CountIncreasesSse42, CountIncreasesAvx2, CountIncreasesAvx512 };
+        return kernel(depths, window);
+#else
+        return CountIncreasesScalar(depths, window);
+#endif
+    }
 
-    for (size_t i = 0; i < data.size() - 2; ++i)
+    std::vector<int> SumSlidingWindow(std::vector<int> const& data)
     {
-        windowSums.push_back(data[i] + data[i + 1] + data[i + 2]);
+        AOC_TRACE_SCOPE("Day1 SumSlidingWindow");
+        std::vector<int> windowSums;
+        windowSums.reserve(data.size() - 2);
+
+        for (size_t i = 0; i < data.size() - 2; ++i)
+        {
+            windowSums.push_back(data[i] + data[i + 1] + data[i + 2]);
+        }
+
+        return windowSums;
     }
 
-    return windowSums;
-}
+    std::ptrdiff_t PartOne(Input const& input)
+    {
+        return CountIncreases(input, 1);
+    }
 
-int main()
-{
-    auto input = ReadInput();
+    std::ptrdiff_t PartTwo(Input const& input)
+    {
+        return CountIncreases(input, 3);
+    }
+
+    WindowAnalysis::WindowAnalysis(std::span<std::size_t const> sizes)
+        : increases_(sizes.size(), 0)
+    {
+        windows_.reserve(sizes.size());
+        for (auto size : sizes)
+        {
+            windows_.emplace_back(size);
+        }
+    }
+
+    std::vector<WindowSummary> SummariseWindows(std::span<int const> depths, std::span<std::size_t const> sizes)
+    {
+        AOC_TRACE_SCOPE("Day1 SummariseWindows");
+        std::vector<WindowSummary> summaries;
+        for (auto size : sizes)
+        {
+            summaries.push_back({ size, 0,
+                std::numeric_limits<int>::max(), std::numeric_limits<int>::min(),
+                std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity() });
+        }
+
+        WindowAnalysis analysis{ sizes };
+        for (auto depth : depths)
+        {
+            analysis.Add(depth);
+            for (std::size_t i = 0; i < analysis.Count(); ++i)
+            {
+                auto const& window = analysis.Window(i);
+                if (!window.Full())
+                {
+                    continue;
+                }
+                auto& summary = summaries[i];
+                summary.lowest = std::min(summary.lowest, window.Min());
+                summary.highest = std::max(summary.highest, window.Max());
+                summary.lowestMean = std::min(summary.lowestMean, window.Mean());
+                summary.highestMean = std::max(summary.highestMean, window.Mean());
+            }
+        }
+
+        for (std::size_t i = 0; i < summaries.size(); ++i)
+        {
+            summaries[i].increases = analysis.Increases(i);
+            if (!analysis.Window(i).Full())
+            {
+                summaries[i] = { sizes[i], 0, 0, 0, 0.0, 0.0 };
+            }
+        }
+        return summaries;
+    }
 
-    auto increases = CountIncreases(input);
+    std::pair<std::ptrdiff_t, std::ptrdiff_t> SolvePipelined(std::string_view text)
+    {
+        DepthCounter counter;
+        Common::RunPipeline(text,
+            [](std::string_view line) { return std::optional{ Common::ToNumber(line) }; },
+            [&counter](int depth) { counter.Add(depth); });
+        return { counter.PartOne(), counter.PartTwo() };
+    }
 
-    std::cout << "Depth increased " << increases << " times.\n";
+    // Enough chunks that a worker which finishes early can take someone else's.
+    unsigned constexpr ChunksPerWorker = 4;
 
-    auto slidingWindows = SumSlidingWindow(input);
-    auto windowIncreases = CountIncreases(slidingWindows);
+    ChunkCount CountChunk(std::string_view text)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        ChunkCount chunk{ -1, text.size(), 0, 0, 0, {}, {}, {} };
+        DepthCounter counter;
+        Common::LineReader lines{ text };
+        std::string_view line;
+        while (lines.Next(line))
+        {
+            if (line.empty())
+            {
+                continue;
+            }
+            auto depth = Common::ToNumber(line);
+            if (chunk.depths < 3)
+            {
+                chunk.first[chunk.depths] = depth;
+            }
+            chunk.last[chunk.depths % 3] = depth;
+            ++chunk.depths;
+            counter.Add(depth);
+        }
+        // oldest first
+        if (chunk.depths > 3)
+        {
+            std::rotate(chunk.last.begin(), chunk.last.begin() + chunk.depths % 3, chunk.last.end());
+        }
+        chunk.increases = counter.PartOne();
+        chunk.windowIncreases = counter.PartTwo();
+        chunk.elapsed = std::chrono::steady_clock::now() - start;
+        return chunk;
+    }
+
+    ParallelCount SolveParallel(std::string_view text, Common::WorkStealingPool& pool)
+    {
+        AOC_TRACE_SCOPE("Day1 SolveParallel");
+        // cut after the line end at or past each even share of the bytes
+        std::vector<std::string_view> pieces;
+        auto const wanted = std::max<std::size_t>(1, std::size_t{ pool.Size() } * ChunksPerWorker);
+        std::size_t begin = 0;
+        for (std::size_t i = 1; i <= wanted && begin < text.size(); ++i)
+        {
+            auto end = i == wanted ? text.size() : std::max(begin, text.size() * i / wanted);
+            end = end >= text.size() ? text.size() : text.find('\n', end);
+            end = end == std::string_view::npos ? text.size() : end + 1;
+            pieces.push_back(text.substr(begin, end - begin));
+            begin = end;
+        }
+
+        ParallelCount result{ 0, 0, std::vector<ChunkCount>(pieces.size()) };
+        for (std::size_t i = 0; i < pieces.size(); ++i)
+        {
+            pool.Submit([&, i]
+                {
+                    result.chunks[i] = CountChunk(pieces[i]);
+                    result.chunks[i].worker = pool.CurrentWorker();
+                });
+        }
+        pool.Wait();
 
-    std::cout << "Sliding Window Depth increased " << windowIncreases << " times.\n";
+        // Feed the depths next to each cut through the same test as DepthCounter,
+        // against the last three depths before it, however many chunks they span.
+        std::array<int, 3> before{};
+        std::size_t seen = 0;
+        for (auto const& chunk : result.chunks)
+        {
+            result.increases += chunk.increases;
+            result.windowIncreases += chunk.windowIncreases;
+            auto const edge = std::min<std::size_t>(chunk.depths, 3);
+            for (std::size_t k = 0; k < edge; ++k)
+            {
+                auto depth = chunk.first[k];
+                if (k == 0 && seen >= 1 && depth > before[(seen - 1) % 3])
+                {
+                    ++result.increases;
+                }
+                if (seen + k >= 3 && depth > before[(seen + k) % 3])
+                {
+                    ++result.windowIncreases;
+                }
+            }
+            auto const& newest = chunk.depths > 3 ? chunk.last : chunk.first;
+            for (std::size_t k = 0; k < edge; ++k)
+            {
+                before[seen % 3] = newest[k];
+                ++seen;
+            }
+        }
+        return result;
+    }
+
+    std::pair<std::ptrdiff_t, std::ptrdiff_t> SolveStreaming(Common::LineStream& lines)
+    {
+        DepthCounter counter;
+        std::string_view line;
+        while (lines.Next(line))
+        {
+            if (!line.empty())
+            {
+                counter.Add(Common::ToNumber(line));
+            }
+        }
+        return { counter.PartOne(), counter.PartTwo() };
+    }
+
+    namespace Reference
+    {
+        std::ptrdiff_t CountRises(std::vector<int> const& data)
+        {
+            std::vector<int> differences(data.size());
+
+            std::adjacent_difference(std::begin(data), std::end(data), std::begin(differences));
+
+            auto increases = std::count_if(std::next(std::begin(differences)), std::end(differences),
+                [](int v) { return v > 0; });
+
+            return increases;
+        }
+
+        std::ptrdiff_t PartOne(Input const& input)
+        {
+            return CountRises(input);
+        }
+
+        std::ptrdiff_t PartTwo(Input const& input)
+        {
+            return CountRises(SumSlidingWindow(input));
+        }
+    }
 }
@@ -1,12 +1,169 @@
-﻿// Day1.h : Include file for standard system include files,
-// or project specific include files.
+﻿// Day1.h : Sonar Sweep. Reads a list of depths and counts how often they go up.
 
 #pragma once
 
-#include <iostream>
-
-// TODO: Reference additional headers your program requires here.
-#include <algorithm>
-#include <numeric>
-#include <string>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <utility>
 #include <vector>
+
+#include "Common/Input.h"
+#include "Common/SlidingWindow.h"
+#include "Common/WorkStealingPool.h"
+
+namespace Day1
+{
+    using Input = std::vector<int>;
+
+    Input ReadInput(std::string_view text);
+
+    // How often the sum of window depths in a row is bigger than the sum one
+    // further back. Neighbouring windows share all but their first and last
+    // depths, so that's just how often depths[i + window] > depths[i], which
+    // is counted in one pass with no window sums made.
+    std::ptrdiff_t CountIncreases(std::span<int const> depths, std::size_t window = 1);
+    std::vector<int> SumSlidingWindow(std::vector<int> const& data);
+
+    std::ptrdiff_t PartOne(Input const& input);
+    std::ptrdiff_t PartTwo(Input const& input);
+
+    // The straightforward versions the faster ones are checked against (aoc_diff).
+    namespace Reference
+    {
+        // Counts the rises in a vector of differences, of the depths or of
+        // a vector of their window sums.
+        std::ptrdiff_t PartOne(Input const& input);
+        std::ptrdiff_t PartTwo(Input const& input);
+    }
+
+    // Counts both parts a depth at a time, for depths that arrive one by one.
+    // A window sum goes up exactly when the depth entering it is bigger than
+    // the one leaving, so only the last three depths are kept.
+    class DepthCounter
+    {
+    public:
+        void Add(int depth) noexcept
+        {
+            if (seen_ >= 1 && depth > last_[(seen_ - 1) % 3])
+            {
+                ++increases_;
+            }
+            if (seen_ >= 3 && depth > last_[seen_ % 3])
+            {
+                ++windowIncreases_;
+            }
+            last_[seen_ % 3] = depth;
+            ++seen_;
+        }
+
+        std::ptrdiff_t PartOne() const noexcept
+        {
+            return increases_;
+        }
+        std::ptrdiff_t PartTwo() const noexcept
+        {
+            return windowIncreases_;
+        }
+
+    private:
+        std::array<int, 3> last_{};
+        std::size_t seen_{ 0 };
+        std::ptrdiff_t increases_{ 0 };
+        std::ptrdiff_t windowIncreases_{ 0 };
+    };
+
+    // Watches windows of several sizes move over the depths together, one
+    // depth at a time. Each keeps its minimum, maximum and mean, and counts
+    // how often its sum has gone up. Part one is the rises of a window of
+    // 1, part two of a window of 3.
+    class WindowAnalysis
+    {
+    public:
+        explicit WindowAnalysis(std::span<std::size_t const> sizes);
+
+        void Add(int depth)
+        {
+            for (std::size_t i = 0; i < windows_.size(); ++i)
+            {
+                auto& window = windows_[i];
+                if (window.Full() && depth > window.Leaving())
+                {
+                    ++increases_[i];
+                }
+                window.Push(depth);
+            }
+        }
+
+        std::size_t Count() const noexcept
+        {
+            return windows_.size();
+        }
+        Common::SlidingWindow<int> const& Window(std::size_t i) const noexcept
+        {
+            return windows_[i];
+        }
+        // How often the sum of window i has gone up as it moved along.
+        std::ptrdiff_t Increases(std::size_t i) const noexcept
+        {
+            return increases_[i];
+        }
+
+    private:
+        std::vector<Common::SlidingWindow<int>> windows_;
+        std::vector<std::ptrdiff_t> increases_;
+    };
+
+    // What a window of one size showed over the whole of the depths.
+    struct WindowSummary
+    {
+        std::size_t size;
+        std::ptrdiff_t increases;
+        // The lowest minimum, highest maximum and range of means of every
+        // position where the window was full.
+        int lowest;
+        int highest;
+        double lowestMean;
+        double highestMean;
+    };
+
+    // All the sizes in one pass. A size longer than the depths is left at zero.
+    std::vector<WindowSummary> SummariseWindows(std::span<int const> depths, std::span<std::size_t const> sizes);
+
+    // Both parts, counting on this thread while another parses (--pipeline).
+    std::pair<std::ptrdiff_t, std::ptrdiff_t> SolvePipelined(std::string_view text);
+
+    // What one task made of its piece of the text in SolveParallel.
+    struct ChunkCount
+    {
+        // the pool worker that counted it
+        int worker;
+        std::size_t bytes;
+        std::size_t depths;
+        // comparisons with both depths inside the chunk
+        std::ptrdiff_t increases;
+        std::ptrdiff_t windowIncreases;
+        // up to the first and last three depths, for the comparisons across its edges
+        std::array<int, 3> first;
+        std::array<int, 3> last;
+        std::chrono::nanoseconds elapsed;
+    };
+
+    struct ParallelCount
+    {
+        std::ptrdiff_t increases;
+        std::ptrdiff_t windowIncreases;
+        // in the order of the text
+        std::vector<ChunkCount> chunks;
+    };
+
+    // Both parts on every worker of the pool (--parallel). The text is cut
+    // at line ends into a few chunks per worker, each parsed and counted on
+    // its own, then the comparisons that straddle the cuts are added.
+    ParallelCount SolveParallel(std::string_view text, Common::WorkStealingPool& pool);
+
+    // Both parts in constant memory, reading the depths as they come (--stream).
+    std::pair<std::ptrdiff_t, std::ptrdiff_t> SolveStreaming(Common::LineStream& lines);
+}
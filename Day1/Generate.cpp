@@ -0,0 +1,29 @@
+// Generate.cpp : Writes a Day1 input of any size, one depth per line.
+//   Day1_gen [depths] [--scale=F] [--seed=N]
+
+#include <algorithm>
+#include <iostream>
+
+#include "Common/Generator.h"
+
+int main(int argc, char* argv[])
+{
+    Common::Generator gen{ argc, argv, 2000 };
+
+    // Day1 reads depths as int and adds them up in windows, and the walk
+    // drifts down about 5 a step, so it turns back at the deepest depth
+    // rather than overflowing a few hundred million depths in.
+    int constexpr deepest = 100'000'000;
+
+    // the sea floor mostly drops away, with the odd rise
+    int depth = gen.Uniform(100, 200);
+    for (std::size_t i = 0; i < gen.Size(); ++i)
+    {
+        std::cout << depth << "\n";
+        depth = std::max(0, depth + gen.Uniform(-10, 20));
+        if (depth > deepest)
+        {
+            depth = 2 * deepest - depth;
+        }
+    }
+}
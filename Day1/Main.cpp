@@ -0,0 +1,132 @@
+// Main.cpp : Defines the entry point for the application.
+//
+
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <iostream>
+#include <optional>
+#include <vector>
+
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/Input.h"
+#include "Common/ParseCache.h"
+#include "Common/Pipeline.h"
+#include "Common/WorkStealingPool.h"
+#include "Day1.h"
+
+int main(int argc, char* argv[])
+{
+    if (auto batch = Common::ReadBatchOptions(argc, argv); batch.enabled)
+    {
+        return Common::RunBatch(batch, Day1::ReadInput, Day1::PartOne, Day1::PartTwo);
+    }
+
+    // --windows=<size>,<size>,... summarises each size of window
+    std::vector<std::size_t> windowSizes;
+    if (auto sizes = Common::OptionValue(argc, argv, "--windows"))
+    {
+        windowSizes = Common::OptionNumbers(*sizes, "--windows takes sizes of at least 1 separated by commas, like --windows=1,3,10", 1);
+    }
+
+    // --parallel=<threads>, or a bare --parallel for one per hardware thread
+    std::optional<unsigned> parallelThreads;
+    if (auto threads = Common::OptionValue(argc, argv, "--parallel"))
+    {
+        parallelThreads = threads->empty() ? 0u : static_cast<unsigned>(Common::OptionNumber(*threads,
+            "--parallel takes a thread count, like --parallel=8, or none for every hardware thread", 0, UINT_MAX));
+    }
+
+    Common::Benchmark bench{ argc, argv };
+    if (Common::StreamRequested(argc, argv))
+    {
+        auto [increases, windowIncreases] = bench.Measure("streamed", [&]
+            {
+                auto lines = Common::LineStream::FromCommandLine(argc, argv);
+                return Day1::SolveStreaming(lines);
+            });
+        std::cout << "Depth increased " << increases << " times.\n";
+        std::cout << "Sliding Window Depth increased " << windowIncreases << " times.\n";
+        bench.Report(std::cout);
+        return 0;
+    }
+
+    Common::ParseCache cache{ argc, argv };
+    auto buffer = Common::InputBuffer::FromCommandLine(argc, argv);
+    if (Common::PipelineRequested(argc, argv))
+    {
+        auto [increases, windowIncreases] = bench.Measure("pipelined", [&] { return Day1::SolvePipelined(buffer.Text()); }, { .bytes = buffer.Size() });
+        std::cout << "Depth increased " << increases << " times.\n";
+        std::cout << "Sliding Window Depth increased " << windowIncreases << " times.\n";
+        bench.Report(std::cout);
+        return 0;
+    }
+
+    if (parallelThreads)
+    {
+        Common::WorkStealingPool pool{ *parallelThreads };
+        auto count = bench.Measure("parallel", [&] { return Day1::SolveParallel(buffer.Text(), pool); }, { .bytes = buffer.Size() });
+        std::cout << "Depth increased " << count.increases << " times.\n";
+        std::cout << "Sliding Window Depth increased " << count.windowIncreases << " times.\n";
+
+        // What each worker got through on the last run; the time is spent
+        // inside its chunks, so the rate leaves out waiting for work.
+        struct WorkerTotal
+        {
+            std::size_t chunks;
+            std::size_t bytes;
+            std::size_t depths;
+            std::chrono::nanoseconds elapsed;
+        };
+        std::vector<WorkerTotal> workers(pool.Size());
+        for (auto const& chunk : count.chunks)
+        {
+            auto& worker = workers[static_cast<std::size_t>(chunk.worker)];
+            ++worker.chunks;
+            worker.bytes += chunk.bytes;
+            worker.depths += chunk.depths;
+            worker.elapsed += chunk.elapsed;
+        }
+        char line[160];
+        std::snprintf(line, sizeof(line), "\n%8s %8s %12s %12s %10s %10s\n", "Thread", "Chunks", "Bytes", "Depths", "ms", "MB/s");
+        std::cout << line;
+        for (std::size_t i = 0; i < workers.size(); ++i)
+        {
+            auto const& worker = workers[i];
+            auto const seconds = std::chrono::duration<double>(worker.elapsed).count();
+            std::snprintf(line, sizeof(line), "%8zu %8zu %12zu %12zu %10.2f %10.1f\n", i, worker.chunks, worker.bytes, worker.depths,
+                seconds * 1e3, seconds > 0 ? static_cast<double>(worker.bytes) / seconds / 1e6 : 0.0);
+            std::cout << line;
+        }
+        bench.Report(std::cout);
+        return 0;
+    }
+
+    auto input = bench.Measure("parse", [&] { return cache.Read("Day1", buffer.Text(), Day1::ReadInput); }, { .bytes = buffer.Size() });
+
+    auto increases = bench.Measure("part one", [&] { return Day1::PartOne(input); }, { .items = input.size() });
+
+    std::cout << "Depth increased " << increases << " times.\n";
+
+    auto windowIncreases = bench.Measure("part two", [&] { return Day1::PartTwo(input); }, { .items = input.size() });
+
+    std::cout << "Sliding Window Depth increased " << windowIncreases << " times.\n";
+
+    if (!windowSizes.empty())
+    {
+        auto summaries = bench.Measure("windows", [&] { return Day1::SummariseWindows(input, windowSizes); }, { .items = input.size() * windowSizes.size() });
+
+        char line[160];
+        std::snprintf(line, sizeof(line), "\n%8s %12s %10s %10s %12s %12s\n", "Window", "Increases", "Lowest", "Highest", "Lowest mean", "Highest mean");
+        std::cout << line;
+        for (auto const& summary : summaries)
+        {
+            std::snprintf(line, sizeof(line), "%8zu %12td %10d %10d %12.2f %12.2f\n",
+                summary.size, summary.increases, summary.lowest, summary.highest, summary.lowestMean, summary.highestMean);
+            std::cout << line;
+        }
+    }
+
+    bench.Report(std::cout);
+}
@@ -1,273 +1,348 @@
+#include "Day10.h"
+
 #include <algorithm>
-#include <iostream>
-#include <sstream>
+#include <cctype>
+#include <stdexcept>
 #include <string>
-#include <vector>
 
-enum class Token
-{
-    END,
-    L_PARAN = '(',
-    R_PARAN = ')',
-    L_BRACE = '{',
-    R_BRACE = '}',
-    L_BRACKET = '[',
-    R_BRACKET = ']',
-    L_ANGLE = '<',
-    R_ANGLE = '>'
-};
-
-class Lexer
+#include "Common/Input.h"
+#include "Common/Pipeline.h"
+#include "Common/Trace.h"
+
+namespace Day10
 {
-public:
-    explicit Lexer(std::istream &input)
-        : input_{ input }
-    {}
+    enum class Token
+    {
+        END,
+        L_PARAN = '(',
+        R_PARAN = ')',
+        L_BRACE = '{',
+        R_BRACE = '}',
+        L_BRACKET = '[',
+        R_BRACKET = ']',
+        L_ANGLE = '<',
+        R_ANGLE = '>'
+    };
 
-    Token GetToken()
+    class Lexer
     {
-        char ch = 0;
-        do
+    public:
+        explicit Lexer(std::string_view input)
+            : input_{ input }
+        {}
+
+        Token GetToken()
         {
-            if (!input_.get(ch))
+            char ch = 0;
+            do
             {
-                return Token::END;
+                if (input_.empty())
+                {
+                    return Token::END;
+                }
+                ch = input_.front();
+                input_.remove_prefix(1);
+            } while (ch != '\n' && isspace(ch));
+
+            switch (ch)
+            {
+            case '(':
+            case ')':
+            case '{':
+            case '}':
+            case '[':
+            case ']':
+            case '<':
+            case '>':
+                return Token{ ch };
+            default:
+                throw std::runtime_error(std::string{ "Bad token in input: " } + ch);
             }
-        } while (ch != '\n' && isspace(ch));
+        }
+
+    private:
+        std::string_view input_;
+    };
+
+    struct ParseResult
+    {
+        bool stop;
+        bool isError;
+        Token lastToken;
+        std::vector<Token> completion_;
+    };
+
+    class Parser
+    {
+    public:
+        explicit Parser(std::string_view input)
+            : lexer_{ input },
+            currentToken_{ Token::END }
+        {}
 
-        switch (ch)
+        ParseResult Result()
         {
-        case '(':
-        case ')':
-        case '{':
-        case '}':
-        case '[':
-        case ']':
-        case '<':
-        case '>':
-            return Token{ ch };
-        default:
-            throw std::runtime_error(std::string{ "Bad token in input: " } + ch);
+            currentToken_ = lexer_.GetToken();
+
+            ParseResult result{};
+            do
+            {
+                result = MatchBrackets(MatchingClose(currentToken_));
+            } while (!result.stop);
+
+            return result;
+        }
+
+    private:
+        bool IsOpen(Token t)
+        {
+            switch (t)
+            {
+            case Token::L_PARAN:
+            case Token::L_BRACE:
+            case Token::L_BRACKET:
+            case Token::L_ANGLE:
+                return true;
+            default:
+                return false;
+            }
         }
-    }
 
-private:
-    std::istream& input_;
-};
+        Token MatchingClose(Token t)
+        {
+            switch (t)
+            {
+            case Token::L_PARAN:
+                return Token::R_PARAN;
+            case Token::L_BRACE:
+                return Token::R_BRACE;
+            case Token::L_BRACKET:
+                return Token::R_BRACKET;
+            case Token::L_ANGLE:
+                return Token::R_ANGLE;
+            default:
+                return Token::END;
+            }
+        }
 
-struct ParseResult
-{
-    bool stop;
-    bool isError;
-    Token lastToken;
-    std::vector<Token> completion_;
-};
+        ParseResult MatchBrackets(Token expectedClose)
+        {
+            AOC_TRACE_COUNT("Day10 chunks matched", 1);
+            currentToken_ = lexer_.GetToken();
+            if (currentToken_ == Token::END)
+            {
+                return { true, false, currentToken_, { expectedClose } };
+            }
 
-class Parser
-{
-public:
-    explicit Parser(std::string const& input)
-        : input_{ input },
-        inputStream_{ input_ },
-        lexer_{ inputStream_ },
-        currentToken_{ Token::END }
-    {}
-
-    ParseResult Result()
+            while (IsOpen(currentToken_))
+            {
+                auto expectClose = MatchingClose(currentToken_);
+                auto res = MatchBrackets(expectClose);
+                if (res.stop)
+                {
+                    res.completion_.push_back(expectedClose);
+                    return res;
+                }
+            }
+            if (currentToken_ != expectedClose)
+            {
+                return { true, true, currentToken_, {} };
+            }
+            else
+            {
+                currentToken_ = lexer_.GetToken();
+                if (currentToken_ == Token::END)
+                {
+                    return { true, false, currentToken_, {} };
+                }
+                else
+                {
+                    return { false, false, currentToken_, {} };
+                }
+            }
+        }
+
+        Lexer lexer_;
+        Token currentToken_;
+    };
+
+    Input ReadInput(std::string_view text)
     {
-        currentToken_ = lexer_.GetToken();
+        std::vector<std::string_view> result;
 
-        ParseResult result{};
-        do
+        Common::LineReader lines{ text };
+        std::string_view input;
+        while (lines.Next(input))
         {
-            result = MatchBrackets(MatchingClose(currentToken_));
-        } while (!result.stop);
-
+            if (input.empty())
+            {
+                break;
+            }
+            result.push_back(input);
+        }
         return result;
     }
 
-private:
-    bool IsOpen(Token t)
+    int IllegalTokenScore(Token t)
     {
         switch (t)
         {
+        case Token::END:
+            return 0;
         case Token::L_PARAN:
+            return 0;
+        case Token::R_PARAN:
+            return 3;
         case Token::L_BRACE:
+            return 0;
+        case Token::R_BRACE:
+            return 1197;
         case Token::L_BRACKET:
+            return 0;
+        case Token::R_BRACKET:
+            return 57;
         case Token::L_ANGLE:
-            return true;
+            return 0;
+        case Token::R_ANGLE:
+            return 25137;
         default:
-            return false;
+            return 0;
         }
     }
 
-    Token MatchingClose(Token t)
+    int CompletionTokenScore(Token t)
     {
         switch (t)
         {
+        case Token::END:
+            return 0;
         case Token::L_PARAN:
-            return Token::R_PARAN;
+            return 0;
+        case Token::R_PARAN:
+            return 1;
         case Token::L_BRACE:
-            return Token::R_BRACE;
+            return 0;
+        case Token::R_BRACE:
+            return 3;
         case Token::L_BRACKET:
-            return Token::R_BRACKET;
+            return 0;
+        case Token::R_BRACKET:
+            return 2;
         case Token::L_ANGLE:
-            return Token::R_ANGLE;
+            return 0;
+        case Token::R_ANGLE:
+            return 4;
         default:
-            return Token::END;
+            return 0;
         }
     }
 
-    ParseResult MatchBrackets(Token expectedClose)
+    uint64_t CompletionScore(std::vector<Token> tokens)
     {
-        currentToken_ = lexer_.GetToken();
-        if (currentToken_ == Token::END)
+        uint64_t score = 0;
+        for (auto t : tokens)
         {
-            return { true, false, currentToken_, { expectedClose } };
+            score *= 5;
+            score += CompletionTokenScore(t);
         }
+        return score;
+    }
+
+    uint64_t MiddleScore(std::vector<uint64_t>& completionScores)
+    {
+        auto middle = completionScores.begin() + completionScores.size() / 2;
+        std::nth_element(completionScores.begin(), middle, completionScores.end());
+        return *middle;
+    }
 
-        while (IsOpen(currentToken_))
+    // Both parts' scores, a line at a time.
+    struct ScoreTally
+    {
+        int totalErrorScore{ 0 };
+        std::vector<uint64_t> completionScores;
+
+        void Add(std::string_view line)
         {
-            auto expectClose = MatchingClose(currentToken_);
-            auto res = MatchBrackets(expectClose);
-            if (res.stop)
+            Parser p{ line };
+            auto result = p.Result();
+            if (result.isError)
+            {
+                totalErrorScore += IllegalTokenScore(result.lastToken);
+            }
+            else
             {
-                res.completion_.push_back(expectedClose);
-                return res;
+                completionScores.push_back(CompletionScore(result.completion_));
             }
         }
-        if (currentToken_ != expectedClose)
+
+        std::pair<int, uint64_t> Result()
         {
-            return { true, true, currentToken_ };
+            return { totalErrorScore, MiddleScore(completionScores) };
         }
-        else
+    };
+
+    int TotalErrorScore(std::vector<std::string_view> const& input)
+    {
+        AOC_TRACE_SCOPE("Day10 TotalErrorScore");
+        int totalErrorScore = 0;
+        for (auto const& line : input)
         {
-            currentToken_ = lexer_.GetToken();
-            if (currentToken_ == Token::END)
-            {
-                return { true, false, currentToken_, {} };
-            }
-            else
+            Parser p{ line };
+            auto result = p.Result();
+            if (result.isError)
             {
-                return { false, false, currentToken_ };
+                auto score = IllegalTokenScore(result.lastToken);
+                totalErrorScore += score;
             }
         }
+        return totalErrorScore;
     }
 
-    std::string input_;
-    std::stringstream inputStream_;
-    Lexer lexer_;
-    Token currentToken_;
-};
-
-std::vector<std::string> ReadInput()
-{
-    std::vector<std::string> result;
-
-    std::string input;
-    while (std::getline(std::cin, input))
+    uint64_t MiddleCompletionScore(std::vector<std::string_view> const& input)
     {
-        if (input.empty())
+        AOC_TRACE_SCOPE("Day10 MiddleCompletionScore");
+        std::vector<uint64_t> completionScores;
+        for (auto const& line : input)
         {
-            break;
+            Parser p{ line };
+            auto result = p.Result();
+            if (!result.isError)
+            {
+                auto score = CompletionScore(result.completion_);
+                completionScores.push_back(score);
+            }
         }
-        result.push_back(input);
+
+        return MiddleScore(completionScores);
     }
-    return result;
-}
 
-int IllegalTokenScore(Token t)
-{
-    switch (t)
+    int PartOne(Input const& input)
     {
-    case Token::END:
-        return 0;
-    case Token::L_PARAN:
-        return 0;
-    case Token::R_PARAN:
-        return 3;
-    case Token::L_BRACE:
-        return 0;
-    case Token::R_BRACE:
-        return 1197;
-    case Token::L_BRACKET:
-        return 0;
-    case Token::R_BRACKET:
-        return 57;
-    case Token::L_ANGLE:
-        return 0;
-    case Token::R_ANGLE:
-        return 25137;
-    default:
-        return 0;
+        return TotalErrorScore(input);
     }
-}
 
-int CompletionTokenScore(Token t)
-{
-    switch (t)
+    uint64_t PartTwo(Input const& input)
     {
-    case Token::END:
-        return 0;
-    case Token::L_PARAN:
-        return 0;
-    case Token::R_PARAN:
-        return 1;
-    case Token::L_BRACE:
-        return 0;
-    case Token::R_BRACE:
-        return 3;
-    case Token::L_BRACKET:
-        return 0;
-    case Token::R_BRACKET:
-        return 2;
-    case Token::L_ANGLE:
-        return 0;
-    case Token::R_ANGLE:
-        return 4;
-    default:
-        return 0;
+        return MiddleCompletionScore(input);
     }
-}
 
-uint64_t CompletionScore(std::vector<Token> tokens)
-{
-    uint64_t score = 0;
-    for (auto t : tokens)
+    std::pair<int, uint64_t> SolvePipelined(std::string_view text)
     {
-        score *= 5;
-        score += CompletionTokenScore(t);
+        ScoreTally tally;
+        Common::RunPipeline(text,
+            [](std::string_view line) { return std::optional{ line }; },
+            [&tally](std::string_view line) { tally.Add(line); });
+        return tally.Result();
     }
-    return score;
-}
-
-int main()
-{
-    auto input = ReadInput();
 
-    int totalErrorScore = 0;
-    std::vector<uint64_t> completionScores;
-    for (auto const& line : input)
+    std::pair<int, uint64_t> SolveStreaming(Common::LineStream& lines)
     {
-        Parser p{ line };
-        auto result = p.Result();
-        if (result.isError)
+        ScoreTally tally;
+        std::string_view line;
+        while (lines.Next(line) && !line.empty())
         {
-            auto score = IllegalTokenScore(result.lastToken);
-            totalErrorScore += score;
-        }
-        else
-        {
-            auto score = CompletionScore(result.completion_);
-            completionScores.push_back(score);
+            tally.Add(line);
         }
+        return tally.Result();
     }
-
-    std::cout << "Total score for error lines: " << totalErrorScore << "\n";
-
-    auto completionCount = completionScores.size();
-    std::sort(completionScores.begin(), completionScores.end());
-    auto completionResult = completionScores[completionCount / 2];
-
-    std::cout << "Complete score for mid-point: " << completionResult << "\n";
 }
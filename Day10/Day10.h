@@ -0,0 +1,33 @@
+// Day10.h : Syntax Scoring. Finds corrupt and incomplete lines of brackets.
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Common/Input.h"
+
+namespace Day10
+{
+    // Each line of the navigation subsystem, viewing the text passed to ReadInput.
+    using Input = std::vector<std::string_view>;
+
+    Input ReadInput(std::string_view text);
+
+    int TotalErrorScore(std::vector<std::string_view> const& input);
+    uint64_t MiddleCompletionScore(std::vector<std::string_view> const& input);
+
+    int PartOne(Input const& input);
+    uint64_t PartTwo(Input const& input);
+
+    // Both parts, checking lines on this thread while another splits them
+    // (--pipeline). There's no parsing beyond finding the line ends, so this
+    // overlaps less than the other days do.
+    std::pair<int, uint64_t> SolvePipelined(std::string_view text);
+
+    // Both parts, reading the lines as they come (--stream). Only the score
+    // of each incomplete line is kept, as the middle one needs them all.
+    std::pair<int, uint64_t> SolveStreaming(Common::LineStream& lines);
+}
@@ -0,0 +1,70 @@
+// Generate.cpp : Writes a Day10 input of any size, one chunk line per line.
+//   Day10_gen [lines] [--scale=F] [--seed=N]
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common/Generator.h"
+
+int main(int argc, char* argv[])
+{
+    Common::Generator gen{ argc, argv, 100 };
+
+    std::string_view const openers = "([{<";
+    std::string_view const closers = ")]}>";
+
+    // the autocomplete score wants the middle one, so always an odd number of incomplete lines
+    std::vector<bool> corrupt(gen.Size());
+    std::size_t incomplete = 0;
+    for (std::size_t i = 0; i < corrupt.size(); ++i)
+    {
+        corrupt[i] = gen.Chance(0.5);
+        incomplete += corrupt[i] ? 0 : 1;
+    }
+    if (incomplete % 2 == 0)
+    {
+        corrupt[0] = !corrupt[0];
+    }
+
+    std::string line;
+    std::vector<int> open;
+    for (bool isCorrupt : corrupt)
+    {
+        line.clear();
+        open.clear();
+        auto length = gen.Uniform<std::size_t>(80, 110);
+        auto corruptAt = gen.Uniform<std::size_t>(length / 4, length - 2);
+        while (line.size() < length)
+        {
+            if (isCorrupt && line.size() >= corruptAt && !open.empty())
+            {
+                // close with anything but the right bracket, then carry on with junk
+                auto wrong = (open.back() + gen.Uniform(1, 3)) % 4;
+                line += closers[wrong];
+                while (line.size() < length)
+                {
+                    line += gen.Chance(0.5) ? openers[gen.Uniform(0, 3)] : closers[gen.Uniform(0, 3)];
+                }
+                break;
+            }
+            // lean towards opening so the line stays incomplete, and don't nest too deeply
+            if (open.empty() || (open.size() < 20 && gen.Chance(0.55)))
+            {
+                open.push_back(gen.Uniform(0, 3));
+                line += openers[open.back()];
+            }
+            else
+            {
+                line += closers[open.back()];
+                open.pop_back();
+            }
+        }
+        if (!isCorrupt && open.empty())
+        {
+            line += openers[gen.Uniform(0, 3)];
+        }
+        std::cout << line << "\n";
+    }
+}
@@ -0,0 +1,51 @@
+#include <iostream>
+
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/Input.h"
+#include "Common/Pipeline.h"
+#include "Day10.h"
+
+int main(int argc, char* argv[])
+{
+    if (auto batch = Common::ReadBatchOptions(argc, argv); batch.enabled)
+    {
+        return Common::RunBatch(batch, Day10::ReadInput, Day10::PartOne, Day10::PartTwo);
+    }
+
+    Common::Benchmark bench{ argc, argv };
+    if (Common::StreamRequested(argc, argv))
+    {
+        auto [totalErrorScore, completionResult] = bench.Measure("streamed", [&]
+            {
+                auto lines = Common::LineStream::FromCommandLine(argc, argv);
+                return Day10::SolveStreaming(lines);
+            });
+        std::cout << "Total score for error lines: " << totalErrorScore << "\n";
+        std::cout << "Complete score for mid-point: " << completionResult << "\n";
+        bench.Report(std::cout);
+        return 0;
+    }
+
+    auto buffer = Common::InputBuffer::FromCommandLine(argc, argv);
+    if (Common::PipelineRequested(argc, argv))
+    {
+        auto [totalErrorScore, completionResult] = bench.Measure("pipelined", [&] { return Day10::SolvePipelined(buffer.Text()); }, { .bytes = buffer.Size() });
+        std::cout << "Total score for error lines: " << totalErrorScore << "\n";
+        std::cout << "Complete score for mid-point: " << completionResult << "\n";
+        bench.Report(std::cout);
+        return 0;
+    }
+
+    auto input = bench.Measure("parse", [&] { return Day10::ReadInput(buffer.Text()); }, { .bytes = buffer.Size() });
+
+    auto totalErrorScore = bench.Measure("part one", [&] { return Day10::PartOne(input); }, { .items = input.size() });
+
+    std::cout << "Total score for error lines: " << totalErrorScore << "\n";
+
+    auto completionResult = bench.Measure("part two", [&] { return Day10::PartTwo(input); }, { .items = input.size() });
+
+    std::cout << "Complete score for mid-point: " << completionResult << "\n";
+
+    bench.Report(std::cout);
+}
@@ -1,48 +1,50 @@
+#include "Day11.h"
+
 #include <algorithm>
-#include <array>
-#include <iostream>
+#include <functional>
 #include <set>
-#include <sstream>
-#include <string>
-#include <vector>
+#include <utility>
 
-using Grid = std::vector<std::vector<int>>;
+#include "Common/FlatHash.h"
+#include "Common/Input.h"
+#include "Common/Trace.h"
 
-auto ReadInput()
+namespace Day11
 {
-    Grid result;
-
-    std::string inLine;
-    while (std::getline(std::cin, inLine))
+    Input ReadInput(std::string_view text)
     {
-        if (inLine.empty())
-            break;
+        std::vector<std::string_view> rows;
 
-        std::stringstream in{ inLine };
-        std::vector<int> row{ std::istreambuf_iterator<char>{ in }, {} };
-        std::transform(row.begin(), row.end(), row.begin(), [](int v) { return v - '0'; });
-        result.push_back(row);
-    }
+        Common::LineReader lines{ text };
+        std::string_view inLine;
+        while (lines.Next(inLine))
+        {
+            if (inLine.empty())
+                break;
 
-    return result;
-}
+            rows.push_back(inLine);
+        }
 
-void IncreaseEnergy(Grid& grid)
-{
-    for (auto& row : grid)
+        Grid result(rows.empty() ? 0 : static_cast<int>(rows[0].size()), static_cast<int>(rows.size()));
+        for (int row = 0; row < result.Height(); ++row)
+        {
+            std::transform(rows[row].begin(), rows[row].end(), result.Row(row).begin(), [](char c) { return c - '0'; });
+        }
+        return result;
+    }
+
+    // These run over the border too, which keeps it from building up.
+    void IncreaseEnergy(Grid& grid)
     {
-        for (auto& octopus : row)
+        for (auto& octopus : grid.Cells())
         {
             ++octopus;
         }
     }
-}
 
-void ResetEnergy(Grid& grid)
-{
-    for (auto& row : grid)
+    void ResetEnergy(Grid& grid)
     {
-        for (auto& octopus : row)
+        for (auto& octopus : grid.Cells())
         {
             if (octopus > 9)
             {
@@ -50,78 +52,199 @@ void ResetEnergy(Grid& grid)
             }
         }
     }
-}
-
-uint64_t DoFlashes(Grid& grid)
-{
-    std::set<std::pair<int, int>> hasFlashed{};
 
-    while (true)
+    uint64_t DoFlashes(Grid& grid)
     {
-        Grid flashEnergy(10, std::vector<int>(10, 0));
-        int flashesThisPass = 0;
-        for (int row = 0; row < 10; ++row)
+        AOC_TRACE_SCOPE("Day11 DoFlashes");
+        Common::FlatSet<std::pair<int, int>> hasFlashed{};
+        int const rows = grid.Height();
+        int const cols = grid.Width();
+
+        while (true)
         {
-            for (int col = 0; col < 10; ++col)
+            AOC_TRACE_COUNT("Day11 flash passes", 1);
+            Grid flashEnergy(cols, rows);
+            int flashesThisPass = 0;
+            for (int row = 0; row < rows; ++row)
             {
-                if (grid[row][col] > 9 && !hasFlashed.contains(std::make_pair(row, col)))
+                for (int col = 0; col < cols; ++col)
                 {
-                    // flash
-                    ++flashesThisPass;
-                    hasFlashed.insert(std::make_pair(row, col));
-
-                    for (int i = std::max(0, row - 1); i < std::min(row + 2, 10); ++i)
+                    if (grid(col, row) > 9 && !hasFlashed.contains(std::make_pair(row, col)))
                     {
-                        for (int j = std::max(0, col - 1); j < std::min(col + 2, 10); ++j)
+                        // flash
+                        ++flashesThisPass;
+                        hasFlashed.insert(std::make_pair(row, col));
+
+                        for (int i = row - 1; i <= row + 1; ++i)
                         {
-                            ++flashEnergy[i][j];
+                            for (int j = col - 1; j <= col + 1; ++j)
+                            {
+                                ++flashEnergy(j, i);
+                            }
                         }
                     }
                 }
             }
-        }
 
-        for (int row = 0; row < 10; ++row)
-        {
-            for (int col = 0; col < 10; ++col)
+            auto energy = flashEnergy.Cells();
+            auto octopuses = grid.Cells();
+            std::transform(octopuses.begin(), octopuses.end(), energy.begin(), octopuses.begin(), std::plus{});
+
+            if (flashesThisPass == 0)
             {
-                grid[row][col] += flashEnergy[row][col];
+                break;
             }
         }
 
-        if (flashesThisPass == 0)
+        return hasFlashed.size();
+    }
+
+    uint64_t FlashesAfterSteps(Grid octopuses, int steps)
+    {
+        uint64_t totalFlashes = 0;
+        for (int i = 0; i < steps; ++i)
         {
-            break;
+            IncreaseEnergy(octopuses);
+            totalFlashes += DoFlashes(octopuses);
+            ResetEnergy(octopuses);
         }
+        return totalFlashes;
     }
 
-    return hasFlashed.size();
-}
+    int FirstStepAllFlash(Grid octopuses)
+    {
+        uint64_t const octopusCount = octopuses.Size();
 
-int main()
-{
-    auto octopuses = ReadInput();
+        for (int i = 0; ; ++i)
+        {
+            AOC_TRACE_COUNT("Day11 steps until all flash", 1);
+            IncreaseEnergy(octopuses);
+            auto flashesThisStep = DoFlashes(octopuses);
+            ResetEnergy(octopuses);
 
-    uint64_t totalFlashes = 0;
+            if (flashesThisStep == octopusCount)
+            {
+                return i + 1;
+            }
+        }
+    }
+
+    uint64_t PartOne(Input const& input)
+    {
+        return FlashesAfterSteps(input, 100);
+    }
+
+    int PartTwo(Input const& input)
+    {
+        return FirstStepAllFlash(input);
+    }
 
-    bool allFlashed = false;
-    for (int i = 0; !allFlashed; ++i)
+    namespace Reference
     {
-        IncreaseEnergy(octopuses);
-        auto flashesThisStep = DoFlashes(octopuses);
-        totalFlashes += flashesThisStep;
-        ResetEnergy(octopuses);
+        Input ReadInput(std::string_view text)
+        {
+            Input result;
+
+            Common::LineReader lines{ text };
+            std::string_view inLine;
+            while (lines.Next(inLine))
+            {
+                if (inLine.empty())
+                    break;
 
-        if (flashesThisStep == 100)
+                std::vector<int> row(inLine.size());
+                std::transform(inLine.begin(), inLine.end(), row.begin(), [](char c) { return c - '0'; });
+                result.push_back(std::move(row));
+            }
+
+            return result;
+        }
+
+        // Steps the grid once, giving how many flashed.
+        uint64_t Step(Input& grid)
+        {
+            int const rows = static_cast<int>(grid.size());
+            int const cols = rows > 0 ? static_cast<int>(grid[0].size()) : 0;
+            for (auto& row : grid)
+            {
+                for (auto& octopus : row)
+                {
+                    ++octopus;
+                }
+            }
+
+            std::set<std::pair<int, int>> hasFlashed{};
+            while (true)
+            {
+                Input flashEnergy(rows, std::vector<int>(cols, 0));
+                int flashesThisPass = 0;
+                for (int row = 0; row < rows; ++row)
+                {
+                    for (int col = 0; col < cols; ++col)
+                    {
+                        if (grid[row][col] > 9 && hasFlashed.insert(std::make_pair(row, col)).second)
+                        {
+                            ++flashesThisPass;
+                            for (int i = std::max(0, row - 1); i < std::min(row + 2, rows); ++i)
+                            {
+                                for (int j = std::max(0, col - 1); j < std::min(col + 2, cols); ++j)
+                                {
+                                    ++flashEnergy[i][j];
+                                }
+                            }
+                        }
+                    }
+                }
+
+                for (int row = 0; row < rows; ++row)
+                {
+                    for (int col = 0; col < cols; ++col)
+                    {
+                        grid[row][col] += flashEnergy[row][col];
+                    }
+                }
+
+                if (flashesThisPass == 0)
+                {
+                    break;
+                }
+            }
+
+            for (auto& row : grid)
+            {
+                for (auto& octopus : row)
+                {
+                    if (octopus > 9)
+                    {
+                        octopus = 0;
+                    }
+                }
+            }
+            return hasFlashed.size();
+        }
+
+        uint64_t PartOne(Input const& input)
         {
-            allFlashed = true;
-            std::cout << "All octopuses flashed on step " << i + 1 << "\n";
+            auto octopuses = input;
+            uint64_t totalFlashes = 0;
+            for (int i = 0; i < 100; ++i)
+            {
+                totalFlashes += Step(octopuses);
+            }
+            return totalFlashes;
         }
 
-        if (i == 99)
+        int PartTwo(Input const& input)
         {
-            std::cout << "Total octopus flashes on step 100: " << totalFlashes << "\n";
+            auto octopuses = input;
+            uint64_t const octopusCount = octopuses.empty() ? 0 : octopuses.size() * octopuses[0].size();
+            for (int i = 1; ; ++i)
+            {
+                if (Step(octopuses) == octopusCount)
+                {
+                    return i;
+                }
+            }
         }
     }
-
 }
@@ -0,0 +1,38 @@
+// Day11.h : Dumbo Octopus. Steps the octopus grid and counts the flashes.
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "Common/Grid2D.h"
+
+namespace Day11
+{
+    // Energy levels indexed (col, row). Flashes spill harmlessly in to the
+    // border, so they need no bounds checks.
+    using Grid = Common::Grid2D<int, 1>;
+    using Input = Grid;
+
+    Input ReadInput(std::string_view text);
+
+    uint64_t FlashesAfterSteps(Grid octopuses, int steps);
+    int FirstStepAllFlash(Grid octopuses);
+
+    uint64_t PartOne(Input const& input);
+    int PartTwo(Input const& input);
+
+    // The straightforward versions the faster ones are checked against (aoc_diff).
+    namespace Reference
+    {
+        // Energy levels indexed [row][col], clamping every flash to the edges
+        // and remembering the flashes in a std::set.
+        using Input = std::vector<std::vector<int>>;
+
+        Input ReadInput(std::string_view text);
+
+        uint64_t PartOne(Input const& input);
+        int PartTwo(Input const& input);
+    }
+}
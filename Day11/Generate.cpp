@@ -0,0 +1,82 @@
+// Generate.cpp : Writes a Day11 input of any size, a square grid of energy levels.
+//   Day11_gen [side] [--scale=F] [--seed=N]
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Common/Generator.h"
+
+// Steps the octopuses until they all flash together, giving up after limit steps.
+bool AllFlashWithin(std::vector<int> grid, int side, int limit)
+{
+    std::vector<int> flashing;
+    for (int step = 0; step < limit; ++step)
+    {
+        flashing.clear();
+        for (int i = 0; i < static_cast<int>(grid.size()); ++i)
+        {
+            if (++grid[i] == 10)
+            {
+                flashing.push_back(i);
+            }
+        }
+        for (std::size_t next = 0; next < flashing.size(); ++next)
+        {
+            int row = flashing[next] / side;
+            int col = flashing[next] % side;
+            for (int r = std::max(0, row - 1); r < std::min(row + 2, side); ++r)
+            {
+                for (int c = std::max(0, col - 1); c < std::min(col + 2, side); ++c)
+                {
+                    if (++grid[r * side + c] == 10)
+                    {
+                        flashing.push_back(r * side + c);
+                    }
+                }
+            }
+        }
+        if (flashing.size() == grid.size())
+        {
+            return true;
+        }
+        for (auto& energy : grid)
+        {
+            energy = energy > 9 ? 0 : energy;
+        }
+    }
+    return false;
+}
+
+int main(int argc, char* argv[])
+{
+    Common::Generator gen{ argc, argv, 10 };
+    int const side = static_cast<int>(gen.Size());
+
+    // Part two never ends unless every octopus flashes at once, and random grids
+    // much over 10x10 almost never get there. Give more and more of the grid the
+    // same energy until they do; with all of it the same they soon flash together.
+    std::vector<int> grid(gen.Size() * gen.Size());
+    for (int shared = 0; ; shared += 5)
+    {
+        auto common = gen.Uniform(0, 9);
+        for (auto& energy : grid)
+        {
+            energy = gen.Uniform(0, 99) < shared ? common : gen.Uniform(0, 9);
+        }
+        if (AllFlashWithin(grid, side, 1000))
+        {
+            break;
+        }
+    }
+
+    std::string row(gen.Size(), '0');
+    for (int r = 0; r < side; ++r)
+    {
+        for (int c = 0; c < side; ++c)
+        {
+            row[c] = static_cast<char>('0' + grid[r * side + c]);
+        }
+        std::cout << row << "\n";
+    }
+}
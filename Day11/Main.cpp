@@ -0,0 +1,28 @@
+#include <iostream>
+
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/Input.h"
+#include "Common/ParseCache.h"
+#include "Day11.h"
+
+int main(int argc, char* argv[])
+{
+    if (auto batch = Common::ReadBatchOptions(argc, argv); batch.enabled)
+    {
+        return Common::RunBatch(batch, Day11::ReadInput, Day11::PartOne, Day11::PartTwo);
+    }
+
+    Common::Benchmark bench{ argc, argv };
+    Common::ParseCache cache{ argc, argv };
+    auto buffer = Common::InputBuffer::FromCommandLine(argc, argv);
+    auto octopuses = bench.Measure("parse", [&] { return cache.Read("Day11", buffer.Text(), Day11::ReadInput); }, { .bytes = buffer.Size() });
+
+    auto totalFlashes = bench.Measure("part one", [&] { return Day11::PartOne(octopuses); }, { .items = 100 });
+    auto allFlashStep = bench.Measure("part two", [&] { return Day11::PartTwo(octopuses); });
+
+    std::cout << "Total octopus flashes on step 100: " << totalFlashes << "\n";
+    std::cout << "All octopuses flashed on step " << allFlashStep << "\n";
+
+    bench.Report(std::cout);
+}
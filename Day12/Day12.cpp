@@ -1,156 +1,222 @@
+#include "Day12.h"
+
 #include <algorithm>
-#include <iostream>
-#include <map>
-#include <set>
-#include <string>
-#include <vector>
+#include <cctype>
+#include <sstream>
 
-struct Cave
-{
-    std::string name;
-    bool large{ false };
-    std::vector<std::string> links;
-};
+#include "Common/Input.h"
+#include "Common/Trace.h"
 
-auto ReadInput()
+namespace Day12
 {
-    std::vector<std::pair<std::string, std::string>> result;
-
-    std::string input;
-    while (std::getline(std::cin, input))
+    std::vector<std::pair<std::string, std::string>> ReadCaveLinks(std::string_view text)
     {
-        if (input.empty())
+        std::vector<std::pair<std::string, std::string>> result;
+
+        Common::LineReader lines{ text };
+        std::string_view input;
+        while (lines.Next(input))
         {
-            break;
+            if (input.empty())
+            {
+                break;
+            }
+            auto first = Common::NextField(input, '-');
+            auto second = input;
+            result.emplace_back(first, second);
         }
-        auto split = input.find('-');
-        auto first = input.substr(0, split);
-        auto second = input.substr(split + 1);
-        result.emplace_back(first, second);
+        return result;
     }
-    return result;
-}
-
-auto MakeCave(std::string name, std::string linkTo)
-{
-    auto isLarge = std::all_of(name.begin(), name.end(), isupper);
-    return Cave{ name, isLarge, { linkTo } };
-}
 
-auto BuildCaves(std::vector<std::pair<std::string, std::string>> const& caveLinks)
-{
-    std::map<std::string, Cave> caves;
+    auto MakeCave(std::string name, std::string linkTo)
+    {
+        auto isLarge = std::all_of(name.begin(), name.end(), isupper);
+        return Cave{ name, isLarge, { linkTo } };
+    }
 
-    for (auto const& link : caveLinks)
+    CaveMap BuildCaves(std::vector<std::pair<std::string, std::string>> const& caveLinks)
     {
-        if (!caves.contains(link.first))
+        std::map<std::string, Cave> caves;
+
+        for (auto const& link : caveLinks)
         {
-            auto c = MakeCave(link.first, link.second);
-            caves.insert({ link.first, c });
+            if (!caves.contains(link.first))
+            {
+                auto c = MakeCave(link.first, link.second);
+                caves.insert({ link.first, c });
+            }
+            else
+            {
+                caves[link.first].links.push_back(link.second);
+            }
+
+            if (!caves.contains(link.second))
+            {
+                auto c = MakeCave(link.second, link.first);
+                caves.insert({ link.second, c });
+            }
+            else
+            {
+                caves[link.second].links.push_back(link.first);
+            }
         }
-        else
+
+        return caves;
+    }
+
+    Input ReadInput(std::string_view text)
+    {
+        auto caveLinks = ReadCaveLinks(text);
+        return BuildCaves(caveLinks);
+    }
+
+    std::vector<std::vector<std::string>> GetPathsPartOne(std::map<std::string, Cave> const& caves, std::string currentCave, std::vector<std::string> pathSoFar, std::set<std::string> smallCavesVisited)
+    {
+        AOC_TRACE_COUNT("Day12 caves entered", 1);
+        auto const& caveIt = caves.find(currentCave);
+        auto const& cave = caveIt->second;
+
+        pathSoFar.push_back(currentCave);
+        if (!cave.large)
         {
-            caves[link.first].links.push_back(link.second);
+            smallCavesVisited.insert(currentCave);
         }
 
-        if (!caves.contains(link.second))
+        if (currentCave == "end")
         {
-            auto c = MakeCave(link.second, link.first);
-            caves.insert({ link.second, c });
+            return { pathSoFar };
         }
         else
         {
-            caves[link.second].links.push_back(link.first);
+            std::vector<std::vector<std::string>> results;
+            for (auto const& link : cave.links)
+            {
+                if (!smallCavesVisited.contains(link))
+                {
+                    auto paths = GetPathsPartOne(caves, link, pathSoFar, smallCavesVisited);
+                    results.insert(results.end(), paths.begin(), paths.end());
+                }
+            }
+            return results;
         }
     }
 
-    return caves;
-}
-
-std::vector<std::vector<std::string>> GetPathsPartOne(std::map<std::string, Cave> const& caves, std::string currentCave, std::vector<std::string> pathSoFar, std::set<std::string> smallCavesVisited)
-{
-    auto const& caveIt = caves.find(currentCave);
-    auto const& cave = caveIt->second;
-
-    pathSoFar.push_back(currentCave);
-    if (!cave.large)
+    std::vector<std::vector<std::string>> GetPathsPartTwo(std::map<std::string, Cave> const& caves, std::string currentCave, std::vector<std::string> pathSoFar, std::map<std::string, int> smallCavesVisited)
     {
-        smallCavesVisited.insert(currentCave);
-    }
+        AOC_TRACE_COUNT("Day12 caves entered", 1);
+        auto const& caveIt = caves.find(currentCave);
+        auto const& cave = caveIt->second;
 
-    if (currentCave == "end")
-    {
-        return { pathSoFar };
-    }
-    else
-    {
-        std::vector<std::vector<std::string>> results;
-        for (auto const& link : cave.links)
+        pathSoFar.push_back(currentCave);
+        if (!cave.large)
         {
-            if (!smallCavesVisited.contains(link))
+            if (smallCavesVisited.contains(currentCave))
             {
-                auto paths = GetPathsPartOne(caves, link, pathSoFar, smallCavesVisited);
-                results.insert(results.end(), paths.begin(), paths.end());
+                smallCavesVisited[currentCave]++;
+            }
+            else
+            {
+                smallCavesVisited.insert({ currentCave, 1 });
             }
         }
-        return results;
-    }
-}
 
-std::vector<std::vector<std::string>> GetPathsPartTwo(std::map<std::string, Cave> const& caves, std::string currentCave, std::vector<std::string> pathSoFar, std::map<std::string, int> smallCavesVisited)
-{
-    auto const& caveIt = caves.find(currentCave);
-    auto const& cave = caveIt->second;
-
-    pathSoFar.push_back(currentCave);
-    if (!cave.large)
-    {
-        if (smallCavesVisited.contains(currentCave))
+        if (currentCave == "end")
         {
-            smallCavesVisited[currentCave]++;
+            return { pathSoFar };
         }
         else
         {
-            smallCavesVisited.insert({ currentCave, 1 });
+            auto hasMultipleVisits = std::any_of(smallCavesVisited.begin(), smallCavesVisited.end(),
+                [](auto const& p)
+                {
+                    return p.second > 1;
+                });
+            std::vector<std::vector<std::string>> results;
+            for (auto const& link : cave.links)
+            {
+                if (link != "start" && (!hasMultipleVisits || !smallCavesVisited.contains(link)))
+                {
+                    auto paths = GetPathsPartTwo(caves, link, pathSoFar, smallCavesVisited);
+                    results.insert(results.end(), paths.begin(), paths.end());
+                }
+            }
+            return results;
         }
     }
 
-    if (currentCave == "end")
+    std::size_t PartOne(Input const& input)
     {
-        return { pathSoFar };
+        AOC_TRACE_SCOPE("Day12 GetPathsPartOne");
+        return GetPathsPartOne(input, "start", {}, {}).size();
     }
-    else
+
+    std::size_t PartTwo(Input const& input)
     {
-        auto hasMultipleVisits = std::any_of(smallCavesVisited.begin(), smallCavesVisited.end(),
-            [](auto const& p)
-            {
-                return p.second > 1;
-            });
-        std::vector<std::vector<std::string>> results;
-        for (auto const& link : cave.links)
+        AOC_TRACE_SCOPE("Day12 GetPathsPartTwo");
+        return GetPathsPartTwo(input, "start", {}, {}).size();
+    }
+
+    namespace Reference
+    {
+        Input ReadInput(std::string_view text)
         {
-            if (link != "start" && (!hasMultipleVisits || !smallCavesVisited.contains(link)))
+            Input caves;
+            std::istringstream in{ std::string{ text } };
+            std::string line;
+            while (std::getline(in, line) && !line.empty())
             {
-                auto paths = GetPathsPartTwo(caves, link, pathSoFar, smallCavesVisited);
-                results.insert(results.end(), paths.begin(), paths.end());
+                auto dash = line.find('-');
+                auto from = line.substr(0, dash);
+                auto to = line.substr(dash + 1);
+                caves[from].push_back(to);
+                caves[to].push_back(from);
             }
+            return caves;
         }
-        return results;
-    }
-}
-
-int main()
-{
-    auto caveLinks = ReadInput();
-
-    auto caves = BuildCaves(caveLinks);
 
-    auto pathsPartOne = GetPathsPartOne(caves, "start", {}, {});
-
-    std::cout << "Total Part 1 paths: " << pathsPartOne.size() << "\n";
+        // The routes to end from cave, with the small caves in visited
+        // already used and, if canRevisit, one of them allowed again.
+        std::size_t CountRoutes(Input const& caves, std::string const& cave, std::set<std::string>& visited, bool canRevisit)
+        {
+            if (cave == "end")
+            {
+                return 1;
+            }
+            std::size_t routes = 0;
+            for (auto const& next : caves.at(cave))
+            {
+                if (next == "start")
+                {
+                    continue;
+                }
+                if (std::isupper(static_cast<unsigned char>(next[0])))
+                {
+                    routes += CountRoutes(caves, next, visited, canRevisit);
+                }
+                else if (!visited.contains(next))
+                {
+                    visited.insert(next);
+                    routes += CountRoutes(caves, next, visited, canRevisit);
+                    visited.erase(next);
+                }
+                else if (canRevisit)
+                {
+                    routes += CountRoutes(caves, next, visited, false);
+                }
+            }
+            return routes;
+        }
 
-    auto pathsPartTwo = GetPathsPartTwo(caves, "start", {}, {});
+        std::size_t PartOne(Input const& input)
+        {
+            std::set<std::string> visited{ "start" };
+            return CountRoutes(input, "start", visited, false);
+        }
 
-    std::cout << "Total Part 2 paths: " << pathsPartTwo.size() << "\n";
+        std::size_t PartTwo(Input const& input)
+        {
+            std::set<std::string> visited{ "start" };
+            return CountRoutes(input, "start", visited, true);
+        }
+    }
 }
-
@@ -0,0 +1,46 @@
+// Day12.h : Passage Pathing. Counts the routes through the cave system.
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Day12
+{
+    struct Cave
+    {
+        std::string name;
+        bool large{ false };
+        std::vector<std::string> links;
+    };
+
+    using CaveMap = std::map<std::string, Cave>;
+    using Input = CaveMap;
+
+    std::vector<std::pair<std::string, std::string>> ReadCaveLinks(std::string_view text);
+    CaveMap BuildCaves(std::vector<std::pair<std::string, std::string>> const& caveLinks);
+    Input ReadInput(std::string_view text);
+
+    std::vector<std::vector<std::string>> GetPathsPartOne(std::map<std::string, Cave> const& caves, std::string currentCave, std::vector<std::string> pathSoFar, std::set<std::string> smallCavesVisited);
+    std::vector<std::vector<std::string>> GetPathsPartTwo(std::map<std::string, Cave> const& caves, std::string currentCave, std::vector<std::string> pathSoFar, std::map<std::string, int> smallCavesVisited);
+
+    std::size_t PartOne(Input const& input);
+    std::size_t PartTwo(Input const& input);
+
+    // The straightforward versions the faster ones are checked against (aoc_diff).
+    namespace Reference
+    {
+        // Each cave's neighbours, read through a std::istringstream.
+        using Input = std::map<std::string, std::vector<std::string>>;
+
+        Input ReadInput(std::string_view text);
+        // Count the routes as they're walked rather than collecting them.
+        std::size_t PartOne(Input const& input);
+        std::size_t PartTwo(Input const& input);
+    }
+}
@@ -0,0 +1,85 @@
+// Generate.cpp : Writes a Day12 input of any size, one cave link per line.
+//   Day12_gen [clusters] [--scale=F] [--seed=N]
+//
+// The number of paths grows exponentially with the caves that can reach each
+// other, so a bigger input is made of more clusters of caves that only meet
+// at start and end. The path count then grows in step with the size.
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Common/Generator.h"
+
+std::string CaveName(std::size_t index, bool large)
+{
+    std::string name;
+    do
+    {
+        name += static_cast<char>((large ? 'A' : 'a') + index % 26);
+        index /= 26;
+    } while (index > 0 || name.size() < 2);
+    return name;
+}
+
+int main(int argc, char* argv[])
+{
+    Common::Generator gen{ argc, argv, 3 };
+
+    std::size_t nextSmall = 0;
+    std::size_t nextLarge = 0;
+    auto newSmall = [&]
+    {
+        auto name = CaveName(nextSmall++, false);
+        return name == "end" ? CaveName(nextSmall++, false) : name;
+    };
+
+    for (std::size_t cluster = 0; cluster < gen.Size(); ++cluster)
+    {
+        std::vector<std::string> small(4);
+        std::vector<std::string> large(2);
+        for (auto& name : small)
+        {
+            name = newSmall();
+        }
+        for (auto& name : large)
+        {
+            name = CaveName(nextLarge++, true);
+        }
+
+        // two large caves are never linked, or the paths would go round them forever
+        for (auto const& s : small)
+        {
+            bool linked = false;
+            for (auto const& l : large)
+            {
+                if (gen.Chance(0.5))
+                {
+                    std::cout << s << "-" << l << "\n";
+                    linked = true;
+                }
+            }
+            if (!linked)
+            {
+                std::cout << gen.Pick(large) << "-" << s << "\n";
+            }
+        }
+        for (std::size_t i = 0; i < small.size(); ++i)
+        {
+            for (std::size_t j = i + 1; j < small.size(); ++j)
+            {
+                if (gen.Chance(0.25))
+                {
+                    std::cout << small[i] << "-" << small[j] << "\n";
+                }
+            }
+        }
+
+        std::cout << "start-" << gen.Pick(large) << "\n";
+        std::cout << gen.Pick(small) << "-end\n";
+        if (gen.Chance(0.5))
+        {
+            std::cout << gen.Pick(large) << "-end\n";
+        }
+    }
+}
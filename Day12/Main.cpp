@@ -0,0 +1,28 @@
+#include <iostream>
+
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/Input.h"
+#include "Day12.h"
+
+int main(int argc, char* argv[])
+{
+    if (auto batch = Common::ReadBatchOptions(argc, argv); batch.enabled)
+    {
+        return Common::RunBatch(batch, Day12::ReadInput, Day12::PartOne, Day12::PartTwo);
+    }
+
+    Common::Benchmark bench{ argc, argv };
+    auto buffer = Common::InputBuffer::FromCommandLine(argc, argv);
+    auto caves = bench.Measure("parse", [&] { return Day12::ReadInput(buffer.Text()); }, { .bytes = buffer.Size() });
+
+    auto pathsPartOne = bench.Measure("part one", [&] { return Day12::PartOne(caves); }, { .items = caves.size() });
+
+    std::cout << "Total Part 1 paths: " << pathsPartOne << "\n";
+
+    auto pathsPartTwo = bench.Measure("part two", [&] { return Day12::PartTwo(caves); }, { .items = caves.size() });
+
+    std::cout << "Total Part 2 paths: " << pathsPartTwo << "\n";
+
+    bench.Report(std::cout);
+}
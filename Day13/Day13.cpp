@@ -1,169 +1,240 @@
-#include <iostream>
-#include <regex>
+#include "Day13.h"
+
+#include <algorithm>
 #include <set>
-#include <string>
-#include <vector>
 
-enum class Axis
-{
-    X,
-    Y
-};
+#include "Common/Pattern.h"
+#include "Common/Trace.h"
 
-auto ReadPoints()
+namespace Day13
 {
-    std::set<std::pair<int, int>> result;
+    Points ReadPoints(Common::LineReader& lines)
+    {
+        Points result;
 
-    std::string input;
-    while (std::getline(std::cin, input))
+        std::string_view input;
+        while (lines.Next(input))
+        {
+            if (input.empty())
+            {
+                break;
+            }
+            auto first = Common::ToNumber(Common::NextField(input, ','));
+            auto second = Common::ToNumber(input);
+            result.insert(std::make_pair(first, second));
+        }
+        return result;
+    }
+
+    std::vector<Fold> ReadFolds(Common::LineReader& lines)
     {
-        if (input.empty())
+        std::vector<Fold> result;
+
+        std::string_view input;
+        while (lines.Next(input))
         {
-            break;
+            if (input.empty())
+            {
+                break;
+            }
+
+            char axis;
+            int value;
+            if (Common::Match<"fold along {}={}">(input, axis, value))
+            {
+                result.emplace_back(axis == 'x' ? Axis::X : Axis::Y, value);
+            }
         }
-        auto split = input.find(',');
-        auto first = std::stoi(input.substr(0, split));
-        auto second = std::stoi(input.substr(split + 1));
-        result.insert(std::make_pair(first, second));
+        return result;
     }
-    return result;
-}
 
-auto ReadFolds()
-{
-    std::vector<std::pair<Axis, int>> result;
+    Input ReadInput(std::string_view text)
+    {
+        Common::LineReader lines{ text };
 
-    std::regex regex("fold along (.)=(\\d+)");
+        auto points = ReadPoints(lines);
 
-    std::string input;
-    while (std::getline(std::cin, input))
+        auto folds = ReadFolds(lines);
+        return { std::move(points), std::move(folds) };
+    }
+
+    Points HorizontalFold(int pos, Points const &points)
     {
-        if (input.empty())
+        Points result;
+
+        for (auto const &p : points)
         {
-            break;
+            if (p.second > pos)
+            {
+                auto newY = pos - (p.second - pos);
+                result.insert(std::make_pair(p.first, newY));
+            }
+            else
+            {
+                result.insert(p);
+            }
         }
+        return result;
+    }
 
-        std::smatch matches;
-        if (std::regex_match(input, matches, regex))
+    Points VerticalFold(int pos, Points const& points)
+    {
+        Points result;
+
+        for (auto const &p : points)
         {
-            if (matches.size() == 3)
+            if (p.first > pos)
             {
-                auto axisStr = matches[1].str();
-                auto valueStr = matches[2].str();
-
-                auto axis = axisStr == "x" ? Axis::X : Axis::Y;
-                auto value = std::stoi(valueStr);
-                result.emplace_back(axis, value);
+                auto newX = pos - (p.first - pos);
+                result.insert(std::make_pair(newX, p.second));
+            }
+            else
+            {
+                result.insert(p);
             }
         }
+        return result;
     }
-    return result;
-}
-
-auto HorizontalFold(int pos, std::set<std::pair<int, int>> const &points)
-{
-    std::set<std::pair<int, int>> result;
 
-    for (auto const &p : points)
+    int MaximumWidth(Points const& points)
     {
-        if (p.second > pos)
+        int maxWidth = 0;
+        for (auto const& l : points)
         {
-            auto newY = pos - (p.second - pos);
-            result.insert(std::make_pair(p.first, newY));
+            if (l.first > maxWidth)
+            {
+                maxWidth = l.first;
+            }
         }
-        else
+        return maxWidth + 1;
+    }
+
+    int MaximumHeight(Points const& points)
+    {
+        int maxHeight = 0;
+        for (auto const& l : points)
         {
-            result.insert(p);
+            if (l.second > maxHeight)
+            {
+                maxHeight = l.second;
+            }
         }
+        return maxHeight + 1;
     }
-    return result;
-}
-
-auto VerticalFold(int pos, std::set<std::pair<int, int>> const& points)
-{
-    std::set<std::pair<int, int>> result;
 
-    for (auto const &p : points)
+    Points ApplyFold(Fold const& fold, Points const& points)
     {
-        if (p.first > pos)
+        AOC_TRACE_SCOPE("Day13 ApplyFold");
+        AOC_TRACE_COUNT("Day13 points folded", points.size());
+        if (fold.first == Axis::X)
         {
-            auto newX = pos - (p.first - pos);
-            result.insert(std::make_pair(newX, p.second));
+            return VerticalFold(fold.second, points);
         }
         else
         {
-            result.insert(p);
+            return HorizontalFold(fold.second, points);
         }
     }
-    return result;
-}
 
-int MaximumWidth(std::set<std::pair<int, int>> const& points)
-{
-    int maxWidth = 0;
-    for (auto const& l : points)
+    std::vector<std::string> DrawPoints(Points const& points)
     {
-        if (l.first > maxWidth)
+        auto width = MaximumWidth(points);
+        auto height = MaximumHeight(points);
+
+        std::vector<std::string> grid(height, std::string(width, ' '));
+        for (auto const& p : points)
         {
-            maxWidth = l.first;
+            grid[p.second][p.first] = '#';
         }
+        return grid;
     }
-    return maxWidth + 1;
-}
 
-int MaximumHeight(std::set<std::pair<int, int>> const& points)
-{
-    int maxHeight = 0;
-    for (auto const& l : points)
+    std::vector<std::size_t> CountPointsAfterFolds(Input const& input)
     {
-        if (l.second > maxHeight)
+        std::vector<std::size_t> counts;
+        auto folded = input.points;
+        for (auto const& fold : input.folds)
         {
-            maxHeight = l.second;
+            folded = ApplyFold(fold, folded);
+            counts.push_back(folded.size());
         }
+        return counts;
     }
-    return maxHeight + 1;
-}
 
-int main()
-{
-    auto points = ReadPoints();
-
-    auto folds = ReadFolds();
-
-    std::cout << "Initial points: " << points.size() << "\n";
+    std::size_t PartOne(Input const& input)
+    {
+        return ApplyFold(input.folds.front(), input.points).size();
+    }
 
-    int foldCount = 0;
-    for (auto const& fold : folds)
+    std::string PartTwo(Input const& input)
     {
-        if (fold.first == Axis::X)
+        auto folded = input.points;
+        for (auto const& fold : input.folds)
         {
-            points = VerticalFold(fold.second, points);
+            folded = ApplyFold(fold, folded);
         }
-        else
+
+        std::string result;
+        for (auto const& row : DrawPoints(folded))
         {
-            points = HorizontalFold(fold.second, points);
+            result += row;
+            result += '\n';
         }
-        ++foldCount;
-
-        std::cout << "Points after " << foldCount << " folds: " << points.size() << "\n";
+        return result;
     }
 
-    std::cout << "\nPart 2\n\n";
+    namespace Reference
+    {
+        using PointSet = std::set<std::pair<int, int>>;
 
-    auto width = MaximumWidth(points);
-    auto height = MaximumHeight(points);
+        PointSet FoldPoints(Fold const& fold, PointSet const& points)
+        {
+            PointSet result;
+            for (auto p : points)
+            {
+                auto& coordinate = fold.first == Axis::X ? p.first : p.second;
+                if (coordinate > fold.second)
+                {
+                    coordinate = fold.second - (coordinate - fold.second);
+                }
+                result.insert(p);
+            }
+            return result;
+        }
 
-    std::vector<std::vector<char>> grid(height, std::vector<char>(width, ' '));
-    for (auto const& p : points)
-    {
-        grid[p.second][p.first] = '#';
-    }
-    for (auto const& row : grid)
-    {
-        for (auto const& c : row)
+        std::size_t PartOne(Input const& input)
+        {
+            return FoldPoints(input.folds.front(), { input.points.begin(), input.points.end() }).size();
+        }
+
+        std::string PartTwo(Input const& input)
         {
-            std::cout << c;
+            PointSet folded{ input.points.begin(), input.points.end() };
+            for (auto const& fold : input.folds)
+            {
+                folded = FoldPoints(fold, folded);
+            }
+
+            int width = 0;
+            int height = 0;
+            for (auto const& p : folded)
+            {
+                width = std::max(width, p.first + 1);
+                height = std::max(height, p.second + 1);
+            }
+            std::vector<std::string> grid(height, std::string(width, ' '));
+            for (auto const& p : folded)
+            {
+                grid[p.second][p.first] = '#';
+            }
+
+            std::string result;
+            for (auto const& row : grid)
+            {
+                result += row;
+                result += '\n';
+            }
+            return result;
         }
-        std::cout << "\n";
     }
 }
@@ -0,0 +1,58 @@
+// Day13.h : Transparent Origami. Folds the sheet of dots to reveal the code.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Common/FlatHash.h"
+#include "Common/Input.h"
+
+namespace Day13
+{
+    enum class Axis
+    {
+        X,
+        Y
+    };
+
+    using Points = Common::FlatSet<std::pair<int, int>>;
+    using Fold = std::pair<Axis, int>;
+
+    struct Input
+    {
+        Points points;
+        std::vector<Fold> folds;
+    };
+
+    template<typename Archive>
+    void Serialise(Archive& archive, Input& input)
+    {
+        archive(input.points, input.folds);
+    }
+
+    Points ReadPoints(Common::LineReader& lines);
+    std::vector<Fold> ReadFolds(Common::LineReader& lines);
+    Input ReadInput(std::string_view text);
+
+    Points ApplyFold(Fold const& fold, Points const& points);
+    std::vector<std::string> DrawPoints(Points const& points);
+
+    // How many points are left after each of the folds in turn.
+    std::vector<std::size_t> CountPointsAfterFolds(Input const& input);
+
+    std::size_t PartOne(Input const& input);
+    // The folded sheet drawn out with a '#' for each point, one line per row.
+    std::string PartTwo(Input const& input);
+
+    // The straightforward versions the faster ones are checked against (aoc_diff).
+    namespace Reference
+    {
+        // Folds a std::set of the points rather than a FlatSet.
+        std::size_t PartOne(Input const& input);
+        std::string PartTwo(Input const& input);
+    }
+}
@@ -0,0 +1,89 @@
+// Generate.cpp : Writes a Day13 input of any size: the dots, then the folds.
+//   Day13_gen [dots] [--scale=F] [--seed=N]
+
+#include <iostream>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "Common/Generator.h"
+
+int main(int argc, char* argv[])
+{
+    Common::Generator gen{ argc, argv, 900 };
+
+    // choose what the folded paper shows, then unfold it on to the full sheet
+    // the same way as the puzzle: 40x6 grows to 1311x895 over 5 + 7 folds
+    std::vector<std::pair<int, int>> shown;
+    for (int y = 0; y < 6; ++y)
+    {
+        for (int x = 0; x < 40; ++x)
+        {
+            if (gen.Chance(0.4))
+            {
+                shown.emplace_back(x, y);
+            }
+        }
+    }
+    std::vector<int> xFolds;
+    std::vector<int> yFolds;
+    for (int width = 40; xFolds.size() < 5; width = 2 * width + 1)
+    {
+        xFolds.push_back(width);
+    }
+    for (int height = 6; yFolds.size() < 7; height = 2 * height + 1)
+    {
+        yFolds.push_back(height);
+    }
+
+    // each shown dot can come from 2^12 places on the sheet
+    auto wanted = std::min(gen.Size(), shown.size() << (xFolds.size() + yFolds.size()));
+    std::set<std::pair<int, int>> dots;
+    auto unfold = [&](std::pair<int, int> dot)
+    {
+        for (auto fold : xFolds)
+        {
+            if (gen.Chance(0.5))
+            {
+                dot.first = 2 * fold - dot.first;
+            }
+        }
+        for (auto fold : yFolds)
+        {
+            if (gen.Chance(0.5))
+            {
+                dot.second = 2 * fold - dot.second;
+            }
+        }
+        return dot;
+    };
+    // make sure each shown dot turns up at least once
+    for (auto const& dot : shown)
+    {
+        if (dots.size() < wanted)
+        {
+            dots.insert(unfold(dot));
+        }
+    }
+    while (dots.size() < wanted)
+    {
+        dots.insert(unfold(gen.Pick(shown)));
+    }
+
+    std::vector<std::pair<int, int>> ordered(dots.begin(), dots.end());
+    gen.Shuffle(ordered);
+    for (auto const& [x, y] : ordered)
+    {
+        std::cout << x << "," << y << "\n";
+    }
+
+    // the largest folds come first, with the two directions interleaved
+    std::cout << "\n";
+    while (!xFolds.empty() || !yFolds.empty())
+    {
+        bool alongX = yFolds.empty() || (!xFolds.empty() && gen.Chance(0.5));
+        auto& folds = alongX ? xFolds : yFolds;
+        std::cout << "fold along " << (alongX ? "x=" : "y=") << folds.back() << "\n";
+        folds.pop_back();
+    }
+}
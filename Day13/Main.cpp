@@ -0,0 +1,40 @@
+#include <iostream>
+
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/Input.h"
+#include "Common/ParseCache.h"
+#include "Day13.h"
+
+int main(int argc, char* argv[])
+{
+    if (auto batch = Common::ReadBatchOptions(argc, argv); batch.enabled)
+    {
+        return Common::RunBatch(batch, Day13::ReadInput, Day13::PartOne, Day13::PartTwo);
+    }
+
+    Common::Benchmark bench{ argc, argv };
+    Common::ParseCache cache{ argc, argv };
+    auto buffer = Common::InputBuffer::FromCommandLine(argc, argv);
+    auto input = bench.Measure("parse", [&] { return cache.Read("Day13", buffer.Text(), Day13::ReadInput); }, { .bytes = buffer.Size() });
+
+    std::cout << "Initial points: " << input.points.size() << "\n";
+
+    auto pointCounts = bench.Measure("part one", [&] { return Day13::CountPointsAfterFolds(input); }, { .items = input.points.size() });
+
+    int foldCount = 0;
+    for (auto const& count : pointCounts)
+    {
+        ++foldCount;
+
+        std::cout << "Points after " << foldCount << " folds: " << count << "\n";
+    }
+
+    std::cout << "\nPart 2\n\n";
+
+    auto code = bench.Measure("part two", [&] { return Day13::PartTwo(input); }, { .items = input.points.size() });
+
+    std::cout << code;
+
+    bench.Report(std::cout);
+}
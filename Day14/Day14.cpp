@@ -1,179 +1,255 @@
+#include "Day14.h"
+
 #include <algorithm>
-#include <iostream>
+#include <array>
+#include <iterator>
+#include <limits>
 #include <map>
 #include <numeric>
-#include <regex>
-#include <string>
-
-using InsertionMap = std::map<std::pair<char, char>, char>;
+#include <tuple>
 
-std::string ReadStart()
-{
-    std::string result;
-    std::getline(std::cin, result);
-    return result;
-}
+#include "Common/Pattern.h"
+#include "Common/Trace.h"
 
-InsertionMap ReadInsertions()
+namespace Day14
 {
-    InsertionMap result;
-
-    std::regex regex("(.)(.) -> (.)");
+    std::string ReadStart(Common::LineReader& lines)
+    {
+        std::string_view result;
+        lines.Next(result);
+        return std::string{ result };
+    }
 
-    std::string input;
-    while (std::getline(std::cin, input))
+    InsertionMap ReadInsertions(Common::LineReader& lines)
     {
-        if (input.empty() && result.empty())
-        {
-            continue;
-        }
-        if (input.empty())
-        {
-            break;
-        }
+        InsertionMap result;
 
-        std::smatch matches;
-        if (std::regex_match(input, matches, regex))
+        std::string_view input;
+        while (lines.Next(input))
         {
-            if (matches.size() == 4)
+            if (input.empty() && result.empty())
             {
-                auto first = matches[1].str()[0];
-                auto second = matches[2].str()[0];
-                auto insertion = matches[3].str()[0];
+                continue;
+            }
+            if (input.empty())
+            {
+                break;
+            }
 
+            char first;
+            char second;
+            char insertion;
+            if (Common::Match<"{}{} -> {}">(input, first, second, insertion))
+            {
                 result.insert(std::make_pair(std::make_pair(first, second), insertion));
             }
         }
-    }
-
-    return result;
-}
 
-auto CountChars(std::string const& str)
-{
-    std::map<char, int> result;
-
-    for (auto const& c : str)
-    {
-        if (result.contains(c))
-        {
-            result[c]++;
-        }
-        else
-        {
-            result.emplace(c, 1);
-        }
+        return result;
     }
 
-    return result;
-}
+    Input ReadInput(std::string_view text)
+    {
+        Common::LineReader lines{ text };
 
-void PartOne(std::string input, InsertionMap const& insertions)
-{
-    auto currentString = input;
+        auto startValue = ReadStart(lines);
 
-    for (int i = 0; i < 10; ++i)
-    {
-        currentString = std::inner_product(currentString.begin(), std::prev(currentString.end()), std::next(currentString.begin()),
-            currentString.substr(0, 1),
-            [](std::string acc, std::string val) { return acc + val; },
-            [&insertions](char first, char second)
-            {
-                auto insertChar = insertions.find(std::make_pair(first, second));
-                auto insert = insertChar->second;
-                return std::string{ insert, second };
-            });
+        auto insertions = ReadInsertions(lines);
+        return { std::move(startValue), std::move(insertions) };
     }
 
-    auto charCounts = CountChars(currentString);
+    auto CountChars(std::string const& str)
+    {
+        Common::FlatMap<char, int> result;
 
-    auto const [minVal, maxVal] = std::minmax_element(charCounts.begin(), charCounts.end(),
-        [](auto const& left, auto const& right)
+        for (auto const& c : str)
         {
-            return left.second < right.second;
-        });
-
-    auto maxMinDiff = maxVal->second - minVal->second;
-
-    std::cout << "Part One Difference between most and least common chars: " << maxMinDiff << "\n";
-}
+            if (result.contains(c))
+            {
+                result[c]++;
+            }
+            else
+            {
+                result.emplace(c, 1);
+            }
+        }
 
-void PartTwo(std::string input, InsertionMap const& insertions)
-{
-    using PairCounter = std::map<std::pair<char, char>, uint64_t>;
-    std::map<char, uint64_t> charCounts;
-    PairCounter pairCounts;
+        return result;
+    }
 
-    auto addCharCount = [&charCounts](char c, uint64_t count)
+    uint64_t GrowByPairs(Input const& input, int steps)
     {
-        if (charCounts.contains(c))
+        auto const& start = input.start;
+        auto const& insertions = input.insertions;
+        using PairCounter = Common::FlatMap<std::pair<char, char>, uint64_t>;
+        Common::FlatMap<char, uint64_t> charCounts;
+        PairCounter pairCounts;
+
+        auto addCharCount = [&charCounts](char c, uint64_t count)
         {
-            charCounts[c] += count;
-        }
-        else
+            if (charCounts.contains(c))
+            {
+                charCounts[c] += count;
+            }
+            else
+            {
+                charCounts[c] = count;
+            }
+        };
+        auto addPairCount = [](PairCounter& pairCounts, std::pair<char, char> pair, uint64_t count)
+        {
+            if (pairCounts.contains(pair))
+            {
+                pairCounts[pair] += count;
+            }
+            else
+            {
+                pairCounts[pair] = count;
+            }
+        };
+
+        for (auto const& c : start)
         {
-            charCounts[c] = count;
+            addCharCount(c, 1);
         }
-    };
-    auto addPairCount = [](PairCounter& pairCounts, std::pair<char, char> pair, uint64_t count)
-    {
-        if (pairCounts.contains(pair))
+        for (std::size_t i = 0; i + 1 < start.size(); ++i)
         {
-            pairCounts[pair] += count;
+            auto first = start[i];
+            auto second = start[i + 1];
+            auto pair = std::make_pair(first, second);
+            addPairCount(pairCounts, pair, 1);
         }
-        else
+
+        for (int i = 0; i < steps; ++i)
         {
-            pairCounts[pair] = count;
+            AOC_TRACE_SCOPE("Day14 pair count step");
+            AOC_TRACE_COUNT("Day14 pair kinds expanded", pairCounts.size());
+            PairCounter newPairCounts;
+
+            for (auto const& [pair, count] : pairCounts)
+            {
+                auto insertChar = insertions.find(pair);
+
+                auto p1 = std::make_pair(pair.first, insertChar->second);
+                auto p2 = std::make_pair(insertChar->second, pair.second);
+
+                addPairCount(newPairCounts, p1, count);
+                addPairCount(newPairCounts, p2, count);
+                addCharCount(insertChar->second, count);
+            }
+            pairCounts = std::move(newPairCounts);
         }
-    };
+        auto const [minVal, maxVal] = std::minmax_element(charCounts.begin(), charCounts.end(),
+            [](auto const& left, auto const& right)
+            {
+                return left.second < right.second;
+            });
 
-    for (auto const& c : input)
-    {
-        addCharCount(c, 1);
+        auto maxMinDiff = maxVal->second - minVal->second;
+
+        return maxMinDiff;
     }
-    for (int i = 0; i < input.size() - 1; ++i)
+
+    int PartOne(Input const& input)
     {
-        auto first = input[i];
-        auto second = input[i + 1];
-        auto pair = std::make_pair(first, second);
-        addPairCount(pairCounts, pair, 1);
+        return static_cast<int>(GrowByPairs(input, 10));
     }
 
-    for (int i = 0; i < 40; ++i)
+    uint64_t PartTwo(Input const& input)
     {
-        PairCounter newPairCounts;
+        return GrowByPairs(input, 40);
+    }
 
-        for (auto const& [pair, count] : pairCounts)
+    namespace Reference
+    {
+        int PartOne(Input const& input)
         {
-            auto insertChar = insertions.find(pair);
+            auto const& insertions = input.insertions;
+            auto currentString = input.start;
+
+            for (int i = 0; i < 10; ++i)
+            {
+                AOC_TRACE_SCOPE("Day14 string step");
+                AOC_TRACE_COUNT("Day14 pairs expanded", currentString.size() - 1);
+                currentString = std::inner_product(currentString.begin(), std::prev(currentString.end()), std::next(currentString.begin()),
+                    currentString.substr(0, 1),
+                    [](std::string acc, std::string val) { return acc + val; },
+                    [&insertions](char first, char second)
+                    {
+                        auto insertChar = insertions.find(std::make_pair(first, second));
+                        auto insert = insertChar->second;
+                        return std::string{ insert, second };
+                    });
+            }
 
-            auto p1 = std::make_pair(pair.first, insertChar->second);
-            auto p2 = std::make_pair(insertChar->second, pair.second);
+            auto charCounts = CountChars(currentString);
 
-            addPairCount(newPairCounts, p1, count);
-            addPairCount(newPairCounts, p2, count);
-            addCharCount(insertChar->second, count);
-        }
-        pairCounts = std::move(newPairCounts);
-    }
-    auto const [minVal, maxVal] = std::minmax_element(charCounts.begin(), charCounts.end(),
-        [](auto const& left, auto const& right)
-        {
-            return left.second < right.second;
-        });
+            auto const [minVal, maxVal] = std::minmax_element(charCounts.begin(), charCounts.end(),
+                [](auto const& left, auto const& right)
+                {
+                    return left.second < right.second;
+                });
 
-    auto maxMinDiff = maxVal->second - minVal->second;
+            auto maxMinDiff = maxVal->second - minVal->second;
 
-    std::cout << "Part Two Difference between most and least common chars: " << maxMinDiff << "\n";
-}
+            return maxMinDiff;
+        }
 
-int main()
-{
-    auto startValue = ReadStart();
+        using ElementCounts = std::array<uint64_t, 256>;
 
-    auto insertions = ReadInsertions();
+        // The elements inserted between first and second over steps steps.
+        ElementCounts GrowBetween(InsertionMap const& insertions, char first, char second, int steps, std::map<std::tuple<char, char, int>, ElementCounts>& known)
+        {
+            ElementCounts counts{};
+            if (steps == 0)
+            {
+                return counts;
+            }
+            auto key = std::make_tuple(first, second, steps);
+            if (auto it = known.find(key); it != known.end())
+            {
+                return it->second;
+            }
+            auto middle = insertions.find(std::make_pair(first, second))->second;
+            auto left = GrowBetween(insertions, first, middle, steps - 1, known);
+            auto right = GrowBetween(insertions, middle, second, steps - 1, known);
+            for (std::size_t i = 0; i < counts.size(); ++i)
+            {
+                counts[i] = left[i] + right[i];
+            }
+            counts[static_cast<unsigned char>(middle)]++;
+            known[key] = counts;
+            return counts;
+        }
 
-    PartOne(startValue, insertions);
-    PartTwo(startValue, insertions);
+        uint64_t PartTwo(Input const& input)
+        {
+            std::map<std::tuple<char, char, int>, ElementCounts> known;
+            ElementCounts counts{};
+            auto const& start = input.start;
+            for (std::size_t i = 0; i < start.size(); ++i)
+            {
+                counts[static_cast<unsigned char>(start[i])]++;
+                if (i + 1 < start.size())
+                {
+                    auto grown = GrowBetween(input.insertions, start[i], start[i + 1], 40, known);
+                    for (std::size_t c = 0; c < counts.size(); ++c)
+                    {
+                        counts[c] += grown[c];
+                    }
+                }
+            }
+            uint64_t most = 0;
+            uint64_t least = std::numeric_limits<uint64_t>::max();
+            for (auto count : counts)
+            {
+                if (count > 0)
+                {
+                    most = std::max(most, count);
+                    least = std::min(least, count);
+                }
+            }
+            return most - least;
+        }
+    }
 }
-
@@ -0,0 +1,46 @@
+// Day14.h : Extended Polymerization. Grows the polymer and counts its elements.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "Common/FlatHash.h"
+#include "Common/Input.h"
+
+namespace Day14
+{
+    using InsertionMap = Common::FlatMap<std::pair<char, char>, char>;
+
+    struct Input
+    {
+        std::string start;
+        InsertionMap insertions;
+    };
+
+    template<typename Archive>
+    void Serialise(Archive& archive, Input& input)
+    {
+        archive(input.start, input.insertions);
+    }
+
+    std::string ReadStart(Common::LineReader& lines);
+    InsertionMap ReadInsertions(Common::LineReader& lines);
+    Input ReadInput(std::string_view text);
+
+    // Both return the difference between the most and least common elements.
+    int PartOne(Input const& input);
+    uint64_t PartTwo(Input const& input);
+
+    // The straightforward versions the faster ones are checked against (aoc_diff).
+    namespace Reference
+    {
+        // Builds the whole polymer string rather than counting pairs.
+        int PartOne(Input const& input);
+        // Counts what grows between each pair of the template, one pair and
+        // depth at a time, remembered in a std::map.
+        uint64_t PartTwo(Input const& input);
+    }
+}
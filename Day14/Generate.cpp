@@ -0,0 +1,32 @@
+// Generate.cpp : Writes a Day14 input of any size: the template, then a rule for every pair.
+//   Day14_gen [template length] [--scale=F] [--seed=N]
+
+#include <iostream>
+#include <string>
+
+#include "Common/Generator.h"
+
+int main(int argc, char* argv[])
+{
+    Common::Generator gen{ argc, argv, 20 };
+
+    // ten elements, like the puzzle
+    std::string elements = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    gen.Shuffle(elements);
+    elements.resize(10);
+
+    std::string polymer(gen.Size(), ' ');
+    for (auto& c : polymer)
+    {
+        c = elements[gen.Uniform<std::size_t>(0, elements.size() - 1)];
+    }
+    std::cout << polymer << "\n\n";
+
+    for (auto first : elements)
+    {
+        for (auto second : elements)
+        {
+            std::cout << first << second << " -> " << elements[gen.Uniform<std::size_t>(0, elements.size() - 1)] << "\n";
+        }
+    }
+}
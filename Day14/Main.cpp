@@ -0,0 +1,28 @@
+#include <iostream>
+
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/Input.h"
+#include "Common/ParseCache.h"
+#include "Day14.h"
+
+int main(int argc, char* argv[])
+{
+    if (auto batch = Common::ReadBatchOptions(argc, argv); batch.enabled)
+    {
+        return Common::RunBatch(batch, Day14::ReadInput, Day14::PartOne, Day14::PartTwo);
+    }
+
+    Common::Benchmark bench{ argc, argv };
+    Common::ParseCache cache{ argc, argv };
+    auto buffer = Common::InputBuffer::FromCommandLine(argc, argv);
+    auto input = bench.Measure("parse", [&] { return cache.Read("Day14", buffer.Text(), Day14::ReadInput); }, { .bytes = buffer.Size() });
+
+    auto partOne = bench.Measure("part one", [&] { return Day14::PartOne(input); }, { .items = 10 });
+    std::cout << "Part One Difference between most and least common chars: " << partOne << "\n";
+
+    auto partTwo = bench.Measure("part two", [&] { return Day14::PartTwo(input); }, { .items = 40 });
+    std::cout << "Part Two Difference between most and least common chars: " << partTwo << "\n";
+
+    bench.Report(std::cout);
+}
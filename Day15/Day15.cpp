@@ -1,225 +1,361 @@
+#include "Day15.h"
+
 #include <algorithm>
-#include <iostream>
+#include <cmath>
+#include <limits>
 #include <map>
-#include <string>
-#include <sstream>
-#include <vector>
-
-using Grid = std::vector<std::vector<int>>;
-
-struct Point
-{
-    int x;
-    int y;
-    auto operator<=>(const Point&) const = default;
-};
-auto DistanceBetween(Point a, Point b)
-{
-    auto xDist = b.x - a.x;
-    auto yDist = b.y - a.y;
-
-    auto distSqrd = (xDist * xDist) + (yDist * yDist);
-    auto distance = sqrt(distSqrd);
-    return static_cast<int>(distance);
-}
+#include <queue>
+#include <stdexcept>
+#include <utility>
 
+#include "Common/FlatHash.h"
+#include "Common/Input.h"
+#include "Common/MemoryReport.h"
+#include "Common/Trace.h"
 
-auto ReadInput()
+namespace Day15
 {
-    Grid result;
-
-    std::string inLine;
-    while (std::getline(std::cin, inLine))
+    auto DistanceBetween(Point a, Point b)
     {
-        if (inLine.empty())
-            break;
+        auto xDist = b.x - a.x;
+        auto yDist = b.y - a.y;
 
-        std::stringstream in{ inLine };
-        std::vector<int> row{ std::istreambuf_iterator<char>{ in }, {} };
-        std::transform(row.begin(), row.end(), row.begin(), [](int v) { return v - '0'; });
-        result.push_back(row);
+        auto distSqrd = (xDist * xDist) + (yDist * yDist);
+        auto distance = sqrt(distSqrd);
+        return static_cast<int>(distance);
     }
 
-    return result;
-}
-
-struct Node
-{
-    Point position;
-    Point parentPosition;
-    int fScore;
-    int hScore;
-    int gScore;
-};
-
-auto Neighbours(Grid const& map, Point pos)
-{
-    std::vector<Point> result;
 
-    if (pos.x > 0)
-    {
-        result.emplace_back(pos.x - 1, pos.y);
-    }
-    if (pos.x < map[0].size() - 1)
-    {
-        result.emplace_back(pos.x + 1, pos.y);
-    }
-    if (pos.y > 0)
-    {
-        result.emplace_back(pos.x, pos.y - 1);
-    }
-    if (pos.y < map.size() - 1)
+    Input ReadInput(std::string_view text)
     {
-        result.emplace_back(pos.x, pos.y + 1);
-    }
-    return result;
-}
+        std::vector<std::string_view> rows;
 
-auto FindPath(Grid const& map, Point start, Point end)
-{
-    std::vector<Node> openSet;
-    std::map<Point, Point> closedSet;
-    auto foundEnd = false;
+        Common::LineReader lines{ text };
+        std::string_view inLine;
+        while (lines.Next(inLine))
+        {
+            if (inLine.empty())
+                break;
 
-    openSet.emplace_back(start, Point{ -1, -1 }, 0, DistanceBetween(start, end), 0);
+            rows.push_back(inLine);
+        }
 
-    while (!foundEnd && !openSet.empty())
-    {
-        auto currentIt = std::min_element(openSet.begin(), openSet.end(),
-            [](auto const& a, auto const& b)
+        Grid result(rows.empty() ? 0 : static_cast<int>(rows[0].size()), static_cast<int>(rows.size()));
+        for (int y = 0; y < result.Height(); ++y)
+        {
+            if (rows[y].size() != rows[0].size())
             {
-                return a.fScore < b.fScore;
-            });
-        auto current = *currentIt;
-        openSet.erase(currentIt);
-        closedSet.insert(std::make_pair(current.position, current.parentPosition));
+                throw std::runtime_error("Every row of the risk map must be as wide as the first");
+            }
+            std::transform(rows[y].begin(), rows[y].end(), result.Row(y).begin(), [](char c) { return c - '0'; });
+        }
+        return result;
+    }
+
+    struct Node
+    {
+        Point position;
+        Point parentPosition;
+        int fScore;
+        int hScore;
+        int gScore;
+    };
+
+    auto Neighbours(Grid const& map, Point pos)
+    {
+        std::vector<Point> result;
 
-        if (current.position == end)
+        if (pos.x > 0)
+        {
+            result.emplace_back(pos.x - 1, pos.y);
+        }
+        if (pos.x < map.Width() - 1)
+        {
+            result.emplace_back(pos.x + 1, pos.y);
+        }
+        if (pos.y > 0)
+        {
+            result.emplace_back(pos.x, pos.y - 1);
+        }
+        if (pos.y < map.Height() - 1)
         {
-            foundEnd = true;
-            break;
+            result.emplace_back(pos.x, pos.y + 1);
         }
+        return result;
+    }
 
-        auto neighbours = Neighbours(map, current.position);
-        for (auto const& n : neighbours)
+    std::vector<Point> FindPath(Grid const& map, Point start, Point end)
+    {
+        AOC_TRACE_SCOPE("Day15 FindPath");
+        // lowest fScore on top; a node whose position is found again more
+        // cheaply is left in the queue and skipped once that position is closed
+        auto higherScore = [](Node const& a, Node const& b) { return a.fScore > b.fScore; };
+        std::priority_queue<Node, std::vector<Node>, decltype(higherScore)> openSet{ higherScore };
+        Grid bestGScore(map.Width(), map.Height(), std::numeric_limits<int>::max());
+        Common::FlatMap<Point, Point> closedSet;
+        auto foundEnd = false;
+
+        openSet.push({ start, Point{ -1, -1 }, DistanceBetween(start, end), DistanceBetween(start, end), 0 });
+        bestGScore(start.x, start.y) = 0;
+
+        while (!foundEnd && !openSet.empty())
         {
-            if (closedSet.contains(n))
+            auto current = openSet.top();
+            openSet.pop();
+            if (!closedSet.insert(std::make_pair(current.position, current.parentPosition)).second)
             {
-                // already checked this one
                 continue;
             }
+            AOC_TRACE_COUNT("Day15 nodes expanded", 1);
 
-            int moveScore = map[n.y][n.x];
-            int gScore = current.gScore + moveScore;
+            if (current.position == end)
+            {
+                foundEnd = true;
+                break;
+            }
 
-            auto it = std::find_if(openSet.begin(), openSet.end(),
-                [&n](auto const& node)
-                {
-                    return node.position == n;
-                });
-            if (it != openSet.end())
+            auto neighbours = Neighbours(map, current.position);
+            for (auto const& n : neighbours)
             {
-                if (it->gScore > gScore)
+                if (closedSet.contains(n))
+                {
+                    // already checked this one
+                    continue;
+                }
+
+                int moveScore = map(n.x, n.y);
+                int gScore = current.gScore + moveScore;
+                if (gScore < bestGScore(n.x, n.y))
                 {
-                    // path through current node is the better way to position n
-                    it->gScore = gScore;
-                    it->fScore = gScore + it->hScore;
-                    it->parentPosition = current.position;
+                    // the best way to n found so far
+                    bestGScore(n.x, n.y) = gScore;
+                    auto hScore = DistanceBetween(n, end);
+                    openSet.push({ n, current.position, gScore + hScore, hScore, gScore });
                 }
             }
-            else
+        }
+        AOC_NOTE_FOOTPRINT("best g scores", bestGScore);
+        AOC_NOTE_FOOTPRINT("closed set", closedSet);
+
+        std::vector<Point> path;
+        if (foundEnd)
+        {
+            auto curPos = end;
+            auto parentPos = closedSet[curPos];
+
+            while (parentPos != Point{ -1, -1 })
             {
-                auto hScore = DistanceBetween(n, end);
-                openSet.emplace_back(n, current.position, gScore + hScore, hScore, gScore);
+                path.insert(path.begin(), curPos);
+
+                curPos = parentPos;
+                parentPos = closedSet[curPos];
             }
         }
+        return path;
     }
 
-    std::vector<Point> path;
-    if (foundEnd)
+    int ScorePath(Grid const& map, std::vector<Point> const& path)
     {
-        auto curPos = end;
-        auto parentPos = closedSet[curPos];
-
-        while (parentPos != Point{ -1, -1 })
+        int score = 0;
+        for (auto const& p : path)
         {
-            path.insert(path.begin(), curPos);
-
-            curPos = parentPos;
-            parentPos = closedSet[curPos];
+            score += map(p.x, p.y);
         }
+        return score;
     }
-    return path;
-}
 
-auto ScorePath(Grid const& map, std::vector<Point> const& path)
-{
-    int score = 0;
-    for (auto const& p : path)
+    Grid ExpandMap(Grid const& map)
     {
-        score += map[p.y][p.x];
-    }
-    return score;
-}
+        int const width = map.Width();
+        int const height = map.Height();
+        Grid newMap(width * 5, height * 5);
 
-auto IncrementVector(std::vector<int> v)
-{
-    std::transform(v.begin(), v.end(), v.begin(),
-        [](int i) { return i == 9 ? 1 : i + 1; });
-    return v;
-}
+        for (int tileY = 0; tileY < 5; ++tileY)
+        {
+            for (int tileX = 0; tileX < 5; ++tileX)
+            {
+                // risk goes up by one for each tile away from the original, wrapping 9 round to 1
+                auto tile = newMap.Tile(tileX * width, tileY * height, width, height);
+                int const increase = tileX + tileY;
+                for (int y = 0; y < height; ++y)
+                {
+                    auto from = map.Row(y);
+                    std::transform(from.begin(), from.end(), tile.Row(y).begin(),
+                        [increase](int risk) { return (risk - 1 + increase) % 9 + 1; });
+                }
+            }
+        }
 
-auto ExpandRow(std::vector<int> row)
-{
-    std::vector<int> result = row;
+        return newMap;
+    }
 
-    for (int i = 0; i < 4; ++i)
+    int PartOne(Input const& input)
     {
-        row = IncrementVector(std::move(row));
-        result.insert(result.end(), row.begin(), row.end());
-    }
-    return result;
-}
+        auto mapWidth = input.Width();
+        auto mapHeight = input.Height();
 
-auto ExpandMap(Grid const& map)
-{
-    Grid newMap;
-    auto originalHeight = map.size();
+        auto path = FindPath(input, { 0, 0 }, { mapWidth - 1, mapHeight - 1 });
+        return ScorePath(input, path);
+    }
 
-    for (auto const& r : map)
+    int PartTwo(Input const& input)
     {
-        auto newRow = ExpandRow(r);
-        newMap.push_back(newRow);
+        auto bigMap = ExpandMap(input);
+        AOC_NOTE_FOOTPRINT("expanded map", bigMap);
+        auto mapWidth = bigMap.Width();
+        auto mapHeight = bigMap.Height();
+
+        auto bigPath = FindPath(bigMap, { 0, 0 }, { mapWidth - 1, mapHeight - 1 });
+        return ScorePath(bigMap, bigPath);
     }
 
-    for (int i = 0; i < 4; ++i)
+    namespace Reference
     {
-        for (int j = 0; j < originalHeight; ++j)
+        Input ReadInput(std::string_view text)
         {
-            auto newRow = IncrementVector(newMap[(i * originalHeight) + j]);
-            newMap.push_back(newRow);
+            Grid result;
+
+            Common::LineReader lines{ text };
+            std::string_view inLine;
+            while (lines.Next(inLine))
+            {
+                if (inLine.empty())
+                    break;
+
+                std::vector<int> row(inLine.size());
+                std::transform(inLine.begin(), inLine.end(), row.begin(), [](char c) { return c - '0'; });
+                result.push_back(std::move(row));
+            }
+
+            return result;
         }
-    }
 
-    return newMap;
-}
+        auto Neighbours(Grid const& map, Point pos)
+        {
+            std::vector<Point> result;
 
-int main()
-{
-    auto map = ReadInput();
-    auto mapWidth = static_cast<int>(map[0].size());
-    auto mapHeight = static_cast<int>(map.size());
+            if (pos.x > 0)
+            {
+                result.push_back({ pos.x - 1, pos.y });
+            }
+            if (pos.x < static_cast<int>(map[0].size()) - 1)
+            {
+                result.push_back({ pos.x + 1, pos.y });
+            }
+            if (pos.y > 0)
+            {
+                result.push_back({ pos.x, pos.y - 1 });
+            }
+            if (pos.y < static_cast<int>(map.size()) - 1)
+            {
+                result.push_back({ pos.x, pos.y + 1 });
+            }
+            return result;
+        }
+
+        // The lowest total risk from the top left to the bottom right.
+        int LowestRisk(Grid const& map)
+        {
+            Point const start{ 0, 0 };
+            Point const end{ static_cast<int>(map[0].size()) - 1, static_cast<int>(map.size()) - 1 };
+            std::vector<Node> openSet;
+            std::map<Point, Point> closedSet;
+            auto foundEnd = false;
+
+            openSet.push_back({ start, Point{ -1, -1 }, 0, DistanceBetween(start, end), 0 });
+
+            while (!openSet.empty())
+            {
+                auto currentIt = std::min_element(openSet.begin(), openSet.end(),
+                    [](auto const& a, auto const& b)
+                    {
+                        return a.fScore < b.fScore;
+                    });
+                auto current = *currentIt;
+                openSet.erase(currentIt);
+                closedSet.insert(std::make_pair(current.position, current.parentPosition));
+
+                if (current.position == end)
+                {
+                    foundEnd = true;
+                    break;
+                }
 
-    auto path = FindPath(map, { 0, 0 }, { mapWidth - 1, mapHeight - 1 });
+                for (auto const& n : Neighbours(map, current.position))
+                {
+                    if (closedSet.contains(n))
+                    {
+                        continue;
+                    }
+
+                    int gScore = current.gScore + map[n.y][n.x];
+                    auto it = std::find_if(openSet.begin(), openSet.end(),
+                        [&n](auto const& node)
+                        {
+                            return node.position == n;
+                        });
+                    if (it == openSet.end())
+                    {
+                        auto hScore = DistanceBetween(n, end);
+                        openSet.push_back({ n, current.position, gScore + hScore, hScore, gScore });
+                    }
+                    else if (it->gScore > gScore)
+                    {
+                        it->gScore = gScore;
+                        it->fScore = gScore + it->hScore;
+                        it->parentPosition = current.position;
+                    }
+                }
+            }
+
+            int risk = 0;
+            if (foundEnd)
+            {
+                for (auto pos = end; pos != start; pos = closedSet[pos])
+                {
+                    risk += map[pos.y][pos.x];
+                }
+            }
+            return risk;
+        }
 
-    auto riskScore = ScorePath(map, path);
+        auto IncrementVector(std::vector<int> v)
+        {
+            std::transform(v.begin(), v.end(), v.begin(),
+                [](int i) { return i == 9 ? 1 : i + 1; });
+            return v;
+        }
 
-    std::cout << "Part one risk score of path: " << riskScore << "\n";
+        Grid ExpandMap(Grid const& map)
+        {
+            Grid newMap;
+            for (auto row : map)
+            {
+                std::vector<int> newRow = row;
+                for (int i = 0; i < 4; ++i)
+                {
+                    row = IncrementVector(std::move(row));
+                    newRow.insert(newRow.end(), row.begin(), row.end());
+                }
+                newMap.push_back(std::move(newRow));
+            }
 
-    auto bigMap = ExpandMap(map);
+            auto const originalHeight = map.size();
+            for (std::size_t i = 0; i < 4 * originalHeight; ++i)
+            {
+                newMap.push_back(IncrementVector(newMap[i]));
+            }
+            return newMap;
+        }
 
-    auto bigPath = FindPath(bigMap, { 0, 0 }, { (mapWidth * 5) - 1, (mapHeight * 5) - 1 });
-    auto bigRiskScore = ScorePath(bigMap, bigPath);
+        int PartOne(Input const& input)
+        {
+            return LowestRisk(input);
+        }
 
-    std::cout << "Part two risk score of path: " << bigRiskScore << "\n";
+        int PartTwo(Input const& input)
+        {
+            return LowestRisk(ExpandMap(input));
+        }
+    }
 }
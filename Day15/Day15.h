@@ -0,0 +1,48 @@
+// Day15.h : Chiton. Finds the lowest risk path across the cave.
+
+#pragma once
+
+#include <compare>
+#include <string_view>
+#include <vector>
+
+#include "Common/Grid2D.h"
+
+namespace Day15
+{
+    // Risk levels indexed (x, y).
+    using Grid = Common::Grid2D<int>;
+    using Input = Grid;
+
+    struct Point
+    {
+        int x;
+        int y;
+        auto operator<=>(const Point&) const = default;
+    };
+
+    Input ReadInput(std::string_view text);
+
+    // The path from start to end, not including start. Empty if end can't be reached.
+    std::vector<Point> FindPath(Grid const& map, Point start, Point end);
+    int ScorePath(Grid const& map, std::vector<Point> const& path);
+
+    // Tiles the map five times in each direction, with the risk rising in each tile.
+    Grid ExpandMap(Grid const& map);
+
+    int PartOne(Input const& input);
+    int PartTwo(Input const& input);
+
+    // The straightforward versions the faster ones are checked against (aoc_diff).
+    namespace Reference
+    {
+        // Risk levels indexed [y][x], searched with a std::map of visited points.
+        using Grid = std::vector<std::vector<int>>;
+        using Input = Grid;
+
+        Input ReadInput(std::string_view text);
+
+        int PartOne(Input const& input);
+        int PartTwo(Input const& input);
+    }
+}
@@ -0,0 +1,22 @@
+// Generate.cpp : Writes a Day15 input of any size, a square map of risk levels.
+//   Day15_gen [side] [--scale=F] [--seed=N]
+
+#include <iostream>
+#include <string>
+
+#include "Common/Generator.h"
+
+int main(int argc, char* argv[])
+{
+    Common::Generator gen{ argc, argv, 100 };
+
+    std::string row(gen.Size(), '1');
+    for (std::size_t y = 0; y < gen.Size(); ++y)
+    {
+        for (auto& c : row)
+        {
+            c = static_cast<char>('0' + gen.Uniform(1, 9));
+        }
+        std::cout << row << "\n";
+    }
+}
@@ -0,0 +1,32 @@
+#include <cstddef>
+#include <iostream>
+
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/Input.h"
+#include "Common/ParseCache.h"
+#include "Day15.h"
+
+int main(int argc, char* argv[])
+{
+    if (auto batch = Common::ReadBatchOptions(argc, argv); batch.enabled)
+    {
+        return Common::RunBatch(batch, Day15::ReadInput, Day15::PartOne, Day15::PartTwo);
+    }
+
+    Common::Benchmark bench{ argc, argv };
+    Common::ParseCache cache{ argc, argv };
+    auto buffer = Common::InputBuffer::FromCommandLine(argc, argv);
+    auto map = bench.Measure("parse", [&] { return cache.Read("Day15", buffer.Text(), Day15::ReadInput); }, { .bytes = buffer.Size() });
+    auto cells = map.Size();
+
+    auto riskScore = bench.Measure("part one", [&] { return Day15::PartOne(map); }, { .items = cells });
+
+    std::cout << "Part one risk score of path: " << riskScore << "\n";
+
+    auto bigRiskScore = bench.Measure("part two", [&] { return Day15::PartTwo(map); }, { .items = cells * 25 });
+
+    std::cout << "Part two risk score of path: " << bigRiskScore << "\n";
+
+    bench.Report(std::cout);
+}
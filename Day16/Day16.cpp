@@ -1,261 +1,328 @@
+#include "Day16.h"
+
+#include <algorithm>
 #include <array>
-#include <exception>
-#include <iostream>
 #include <iterator>
-#include <memory>
+#include <stdexcept>
 #include <string>
-#include <vector>
-
-struct Packet
-{
-    Packet(int v, int t)
-        : version{ v },
-        type{ t }
-    {}
-    virtual ~Packet() {}
-
-    virtual int SumVersions() const = 0;
-    virtual int64_t ExpressionValue() const = 0;
 
-    int version;
-    int type;
-};
+#include "Common/Input.h"
+#include "Common/Trace.h"
 
-struct LiteralValue : Packet
+namespace Day16
 {
-    LiteralValue(int v, int t, int64_t val)
-        : Packet{ v, t },
-        value{ val }
-    {}
-
-    int SumVersions() const override { return version; }
-    int64_t ExpressionValue() const override { return value; }
-
-    int64_t value;
-};
-
-struct Operator : Packet
-{
-    Operator(int v, int t, std::vector<std::unique_ptr<Packet>> sub)
-        : Packet{ v, t },
-        subpackets{ std::move(sub) }
-    {}
-
-    int SumVersions() const override
+    std::array<uint8_t, 4> HexCharToBits(char c)
     {
-        int sum = 0;
-        for (auto const& p : subpackets)
+        switch (c)
         {
-            sum += p->SumVersions();
+        case '0':
+            return { 0,0,0,0 };
+        case '1':
+            return { 0,0,0,1 };
+        case '2':
+            return { 0,0,1,0 };
+        case '3':
+            return { 0,0,1,1 };
+        case '4':
+            return { 0,1,0,0 };
+        case '5':
+            return { 0,1,0,1 };
+        case '6':
+            return { 0,1,1,0 };
+        case '7':
+            return { 0,1,1,1 };
+        case '8':
+            return { 1,0,0,0 };
+        case '9':
+            return { 1,0,0,1 };
+        case 'A': case 'a':
+            return { 1,0,1,0 };
+        case 'B': case 'b':
+            return { 1,0,1,1 };
+        case 'C': case 'c':
+            return { 1,1,0,0 };
+        case 'D': case 'd':
+            return { 1,1,0,1 };
+        case 'E': case 'e':
+            return { 1,1,1,0 };
+        case 'F': case 'f':
+            return { 1,1,1,1 };
+        default:
+            throw std::runtime_error(std::string("Unrecgonised hex character: ") + c);
         }
-        return sum + version;
     }
-    int64_t ExpressionValue() const override
+
+    std::vector<uint8_t> InputToBits(std::string_view input)
     {
-        switch (type)
-        {
-        case 0: // sum
+        std::vector<uint8_t> bits;
+
+        for (auto const& c : input)
         {
-            int64_t sum = 0;
-            for (auto const& p : subpackets)
-            {
-                sum += p->ExpressionValue();
-            }
-            return sum;
+            auto newBits = HexCharToBits(c);
+            bits.insert(bits.end(), newBits.begin(), newBits.end());
         }
-        case 1: // product
+        return bits;
+    }
+
+    auto BitsToValue(std::input_iterator auto first, std::input_iterator auto last)
+    {
+        int value = 0;
+        while (first != last)
         {
-            int64_t prod = 1;
-            for (auto const& p : subpackets)
-            {
-                prod *= p->ExpressionValue();
-            }
-            return prod;
+            value = (value << 1) + *first;
+            ++first;
         }
-        case 2: // minimum
+        return value;
+    }
+
+
+
+    // Decodes up to packetLimit packets into the arena. Each level's packets
+    // go on the end of pending until they're all read, then are copied into
+    // the arena in one block for their operator to point at.
+    std::span<Packet const* const> BitsToPackets(std::input_iterator auto &first, std::input_iterator auto last, int packetLimit, Common::Arena& arena, std::vector<Packet const*>& pending)
+    {
+        auto levelStart = pending.size();
+
+        while (std::distance(first, last) > 10 && packetLimit > 0)
         {
-            int64_t min = std::numeric_limits<int64_t>::max();
-            for (auto const& p : subpackets)
+            AOC_TRACE_COUNT("Day16 packets decoded", 1);
+            --packetLimit;
+            auto version = BitsToValue(first, first + 3);
+            std::advance(first, 3);
+            auto type = BitsToValue(first, first + 3);
+            std::advance(first, 3);
+
+            if (type == 4)
             {
-                auto val = p->ExpressionValue();
-                if (val < min)
+                // literal
+                int64_t val = 0;
+                int notLast = 0;
+                do
                 {
-                    min = val;
-                }
+                    notLast = *first;
+                    ++first;
+                    auto nextVal = BitsToValue(first, first + 4);
+                    val = (val << 4) + nextVal;
+                    std::advance(first, 4);
+                } while (notLast != 0);
+                pending.push_back(arena.Create<LiteralValue>(version, type, val));
             }
-            return min;
-        }
-        case 3: // maximum
-        {
-            int64_t max = std::numeric_limits<int>::min();
-            for (auto const& p : subpackets)
+            else
             {
-                auto val = p->ExpressionValue();
-                if (val > max)
+                // operator
+                auto lengthType = *first;
+                ++first;
+                if (lengthType == 0)
                 {
-                    max = val;
+                    auto subPacketBits = BitsToValue(first, first + 15);
+                    std::advance(first, 15);
+                    auto subStart = first;
+                    auto subPackets = BitsToPackets(subStart, first + subPacketBits, std::numeric_limits<int>::max(), arena, pending);
+                    std::advance(first, subPacketBits);
+                    pending.push_back(arena.Create<Operator>(version, type, subPackets));
+                }
+                else
+                {
+                    auto subPacketCount = BitsToValue(first, first + 11);
+                    std::advance(first, 11);
+                    auto subStart = first;
+                    auto subPackets = BitsToPackets(subStart, last, subPacketCount, arena, pending);
+                    first = subStart;
+                    pending.push_back(arena.Create<Operator>(version, type, subPackets));
                 }
             }
-            return max;
-        }
-        case 5: // greater than
-        {
-            return subpackets[0]->ExpressionValue() > subpackets[1]->ExpressionValue() ? 1 : 0;
         }
-        case 6: // less than
-        {
-            return subpackets[0]->ExpressionValue() < subpackets[1]->ExpressionValue() ? 1 : 0;
-        }
-        case 7: // equal
-        {
-            return subpackets[0]->ExpressionValue() == subpackets[1]->ExpressionValue() ? 1 : 0;
-        }
-        }
-        return 0;
-    }
 
-    std::vector<std::unique_ptr<Packet>> subpackets;
-};
+        auto level = arena.CopyOf(std::span<Packet const* const>{ pending }.subspan(levelStart));
+        pending.resize(levelStart);
+        return level;
+    }
 
-std::array<uint8_t, 4> HexCharToBits(char c)
-{
-    switch (c)
+    Input ReadInput(std::string_view text)
     {
-    case '0':
-        return { 0,0,0,0 };
-    case '1':
-        return { 0,0,0,1 };
-    case '2':
-        return { 0,0,1,0 };
-    case '3':
-        return { 0,0,1,1 };
-    case '4':
-        return { 0,1,0,0 };
-    case '5':
-        return { 0,1,0,1 };
-    case '6':
-        return { 0,1,1,0 };
-    case '7':
-        return { 0,1,1,1 };
-    case '8':
-        return { 1,0,0,0 };
-    case '9':
-        return { 1,0,0,1 };
-    case 'A': case 'a':
-        return { 1,0,1,0 };
-    case 'B': case 'b':
-        return { 1,0,1,1 };
-    case 'C': case 'c':
-        return { 1,1,0,0 };
-    case 'D': case 'd':
-        return { 1,1,0,1 };
-    case 'E': case 'e':
-        return { 1,1,1,0 };
-    case 'F': case 'f':
-        return { 1,1,1,1 };
-    default:
-        throw std::runtime_error(std::string("Unrecgonised hex character: ") + c);
-    }
-}
+        Common::LineReader lines{ text };
 
-auto InputToBits(std::string const& input)
-{
-    std::vector<uint8_t> bits;
+        std::string_view input;
+        lines.Next(input);
 
-    for (auto const& c : input)
-    {
-        auto newBits = HexCharToBits(c);
-        bits.insert(bits.end(), newBits.begin(), newBits.end());
+        AOC_TRACE_SCOPE("Day16 decode packets");
+        auto bits = InputToBits(input);
+
+        Input result;
+        std::vector<Packet const*> pending;
+        auto first = bits.begin();
+        result.packets = BitsToPackets(first, bits.end(), std::numeric_limits<int>::max(), result.arena, pending);
+        return result;
     }
-    return bits;
-}
 
-auto BitsToValue(std::input_iterator auto first, std::input_iterator auto last)
-{
-    int value = 0;
-    while (first != last)
+    int PartOne(Input const& input)
     {
-        value = (value << 1) + *first;
-        ++first;
+        AOC_TRACE_SCOPE("Day16 SumVersions");
+        return input.packets[0]->SumVersions();
     }
-    return value;
-}
 
+    int64_t PartTwo(Input const& input)
+    {
+        AOC_TRACE_SCOPE("Day16 ExpressionValue");
+        return input.packets[0]->ExpressionValue();
+    }
 
+    namespace Reference
+    {
+        struct LiteralValue : Packet
+        {
+            LiteralValue(int v, int t, int64_t val)
+                : Packet{ v, t },
+                value{ val }
+            {}
 
-std::vector<std::unique_ptr<Packet>> BitsToPackets(std::input_iterator auto &first, std::input_iterator auto last, int packetLimit)
-{
-    std::vector<std::unique_ptr<Packet>> result;
+            int SumVersions() const override { return version; }
+            int64_t ExpressionValue() const override { return value; }
 
-    while (std::distance(first, last) > 10 && packetLimit > 0)
-    {
-        --packetLimit;
-        auto version = BitsToValue(first, first + 3);
-        std::advance(first, 3);
-        auto type = BitsToValue(first, first + 3);
-        std::advance(first, 3);
+            int64_t value;
+        };
 
-        if (type == 4)
+        struct Operator : Packet
         {
-            // literal
-            int64_t val = 0;
-            int notLast = 0;
-            do
-            {
-                notLast = *first;
-                ++first;
-                auto nextVal = BitsToValue(first, first + 4);
-                val = (val << 4) + nextVal;
-                std::advance(first, 4);
-            } while (notLast != 0);
-            auto packet = std::make_unique<LiteralValue>(version, type, val);
-            result.push_back(std::move(packet));
-        }
-        else
-        {
-            // operator
-            auto lengthType = *first;
-            ++first;
-            if (lengthType == 0)
+            Operator(int v, int t, std::vector<std::unique_ptr<Packet>> sub)
+                : Packet{ v, t },
+                subpackets{ std::move(sub) }
+            {}
+
+            int SumVersions() const override
             {
-                auto subPacketBits = BitsToValue(first, first + 15);
-                std::advance(first, 15);
-                auto subStart = first;
-                auto subPackets = BitsToPackets(subStart, first + subPacketBits, std::numeric_limits<int>::max());
-                std::advance(first, subPacketBits);
-                auto packet = std::make_unique<Operator>(version, type, std::move(subPackets));
-                result.push_back(std::move(packet));
+                int sum = 0;
+                for (auto const& p : subpackets)
+                {
+                    sum += p->SumVersions();
+                }
+                return sum + version;
             }
-            else
+            int64_t ExpressionValue() const override
             {
-                auto subPacketCount = BitsToValue(first, first + 11);
-                std::advance(first, 11);
-                auto subStart = first;
-                auto subPackets = BitsToPackets(subStart, last, subPacketCount);
-                first = subStart;
-
-                auto packet = std::make_unique<Operator>(version, type, std::move(subPackets));
-                result.push_back(std::move(packet));
+                switch (type)
+                {
+                case 0: // sum
+                {
+                    int64_t sum = 0;
+                    for (auto const& p : subpackets)
+                    {
+                        sum += p->ExpressionValue();
+                    }
+                    return sum;
+                }
+                case 1: // product
+                {
+                    int64_t prod = 1;
+                    for (auto const& p : subpackets)
+                    {
+                        prod *= p->ExpressionValue();
+                    }
+                    return prod;
+                }
+                case 2: // minimum
+                {
+                    int64_t min = std::numeric_limits<int64_t>::max();
+                    for (auto const& p : subpackets)
+                    {
+                        min = std::min(min, p->ExpressionValue());
+                    }
+                    return min;
+                }
+                case 3: // maximum
+                {
+                    int64_t max = std::numeric_limits<int>::min();
+                    for (auto const& p : subpackets)
+                    {
+                        max = std::max(max, p->ExpressionValue());
+                    }
+                    return max;
+                }
+                case 5: // greater than
+                    return subpackets[0]->ExpressionValue() > subpackets[1]->ExpressionValue() ? 1 : 0;
+                case 6: // less than
+                    return subpackets[0]->ExpressionValue() < subpackets[1]->ExpressionValue() ? 1 : 0;
+                case 7: // equal
+                    return subpackets[0]->ExpressionValue() == subpackets[1]->ExpressionValue() ? 1 : 0;
+                }
+                return 0;
             }
-        }
-    }
 
-    return result;
-}
+            std::vector<std::unique_ptr<Packet>> subpackets;
+        };
 
-int main()
-{
-    std::string input;
-    std::getline(std::cin, input);
+        Input BitsToPackets(std::input_iterator auto &first, std::input_iterator auto last, int packetLimit)
+        {
+            Input result;
 
-    auto bits = InputToBits(input);
+            while (std::distance(first, last) > 10 && packetLimit > 0)
+            {
+                --packetLimit;
+                auto version = BitsToValue(first, first + 3);
+                std::advance(first, 3);
+                auto type = BitsToValue(first, first + 3);
+                std::advance(first, 3);
 
-    auto first = bits.begin();
-    auto packets = BitsToPackets(first, bits.end(), std::numeric_limits<int>::max());
+                if (type == 4)
+                {
+                    // literal
+                    int64_t val = 0;
+                    int notLast = 0;
+                    do
+                    {
+                        notLast = *first;
+                        ++first;
+                        auto nextVal = BitsToValue(first, first + 4);
+                        val = (val << 4) + nextVal;
+                        std::advance(first, 4);
+                    } while (notLast != 0);
+                    result.push_back(std::make_unique<LiteralValue>(version, type, val));
+                }
+                else if (*first++ == 0)
+                {
+                    // operator with its subpackets' length in bits
+                    auto subPacketBits = BitsToValue(first, first + 15);
+                    std::advance(first, 15);
+                    auto subStart = first;
+                    auto subPackets = BitsToPackets(subStart, first + subPacketBits, std::numeric_limits<int>::max());
+                    std::advance(first, subPacketBits);
+                    result.push_back(std::make_unique<Operator>(version, type, std::move(subPackets)));
+                }
+                else
+                {
+                    // operator with its number of subpackets
+                    auto subPacketCount = BitsToValue(first, first + 11);
+                    std::advance(first, 11);
+                    auto subStart = first;
+                    auto subPackets = BitsToPackets(subStart, last, subPacketCount);
+                    first = subStart;
+                    result.push_back(std::make_unique<Operator>(version, type, std::move(subPackets)));
+                }
+            }
+
+            return result;
+        }
+
+        Input ReadInput(std::string_view text)
+        {
+            Common::LineReader lines{ text };
+            std::string_view input;
+            lines.Next(input);
+
+            auto bits = InputToBits(input);
+            auto first = bits.begin();
+            return BitsToPackets(first, bits.end(), std::numeric_limits<int>::max());
+        }
 
-    auto versionSum = packets[0]->SumVersions();
-    std::cout << "Sum of packet versions: " << versionSum << "\n";
+        int PartOne(Input const& input)
+        {
+            return input[0]->SumVersions();
+        }
 
-    auto exprValue = packets[0]->ExpressionValue();
-    std::cout << "Value of expression: " << exprValue << "\n";
+        int64_t PartTwo(Input const& input)
+        {
+            return input[0]->ExpressionValue();
+        }
+    }
 }
@@ -0,0 +1,170 @@
+// Day16.h : Packet Decoder. Decodes the BITS transmission into a tree of packets.
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "Common/Arena.h"
+
+namespace Day16
+{
+    // Packets live in an arena and are never deleted one at a time.
+    struct Packet
+    {
+        Packet(int v, int t)
+            : version{ v },
+            type{ t }
+        {}
+
+        virtual int SumVersions() const = 0;
+        virtual int64_t ExpressionValue() const = 0;
+
+        int version;
+        int type;
+
+    protected:
+        ~Packet() = default;
+    };
+
+    struct LiteralValue : Packet
+    {
+        LiteralValue(int v, int t, int64_t val)
+            : Packet{ v, t },
+            value{ val }
+        {}
+
+        int SumVersions() const override { return version; }
+        int64_t ExpressionValue() const override { return value; }
+
+        int64_t value;
+    };
+
+    struct Operator : Packet
+    {
+        Operator(int v, int t, std::span<Packet const* const> sub)
+            : Packet{ v, t },
+            subpackets{ sub }
+        {}
+
+        int SumVersions() const override
+        {
+            int sum = 0;
+            for (auto const& p : subpackets)
+            {
+                sum += p->SumVersions();
+            }
+            return sum + version;
+        }
+        int64_t ExpressionValue() const override
+        {
+            switch (type)
+            {
+            case 0: // sum
+            {
+                int64_t sum = 0;
+                for (auto const& p : subpackets)
+                {
+                    sum += p->ExpressionValue();
+                }
+                return sum;
+            }
+            case 1: // product
+            {
+                int64_t prod = 1;
+                for (auto const& p : subpackets)
+                {
+                    prod *= p->ExpressionValue();
+                }
+                return prod;
+            }
+            case 2: // minimum
+            {
+                int64_t min = std::numeric_limits<int64_t>::max();
+                for (auto const& p : subpackets)
+                {
+                    auto val = p->ExpressionValue();
+                    if (val < min)
+                    {
+                        min = val;
+                    }
+                }
+                return min;
+            }
+            case 3: // maximum
+            {
+                int64_t max = std::numeric_limits<int>::min();
+                for (auto const& p : subpackets)
+                {
+                    auto val = p->ExpressionValue();
+                    if (val > max)
+                    {
+                        max = val;
+                    }
+                }
+                return max;
+            }
+            case 5: // greater than
+            {
+                return subpackets[0]->ExpressionValue() > subpackets[1]->ExpressionValue() ? 1 : 0;
+            }
+            case 6: // less than
+            {
+                return subpackets[0]->ExpressionValue() < subpackets[1]->ExpressionValue() ? 1 : 0;
+            }
+            case 7: // equal
+            {
+                return subpackets[0]->ExpressionValue() == subpackets[1]->ExpressionValue() ? 1 : 0;
+            }
+            }
+            return 0;
+        }
+
+        std::span<Packet const* const> subpackets;
+    };
+
+    struct Input
+    {
+        // Holds every packet, so the whole tree goes in one go.
+        Common::Arena arena;
+        // The outermost packets of the transmission.
+        std::span<Packet const* const> packets;
+    };
+
+    std::vector<uint8_t> InputToBits(std::string_view input);
+    Input ReadInput(std::string_view text);
+
+    int PartOne(Input const& input);
+    int64_t PartTwo(Input const& input);
+
+    // The straightforward versions the faster ones are checked against (aoc_diff).
+    namespace Reference
+    {
+        // Each operator owns its subpackets through unique_ptrs, made one at a time.
+        struct Packet
+        {
+            Packet(int v, int t)
+                : version{ v },
+                type{ t }
+            {}
+            virtual ~Packet() {}
+
+            virtual int SumVersions() const = 0;
+            virtual int64_t ExpressionValue() const = 0;
+
+            int version;
+            int type;
+        };
+
+        using Input = std::vector<std::unique_ptr<Packet>>;
+
+        Input ReadInput(std::string_view text);
+
+        int PartOne(Input const& input);
+        int64_t PartTwo(Input const& input);
+    }
+}
@@ -0,0 +1,115 @@
+// Generate.cpp : Writes a Day16 input of any size, one hexadecimal transmission.
+//   Day16_gen [packets] [--scale=F] [--seed=N]
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Common/Generator.h"
+
+void AppendBits(std::string& bits, std::uint64_t value, int count)
+{
+    for (int i = count - 1; i >= 0; --i)
+    {
+        bits += (value >> i) & 1 ? '1' : '0';
+    }
+}
+
+std::string Literal(Common::Generator& gen, std::uint64_t value)
+{
+    std::string bits;
+    AppendBits(bits, gen.Uniform(0, 7), 3);
+    AppendBits(bits, 4, 3);
+    int groups = 1;
+    while (groups < 16 && (value >> (4 * groups)) != 0)
+    {
+        ++groups;
+    }
+    for (int g = groups - 1; g >= 0; --g)
+    {
+        bits += g > 0 ? '1' : '0';
+        AppendBits(bits, value >> (4 * g), 4);
+    }
+    return bits;
+}
+
+std::string Operator(Common::Generator& gen, int type, std::vector<std::string> const& children)
+{
+    std::string body;
+    for (auto const& child : children)
+    {
+        body += child;
+    }
+
+    std::string bits;
+    AppendBits(bits, gen.Uniform(0, 7), 3);
+    AppendBits(bits, type, 3);
+    if (body.size() < (1u << 15) && gen.Chance(0.5))
+    {
+        bits += '0';
+        AppendBits(bits, body.size(), 15);
+    }
+    else
+    {
+        bits += '1';
+        AppendBits(bits, children.size(), 11);
+    }
+    return bits + body;
+}
+
+// A tree of about this many packets. Products only take literals so the
+// expression can't overflow however big the tree gets.
+std::string Packets(Common::Generator& gen, std::size_t count)
+{
+    if (count <= 1)
+    {
+        return Literal(gen, gen.Uniform(0, 4095));
+    }
+    if (count <= 4 && gen.Chance(0.3))
+    {
+        std::vector<std::string> factors;
+        for (std::size_t i = 1; i < count; ++i)
+        {
+            factors.push_back(Literal(gen, gen.Uniform(1, 255)));
+        }
+        return Operator(gen, 1, factors);
+    }
+
+    // sum, minimum and maximum take any number of packets, comparisons exactly two
+    static int const types[] = { 0, 2, 3, 5, 6, 7 };
+    auto type = count >= 3 ? types[gen.Uniform(0, 5)] : types[gen.Uniform(0, 2)];
+    auto children = type >= 5 ? 2 : gen.Uniform<std::size_t>(1, std::min<std::size_t>(count - 1, 8));
+
+    // share out what's left between the children, at least one each
+    std::vector<std::size_t> sizes(children, 1);
+    for (std::size_t i = children; i < count - 1; ++i)
+    {
+        ++sizes[gen.Uniform<std::size_t>(0, children - 1)];
+    }
+    std::vector<std::string> subpackets;
+    for (auto size : sizes)
+    {
+        subpackets.push_back(Packets(gen, size));
+    }
+    return Operator(gen, type, subpackets);
+}
+
+int main(int argc, char* argv[])
+{
+    Common::Generator gen{ argc, argv, 250 };
+
+    auto bits = Packets(gen, gen.Size());
+    while (bits.size() % 4 != 0)
+    {
+        bits += '0';
+    }
+
+    std::string hex;
+    hex.reserve(bits.size() / 4);
+    for (std::size_t i = 0; i < bits.size(); i += 4)
+    {
+        hex += "0123456789ABCDEF"[std::stoi(bits.substr(i, 4), nullptr, 2)];
+    }
+    std::cout << hex << "\n";
+}
@@ -0,0 +1,26 @@
+#include <iostream>
+
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/Input.h"
+#include "Day16.h"
+
+int main(int argc, char* argv[])
+{
+    if (auto batch = Common::ReadBatchOptions(argc, argv); batch.enabled)
+    {
+        return Common::RunBatch(batch, Day16::ReadInput, Day16::PartOne, Day16::PartTwo);
+    }
+
+    Common::Benchmark bench{ argc, argv };
+    auto buffer = Common::InputBuffer::FromCommandLine(argc, argv);
+    auto packets = bench.Measure("parse", [&] { return Day16::ReadInput(buffer.Text()); }, { .bytes = buffer.Size() });
+
+    auto versionSum = bench.Measure("part one", [&] { return Day16::PartOne(packets); });
+    std::cout << "Sum of packet versions: " << versionSum << "\n";
+
+    auto exprValue = bench.Measure("part two", [&] { return Day16::PartTwo(packets); });
+    std::cout << "Value of expression: " << exprValue << "\n";
+
+    bench.Report(std::cout);
+}
@@ -1,129 +1,90 @@
-#include <iostream>
-#include <regex>
+#include "Day17.h"
+
+#include <algorithm>
+#include <cstdio>
 #include <string>
+#include <vector>
 
-struct Point
-{
-    int x;
-    int y;
-    auto operator<=>(const Point&) const = default;
-};
+#include "Common/Trace.h"
 
-struct BoundingBox
+namespace Day17
 {
-    BoundingBox(Point pos, Point s)
-        : position{ pos },
-        size{ s }
-    {}
-
-    Point const position;
-    Point const size;
-
-    bool Contains(Point const& p) const noexcept
+    ProbeResults TryAllVelocities(BoundingBox const& targetField)
     {
-        auto inWidth = position.x <= p.x && p.x <= (position.x + size.x);
-        auto inHeight = position.y <= p.y && p.y <= (position.y + size.y);
-        return inWidth && inHeight;
+        AOC_TRACE_SCOPE("Day17 TryAllVelocities");
+        return SearchVelocities(targetField);
     }
-};
-
-auto ReadInput()
-{
-    std::string line;
-    std::getline(std::cin, line);
 
-    std::regex regex(R"(target area: x=(\d+)\.\.(\d+), y=(-?\d+)\.\.(-?\d+))");
-
-    std::smatch matches;
-    if (std::regex_match(line, matches, regex))
+    int PartOne(Input const& input)
     {
-        if (matches.size() == 5)
-        {
-            auto x1 = std::stoi(matches[1].str());
-            auto x2 = std::stoi(matches[2].str());
-            auto y1 = std::stoi(matches[3].str());
-            auto y2 = std::stoi(matches[4].str());
-
-            return BoundingBox{ Point{x1, y1}, Point{x2 - x1, y2 - y1} };
-        }
+        return TryAllVelocities(input).maxHeight;
     }
-    throw std::runtime_error("Input not recognised");
-}
 
-bool HasOverShot(BoundingBox const& box, Point const& p)
-{
-    if (p.x > box.position.x + box.size.x)
-        return true;
-    if (p.y < box.position.y)
-        return true;
-    return false;
-}
-
-std::pair<bool, int> TryVelocity(BoundingBox const& targetField, Point const & startVelocity)
-{
-    Point position{ 0,0 };
-    Point velocity = startVelocity;
-    int maxHeight = 0;
-
-    while (!targetField.Contains(position) && !HasOverShot(targetField, position))
+    int PartTwo(Input const& input)
     {
-        position.x += velocity.x;
-        position.y += velocity.y;
+        return TryAllVelocities(input).totalHits;
+    }
 
-        if (position.y > maxHeight)
+    namespace Reference
+    {
+        Input ReadInput(std::string_view text)
         {
-            maxHeight = position.y;
+            std::string line{ text.substr(0, text.find('\n')) };
+            int x1 = 0;
+            int x2 = 0;
+            int y1 = 0;
+            int y2 = 0;
+            if (std::sscanf(line.c_str(), "target area: x=%d..%d, y=%d..%d", &x1, &x2, &y1, &y2) != 4)
+            {
+                throw std::runtime_error("Input not recognised");
+            }
+            return BoundingBox{ Point{ x1, y1 }, Point{ x2 - x1, y2 - y1 } };
         }
 
-        if (velocity.x > 0)
-        {
-            velocity.x -= 1;
-        }
-        else if (velocity.x < 0)
+        // Where the probe is after steps steps, drag stopping it at vx.
+        Point PositionAfter(Point velocity, int steps)
         {
-            velocity.x += 1;
+            int moving = std::min(steps, velocity.x);
+            return { moving * velocity.x - moving * (moving - 1) / 2, steps * velocity.y - steps * (steps - 1) / 2 };
         }
 
-        velocity.y -= 1;
-
-    }
-    if (targetField.Contains(position))
-    {
-        //std::cout << "Start velocity: (" << startVelocity.x << ", " << startVelocity.y << ")\n";
-        //std::cout << "Reached target area! Maximum height reached: " << maxHeight << " \n";
-        return { true, maxHeight };
-    }
-    else
-    {
-        return { false, maxHeight };
-    }
-}
-
-int main()
-{
-    auto targetField = ReadInput();
-
-    int maxHorizontalVelocity = targetField.position.x + targetField.size.x;
-    int minVerticalVelocity = targetField.position.y;
-    int maxVerticalVelocity = std::abs(targetField.position.y);
-
-    int maxHeight = 0;
-    int totalHits = 0;
-    for (int x = 0; x <= maxHorizontalVelocity; ++x)
-    {
-        for (int y = minVerticalVelocity; y <= maxVerticalVelocity; ++y)
+        // The upward velocity of each launch that hits, for a target below
+        // and to the right of the start.
+        std::vector<int> HittingUpwardVelocities(Input const& input)
         {
-            auto [hit, height] = TryVelocity(targetField, { x,y });
-            if (hit)
+            int right = input.position.x + input.size.x;
+            int bottom = input.position.y;
+            std::vector<int> hits;
+            for (int vx = 0; vx <= right; ++vx)
             {
-                ++totalHits;
-                if (height > maxHeight)
+                for (int vy = bottom; vy <= -bottom; ++vy)
                 {
-                    maxHeight = height;
+                    for (int step = 0; PositionAfter({ vx, vy }, step).y >= bottom; ++step)
+                    {
+                        if (input.Contains(PositionAfter({ vx, vy }, step)))
+                        {
+                            hits.push_back(vy);
+                            break;
+                        }
+                    }
                 }
             }
+            return hits;
+        }
+
+        int PartOne(Input const& input)
+        {
+            int highest = 0;
+            for (auto vy : HittingUpwardVelocities(input))
+            {
+                highest = std::max(highest, vy * (vy + 1) / 2);
+            }
+            return highest;
+        }
+
+        int PartTwo(Input const& input)
+        {
+            return static_cast<int>(HittingUpwardVelocities(input).size());
         }
     }
-    std::cout << "Max height reached from any start velocity: " << maxHeight << "\n";
-    std::cout << "Total number of velocities that hit the target: " << totalHits << "\n";
 }
@@ -0,0 +1,151 @@
+// Day17.h : Trick Shot. Searches the launch velocities that land the probe in the target.
+
+#pragma once
+
+#include <compare>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include "Common/Input.h"
+#include "Common/Pattern.h"
+#include "Common/Trace.h"
+
+namespace Day17
+{
+    struct Point
+    {
+        int x;
+        int y;
+        auto operator<=>(const Point&) const = default;
+    };
+
+    struct BoundingBox
+    {
+        constexpr BoundingBox(Point pos, Point s)
+            : position{ pos },
+            size{ s }
+        {}
+
+        Point const position;
+        Point const size;
+
+        constexpr bool Contains(Point const& p) const noexcept
+        {
+            auto inWidth = position.x <= p.x && p.x <= (position.x + size.x);
+            auto inHeight = position.y <= p.y && p.y <= (position.y + size.y);
+            return inWidth && inHeight;
+        }
+    };
+
+    struct ProbeResults
+    {
+        int maxHeight;
+        int totalHits;
+    };
+
+    using Input = BoundingBox;
+
+    // ReadInput and SearchVelocities can be run by the compiler, for AOC_EMBED_INPUTS.
+    constexpr Input ReadInput(std::string_view text)
+    {
+        Common::LineReader lines{ text };
+        std::string_view line;
+        lines.Next(line);
+
+        int x1 = 0;
+        int x2 = 0;
+        int y1 = 0;
+        int y2 = 0;
+        if (Common::Match<"target area: x={}..{}, y={}..{}">(line, x1, x2, y1, y2))
+        {
+            return BoundingBox{ Point{x1, y1}, Point{x2 - x1, y2 - y1} };
+        }
+        throw std::runtime_error("Input not recognised");
+    }
+
+    constexpr bool HasOverShot(BoundingBox const& box, Point const& p) noexcept
+    {
+        if (p.x > box.position.x + box.size.x)
+            return true;
+        if (p.y < box.position.y)
+            return true;
+        return false;
+    }
+
+    constexpr std::pair<bool, int> TryVelocity(BoundingBox const& targetField, Point const & startVelocity) noexcept
+    {
+        AOC_TRACE_COUNT_CONSTEXPR("Day17 velocities tried", 1);
+        Point position{ 0,0 };
+        Point velocity = startVelocity;
+        int maxHeight = 0;
+
+        while (!targetField.Contains(position) && !HasOverShot(targetField, position))
+        {
+            AOC_TRACE_COUNT_CONSTEXPR("Day17 probe steps", 1);
+            position.x += velocity.x;
+            position.y += velocity.y;
+
+            if (position.y > maxHeight)
+            {
+                maxHeight = position.y;
+            }
+
+            if (velocity.x > 0)
+            {
+                velocity.x -= 1;
+            }
+            else if (velocity.x < 0)
+            {
+                velocity.x += 1;
+            }
+
+            velocity.y -= 1;
+
+        }
+        return { targetField.Contains(position), maxHeight };
+    }
+
+    constexpr ProbeResults SearchVelocities(BoundingBox const& targetField) noexcept
+    {
+        int maxHorizontalVelocity = targetField.position.x + targetField.size.x;
+        int minVerticalVelocity = targetField.position.y;
+        int maxVerticalVelocity = targetField.position.y < 0 ? -targetField.position.y : targetField.position.y;
+
+        int maxHeight = 0;
+        int totalHits = 0;
+        for (int x = 0; x <= maxHorizontalVelocity; ++x)
+        {
+            for (int y = minVerticalVelocity; y <= maxVerticalVelocity; ++y)
+            {
+                auto [hit, height] = TryVelocity(targetField, { x,y });
+                if (hit)
+                {
+                    ++totalHits;
+                    if (height > maxHeight)
+                    {
+                        maxHeight = height;
+                    }
+                }
+            }
+        }
+        return { maxHeight, totalHits };
+    }
+
+    // both parts come out of the same search over every start velocity
+    ProbeResults TryAllVelocities(BoundingBox const& targetField);
+
+    int PartOne(Input const& input);
+    int PartTwo(Input const& input);
+
+    // The straightforward versions the faster ones are checked against (aoc_diff).
+    namespace Reference
+    {
+        // Reads the target with std::sscanf.
+        Input ReadInput(std::string_view text);
+        // Both work out where the probe is after each step from the sums of
+        // its velocities, rather than stepping it.
+        int PartOne(Input const& input);
+        int PartTwo(Input const& input);
+    }
+}
@@ -0,0 +1,30 @@
+// Generate.cpp : Writes a Day17 input of any size, a target area.
+//   Day17_gen [depth] [--scale=F] [--seed=N]
+//
+// The target sits about depth below the launcher and twice that away from it.
+
+#include <iostream>
+
+#include "Common/Generator.h"
+
+int main(int argc, char* argv[])
+{
+    Common::Generator gen{ argc, argv, 100 };
+    int const size = static_cast<int>(gen.Size());
+
+    // leave a triangular number in the x range, so a probe can stall over the target
+    int stall = 1;
+    int const reach = gen.Uniform(size, 2 * size);
+    while (stall * (stall + 1) / 2 < reach)
+    {
+        ++stall;
+    }
+    int const centre = stall * (stall + 1) / 2;
+    int x1 = std::max(1, centre - gen.Uniform(0, size / 2));
+    int x2 = centre + gen.Uniform(0, size / 2);
+
+    int y1 = -gen.Uniform(size, 3 * size / 2);
+    int y2 = std::min(-1, y1 + gen.Uniform(size / 4, size / 2));
+
+    std::cout << "target area: x=" << x1 << ".." << x2 << ", y=" << y1 << ".." << y2 << "\n";
+}
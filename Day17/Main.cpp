@@ -0,0 +1,43 @@
+#include <iostream>
+
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/Input.h"
+#include "Day17.h"
+
+#ifdef AOC_EMBEDDED_INPUT
+#include "EmbeddedInput.h"
+#endif
+
+int main(int argc, char* argv[])
+{
+    if (auto batch = Common::ReadBatchOptions(argc, argv); batch.enabled)
+    {
+        return Common::RunBatch(batch, Day17::ReadInput, Day17::PartOne, Day17::PartTwo);
+    }
+
+    if (Common::EmbeddedRequested(argc, argv))
+    {
+#ifdef AOC_EMBEDDED_INPUT
+        // worked out by the compiler
+        constexpr auto results = Day17::SearchVelocities(Day17::ReadInput(Common::EmbeddedInput));
+        std::cout << "Max height reached from any start velocity: " << results.maxHeight << "\n";
+        std::cout << "Total number of velocities that hit the target: " << results.totalHits << "\n";
+        return 0;
+#else
+        std::cerr << "Day17 was built without an embedded input, configure with -DAOC_EMBED_INPUTS=ON\n";
+        return 1;
+#endif
+    }
+
+    Common::Benchmark bench{ argc, argv };
+    auto buffer = Common::InputBuffer::FromCommandLine(argc, argv);
+    auto targetField = bench.Measure("parse", [&] { return Day17::ReadInput(buffer.Text()); }, { .bytes = buffer.Size() });
+
+    auto [maxHeight, totalHits] = bench.Measure("both parts", [&] { return Day17::TryAllVelocities(targetField); });
+
+    std::cout << "Max height reached from any start velocity: " << maxHeight << "\n";
+    std::cout << "Total number of velocities that hit the target: " << totalHits << "\n";
+
+    bench.Report(std::cout);
+}
@@ -1,535 +1,848 @@
+#include "Day18.h"
+
+#include <algorithm>
+#include <cctype>
 #include <iostream>
-#include <memory>
 #include <optional>
-#include <sstream>
+#include <stdexcept>
 #include <string>
-#include <vector>
+#include <utility>
 
-enum class NumberType
-{
-    Pair,
-    Regular
-};
+#include "Common/Input.h"
+#include "Common/Trace.h"
 
-class FishNumber abstract
-{
-public:
-    virtual ~FishNumber() {};
-
-    virtual void Print(std::ostream& out) const = 0;
-    virtual uint64_t Magnitude() const noexcept = 0;
-    virtual NumberType Type() const noexcept = 0;
-    virtual std::unique_ptr<FishNumber> Copy() const = 0;
-    virtual std::unique_ptr<FishNumber> CopyAddingToLeft(int val) const = 0;
-    virtual std::unique_ptr<FishNumber> CopyAddingToRight(int val) const = 0;
-    virtual std::unique_ptr<FishNumber> Split() const = 0;
-};
-
-std::ostream& operator<<(std::ostream& out, FishNumber const& number)
+namespace Day18
 {
-    number.Print(out);
-    return out;
-}
-
-struct ExplodeResult
-{
-    std::unique_ptr<FishNumber> newNumber;
-    int addLeft;
-    int addRight;
-};
-
-class FishPair : public FishNumber
-{
-public:
-    FishPair(std::unique_ptr<FishNumber> l, std::unique_ptr<FishNumber> r)
-        : left{ std::move(l) },
-        right{ std::move(r) }
-    {}
-
-    void Print(std::ostream& out) const override
+    std::ostream& operator<<(std::ostream& out, FishNumber const& number)
     {
-        out << "[";
-        left->Print(out);
-        out << ",";
-        right->Print(out);
-        out << "]";
+        number.Print(out);
+        return out;
     }
 
-    uint64_t Magnitude() const noexcept override
+    struct ExplodeResult
     {
-        return 3 * left->Magnitude() + 2 * right->Magnitude();
-    }
-    NumberType Type() const noexcept override
-    {
-        return NumberType::Pair;
-    }
+        FishNumber const* newNumber;
+        int addLeft;
+        int addRight;
+    };
 
-    std::unique_ptr<FishNumber> Copy() const override
-    {
-        return std::make_unique<FishPair>(
-            left->Copy(),
-            right->Copy());
-    }
-    std::unique_ptr<FishNumber> CopyAddingToLeft(int val) const override
+    class FishPair : public FishNumber
     {
-        return std::make_unique<FishPair>(
-            left->CopyAddingToLeft(val),
-            right->Copy());
-    }
-    std::unique_ptr<FishNumber> CopyAddingToRight(int val) const override
-    {
-        return std::make_unique<FishPair>(
-            left->Copy(),
-            right->CopyAddingToRight(val));
-    }
+    public:
+        FishPair(FishNumber const* l, FishNumber const* r)
+            : left{ l },
+            right{ r }
+        {}
 
-    std::unique_ptr<FishNumber> Split() const override
-    {
-        auto leftResult = left->Split();
-        if (leftResult)
+        void Print(std::ostream& out) const override
         {
-            return std::make_unique<FishPair>(
-                std::move(leftResult),
-                right->Copy());
+            out << "[";
+            left->Print(out);
+            out << ",";
+            right->Print(out);
+            out << "]";
         }
-        auto rightResult = right->Split();
-        if (rightResult)
+
+        uint64_t Magnitude() const noexcept override
         {
-            return std::make_unique<FishPair>(
-                left->Copy(),
-                std::move(rightResult));
+            return 3 * left->Magnitude() + 2 * right->Magnitude();
+        }
+        NumberType Type() const noexcept override
+        {
+            return NumberType::Pair;
         }
-        return nullptr;
-    }
 
-    ExplodeResult Explode(int curDepth, int maxDepth);
+        FishNumber const* Copy(Common::Arena& arena) const override
+        {
+            return arena.Create<FishPair>(
+                left->Copy(arena),
+                right->Copy(arena));
+        }
+        FishNumber const* CopyAddingToLeft(Common::Arena& arena, int val) const override
+        {
+            if (val == 0)
+            {
+                return this;
+            }
+            return arena.Create<FishPair>(
+                left->CopyAddingToLeft(arena, val),
+                right);
+        }
+        FishNumber const* CopyAddingToRight(Common::Arena& arena, int val) const override
+        {
+            if (val == 0)
+            {
+                return this;
+            }
+            return arena.Create<FishPair>(
+                left,
+                right->CopyAddingToRight(arena, val));
+        }
 
-private:
-    std::unique_ptr<FishNumber> left;
-    std::unique_ptr<FishNumber> right;
-};
+        FishNumber const* Split(Common::Arena& arena) const override
+        {
+            auto leftResult = left->Split(arena);
+            if (leftResult)
+            {
+                return arena.Create<FishPair>(
+                    leftResult,
+                    right);
+            }
+            auto rightResult = right->Split(arena);
+            if (rightResult)
+            {
+                return arena.Create<FishPair>(
+                    left,
+                    rightResult);
+            }
+            return nullptr;
+        }
 
-class RegularNumber : public FishNumber
-{
-public:
-    explicit RegularNumber(int val)
-        : value{ val }
-    {}
+        ExplodeResult Explode(Common::Arena& arena, int curDepth, int maxDepth) const;
 
-    void Print(std::ostream &out) const override
-    {
-        out << value;
-    }
+    private:
+        FishNumber const* left;
+        FishNumber const* right;
+    };
 
-    uint64_t Magnitude() const noexcept override
-    {
-        return value;
-    }
-    NumberType Type() const noexcept override
+    class RegularNumber : public FishNumber
     {
-        return NumberType::Regular;
-    }
+    public:
+        explicit RegularNumber(int val)
+            : value{ val }
+        {}
 
-    std::unique_ptr<FishNumber> Copy() const override
-    {
-        return std::make_unique<RegularNumber>(value);
-    }
-    std::unique_ptr<FishNumber> CopyAddingToLeft(int val) const override
-    {
-        return std::make_unique<RegularNumber>(value + val);
-    }
-    std::unique_ptr<FishNumber> CopyAddingToRight(int val) const override
-    {
-        return std::make_unique<RegularNumber>(value + val);
-    }
+        void Print(std::ostream &out) const override
+        {
+            out << value;
+        }
 
-    std::unique_ptr<FishNumber> Split() const override
-    {
-        if (value >= 10)
+        uint64_t Magnitude() const noexcept override
         {
-            auto newLeft = value / 2;
-            auto newRight = (value / 2) + (value % 2);
-            return std::make_unique<FishPair>(
-                std::make_unique<RegularNumber>(newLeft),
-                std::make_unique<RegularNumber>(newRight));
+            return value;
+        }
+        NumberType Type() const noexcept override
+        {
+            return NumberType::Regular;
         }
-        return nullptr;
-    }
 
-private:
-    int const value;
-};
+        FishNumber const* Copy(Common::Arena& arena) const override
+        {
+            return arena.Create<RegularNumber>(value);
+        }
+        FishNumber const* CopyAddingToLeft(Common::Arena& arena, int val) const override
+        {
+            return arena.Create<RegularNumber>(value + val);
+        }
+        FishNumber const* CopyAddingToRight(Common::Arena& arena, int val) const override
+        {
+            return arena.Create<RegularNumber>(value + val);
+        }
 
-ExplodeResult FishPair::Explode(int curDepth, int maxDepth)
-{
-    if (curDepth >= maxDepth)
-    {
-        // do the explode - this pair will only have regular numbers in it
-        return
+        FishNumber const* Split(Common::Arena& arena) const override
         {
-            std::make_unique<RegularNumber>(0),
-            static_cast<int>(left->Magnitude()),
-            static_cast<int>(right->Magnitude())
-        };
-    }
-    else
+            if (value >= 10)
+            {
+                auto newLeft = value / 2;
+                auto newRight = (value / 2) + (value % 2);
+                return arena.Create<FishPair>(
+                    arena.Create<RegularNumber>(newLeft),
+                    arena.Create<RegularNumber>(newRight));
+            }
+            return nullptr;
+        }
+
+    private:
+        int const value;
+    };
+
+    ExplodeResult FishPair::Explode(Common::Arena& arena, int curDepth, int maxDepth) const
     {
-        // do left or right need to explode?
-        if (left->Type() == NumberType::Pair)
+        if (curDepth >= maxDepth)
         {
-            auto leftResult = (static_cast<FishPair&>(*left)).Explode(curDepth + 1, maxDepth);
-            if (leftResult.newNumber)
+            // do the explode - this pair will only have regular numbers in it
+            return
             {
-                // there was an explosion
-                // copy the right side with addRight
-                // return new pair along with addLeft (addRight now 0)
-                return
-                {
-                    std::make_unique<FishPair>(
-                        std::move(leftResult.newNumber),
-                        right->CopyAddingToLeft(leftResult.addRight)),
-                    leftResult.addLeft,
-                    0
-                };
-            }
+                arena.Create<RegularNumber>(0),
+                static_cast<int>(left->Magnitude()),
+                static_cast<int>(right->Magnitude())
+            };
         }
-        if (right->Type() == NumberType::Pair)
+        else
         {
-            auto rightResult = (static_cast<FishPair&>(*right)).Explode(curDepth + 1, maxDepth);
-            if (rightResult.newNumber)
+            // do left or right need to explode?
+            if (left->Type() == NumberType::Pair)
             {
-                // there was an explosion
-                // copy the left side with addLeft
-                // return the new pair along with addRight (addLeft now 0)
-                return
+                auto leftResult = (static_cast<FishPair const&>(*left)).Explode(arena, curDepth + 1, maxDepth);
+                if (leftResult.newNumber)
                 {
-                    std::make_unique<FishPair>(
-                        left->CopyAddingToRight(rightResult.addLeft),
-                        std::move(rightResult.newNumber)),
-                    0,
-                    rightResult.addRight
-                };
+                    // there was an explosion
+                    // rework the right side with addRight
+                    // return new pair along with addLeft (addRight now 0)
+                    return
+                    {
+                        arena.Create<FishPair>(
+                            leftResult.newNumber,
+                            right->CopyAddingToLeft(arena, leftResult.addRight)),
+                        leftResult.addLeft,
+                        0
+                    };
+                }
             }
+            if (right->Type() == NumberType::Pair)
+            {
+                auto rightResult = (static_cast<FishPair const&>(*right)).Explode(arena, curDepth + 1, maxDepth);
+                if (rightResult.newNumber)
+                {
+                    // there was an explosion
+                    // rework the left side with addLeft
+                    // return the new pair along with addRight (addLeft now 0)
+                    return
+                    {
+                        arena.Create<FishPair>(
+                            left->CopyAddingToRight(arena, rightResult.addLeft),
+                            rightResult.newNumber),
+                        0,
+                        rightResult.addRight
+                    };
+                }
+            }
+            // nothing to do
+            return
+            {
+                nullptr,
+                0,
+                0
+            };
         }
-        // nothing to do
-        return
+    }
+
+    FishNumber const* ExplodeNumber(Common::Arena& arena, FishNumber const* number, bool &didExplode)
+    {
+        if (number->Type() == NumberType::Pair)
         {
-            nullptr,
-            0,
-            0
-        };
+            auto result = (static_cast<FishPair const&>(*number)).Explode(arena, 0, 4);
+            if (result.newNumber)
+            {
+                didExplode = true;
+                return result.newNumber;
+            }
+        }
+        didExplode = false;
+        return number;
     }
-}
 
-auto ExplodeNumber(std::unique_ptr<FishNumber> number, bool &didExplode)
-{
-    if (number->Type() == NumberType::Pair)
+    FishNumber const* SplitNumber(Common::Arena& arena, FishNumber const* number, bool &didSplit)
     {
-        auto result = (static_cast<FishPair&>(*number)).Explode(0, 4);
-        if (result.newNumber)
+        auto splitResult = number->Split(arena);
+        if (splitResult)
         {
-            didExplode = true;
-            return std::move(result.newNumber);
+            didSplit = true;
+            return splitResult;
         }
+        didSplit = false;
+        return number;
     }
-    didExplode = false;
-    return number;
-}
 
-auto SplitNumber(std::unique_ptr<FishNumber> number, bool &didSplit)
-{
-    auto splitResult = number->Split();
-    if (splitResult)
+    FishNumber const* ReduceNumber(Common::Arena& arena, FishNumber const* number)
     {
-        didSplit = true;
-        return splitResult;
+        AOC_TRACE_COUNT("Day18 additions", 1);
+        bool hasReduced = false;
+        do
+        {
+            AOC_TRACE_COUNT("Day18 reduce loops", 1);
+            bool didExplode{ false };
+            number = ExplodeNumber(arena, number, didExplode);
+
+            if (!didExplode)
+            {
+                bool didSplit{ false };
+                number = SplitNumber(arena, number, didSplit);
+                hasReduced = didSplit;
+                AOC_TRACE_COUNT("Day18 splits", didSplit ? 1 : 0);
+            }
+            else
+            {
+                AOC_TRACE_COUNT("Day18 explodes", 1);
+                hasReduced = true;
+            }
+        } while (hasReduced);
+        return number;
     }
-    didSplit = false;
-    return number;
-}
 
-auto ReduceNumber(std::unique_ptr<FishNumber> number)
-{
-    bool hasReduced = false;
-    do
+    FishNumber const* AddFishNumbers(Common::Arena& arena, FishNumber const* left, FishNumber const* right)
+    {
+        return ReduceNumber(arena, arena.Create<FishPair>(
+            left,
+            right));
+    }
+
+    enum class TokenType
+    {
+        End,
+        Number,
+        Comma = ',',
+        LB = '[',
+        RB = ']'
+    };
+
+    struct Token
+    {
+        TokenType type{ TokenType::End };
+        std::optional<int> value;
+    };
+
+    class Lexer
     {
-        bool didExplode{ false };
-        number = ExplodeNumber(std::move(number), didExplode);
+    public:
+        explicit Lexer(std::string_view in)
+            : input{ in }
+        {}
 
-        if (!didExplode)
+        Token GetToken()
         {
-            bool didSplit{ false };
-            number = SplitNumber(std::move(number), didSplit);
-            hasReduced = didSplit;
+            char ch = 0;
+            do
+            {
+                if (input.empty())
+                {
+                    return Token{ TokenType::End, {} };
+                }
+                ch = input.front();
+                input.remove_prefix(1);
+            } while (ch != '\n' && isspace(ch));
+            switch (ch)
+            {
+            case '[':
+            case ']':
+            case ',':
+                return Token{ TokenType{ch}, {} };
+            case '0':
+            case '1':
+            case '2':
+            case '3':
+            case '4':
+            case '5':
+            case '6':
+            case '7':
+            case '8':
+            case '9':
+            {
+                int number = ch - '0';
+                while (!input.empty() && isdigit(input.front()))
+                {
+                    number = (number * 10) + (input.front() - '0');
+                    input.remove_prefix(1);
+                }
+                return Token{ TokenType::Number, number };
+            }
+            default:
+                throw std::runtime_error(std::string{ "Bad token in input: " } + ch);
+            }
         }
-        else
+
+    private:
+        std::string_view input;
+    };
+
+    class Parser
+    {
+    public:
+        Parser(std::string_view in, Common::Arena& a)
+            : lexer{ in },
+            arena{ a }
+        {}
+
+        FishNumber const* Result()
         {
-            hasReduced = true;
+            currentToken = lexer.GetToken();
+
+            return ReadPair();
         }
-    } while (hasReduced);
-    return number;
-}
 
-auto AddFishNumbers(std::unique_ptr<FishNumber> left, std::unique_ptr<FishNumber> right)
-{
-    return ReduceNumber(std::make_unique<FishPair>(
-        std::move(left),
-        std::move(right)));
-}
+    private:
 
-enum class TokenType
-{
-    End,
-    Number,
-    Comma = ',',
-    LB = '[',
-    RB = ']'
-};
-
-struct Token
-{
-    TokenType type{ TokenType::End };
-    std::optional<int> value;
-};
+        FishNumber const* ReadPair()
+        {
+            if (currentToken.type != TokenType::LB)
+            {
 
-class Lexer
-{
-public:
-    explicit Lexer(std::string const &in)
-        : input{ in },
-        stream{ input }
-    {}
+            }
+            auto left = ReadSub();
+            currentToken = lexer.GetToken(); // ,
+            auto right = ReadSub();
+            currentToken = lexer.GetToken(); // ]
+
+            return arena.Create<FishPair>(
+                left,
+                right);
+        }
 
-    Token GetToken()
-    {
-        char ch = 0;
-        do
+        FishNumber const* ReadSub()
         {
-            if (!stream.get(ch))
+            currentToken = lexer.GetToken();
+            if (currentToken.type == TokenType::LB)
             {
-                return Token{ TokenType::End };
+                return ReadPair();
+            }
+            else if (currentToken.type == TokenType::Number)
+            {
+                return arena.Create<RegularNumber>(currentToken.value.value());
+            }
+            else
+            {
+                throw std::runtime_error("Unexpected token type in input");
             }
-        } while (ch != '\n' && isspace(ch));
-        switch (ch)
-        {
-        case '[':
-        case ']':
-        case ',':
-            return Token{ TokenType{ch} };
-        case '0':
-        case '1':
-        case '2':
-        case '3':
-        case '4':
-        case '5':
-        case '6':
-        case '7':
-        case '8':
-        case '9':
-        {
-            stream.putback(ch);
-            int number;
-            stream >> number;
-            return Token{ TokenType::Number, number };
-        }
-        default:
-            throw std::runtime_error(std::string{ "Bad token in input: " } + ch);
         }
-    }
 
-private:
-    std::string const input;
-    std::stringstream stream;
-};
+        Lexer lexer;
+        Token currentToken;
+        Common::Arena& arena;
+    };
 
-class Parser
-{
-public:
-    explicit Parser(std::string const& in)
-        : lexer{ in }
-    {}
-
-    std::unique_ptr<FishNumber> Result()
+    void TestOne()
     {
-        currentToken = lexer.GetToken();
+        std::cout << "Test one\n";
+        Common::Arena arena;
+
+        Parser p1("[1,2]", arena);
+        auto valOne = p1.Result();
+
+        Parser p2("[[3,4],5]", arena);
+        auto valTwo = p2.Result();
 
-        return ReadPair();
+        std::cout << "Input: " << *valOne << " + " << *valTwo << "\n";
+
+        auto added = AddFishNumbers(arena, valOne, valTwo);
+        std::cout << "Result: " << *added << "\n";
+        std::cout << "Magnitude: " << added->Magnitude() << "\n";
     }
 
-private:
+    void TestTwo()
+    {
+        std::cout << "Test two\n";
+        Common::Arena arena;
+        Parser p1("[[[[[9,8],1],2],3],4]", arena);
+        auto val1 = p1.Result();
+
+        bool b{ false };
+
+        std::cout << "Input: " << *val1 << "\n";
+        val1 = ExplodeNumber(arena, val1, b);
+        std::cout << "Result: " << *val1 << "\n";
+
+        Parser p2("[7,[6,[5,[4,[3,2]]]]]", arena);
+        auto val2 = p2.Result();
+        std::cout << "Input: " << *val2 << "\n";
+        val2 = ExplodeNumber(arena, val2, b);
+        std::cout << "Result: " << *val2 << "\n";
+
+        Parser p3("[[6,[5,[4,[3,2]]]],1]", arena);
+        auto val3 = p3.Result();
+        std::cout << "Input: " << *val3 << "\n";
+        val3 = ExplodeNumber(arena, val3, b);
+        std::cout << "Result: " << *val3 << "\n";
+
+        Parser p4("[[3,[2,[1,[7,3]]]],[6,[5,[4,[3,2]]]]]", arena);
+        auto val4 = p4.Result();
+        std::cout << "Input: " << *val4 << "\n";
+        val4 = ExplodeNumber(arena, val4, b);
+        std::cout << "Result: " << *val4 << "\n";
+        val4 = ExplodeNumber(arena, val4, b);
+        std::cout << "Result: " << *val4 << "\n";
+    }
 
-    std::unique_ptr<FishNumber> ReadPair()
+    void TestThree()
     {
-        if (currentToken.type != TokenType::LB)
-        {
+        std::cout << "Test three\n";
+        Common::Arena arena;
 
-        }
-        auto left = ReadSub();
-        currentToken = lexer.GetToken(); // ,
-        auto right = ReadSub();
-        currentToken = lexer.GetToken(); // ]
+        Parser p("[[[[0,7],4],[15,[0,13]]],[1,1]]", arena);
+        auto val = p.Result();
+
+        bool b{ false };
+
+        std::cout << "Input: " << *val << "\n";
+        val = SplitNumber(arena, val, b);
+        std::cout << "Result: " << *val << "\n";
+        val = SplitNumber(arena, val, b);
+        std::cout << "Result: " << *val << "\n";
+    }
 
-        return std::make_unique<FishPair>(
-            std::move(left),
-            std::move(right));
+    void TestFour()
+    {
+        std::cout << "Test four\n";
+        Common::Arena arena;
+
+        Parser p1("[[[[4,3],4],4],[7,[[8,4],9]]]", arena);
+        auto val1 = p1.Result();
+
+        Parser p2("[1,1]", arena);
+        auto val2 = p2.Result();
+
+        std::cout << "Input: " << *val1 << " + " << *val2 << "\n";
+        auto added = AddFishNumbers(arena, val1, val2);
+        std::cout << "Result: " << *added << "\n";
     }
 
-    std::unique_ptr<FishNumber> ReadSub()
+    Input ReadInput(std::string_view text)
     {
-        currentToken = lexer.GetToken();
-        if (currentToken.type == TokenType::LB)
+        Input result;
+
+        Common::LineReader lines{ text };
+        std::string_view input;
+        while (lines.Next(input))
         {
-            return ReadPair();
+            if (input.empty())
+            {
+                break;
+            }
+            Parser p{ input, result.arena };
+            result.numbers.push_back(p.Result());
         }
-        else if (currentToken.type == TokenType::Number)
+        if (result.numbers.empty())
         {
-            return std::make_unique<RegularNumber>(currentToken.value.value());
+            throw std::runtime_error("Expected at least one snailfish number in input");
         }
-        else
+        return result;
+    }
+
+    FishNumber const* SumNumbers(Input const& input, Common::Arena& result)
+    {
+        AOC_TRACE_SCOPE("Day18 SumNumbers");
+        // Each addition is worked out in scratch, then its sum is copied to
+        // the other of sums, so the last sum and everything made on the way
+        // to it can go in one Reset().
+        Common::Arena scratch;
+        Common::Arena sums[2];
+        int next = 0;
+        auto accum = input.numbers[0];
+        for (std::size_t i = 1; i < input.numbers.size(); ++i)
         {
-            throw std::runtime_error("Unexpected token type in input");
+            auto sum = AddFishNumbers(scratch, accum, input.numbers[i]);
+            sums[next].Reset();
+            accum = sum->Copy(sums[next]);
+            next = 1 - next;
+            scratch.Reset();
         }
+        return accum->Copy(result);
     }
 
-    Lexer lexer;
-    Token currentToken;
-};
+    uint64_t LargestPairMagnitude(Input const& input)
+    {
+        AOC_TRACE_SCOPE("Day18 LargestPairMagnitude");
+        auto const& numbers = input.numbers;
+        Common::Arena scratch;
+        uint64_t largestPairMagnitude = 0;
+        for (std::size_t i = 0; i + 1 < numbers.size(); ++i)
+        {
+            for (std::size_t j = i + 1; j < numbers.size(); ++j)
+            {
+                auto firstMagnitude = AddFishNumbers(scratch, numbers[i], numbers[j])->Magnitude();
+                if (firstMagnitude > largestPairMagnitude)
+                {
+                    largestPairMagnitude = firstMagnitude;
+                }
+                scratch.Reset();
 
-void TestOne()
-{
-    std::cout << "Test one\n";
+                auto secondMagnitude = AddFishNumbers(scratch, numbers[j], numbers[i])->Magnitude();
+                if (secondMagnitude > largestPairMagnitude)
+                {
+                    largestPairMagnitude = secondMagnitude;
+                }
+                scratch.Reset();
+            }
+        }
+        return largestPairMagnitude;
+    }
 
-    Parser p1("[1,2]");
-    auto valOne = p1.Result();
+    uint64_t PartOne(Input const& input)
+    {
+        Common::Arena result;
+        return SumNumbers(input, result)->Magnitude();
+    }
 
-    Parser p2("[[3,4],5]");
-    auto valTwo = p2.Result();
+    uint64_t PartTwo(Input const& input)
+    {
+        return LargestPairMagnitude(input);
+    }
 
-    std::cout << "Input: " << *valOne << " + " << *valTwo << "\n";
+    namespace Reference
+    {
+        struct ExplodeResult
+        {
+            std::unique_ptr<FishNumber> newNumber;
+            int addLeft;
+            int addRight;
+        };
 
-    auto added = AddFishNumbers(std::move(valOne), std::move(valTwo));
-    std::cout << "Result: " << *added << "\n";
-    std::cout << "Magnitude: " << added->Magnitude() << "\n";
-}
+        class FishPair : public FishNumber
+        {
+        public:
+            FishPair(std::unique_ptr<FishNumber> l, std::unique_ptr<FishNumber> r)
+                : left{ std::move(l) },
+                right{ std::move(r) }
+            {}
 
-void TestTwo()
-{
-    std::cout << "Test two\n";
-    Parser p1("[[[[[9,8],1],2],3],4]");
-    auto val1 = p1.Result();
-
-    bool b{ false };
-
-    std::cout << "Input: " << *val1 << "\n";
-    val1 = ExplodeNumber(std::move(val1), b);
-    std::cout << "Result: " << *val1 << "\n";
-
-    Parser p2("[7,[6,[5,[4,[3,2]]]]]");
-    auto val2 = p2.Result();
-    std::cout << "Input: " << *val2 << "\n";
-    val2 = ExplodeNumber(std::move(val2), b);
-    std::cout << "Result: " << *val2 << "\n";
-
-    Parser p3("[[6,[5,[4,[3,2]]]],1]");
-    auto val3 = p3.Result();
-    std::cout << "Input: " << *val3 << "\n";
-    val3 = ExplodeNumber(std::move(val3), b);
-    std::cout << "Result: " << *val3 << "\n";
-
-    Parser p4("[[3,[2,[1,[7,3]]]],[6,[5,[4,[3,2]]]]]");
-    auto val4 = p4.Result();
-    std::cout << "Input: " << *val4 << "\n";
-    val4 = ExplodeNumber(std::move(val4), b);
-    std::cout << "Result: " << *val4 << "\n";
-    val4 = ExplodeNumber(std::move(val4), b);
-    std::cout << "Result: " << *val4 << "\n";
-}
+            uint64_t Magnitude() const noexcept override
+            {
+                return 3 * left->Magnitude() + 2 * right->Magnitude();
+            }
+            NumberType Type() const noexcept override
+            {
+                return NumberType::Pair;
+            }
 
-void TestThree()
-{
-    std::cout << "Test three\n";
+            std::unique_ptr<FishNumber> Copy() const override
+            {
+                return std::make_unique<FishPair>(
+                    left->Copy(),
+                    right->Copy());
+            }
+            std::unique_ptr<FishNumber> CopyAddingToLeft(int val) const override
+            {
+                return std::make_unique<FishPair>(
+                    left->CopyAddingToLeft(val),
+                    right->Copy());
+            }
+            std::unique_ptr<FishNumber> CopyAddingToRight(int val) const override
+            {
+                return std::make_unique<FishPair>(
+                    left->Copy(),
+                    right->CopyAddingToRight(val));
+            }
 
-    Parser p("[[[[0,7],4],[15,[0,13]]],[1,1]]");
-    auto val = p.Result();
+            std::unique_ptr<FishNumber> Split() const override
+            {
+                auto leftResult = left->Split();
+                if (leftResult)
+                {
+                    return std::make_unique<FishPair>(
+                        std::move(leftResult),
+                        right->Copy());
+                }
+                auto rightResult = right->Split();
+                if (rightResult)
+                {
+                    return std::make_unique<FishPair>(
+                        left->Copy(),
+                        std::move(rightResult));
+                }
+                return nullptr;
+            }
 
-    bool b{ false };
+            ExplodeResult Explode(int curDepth, int maxDepth);
 
-    std::cout << "Input: " << *val << "\n";
-    val = SplitNumber(std::move(val), b);
-    std::cout << "Result: " << *val << "\n";
-    val = SplitNumber(std::move(val), b);
-    std::cout << "Result: " << *val << "\n";
-}
+        private:
+            std::unique_ptr<FishNumber> left;
+            std::unique_ptr<FishNumber> right;
+        };
 
-void TestFour()
-{
-    std::cout << "Test four\n";
+        class RegularNumber : public FishNumber
+        {
+        public:
+            explicit RegularNumber(int val)
+                : value{ val }
+            {}
 
-    Parser p1("[[[[4,3],4],4],[7,[[8,4],9]]]");
-    auto val1 = p1.Result();
+            uint64_t Magnitude() const noexcept override
+            {
+                return value;
+            }
+            NumberType Type() const noexcept override
+            {
+                return NumberType::Regular;
+            }
 
-    Parser p2("[1,1]");
-    auto val2 = p2.Result();
+            std::unique_ptr<FishNumber> Copy() const override
+            {
+                return std::make_unique<RegularNumber>(value);
+            }
+            std::unique_ptr<FishNumber> CopyAddingToLeft(int val) const override
+            {
+                return std::make_unique<RegularNumber>(value + val);
+            }
+            std::unique_ptr<FishNumber> CopyAddingToRight(int val) const override
+            {
+                return std::make_unique<RegularNumber>(value + val);
+            }
 
-    std::cout << "Input: " << *val1 << " + " << *val2 << "\n";
-    auto added = AddFishNumbers(std::move(val1), std::move(val2));
-    std::cout << "Result: " << *added << "\n";
-}
+            std::unique_ptr<FishNumber> Split() const override
+            {
+                if (value >= 10)
+                {
+                    auto newLeft = value / 2;
+                    auto newRight = (value / 2) + (value % 2);
+                    return std::make_unique<FishPair>(
+                        std::make_unique<RegularNumber>(newLeft),
+                        std::make_unique<RegularNumber>(newRight));
+                }
+                return nullptr;
+            }
 
-auto ReadInput()
-{
-    std::vector<std::unique_ptr<FishNumber>> result;
+        private:
+            int const value;
+        };
 
-    std::string input;
-    while (std::getline(std::cin, input))
-    {
-        if (input.empty())
+        ExplodeResult FishPair::Explode(int curDepth, int maxDepth)
         {
-            break;
+            if (curDepth >= maxDepth)
+            {
+                // do the explode - this pair will only have regular numbers in it
+                return
+                {
+                    std::make_unique<RegularNumber>(0),
+                    static_cast<int>(left->Magnitude()),
+                    static_cast<int>(right->Magnitude())
+                };
+            }
+            if (left->Type() == NumberType::Pair)
+            {
+                auto leftResult = (static_cast<FishPair&>(*left)).Explode(curDepth + 1, maxDepth);
+                if (leftResult.newNumber)
+                {
+                    return
+                    {
+                        std::make_unique<FishPair>(
+                            std::move(leftResult.newNumber),
+                            right->CopyAddingToLeft(leftResult.addRight)),
+                        leftResult.addLeft,
+                        0
+                    };
+                }
+            }
+            if (right->Type() == NumberType::Pair)
+            {
+                auto rightResult = (static_cast<FishPair&>(*right)).Explode(curDepth + 1, maxDepth);
+                if (rightResult.newNumber)
+                {
+                    return
+                    {
+                        std::make_unique<FishPair>(
+                            left->CopyAddingToRight(rightResult.addLeft),
+                            std::move(rightResult.newNumber)),
+                        0,
+                        rightResult.addRight
+                    };
+                }
+            }
+            return { nullptr, 0, 0 };
         }
-        Parser p{ input };
-        result.push_back(p.Result());
-    }
-    return result;
-}
 
-int main()
-{
-    //TestOne();
-    //TestTwo();
-    //TestThree();
-    //TestFour();
-    auto input = ReadInput();
-
-    auto accum = input[0]->Copy();
-    for (int i = 1; i < input.size(); ++i)
-    {
-        accum = AddFishNumbers(std::move(accum), input[i]->Copy());
-    }
+        std::unique_ptr<FishNumber> ReduceNumber(std::unique_ptr<FishNumber> number)
+        {
+            while (true)
+            {
+                if (number->Type() == NumberType::Pair)
+                {
+                    auto exploded = (static_cast<FishPair&>(*number)).Explode(0, 4);
+                    if (exploded.newNumber)
+                    {
+                        number = std::move(exploded.newNumber);
+                        continue;
+                    }
+                }
+                auto split = number->Split();
+                if (!split)
+                {
+                    return number;
+                }
+                number = std::move(split);
+            }
+        }
 
-    std::cout << "\nPart one\nResult: " << *accum << "\n";
-    std::cout << "Magnitude: " << accum->Magnitude() << "\n";
+        std::unique_ptr<FishNumber> AddFishNumbers(std::unique_ptr<FishNumber> left, std::unique_ptr<FishNumber> right)
+        {
+            return ReduceNumber(std::make_unique<FishPair>(
+                std::move(left),
+                std::move(right)));
+        }
 
-    uint64_t largestPairMagnitude = 0;
-    for (int i = 0; i < input.size() - 1; ++i)
-    {
-        for (int j = i + 1; j < input.size(); ++j)
+        class Parser
+        {
+        public:
+            explicit Parser(std::string_view in)
+                : lexer{ in }
+            {}
+
+            std::unique_ptr<FishNumber> Result()
+            {
+                lexer.GetToken(); // [
+                return ReadPair();
+            }
+
+        private:
+            std::unique_ptr<FishNumber> ReadPair()
+            {
+                auto left = ReadSub();
+                lexer.GetToken(); // ,
+                auto right = ReadSub();
+                lexer.GetToken(); // ]
+
+                return std::make_unique<FishPair>(
+                    std::move(left),
+                    std::move(right));
+            }
+
+            std::unique_ptr<FishNumber> ReadSub()
+            {
+                auto token = lexer.GetToken();
+                if (token.type == TokenType::LB)
+                {
+                    return ReadPair();
+                }
+                if (token.type == TokenType::Number)
+                {
+                    return std::make_unique<RegularNumber>(token.value.value());
+                }
+                throw std::runtime_error("Unexpected token type in input");
+            }
+
+            Lexer lexer;
+        };
+
+        Input ReadInput(std::string_view text)
         {
-            auto addFirst = AddFishNumbers(input[i]->Copy(), input[j]->Copy());
-            auto firstMagnitude = addFirst->Magnitude();
-            if (firstMagnitude > largestPairMagnitude)
+            Input result;
+
+            Common::LineReader lines{ text };
+            std::string_view input;
+            while (lines.Next(input))
             {
-                largestPairMagnitude = firstMagnitude;
+                if (input.empty())
+                {
+                    break;
+                }
+                Parser p{ input };
+                result.push_back(p.Result());
             }
+            return result;
+        }
 
-            auto secondAdd = AddFishNumbers(input[j]->Copy(), input[i]->Copy());
-            auto secondMagnitude = secondAdd->Magnitude();
-            if (secondMagnitude > largestPairMagnitude)
+        uint64_t PartOne(Input const& input)
+        {
+            auto accum = input[0]->Copy();
+            for (std::size_t i = 1; i < input.size(); ++i)
             {
-                largestPairMagnitude = secondMagnitude;
+                accum = AddFishNumbers(std::move(accum), input[i]->Copy());
             }
+            return accum->Magnitude();
         }
-    }
 
-    std::cout << "\nPart two\nLargest pair-wise magnitude: " << largestPairMagnitude << "\n";
+        uint64_t PartTwo(Input const& input)
+        {
+            uint64_t largestPairMagnitude = 0;
+            for (std::size_t i = 0; i < input.size(); ++i)
+            {
+                for (std::size_t j = 0; j < input.size(); ++j)
+                {
+                    if (i != j)
+                    {
+                        largestPairMagnitude = std::max(largestPairMagnitude, AddFishNumbers(input[i]->Copy(), input[j]->Copy())->Magnitude());
+                    }
+                }
+            }
+            return largestPairMagnitude;
+        }
+    }
 }
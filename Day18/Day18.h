@@ -0,0 +1,87 @@
+// Day18.h : Snailfish. Adds up snailfish numbers and finds their magnitudes.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include "Common/Arena.h"
+
+namespace Day18
+{
+    enum class NumberType
+    {
+        Pair,
+        Regular
+    };
+
+    // Numbers live in an arena and never change once made. The reworked
+    // numbers the Copy functions and Split make in an arena share whatever
+    // they leave alone with the original, so the original's arena has to
+    // outlive them, apart from Copy which shares nothing.
+    class FishNumber
+    {
+    public:
+        virtual void Print(std::ostream& out) const = 0;
+        virtual uint64_t Magnitude() const noexcept = 0;
+        virtual NumberType Type() const noexcept = 0;
+        virtual FishNumber const* Copy(Common::Arena& arena) const = 0;
+        virtual FishNumber const* CopyAddingToLeft(Common::Arena& arena, int val) const = 0;
+        virtual FishNumber const* CopyAddingToRight(Common::Arena& arena, int val) const = 0;
+        // Null if there's nothing to split.
+        virtual FishNumber const* Split(Common::Arena& arena) const = 0;
+
+    protected:
+        ~FishNumber() = default;
+    };
+
+    std::ostream& operator<<(std::ostream& out, FishNumber const& number);
+
+    struct Input
+    {
+        // Holds every number read.
+        Common::Arena arena;
+        std::vector<FishNumber const*> numbers;
+    };
+
+    // Throws if there are no numbers, as there would be nothing to sum.
+    Input ReadInput(std::string_view text);
+
+    // Makes the reduced sum, and every step on the way to it, in arena.
+    FishNumber const* AddFishNumbers(Common::Arena& arena, FishNumber const* left, FishNumber const* right);
+    // The sum of all the numbers, made in result.
+    FishNumber const* SumNumbers(Input const& input, Common::Arena& result);
+    uint64_t LargestPairMagnitude(Input const& input);
+
+    uint64_t PartOne(Input const& input);
+    uint64_t PartTwo(Input const& input);
+
+    // The straightforward versions the faster ones are checked against (aoc_diff).
+    namespace Reference
+    {
+        // Each number owns its halves, and every step copies the whole
+        // number, rather than sharing what it leaves alone.
+        class FishNumber
+        {
+        public:
+            virtual ~FishNumber() {};
+
+            virtual uint64_t Magnitude() const noexcept = 0;
+            virtual NumberType Type() const noexcept = 0;
+            virtual std::unique_ptr<FishNumber> Copy() const = 0;
+            virtual std::unique_ptr<FishNumber> CopyAddingToLeft(int val) const = 0;
+            virtual std::unique_ptr<FishNumber> CopyAddingToRight(int val) const = 0;
+            virtual std::unique_ptr<FishNumber> Split() const = 0;
+        };
+
+        using Input = std::vector<std::unique_ptr<FishNumber>>;
+
+        Input ReadInput(std::string_view text);
+
+        uint64_t PartOne(Input const& input);
+        uint64_t PartTwo(Input const& input);
+    }
+}
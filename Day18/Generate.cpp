@@ -0,0 +1,42 @@
+// Generate.cpp : Writes a Day18 input of any size, one snailfish number per line.
+//   Day18_gen [numbers] [--scale=F] [--seed=N]
+
+#include <iostream>
+#include <string>
+
+#include "Common/Generator.h"
+
+// Already reduced: nested at most four deep, with nothing over 9.
+void AppendNumber(Common::Generator& gen, std::string& out, int depth)
+{
+    out += '[';
+    for (int side = 0; side < 2; ++side)
+    {
+        if (side == 1)
+        {
+            out += ',';
+        }
+        if (depth < 4 && gen.Chance(0.6))
+        {
+            AppendNumber(gen, out, depth + 1);
+        }
+        else
+        {
+            out += static_cast<char>('0' + gen.Uniform(0, 9));
+        }
+    }
+    out += ']';
+}
+
+int main(int argc, char* argv[])
+{
+    Common::Generator gen{ argc, argv, 100 };
+
+    std::string line;
+    for (std::size_t i = 0; i < gen.Size(); ++i)
+    {
+        line.clear();
+        AppendNumber(gen, line, 1);
+        std::cout << line << "\n";
+    }
+}
@@ -0,0 +1,31 @@
+#include <iostream>
+
+#include "Common/Arena.h"
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/Input.h"
+#include "Day18.h"
+
+int main(int argc, char* argv[])
+{
+    if (auto batch = Common::ReadBatchOptions(argc, argv); batch.enabled)
+    {
+        return Common::RunBatch(batch, Day18::ReadInput, Day18::PartOne, Day18::PartTwo);
+    }
+
+    Common::Benchmark bench{ argc, argv };
+    auto buffer = Common::InputBuffer::FromCommandLine(argc, argv);
+    auto input = bench.Measure("parse", [&] { return Day18::ReadInput(buffer.Text()); }, { .bytes = buffer.Size() });
+
+    Common::Arena sumArena;
+    auto accum = bench.Measure("part one", [&] { sumArena.Reset(); return Day18::SumNumbers(input, sumArena); }, { .items = input.numbers.size() });
+
+    std::cout << "\nPart one\nResult: " << *accum << "\n";
+    std::cout << "Magnitude: " << accum->Magnitude() << "\n";
+
+    auto largestPairMagnitude = bench.Measure("part two", [&] { return Day18::PartTwo(input); }, { .items = input.numbers.size() * (input.numbers.size() - 1) });
+
+    std::cout << "\nPart two\nLargest pair-wise magnitude: " << largestPairMagnitude << "\n";
+
+    bench.Report(std::cout);
+}
@@ -1,207 +1,246 @@
+#include "Day19.h"
+
 #include <algorithm>
 #include <array>
-#include <compare>
+#include <cstdlib>
 #include <functional>
-#include <iostream>
-#include <numeric>
-#include <regex>
+#include <iterator>
 #include <set>
+#include <stdexcept>
 #include <string>
-#include <vector>
-
-struct Point
-{
-    int x;
-    int y;
-    int z;
-    auto operator<=>(const Point&) const = default;
-};
+#include <utility>
 
-Point operator-(Point const& a, Point const& b)
-{
-    return { a.x - b.x, a.y - b.y, a.z - b.z };
-}
-Point operator+(Point const& a, Point const& b)
-{
-    return { a.x + b.x, a.y + b.y, a.z + b.z };
-}
+#include "Common/Input.h"
+#include "Common/Pattern.h"
+#include "Common/Trace.h"
 
-Point RotateZ(Point const& p)
+namespace Day19
 {
-    return { -p.y, p.x, p.z };
-}
-Point RotateY(Point const& p)
-{
-    return { -p.z, p.y, p.x };
-}
-Point RotateX(Point const& p)
-{
-    return { p.x, -p.z, p.y };
-}
-
-int ManhattenDistance(Point const& a, Point const& b)
-{
-    return abs(a.x - b.x) + abs(a.y - b.y) + abs(a.z - b.z);
-}
-
-struct Scanner
-{
-    int id{ -1 };
-    bool locked{ false };
-    Point offset{ 0,0,0 };
-    std::vector<Point> points;
-};
+    Point operator-(Point const& a, Point const& b)
+    {
+        return { a.x - b.x, a.y - b.y, a.z - b.z };
+    }
+    Point operator+(Point const& a, Point const& b)
+    {
+        return { a.x + b.x, a.y + b.y, a.z + b.z };
+    }
 
-auto ReadInput()
-{
-    std::vector<Scanner> result;
-    std::string line;
+    Point RotateZ(Point const& p)
+    {
+        return { -p.y, p.x, p.z };
+    }
+    Point RotateY(Point const& p)
+    {
+        return { -p.z, p.y, p.x };
+    }
+    Point RotateX(Point const& p)
+    {
+        return { p.x, -p.z, p.y };
+    }
 
-    std::regex scannerIdRegex("--- scanner (\\d+) ---");
-    std::regex pointRegex("(-?\\d+),(-?\\d+),(-?\\d+)");
+    int ManhattenDistance(Point const& a, Point const& b)
+    {
+        return abs(a.x - b.x) + abs(a.y - b.y) + abs(a.z - b.z);
+    }
 
-    while (std::getline(std::cin, line))
+    Input ReadInput(std::string_view text)
     {
-        if (line.empty())
-        {
-            break;
-        }
+        std::vector<Scanner> result;
+        Common::LineReader lines{ text };
+        std::string_view line;
 
-        int scannerId = -1;
-        std::smatch scannerIdMatch;
-        if (std::regex_match(line, scannerIdMatch, scannerIdRegex))
+        while (lines.Next(line))
         {
-            if (scannerIdMatch.size() == 2)
+            if (line.empty())
             {
-                scannerId = std::stoi(scannerIdMatch[1].str());
+                break;
             }
-        }
-        else
-        {
-            throw std::runtime_error("Could not identify scanner: " + line);
-        }
 
-        Scanner s{ .id = scannerId };
-        // now read the points until an empty line
-        while (std::getline(std::cin, line))
-        {
-            if (line.empty())
+            int scannerId = -1;
+            if (!Common::Match<"--- scanner {} ---">(line, scannerId))
             {
-                break;
+                throw std::runtime_error("Could not identify scanner: " + std::string{ line });
             }
 
-            std::smatch pointMatch;
-            if (std::regex_match(line, pointMatch, pointRegex))
+            Scanner s{ .id = scannerId, .points = {} };
+            // now read the points until an empty line
+            while (lines.Next(line))
             {
-                if (pointMatch.size() == 4)
+                if (line.empty())
+                {
+                    break;
+                }
+
+                int x;
+                int y;
+                int z;
+                if (Common::Match<"{},{},{}">(line, x, y, z))
                 {
-                    auto x = std::stoi(pointMatch[1].str());
-                    auto y = std::stoi(pointMatch[2].str());
-                    auto z = std::stoi(pointMatch[3].str());
                     s.points.emplace_back(x, y, z);
                 }
+                else
+                {
+                    throw std::runtime_error("Could not identify point: " + std::string{ line });
+                }
             }
-            else
-            {
-                throw std::runtime_error("Could not identify point: " + line);
-            }
+            result.push_back(s);
         }
-        result.push_back(s);
+        return result;
     }
-    return result;
-}
 
-int main()
-{
-    auto scanners = ReadInput();
-
-    std::set<Point> lockedPoints{ scanners[0].points.begin(), scanners[0].points.end() };
-    scanners[0].locked = true;
-
-    std::array<std::function<Point(Point const&)>, 24> rotations = {
-        // assume we start facing +x and try each way up (rotate around x-axis)
-        [](Point const& p) { return p; },
-        [](Point const& p) { return RotateX(p); },
-        [](Point const& p) { return RotateX(RotateX(p)); },
-        [](Point const& p) { return RotateX(RotateX(RotateX(p))); },
-        //  now point to -x
-        [](Point const& p) { return RotateY(RotateY(p)); },
-        [](Point const& p) { return RotateX(RotateY(RotateY(p))); },
-        [](Point const& p) { return RotateX(RotateX(RotateY(RotateY(p)))); },
-        [](Point const& p) { return RotateX(RotateX(RotateX(RotateY(RotateY(p))))); },
-        // now to facing along z-axis
-        [](Point const& p) { return RotateY(p); },
-        [](Point const& p) { return RotateZ(RotateY(p)); },
-        [](Point const& p) { return RotateZ(RotateZ(RotateY(p))); },
-        [](Point const& p) { return RotateZ(RotateZ(RotateZ(RotateY(p)))); },
-        // and the other way on the z-axis
-        [](Point const& p) { return RotateY(RotateY(RotateY(p))); },
-        [](Point const& p) { return RotateZ(RotateY(RotateY(RotateY(p)))); },
-        [](Point const& p) { return RotateZ(RotateZ(RotateY(RotateY(RotateY(p))))); },
-        [](Point const& p) { return RotateZ(RotateZ(RotateZ(RotateY(RotateY(RotateY(p)))))); },
-        // now facing along the y-axis
-        [](Point const& p) { return RotateZ(p); },
-        [](Point const& p) { return RotateY(RotateZ(p)); },
-        [](Point const& p) { return RotateY(RotateY(RotateZ(p))); },
-        [](Point const& p) { return RotateY(RotateY(RotateY(RotateZ(p)))); },
-        // and the other way along the y-axis
-        [](Point const& p) { return RotateZ(RotateZ(RotateZ(p))); },
-        [](Point const& p) { return RotateY(RotateZ(RotateZ(RotateZ(p)))); },
-        [](Point const& p) { return RotateY(RotateY(RotateZ(RotateZ(RotateZ(p))))); },
-        [](Point const& p) { return RotateY(RotateY(RotateY(RotateZ(RotateZ(RotateZ(p)))))); },
-    };
-
-    while (std::any_of(scanners.begin(), scanners.end(), [](auto const& s) { return !s.locked; }))
+    using Rotation = std::function<Point(Point const&)>;
+
+    std::array<Rotation, 24> const& Rotations()
+    {
+        static std::array<Rotation, 24> const rotations = {
+            // assume we start facing +x and try each way up (rotate around x-axis)
+            [](Point const& p) { return p; },
+            [](Point const& p) { return RotateX(p); },
+            [](Point const& p) { return RotateX(RotateX(p)); },
+            [](Point const& p) { return RotateX(RotateX(RotateX(p))); },
+            //  now point to -x
+            [](Point const& p) { return RotateY(RotateY(p)); },
+            [](Point const& p) { return RotateX(RotateY(RotateY(p))); },
+            [](Point const& p) { return RotateX(RotateX(RotateY(RotateY(p)))); },
+            [](Point const& p) { return RotateX(RotateX(RotateX(RotateY(RotateY(p))))); },
+            // now to facing along z-axis
+            [](Point const& p) { return RotateY(p); },
+            [](Point const& p) { return RotateZ(RotateY(p)); },
+            [](Point const& p) { return RotateZ(RotateZ(RotateY(p))); },
+            [](Point const& p) { return RotateZ(RotateZ(RotateZ(RotateY(p)))); },
+            // and the other way on the z-axis
+            [](Point const& p) { return RotateY(RotateY(RotateY(p))); },
+            [](Point const& p) { return RotateZ(RotateY(RotateY(RotateY(p)))); },
+            [](Point const& p) { return RotateZ(RotateZ(RotateY(RotateY(RotateY(p))))); },
+            [](Point const& p) { return RotateZ(RotateZ(RotateZ(RotateY(RotateY(RotateY(p)))))); },
+            // now facing along the y-axis
+            [](Point const& p) { return RotateZ(p); },
+            [](Point const& p) { return RotateY(RotateZ(p)); },
+            [](Point const& p) { return RotateY(RotateY(RotateZ(p))); },
+            [](Point const& p) { return RotateY(RotateY(RotateY(RotateZ(p)))); },
+            // and the other way along the y-axis
+            [](Point const& p) { return RotateZ(RotateZ(RotateZ(p))); },
+            [](Point const& p) { return RotateY(RotateZ(RotateZ(RotateZ(p)))); },
+            [](Point const& p) { return RotateY(RotateY(RotateZ(RotateZ(RotateZ(p))))); },
+            [](Point const& p) { return RotateY(RotateY(RotateY(RotateZ(RotateZ(RotateZ(p)))))); },
+        };
+        return rotations;
+    }
+
+    // Locks every scanner in place around scanner 0, adding its beacons to
+    // lockedPoints, and gives the order they were locked in.
+    template<typename PointSet>
+    std::vector<int> LockScanners(std::vector<Scanner>& scanners, PointSet& lockedPoints)
     {
-        for (auto& s : scanners)
+        auto const& rotations = Rotations();
+
+        lockedPoints.insert(scanners[0].points.begin(), scanners[0].points.end());
+        scanners[0].locked = true;
+        std::vector<int> lockOrder;
+
+        while (std::any_of(scanners.begin(), scanners.end(), [](auto const& s) { return !s.locked; }))
         {
-            if (!s.locked)
+            AOC_TRACE_COUNT("Day19 passes over scanners", 1);
+            for (auto& s : scanners)
             {
-                bool didLock = false;
-                //for (auto const& r : rotations)
-                for (auto rotIt = rotations.begin(); rotIt != rotations.end() && !didLock; ++rotIt)
+                if (!s.locked)
                 {
-                    auto const& r = *rotIt;
-                    //for (auto const& lp : lockedPoints)
-                    for (auto lpIt = lockedPoints.begin(); lpIt != lockedPoints.end() && !didLock; ++lpIt)
+                    bool didLock = false;
+                    // added once the loops are done, as inserting can move the points being looped over
+                    std::vector<Point> placed;
+                    //for (auto const& r : rotations)
+                    for (auto rotIt = rotations.begin(); rotIt != rotations.end() && !didLock; ++rotIt)
                     {
-                        auto const& lp = *lpIt;
-                        //for (auto const& sp : s.points)
-                        for (auto spIt = s.points.begin(); spIt != s.points.end() && !didLock; ++spIt)
+                        auto const& r = *rotIt;
+                        //for (auto const& lp : lockedPoints)
+                        for (auto lpIt = lockedPoints.begin(); lpIt != lockedPoints.end() && !didLock; ++lpIt)
                         {
-                            auto const& sp = *spIt;
-                            auto offset = lp - r(sp);
-                            // check how many points from the scanner line up with locked points
-                            auto overlapCount = std::count_if(s.points.begin(), s.points.end(), [&lockedPoints, &offset, &r](auto const& p) { return lockedPoints.contains(offset + r(p)); });
-                            if (overlapCount >= 12)
+                            auto const& lp = *lpIt;
+                            //for (auto const& sp : s.points)
+                            for (auto spIt = s.points.begin(); spIt != s.points.end() && !didLock; ++spIt)
                             {
-                                std::cout << "Locking scanner " << s.id << "\n";
-                                didLock = true;
-                                s.locked = true;
-                                s.offset = offset;
-                                std::transform(s.points.begin(), s.points.end(), std::inserter(lockedPoints, lockedPoints.begin()), [&offset, &r](auto const& p) { return offset + r(p); });
+                                AOC_TRACE_COUNT("Day19 offsets tested", 1);
+                                auto const& sp = *spIt;
+                                auto offset = lp - r(sp);
+                                // check how many points from the scanner line up with locked points
+                                auto overlapCount = std::count_if(s.points.begin(), s.points.end(), [&lockedPoints, &offset, &r](auto const& p) { return lockedPoints.contains(offset + r(p)); });
+                                if (overlapCount >= 12)
+                                {
+                                    AOC_TRACE_COUNT("Day19 scanners locked", 1);
+                                    lockOrder.push_back(s.id);
+                                    didLock = true;
+                                    s.locked = true;
+                                    s.offset = offset;
+                                    std::transform(s.points.begin(), s.points.end(), std::back_inserter(placed), [&offset, &r](auto const& p) { return offset + r(p); });
+                                }
                             }
                         }
                     }
+                    lockedPoints.insert(placed.begin(), placed.end());
                 }
             }
         }
+
+        return lockOrder;
     }
 
-    std::cout << "Total number of points after aligning: " << lockedPoints.size() << "\n";
+    Alignment AlignScanners(std::vector<Scanner> scanners)
+    {
+        AOC_TRACE_SCOPE("Day19 AlignScanners");
+        Common::FlatSet<Point> lockedPoints;
+        auto lockOrder = LockScanners(scanners, lockedPoints);
 
-    int largestManhattenDistance = 0;
-    for (int i = 0; i < scanners.size() - 1; ++i)
+        std::vector<Point> offsets;
+        std::transform(scanners.begin(), scanners.end(), std::back_inserter(offsets), [](auto const& s) { return s.offset; });
+        return { std::move(lockedPoints), std::move(offsets), std::move(lockOrder) };
+    }
+
+    int LargestManhattenDistance(std::vector<Point> const& offsets)
     {
-        for (int j = i + 1; j < scanners.size(); ++j)
+        int largestManhattenDistance = 0;
+        for (std::size_t i = 0; i + 1 < offsets.size(); ++i)
         {
-            auto distance = ManhattenDistance(scanners[i].offset, scanners[j].offset);
-            if (distance > largestManhattenDistance)
+            for (std::size_t j = i + 1; j < offsets.size(); ++j)
             {
-                largestManhattenDistance = distance;
+                auto distance = ManhattenDistance(offsets[i], offsets[j]);
+                if (distance > largestManhattenDistance)
+                {
+                    largestManhattenDistance = distance;
+                }
             }
         }
+        return largestManhattenDistance;
+    }
+
+    std::size_t PartOne(Input const& input)
+    {
+        return AlignScanners(input).beacons.size();
+    }
+
+    int PartTwo(Input const& input)
+    {
+        return LargestManhattenDistance(AlignScanners(input).offsets);
     }
 
-    std::cout << "Largest Manhatten Distance between scanners: " << largestManhattenDistance << "\n";
+    namespace Reference
+    {
+        std::size_t PartOne(Input const& input)
+        {
+            auto scanners = input;
+            std::set<Point> lockedPoints;
+            LockScanners(scanners, lockedPoints);
+            return lockedPoints.size();
+        }
+
+        int PartTwo(Input const& input)
+        {
+            auto scanners = input;
+            std::set<Point> lockedPoints;
+            LockScanners(scanners, lockedPoints);
+
+            std::vector<Point> offsets;
+            std::transform(scanners.begin(), scanners.end(), std::back_inserter(offsets), [](auto const& s) { return s.offset; });
+            return LargestManhattenDistance(offsets);
+        }
+    }
 }
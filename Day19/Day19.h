@@ -0,0 +1,63 @@
+// Day19.h : Beacon Scanner. Lines the scanners up to map out the beacons.
+
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "Common/FlatHash.h"
+
+namespace Day19
+{
+    struct Point
+    {
+        int x;
+        int y;
+        int z;
+        auto operator<=>(const Point&) const = default;
+    };
+
+    struct Scanner
+    {
+        int id{ -1 };
+        bool locked{ false };
+        Point offset{ 0,0,0 };
+        std::vector<Point> points;
+    };
+
+    template<typename Archive>
+    void Serialise(Archive& archive, Scanner& scanner)
+    {
+        archive(scanner.id, scanner.locked, scanner.offset, scanner.points);
+    }
+
+    // Where everything ended up once all of the scanners were locked in place.
+    // offsets holds the position of each scanner relative to scanner 0.
+    struct Alignment
+    {
+        Common::FlatSet<Point> beacons;
+        std::vector<Point> offsets;
+        std::vector<int> lockOrder;
+    };
+
+    using Input = std::vector<Scanner>;
+
+    Input ReadInput(std::string_view text);
+
+    Alignment AlignScanners(std::vector<Scanner> scanners);
+    int LargestManhattenDistance(std::vector<Point> const& offsets);
+
+    // Both parts need the scanners aligned, so each one does the alignment.
+    std::size_t PartOne(Input const& input);
+    int PartTwo(Input const& input);
+
+    // The straightforward versions the faster ones are checked against (aoc_diff).
+    namespace Reference
+    {
+        // Lines the scanners up against a std::set of the beacons placed so far.
+        std::size_t PartOne(Input const& input);
+        int PartTwo(Input const& input);
+    }
+}
@@ -0,0 +1,120 @@
+// Generate.cpp : Writes a Day19 input of any size, the beacons each scanner reports.
+//   Day19_gen [scanners] [--scale=F] [--seed=N]
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <set>
+#include <vector>
+
+#include "Common/Generator.h"
+
+using Point = std::array<int, 3>;
+using Rotation = std::array<Point, 3>;
+
+// The 24 ways a scanner can face: each axis goes to a different axis, either
+// way round, as long as it isn't a mirror image.
+std::vector<Rotation> AllRotations()
+{
+    std::vector<Rotation> result;
+    std::array<int, 3> axes{ 0, 1, 2 };
+    do
+    {
+        // an odd permutation needs an odd number of flips to stay right-handed
+        int swaps = (axes[0] != 0) + (axes[1] != 1) + (axes[2] != 2);
+        bool oddPermutation = swaps == 2;
+        for (int signs = 0; signs < 8; ++signs)
+        {
+            int flips = std::popcount(static_cast<unsigned>(signs));
+            if ((flips % 2 == 1) != oddPermutation)
+            {
+                continue;
+            }
+            Rotation r{};
+            for (int i = 0; i < 3; ++i)
+            {
+                r[i][axes[i]] = (signs >> i) & 1 ? -1 : 1;
+            }
+            result.push_back(r);
+        }
+    } while (std::next_permutation(axes.begin(), axes.end()));
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    Common::Generator gen{ argc, argv, 30 };
+    int const range = 1000;
+
+    // wander from one scanner to the next, putting 12 beacons where each pair can
+    // both see them so the whole chain can be stitched back together
+    std::vector<Point> scanners{ { 0, 0, 0 } };
+    std::set<Point> beacons;
+    auto addBeacons = [&](Point const& low, Point const& high, std::size_t count)
+    {
+        for (auto target = beacons.size() + count; beacons.size() < target; )
+        {
+            beacons.insert({ gen.Uniform(low[0], high[0]), gen.Uniform(low[1], high[1]), gen.Uniform(low[2], high[2]) });
+        }
+    };
+    auto const& first = scanners[0];
+    addBeacons({ first[0] - range, first[1] - range, first[2] - range }, { first[0] + range, first[1] + range, first[2] + range }, 26);
+    // mostly keep heading the same way, so the chain doesn't double back over
+    // itself and leave scanners seeing far more beacons than the puzzle's do
+    Point heading{ 1, 1, 1 };
+    while (scanners.size() < gen.Size())
+    {
+        auto previous = scanners.back();
+        Point next;
+        Point low;
+        Point high;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            heading[axis] = gen.Chance(0.2) ? -heading[axis] : heading[axis];
+            next[axis] = previous[axis] + heading[axis] * gen.Uniform(600, 1300);
+            low[axis] = std::max(previous[axis], next[axis]) - range;
+            high[axis] = std::min(previous[axis], next[axis]) + range;
+        }
+        scanners.push_back(next);
+        addBeacons(low, high, 12);
+        addBeacons({ next[0] - range, next[1] - range, next[2] - range }, { next[0] + range, next[1] + range, next[2] + range }, 3);
+    }
+
+    auto rotations = AllRotations();
+    std::vector<Point> seen;
+    for (std::size_t s = 0; s < scanners.size(); ++s)
+    {
+        // scanner 0 sets the frame everything else is measured in
+        auto const& rotation = s == 0 ? rotations[0] : gen.Pick(rotations);
+        auto const& position = scanners[s];
+
+        seen.clear();
+        for (auto const& beacon : beacons)
+        {
+            Point offset;
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                offset[axis] = beacon[axis] - position[axis];
+            }
+            if (std::all_of(offset.begin(), offset.end(), [&](int d) { return std::abs(d) <= range; }))
+            {
+                Point local{};
+                for (int i = 0; i < 3; ++i)
+                {
+                    local[i] = std::inner_product(rotation[i].begin(), rotation[i].end(), offset.begin(), 0);
+                }
+                seen.push_back(local);
+            }
+        }
+        gen.Shuffle(seen);
+
+        std::cout << (s == 0 ? "" : "\n") << "--- scanner " << s << " ---\n";
+        for (auto const& p : seen)
+        {
+            std::cout << p[0] << "," << p[1] << "," << p[2] << "\n";
+        }
+    }
+}
@@ -0,0 +1,34 @@
+#include <iostream>
+
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/Input.h"
+#include "Common/ParseCache.h"
+#include "Day19.h"
+
+int main(int argc, char* argv[])
+{
+    if (auto batch = Common::ReadBatchOptions(argc, argv); batch.enabled)
+    {
+        return Common::RunBatch(batch, Day19::ReadInput, Day19::PartOne, Day19::PartTwo);
+    }
+
+    Common::Benchmark bench{ argc, argv };
+    Common::ParseCache cache{ argc, argv };
+    auto buffer = Common::InputBuffer::FromCommandLine(argc, argv);
+    auto scanners = bench.Measure("parse", [&] { return cache.Read("Day19", buffer.Text(), Day19::ReadInput); }, { .bytes = buffer.Size() });
+
+    auto alignment = bench.Measure("part one", [&] { return Day19::AlignScanners(scanners); }, { .items = scanners.size() });
+
+    for (auto id : alignment.lockOrder)
+    {
+        std::cout << "Locking scanner " << id << "\n";
+    }
+    std::cout << "Total number of points after aligning: " << alignment.beacons.size() << "\n";
+
+    auto largestManhattenDistance = bench.Measure("part two", [&] { return Day19::LargestManhattenDistance(alignment.offsets); }, { .items = scanners.size() });
+
+    std::cout << "Largest Manhatten Distance between scanners: " << largestManhattenDistance << "\n";
+
+    bench.Report(std::cout);
+}
@@ -1,99 +1,157 @@
-#include <iostream>
+#include "Day2.h"
+
 #include <sstream>
 #include <string>
-#include <vector>
 
-enum class Direction
-{
-    Unknown,
-    Forward,
-    Up,
-    Down
-};
+#include "Common/Input.h"
+#include "Common/Pipeline.h"
+#include "Common/Trace.h"
 
-struct Command
+namespace Day2
 {
-    Direction dir;
-    int distance;
-};
+    Command ParseCommand(std::string_view inputLine)
+    {
+        auto dir = Common::NextWord(inputLine);
+        int distance = Common::NextNumber(inputLine);
 
-struct Position
-{
-    int depth;
-    int horizontal;
-    int aim;
-};
+        Direction d = [](std::string_view inDir)
+        {
+            if (inDir == "forward")
+            {
+                return Direction::Forward;
+            }
+            else if (inDir == "up")
+            {
+                return Direction::Up;
+            }
+            else if (inDir == "down")
+            {
+                return Direction::Down;
+            }
+            else
+            {
+                return Direction::Unknown;
+            }
+        }(dir);
 
-Command ParseCommand(std::string const& inputLine)
-{
-    std::stringstream in{ inputLine };
-    std::string dir;
-    int distance;
-    in >> dir >> distance;
+        return { d, distance };
+    }
 
-    Direction d = [](std::string const& inDir)
+    Input ReadInput(std::string_view text)
     {
-        if (inDir == "forward")
-        {
-            return Direction::Forward;
-        }
-        else if (inDir == "up")
+        std::vector<Command> commands;
+
+        Common::LineReader lines{ text };
+        std::string_view input;
+        while (lines.Next(input))
         {
-            return Direction::Up;
+            if (input.empty())
+            {
+                break;
+            }
+            auto c = ParseCommand(input);
+            commands.push_back(c);
         }
-        else if (inDir == "down")
+        return commands;
+    }
+
+    Position ApplyCommand(Position currentPos, Command cmd)
+    {
+        switch (cmd.dir)
         {
-            return Direction::Down;
+        case Direction::Forward:
+            return { currentPos.depth + (cmd.distance * currentPos.aim), currentPos.horizontal + cmd.distance, currentPos.aim};
+        case Direction::Down:
+            return { currentPos.depth, currentPos.horizontal, currentPos.aim + cmd.distance };
+        case Direction::Up:
+            return{ currentPos.depth, currentPos.horizontal, currentPos.aim - cmd.distance };
+        default:
+            return currentPos;
         }
-        else
+    }
+
+    Position ApplyCommands(std::vector<Command> const& commands)
+    {
+        AOC_TRACE_SCOPE("Day2 ApplyCommands");
+        AOC_TRACE_COUNT("Day2 commands applied", commands.size());
+        Position pos{ 0, 0, 0 };
+        for (auto const &c : commands)
         {
-            return Direction::Unknown;
+            pos = ApplyCommand(pos, c);
         }
-    }(dir);
+        return pos;
+    }
 
-    return { d, distance };
-}
+    int PartTwo(Input const& input)
+    {
+        auto pos = ApplyCommands(input);
+        return pos.depth * pos.horizontal;
+    }
 
-std::vector<Command> ReadInput()
-{
-    std::vector<Command> commands;
+    int SolvePipelined(std::string_view text)
+    {
+        Position pos{ 0, 0, 0 };
+        Common::RunPipeline(text,
+            [](std::string_view line) { return std::optional{ ParseCommand(line) }; },
+            [&pos](Command c) { pos = ApplyCommand(pos, c); });
+        return pos.depth * pos.horizontal;
+    }
 
-    std::string input;
-    while (std::getline(std::cin, input))
+    int SolveStreaming(Common::LineStream& lines)
     {
-        if (input.empty())
+        Position pos{ 0, 0, 0 };
+        std::string_view line;
+        while (lines.Next(line) && !line.empty())
         {
-            break;
+            pos = ApplyCommand(pos, ParseCommand(line));
         }
-        auto c = ParseCommand(input);
-        commands.push_back(c);
+        return pos.depth * pos.horizontal;
     }
-    return commands;
-}
 
-Position ApplyCommand(Position currentPos, Command cmd)
-{
-    switch (cmd.dir)
+    namespace Reference
     {
-    case Direction::Forward:
-        return { currentPos.depth + (cmd.distance * currentPos.aim), currentPos.horizontal + cmd.distance, currentPos.aim};
-    case Direction::Down:
-        return { currentPos.depth, currentPos.horizontal, currentPos.aim + cmd.distance };
-    case Direction::Up:
-        return{ currentPos.depth, currentPos.horizontal, currentPos.aim - cmd.distance };
-    default:
-        return currentPos;
-    }
-}
+        Input ReadInput(std::string_view text)
+        {
+            std::vector<Command> commands;
+            std::istringstream in{ std::string{ text } };
+            std::string line;
+            while (std::getline(in, line) && !line.empty())
+            {
+                std::istringstream words{ line };
+                std::string dir;
+                int distance = 0;
+                words >> dir >> distance;
+                auto d = dir == "forward" ? Direction::Forward
+                    : dir == "up" ? Direction::Up
+                    : dir == "down" ? Direction::Down
+                    : Direction::Unknown;
+                commands.push_back({ d, distance });
+            }
+            return commands;
+        }
 
-int main()
-{
-    auto commands = ReadInput();
-    Position pos{ 0, 0, 0 };
-    for (auto const &c : commands)
-    {
-        pos = ApplyCommand(pos, c);
+        int PartTwo(Input const& input)
+        {
+            int depth = 0;
+            int horizontal = 0;
+            int aim = 0;
+            for (auto const& c : input)
+            {
+                if (c.dir == Direction::Forward)
+                {
+                    horizontal += c.distance;
+                    depth += aim * c.distance;
+                }
+                else if (c.dir == Direction::Down)
+                {
+                    aim += c.distance;
+                }
+                else if (c.dir == Direction::Up)
+                {
+                    aim -= c.distance;
+                }
+            }
+            return depth * horizontal;
+        }
     }
-
-    std::cout << "Depth * horizontal distance = " << pos.depth * pos.horizontal << "\n";
 }
@@ -0,0 +1,58 @@
+// Day2.h : Dive! Follows the submarine's course commands.
+
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include "Common/Input.h"
+
+namespace Day2
+{
+    enum class Direction
+    {
+        Unknown,
+        Forward,
+        Up,
+        Down
+    };
+
+    struct Command
+    {
+        Direction dir;
+        int distance;
+    };
+
+    struct Position
+    {
+        int depth;
+        int horizontal;
+        int aim;
+    };
+
+    using Input = std::vector<Command>;
+
+    Command ParseCommand(std::string_view inputLine);
+    Input ReadInput(std::string_view text);
+
+    // ApplyCommand follows the aimed rules from part two
+    Position ApplyCommand(Position currentPos, Command cmd);
+    Position ApplyCommands(std::vector<Command> const& commands);
+
+    int PartTwo(Input const& input);
+
+    // Part two, following the commands on this thread while another parses
+    // them (--pipeline).
+    int SolvePipelined(std::string_view text);
+
+    // Part two in constant memory, reading the commands as they come (--stream).
+    int SolveStreaming(Common::LineStream& lines);
+
+    // The straightforward versions the faster ones are checked against (aoc_diff).
+    namespace Reference
+    {
+        // Reads each line through a std::istringstream.
+        Input ReadInput(std::string_view text);
+        int PartTwo(Input const& input);
+    }
+}
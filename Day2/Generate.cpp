@@ -0,0 +1,33 @@
+// Generate.cpp : Writes a Day2 input of any size, one command per line.
+//   Day2_gen [commands] [--scale=F] [--seed=N]
+
+#include <iostream>
+
+#include "Common/Generator.h"
+
+int main(int argc, char* argv[])
+{
+    Common::Generator gen{ argc, argv, 1000 };
+
+    // never rise above the surface
+    int depth = 0;
+    for (std::size_t i = 0; i < gen.Size(); ++i)
+    {
+        auto x = gen.Uniform(1, 9);
+        switch (gen.Uniform(0, 2))
+        {
+        case 0:
+            std::cout << "forward " << x << "\n";
+            break;
+        case 1:
+            depth += x;
+            std::cout << "down " << x << "\n";
+            break;
+        default:
+            x = std::min(x, depth);
+            depth -= x;
+            std::cout << "up " << x << "\n";
+            break;
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#include <iostream>
+
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/Input.h"
+#include "Common/ParseCache.h"
+#include "Common/Pipeline.h"
+#include "Day2.h"
+
+int main(int argc, char* argv[])
+{
+    if (auto batch = Common::ReadBatchOptions(argc, argv); batch.enabled)
+    {
+        return Common::RunBatch(batch, Day2::ReadInput, Day2::PartTwo);
+    }
+
+    Common::Benchmark bench{ argc, argv };
+    if (Common::StreamRequested(argc, argv))
+    {
+        auto product = bench.Measure("streamed", [&]
+            {
+                auto lines = Common::LineStream::FromCommandLine(argc, argv);
+                return Day2::SolveStreaming(lines);
+            });
+        std::cout << "Depth * horizontal distance = " << product << "\n";
+        bench.Report(std::cout);
+        return 0;
+    }
+
+    Common::ParseCache cache{ argc, argv };
+    auto buffer = Common::InputBuffer::FromCommandLine(argc, argv);
+    if (Common::PipelineRequested(argc, argv))
+    {
+        auto product = bench.Measure("pipelined", [&] { return Day2::SolvePipelined(buffer.Text()); }, { .bytes = buffer.Size() });
+        std::cout << "Depth * horizontal distance = " << product << "\n";
+        bench.Report(std::cout);
+        return 0;
+    }
+
+    auto commands = bench.Measure("parse", [&] { return cache.Read("Day2", buffer.Text(), Day2::ReadInput); }, { .bytes = buffer.Size() });
+
+    auto product = bench.Measure("part two", [&] { return Day2::PartTwo(commands); }, { .items = commands.size() });
+
+    std::cout << "Depth * horizontal distance = " << product << "\n";
+
+    bench.Report(std::cout);
+}
@@ -1,168 +1,199 @@
-#include <algorithm>
+#include "Day20.h"
+
 #include <array>
-#include <iostream>
-#include <iterator>
-#include <string>
-#include <vector>
+#include <utility>
 
-enum class Pixel
-{
-    Dark,
-    Light
-};
+#include "Common/Trace.h"
 
-class Grid
+namespace Day20
 {
-public:
-    Grid(int width, int height)
-        : width_{ width },
-        height_{ height },
-        pixels_(height_, std::vector<Pixel>(width_, Pixel::Dark))
-    {}
-
-    Pixel At(int x, int y, Pixel def) const noexcept
+    std::vector<Pixel> ReadEnhancementKey(Common::LineReader& lines)
     {
-        if (x < 0 || x >= width_)
-            return def;
-        if (y < 0 || y >= height_)
-            return def;
-        return pixels_[y][x];
-    }
+        std::string_view line;
+        lines.Next(line);
 
-    void Set(int x, int y, Pixel p)
-    {
-        pixels_[y][x] = p;
-    }
+        std::vector<Pixel> result(512, Pixel::Dark);
 
-    int Width() const noexcept
-    {
-        return width_;
-    }
-    int Height() const noexcept
-    {
-        return height_;
+        std::transform(line.begin(), line.end(), result.begin(), [](char c) { return c == '#' ? Pixel::Light : Pixel::Dark; });
+
+        return result;
     }
 
-    void Print(std::ostream& out) const
+    template<typename PixelGrid>
+    PixelGrid ReadPixels(Common::LineReader& lines)
     {
-        for (auto const& row : pixels_)
+        std::vector<std::string_view> gridData;
+        std::string_view line;
+        while (lines.Next(line))
         {
-            std::transform(row.begin(), row.end(), std::ostream_iterator<char>(out), [](Pixel p) { return p == Pixel::Light ? '#' : '.'; });
-            out << "\n";
+            if (line.empty() && !gridData.empty())
+            {
+                break;
+            }
+            if (line.empty())
+            {
+                continue;
+            }
+
+            gridData.push_back(line);
         }
-    }
 
-    int LitPixels() const noexcept
-    {
-        int count = 0;
-        for (auto const& row : pixels_)
+        int width = static_cast<int>(gridData[0].size());
+        int height = static_cast<int>(gridData.size());
+
+        PixelGrid result(width, height);
+
+        for (int y = 0; y < height; ++y)
         {
-            count += static_cast<int>(std::count_if(row.begin(), row.end(), [](Pixel p) { return p == Pixel::Light; }));
+            for (int x = 0; x < width; ++x)
+            {
+                result.Set(x, y, gridData[y][x] == '#' ? Pixel::Light : Pixel::Dark);
+            }
         }
-        return count;
-    }
 
-private:
-    int width_;
-    int height_;
-    std::vector<std::vector<Pixel>> pixels_;
-};
+        return result;
+    }
 
-auto ReadEnhancementKey()
-{
-    std::string line;
-    std::getline(std::cin, line);
+    Grid ReadImage(Common::LineReader& lines)
+    {
+        return ReadPixels<Grid>(lines);
+    }
 
-    std::vector<Pixel> result(512, Pixel::Dark);
+    Input ReadInput(std::string_view text)
+    {
+        Common::LineReader lines{ text };
 
-    std::transform(line.begin(), line.end(), result.begin(), [](char c) { return c == '#' ? Pixel::Light : Pixel::Dark; });
+        auto enhanceKey = ReadEnhancementKey(lines);
 
-    return result;
-}
+        auto startGrid = ReadImage(lines);
+        return { std::move(enhanceKey), std::move(startGrid) };
+    }
 
-auto ReadInput()
-{
-    std::vector<std::string> gridData;
-    std::string line;
-    while (std::getline(std::cin, line))
+    // The border of grid has to be set to the pixels around it first.
+    auto EnhanceGrid(Grid const& grid, std::vector<Pixel> const& enhanceKey)
     {
-        if (line.empty() && !gridData.empty())
+        AOC_TRACE_SCOPE("Day20 EnhanceGrid");
+        int newWidth = grid.Width() + 2;
+        int newHeight = grid.Height() + 2;
+
+        Grid newGrid(newWidth, newHeight);
+
+        for (int y = 0; y < newHeight; ++y)
         {
-            break;
+            for (int x = 0; x < newWidth; ++x)
+            {
+                std::array lookup{
+                    grid.At(x - 2, y - 2),
+                    grid.At(x - 1, y - 2),
+                    grid.At(x, y - 2),
+                    grid.At(x - 2, y - 1),
+                    grid.At(x - 1, y - 1),
+                    grid.At(x, y - 1),
+                    grid.At(x - 2, y),
+                    grid.At(x - 1, y),
+                    grid.At(x, y)
+                };
+                int enhanceIndex = 0;
+                for (auto const& p : lookup)
+                {
+                    enhanceIndex <<= 1;
+                    enhanceIndex += p == Pixel::Light ? 1 : 0;
+                }
+                newGrid.Set(x, y, enhanceKey[enhanceIndex]);
+            }
         }
-        if (line.empty())
+        AOC_TRACE_COUNT("Day20 pixels enhanced", static_cast<std::uint64_t>(newWidth) * newHeight);
+        return newGrid;
+    }
+
+    std::vector<int> EnhanceRepeatedly(Grid grid, std::vector<Pixel> const& enhanceKey, int iterations)
+    {
+        std::vector<int> litPixels;
+        Pixel def = Pixel::Dark;
+
+        for (int i = 0; i < iterations; ++i)
         {
-            continue;
+            grid.SetBorder(def);
+            grid = EnhanceGrid(grid, enhanceKey);
+            litPixels.push_back(grid.LitPixels());
+            if (enhanceKey.front() == Pixel::Light)
+            {
+                def = i % 2 == 0 ? enhanceKey.front() : enhanceKey.back();
+            }
         }
-
-        gridData.push_back(line);
+        return litPixels;
     }
 
-    int width = static_cast<int>(gridData[0].size());
-    int height = static_cast<int>(gridData.size());
+    int PartOne(Input const& input)
+    {
+        return EnhanceRepeatedly(input.image, input.enhanceKey, 2).back();
+    }
 
-    Grid result(width, height);
+    int PartTwo(Input const& input)
+    {
+        return EnhanceRepeatedly(input.image, input.enhanceKey, 50).back();
+    }
 
-    for (int y = 0; y < height; ++y)
+    namespace Reference
     {
-        for (int x = 0; x < width; ++x)
+        Input ReadInput(std::string_view text)
         {
-            result.Set(x, y, gridData[y][x] == '#' ? Pixel::Light : Pixel::Dark);
+            Common::LineReader lines{ text };
+
+            auto enhanceKey = ReadEnhancementKey(lines);
+
+            auto startGrid = ReadPixels<Grid>(lines);
+            return { std::move(enhanceKey), std::move(startGrid) };
         }
-    }
 
-    return result;
-}
+        Grid EnhanceGrid(Grid const& grid, std::vector<Pixel> const& enhanceKey, Pixel def)
+        {
+            int newWidth = grid.Width() + 2;
+            int newHeight = grid.Height() + 2;
 
-auto EnhanceGrid(Grid const& grid, std::vector<Pixel> const& enhanceKey, Pixel def)
-{
-    int newWidth = grid.Width() + 2;
-    int newHeight = grid.Height() + 2;
+            Grid newGrid(newWidth, newHeight);
 
-    Grid newGrid(newWidth, newHeight);
+            for (int y = 0; y < newHeight; ++y)
+            {
+                for (int x = 0; x < newWidth; ++x)
+                {
+                    int enhanceIndex = 0;
+                    for (int dy = -2; dy <= 0; ++dy)
+                    {
+                        for (int dx = -2; dx <= 0; ++dx)
+                        {
+                            enhanceIndex = (enhanceIndex << 1) + (grid.At(x + dx, y + dy, def) == Pixel::Light ? 1 : 0);
+                        }
+                    }
+                    newGrid.Set(x, y, enhanceKey[enhanceIndex]);
+                }
+            }
+            return newGrid;
+        }
 
-    for (int y = 0; y < newHeight; ++y)
-    {
-        for (int x = 0; x < newWidth; ++x)
+        int LitAfter(Input const& input, int iterations)
         {
-            std::array lookup{
-                grid.At(x - 2, y - 2, def),
-                grid.At(x - 1, y - 2, def),
-                grid.At(x, y - 2, def),
-                grid.At(x - 2, y - 1, def),
-                grid.At(x - 1, y - 1, def),
-                grid.At(x, y - 1, def),
-                grid.At(x - 2, y, def),
-                grid.At(x - 1, y, def),
-                grid.At(x, y, def)
-            };
-            int enhanceIndex = 0;
-            for (auto const& p : lookup)
+            auto grid = input.image;
+            Pixel def = Pixel::Dark;
+            for (int i = 0; i < iterations; ++i)
             {
-                enhanceIndex <<= 1;
-                enhanceIndex += p == Pixel::Light ? 1 : 0;
+                grid = EnhanceGrid(grid, input.enhanceKey, def);
+                if (input.enhanceKey.front() == Pixel::Light)
+                {
+                    def = i % 2 == 0 ? input.enhanceKey.front() : input.enhanceKey.back();
+                }
             }
-            newGrid.Set(x, y, enhanceKey[enhanceIndex]);
+            return grid.LitPixels();
         }
-    }
-    return newGrid;
-}
-
-int main()
-{
-    auto enhanceKey = ReadEnhancementKey();
-
-    auto startGrid = ReadInput();
 
-    Pixel def = Pixel::Dark;
+        int PartOne(Input const& input)
+        {
+            return LitAfter(input, 2);
+        }
 
-    for (int i = 0; i < 50; ++i)
-    {
-        startGrid = EnhanceGrid(startGrid, enhanceKey, def);
-        std::cout << "Total lit pixels after " << i + 1 << " iterations: " << startGrid.LitPixels() << "\n";
-        if (enhanceKey.front() == Pixel::Light)
+        int PartTwo(Input const& input)
         {
-            def = i % 2 == 0 ? enhanceKey.front() : enhanceKey.back();
+            return LitAfter(input, 50);
         }
     }
 }
@@ -0,0 +1,164 @@
+// Day20.h : Trench Map. Runs the image enhancement algorithm over the trench image.
+
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include "Common/Grid2D.h"
+#include "Common/Input.h"
+
+namespace Day20
+{
+    enum class Pixel
+    {
+        Dark,
+        Light
+    };
+
+    // The image, with a border two pixels wide standing in for the rest of
+    // the infinite image, so that enhancing it needs no bounds checks.
+    class Grid
+    {
+    public:
+        static int constexpr Border = 2;
+
+        Grid(int width, int height)
+            : pixels_(width, height, Pixel::Dark)
+        {}
+
+        // x and y can be up to Border outside the image.
+        Pixel At(int x, int y) const noexcept
+        {
+            return pixels_(x, y);
+        }
+
+        void Set(int x, int y, Pixel p)
+        {
+            pixels_(x, y) = p;
+        }
+
+        // Sets every pixel of the border, the same as the infinite image around it.
+        void SetBorder(Pixel p)
+        {
+            pixels_.FillBorder(p);
+        }
+
+        int Width() const noexcept
+        {
+            return pixels_.Width();
+        }
+        int Height() const noexcept
+        {
+            return pixels_.Height();
+        }
+
+        void Print(std::ostream& out) const
+        {
+            for (int y = 0; y < Height(); ++y)
+            {
+                auto row = pixels_.Row(y);
+                std::transform(row.begin(), row.end(), std::ostream_iterator<char>(out), [](Pixel p) { return p == Pixel::Light ? '#' : '.'; });
+                out << "\n";
+            }
+        }
+
+        int LitPixels() const noexcept
+        {
+            int count = 0;
+            for (int y = 0; y < Height(); ++y)
+            {
+                auto row = pixels_.Row(y);
+                count += static_cast<int>(std::count(row.begin(), row.end(), Pixel::Light));
+            }
+            return count;
+        }
+
+    private:
+        Common::Grid2D<Pixel, Border> pixels_;
+    };
+
+    struct Input
+    {
+        std::vector<Pixel> enhanceKey;
+        Grid image;
+    };
+
+    std::vector<Pixel> ReadEnhancementKey(Common::LineReader& lines);
+    Grid ReadImage(Common::LineReader& lines);
+    Input ReadInput(std::string_view text);
+
+    // number of lit pixels after each round of enhancement
+    std::vector<int> EnhanceRepeatedly(Grid grid, std::vector<Pixel> const& enhanceKey, int iterations);
+
+    int PartOne(Input const& input);
+    int PartTwo(Input const& input);
+
+    // The straightforward versions the faster ones are checked against (aoc_diff).
+    namespace Reference
+    {
+        // The image as a vector of rows, where every read checks the edges
+        // and gives the infinite image's pixel off them.
+        class Grid
+        {
+        public:
+            Grid(int width, int height)
+                : width_{ width },
+                height_{ height },
+                pixels_(height_, std::vector<Pixel>(width_, Pixel::Dark))
+            {}
+
+            Pixel At(int x, int y, Pixel def) const noexcept
+            {
+                if (x < 0 || x >= width_)
+                    return def;
+                if (y < 0 || y >= height_)
+                    return def;
+                return pixels_[y][x];
+            }
+
+            void Set(int x, int y, Pixel p)
+            {
+                pixels_[y][x] = p;
+            }
+
+            int Width() const noexcept
+            {
+                return width_;
+            }
+            int Height() const noexcept
+            {
+                return height_;
+            }
+
+            int LitPixels() const noexcept
+            {
+                int count = 0;
+                for (auto const& row : pixels_)
+                {
+                    count += static_cast<int>(std::count(row.begin(), row.end(), Pixel::Light));
+                }
+                return count;
+            }
+
+        private:
+            int width_;
+            int height_;
+            std::vector<std::vector<Pixel>> pixels_;
+        };
+
+        struct Input
+        {
+            std::vector<Pixel> enhanceKey;
+            Grid image;
+        };
+
+        Input ReadInput(std::string_view text);
+
+        int PartOne(Input const& input);
+        int PartTwo(Input const& input);
+    }
+}
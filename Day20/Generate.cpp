@@ -0,0 +1,37 @@
+// Generate.cpp : Writes a Day20 input of any size: the enhancement key, then a square image.
+//   Day20_gen [side] [--scale=F] [--seed=N]
+
+#include <iostream>
+#include <string>
+
+#include "Common/Generator.h"
+
+int main(int argc, char* argv[])
+{
+    Common::Generator gen{ argc, argv, 100 };
+
+    auto pixel = [&] { return gen.Chance(0.5) ? '#' : '.'; };
+
+    // if the dark infinity lights up it must go dark again next time,
+    // otherwise the count would be infinite
+    std::string key(512, '.');
+    for (auto& c : key)
+    {
+        c = pixel();
+    }
+    if (key.front() == '#')
+    {
+        key.back() = '.';
+    }
+    std::cout << key << "\n\n";
+
+    std::string row(gen.Size(), '.');
+    for (std::size_t y = 0; y < gen.Size(); ++y)
+    {
+        for (auto& c : row)
+        {
+            c = pixel();
+        }
+        std::cout << row << "\n";
+    }
+}
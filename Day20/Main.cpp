@@ -0,0 +1,27 @@
+#include <iostream>
+
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/Input.h"
+#include "Day20.h"
+
+int main(int argc, char* argv[])
+{
+    if (auto batch = Common::ReadBatchOptions(argc, argv); batch.enabled)
+    {
+        return Common::RunBatch(batch, Day20::ReadInput, Day20::PartOne, Day20::PartTwo);
+    }
+
+    Common::Benchmark bench{ argc, argv };
+    auto buffer = Common::InputBuffer::FromCommandLine(argc, argv);
+    auto input = bench.Measure("parse", [&] { return Day20::ReadInput(buffer.Text()); }, { .bytes = buffer.Size() });
+
+    auto litPixels = bench.Measure("part two", [&] { return Day20::EnhanceRepeatedly(input.image, input.enhanceKey, 50); }, { .items = 50 });
+
+    for (std::size_t i = 0; i < litPixels.size(); ++i)
+    {
+        std::cout << "Total lit pixels after " << i + 1 << " iterations: " << litPixels[i] << "\n";
+    }
+
+    bench.Report(std::cout);
+}
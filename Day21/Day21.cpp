@@ -1,232 +1,60 @@
-#include <array>
-#include <iostream>
-#include <map>
-#include <regex>
-#include <string>
-
-namespace PartOne
-{
-    class DeterministicDice
-    {
-    public:
-        DeterministicDice(int sides)
-            : sides_{ sides },
-            nextRoll_{ 1 },
-            rollCount_{ 0 }
-        {}
-
-        int Roll() noexcept
-        {
-            int result = nextRoll_;
-            ++nextRoll_;
-            ++rollCount_;
-            if (nextRoll_ > sides_)
-            {
-                nextRoll_ = 1;
-            }
-            return result;
-        }
+#include "Day21.h"
 
-        int TimesRolled() const noexcept
-        {
-            return rollCount_;
-        }
-
-    private:
-        int const sides_;
-        int nextRoll_;
-        int rollCount_;
-    };
+#include <algorithm>
+#include <map>
+#include <utility>
 
-    struct Player
-    {
-        int position;
-        int score;
-    };
+#include "Common/FlatHash.h"
+#include "Common/Trace.h"
 
-    void TakeTurn(Player& p, DeterministicDice& d)
+namespace Day21
+{
+    namespace DiracGame
     {
-        int totalRoll = 0;
-        for (int i = 0; i < 3; ++i)
-        {
-            totalRoll += d.Roll();
-        }
-        p.position += totalRoll % 10;
-        if (p.position > 10)
+        std::array<uint64_t, 2> Run(int playerOnePos, int playerTwoPos)
         {
-            p.position %= 10;
+            AOC_TRACE_SCOPE("Day21 Dirac game");
+            return Play<Common::FlatMap<Game, uint64_t>>(playerOnePos, playerTwoPos);
         }
-        p.score += p.position;
     }
 
-    void Run(int playerOnePos, int playerTwoPos)
+    int PartOne(Input const& input)
     {
-        Player one{ playerOnePos, 0 };
-        Player two{ playerTwoPos, 0 };
-
-        DeterministicDice dice(100);
-
-        Player winner;
-        Player loser;
-
-        while (true)
-        {
-            TakeTurn(one, dice);
-            if (one.score >= 1000)
-            {
-                winner = one;
-                loser = two;
-                break;
-            }
-            TakeTurn(two, dice);
-            if (two.score >= 1000)
-            {
-                winner = two;
-                loser = one;
-                break;
-            }
-        }
-
-        std::cout << "Loser score multiplied by roll count: " << loser.score * dice.TimesRolled() << "\n";
+        return DeterministicGame::Run(input.playerOne, input.playerTwo);
     }
-}
-
-namespace PartTwo
-{
-    struct Player
-    {
-        int position;
-        int score;
-        auto operator<=>(const Player&) const = default;
-    };
-    struct Game
-    {
-        Player one;
-        Player two;
-        auto operator<=>(const Game&) const = default;
-    };
-    using GameFreqs = std::map<Game, uint64_t>;
 
-    Player MovePlayer(Player const& p, int roll)
+    uint64_t PartTwo(Input const& input)
     {
-        Player next{ p.position + roll, p.score };
-        if (next.position > 10)
-        {
-            next.position = next.position % 10;
-        }
-        next.score += next.position;
-        return next;
+        auto playerWins = DiracGame::Run(input.playerOne, input.playerTwo);
+        return std::max(playerWins[0], playerWins[1]);
     }
 
-    Game MakeMove(Game const& game, int roll, bool playerOne)
+    namespace Reference
     {
-        if (playerOne)
-        {
-            Player one = MovePlayer(game.one, roll);
-            return { one, game.two };
-        }
-        else
+        Input ReadInput(std::string_view text)
         {
-            Player two = MovePlayer(game.two, roll);
-            return { game.one, two };
-        }
-    }
-
-    auto Move(GameFreqs const &games, bool playerOne)
-    {
-        GameFreqs nextGames;
-        uint64_t wins = 0;
-
-        static std::map<int, int> const waysToRoll = {
-            {3, 1},
-            {4, 3},
-            {5, 6},
-            {6, 7},
-            {7, 6},
-            {8, 3},
-            {9, 1}
-        };
-
-        for (auto const& [game, count] : games)
-        {
-            for (auto const& [roll, ways] : waysToRoll)
+            Common::LineReader lines{ text };
+            int positions[2] = { -1, -1 };
+            std::string_view line;
+            for (auto& position : positions)
             {
-                auto newGameState = MakeMove(game, roll, playerOne);
-                auto newCount = count * ways;
-                if (newGameState.one.score > 20 || newGameState.two.score > 20)
-                {
-                    wins += newCount;
-                }
-                else
+                if (lines.Next(line))
                 {
-                    if (nextGames.contains(newGameState))
+                    if (auto colon = line.rfind(':'); colon != std::string_view::npos)
                     {
-                        nextGames[newGameState] += newCount;
-                    }
-                    else
-                    {
-                        nextGames[newGameState] = newCount;
+                        auto number = line.substr(colon + 1);
+                        Common::SkipSpaces(number);
+                        position = Common::ToNumber(number);
                     }
                 }
             }
+            return { positions[0], positions[1] };
         }
-        return std::make_pair(wins, nextGames);
-    }
-
-    void Run(int playerOnePos, int playerTwoPos)
-    {
-        GameFreqs gameCounts;
 
-        Game initial{ {playerOnePos, 0}, {playerTwoPos, 0} };
-        gameCounts[initial] = 1;
-
-        std::array<uint64_t, 2> playerWins{ 0, 0 };
-        bool playerOneTurn = true;
-
-        while (!gameCounts.empty())
+        uint64_t PartTwo(Input const& input)
         {
-            auto moveResult = Move(gameCounts, playerOneTurn);
-            if (playerOneTurn)
-            {
-                playerWins[0] += moveResult.first;
-            }
-            else
-            {
-                playerWins[1] += moveResult.first;
-            }
-            playerOneTurn = !playerOneTurn;
-            gameCounts = moveResult.second;
+            auto playerWins = DiracGame::Play<std::map<DiracGame::Game, uint64_t>>(input.playerOne, input.playerTwo);
+            return std::max(playerWins[0], playerWins[1]);
         }
-
-        std::cout << "Player one won " << playerWins[0] << " times\n";
-        std::cout << "Player two won " << playerWins[1] << " times\n";
     }
 }
-
-
-int ReadPlayerPosition()
-{
-    std::string line;
-    std::getline(std::cin, line);
-
-    std::regex posRegex("Player \\d starting position: (\\d)");
-    std::smatch matches;
-    if (std::regex_match(line, matches, posRegex))
-    {
-        if (matches.size() == 2)
-        {
-            return std::stoi(matches[1].str());
-        }
-    }
-    return -1;
-}
-
-int main()
-{
-    int playerOnePos = ReadPlayerPosition();
-    int playerTwoPos = ReadPlayerPosition();
-
-    PartOne::Run(playerOnePos, playerTwoPos);
-
-    PartTwo::Run(playerOnePos, playerTwoPos);
-}
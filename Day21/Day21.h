@@ -0,0 +1,360 @@
+// Day21.h : Dirac Dice. Plays the dice game with practice and quantum dice.
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <compare>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Common/Input.h"
+#include "Common/Pattern.h"
+#include "Common/Trace.h"
+
+namespace Day21
+{
+    // Starting positions on the board.
+    struct Input
+    {
+        int playerOne;
+        int playerTwo;
+    };
+
+    // Everything here but DiracGame::Run can be run by the compiler, for AOC_EMBED_INPUTS.
+    constexpr int ReadPlayerPosition(Common::LineReader& lines)
+    {
+        std::string_view line;
+        lines.Next(line);
+
+        int player = 0;
+        int position = 0;
+        if (!Common::Match<"Player {} starting position: {}">(line, player, position))
+        {
+            throw std::runtime_error("Could not read a starting position");
+        }
+        if (position < 1 || position > 10)
+        {
+            throw std::out_of_range("A starting position must be from 1 to 10");
+        }
+        return position;
+    }
+
+    constexpr Input ReadInput(std::string_view text)
+    {
+        Common::LineReader lines{ text };
+
+        int playerOnePos = ReadPlayerPosition(lines);
+        int playerTwoPos = ReadPlayerPosition(lines);
+        return { playerOnePos, playerTwoPos };
+    }
+
+    namespace DeterministicGame
+    {
+        class DeterministicDice
+        {
+        public:
+            constexpr DeterministicDice(int sides)
+                : sides_{ sides },
+                nextRoll_{ 1 },
+                rollCount_{ 0 }
+            {}
+
+            constexpr int Roll() noexcept
+            {
+                int result = nextRoll_;
+                ++nextRoll_;
+                ++rollCount_;
+                if (nextRoll_ > sides_)
+                {
+                    nextRoll_ = 1;
+                }
+                return result;
+            }
+
+            constexpr int TimesRolled() const noexcept
+            {
+                return rollCount_;
+            }
+
+        private:
+            int const sides_;
+            int nextRoll_;
+            int rollCount_;
+        };
+
+        struct Player
+        {
+            int position;
+            int score;
+        };
+
+        constexpr void TakeTurn(Player& p, DeterministicDice& d) noexcept
+        {
+            int totalRoll = 0;
+            for (int i = 0; i < 3; ++i)
+            {
+                totalRoll += d.Roll();
+            }
+            p.position += totalRoll % 10;
+            if (p.position > 10)
+            {
+                p.position %= 10;
+            }
+            p.score += p.position;
+        }
+
+        // the losing score multiplied by the number of rolls
+        constexpr int Run(int playerOnePos, int playerTwoPos) noexcept
+        {
+            Player one{ playerOnePos, 0 };
+            Player two{ playerTwoPos, 0 };
+
+            DeterministicDice dice(100);
+
+            Player loser{};
+
+            while (true)
+            {
+                TakeTurn(one, dice);
+                if (one.score >= 1000)
+                {
+                    loser = two;
+                    break;
+                }
+                TakeTurn(two, dice);
+                if (two.score >= 1000)
+                {
+                    loser = one;
+                    break;
+                }
+            }
+
+            return loser.score * dice.TimesRolled();
+        }
+    }
+
+    namespace DiracGame
+    {
+        struct Player
+        {
+            int position;
+            int score;
+            auto operator<=>(const Player&) const = default;
+        };
+        struct Game
+        {
+            Player one;
+            Player two;
+            auto operator<=>(const Game&) const = default;
+        };
+
+        constexpr Player MovePlayer(Player const& p, int roll) noexcept
+        {
+            Player next{ p.position + roll, p.score };
+            if (next.position > 10)
+            {
+                next.position = next.position % 10;
+            }
+            next.score += next.position;
+            return next;
+        }
+
+        constexpr Game MakeMove(Game const& game, int roll, bool playerOne) noexcept
+        {
+            if (playerOne)
+            {
+                Player one = MovePlayer(game.one, roll);
+                return { one, game.two };
+            }
+            else
+            {
+                Player two = MovePlayer(game.two, roll);
+                return { game.one, two };
+            }
+        }
+
+        // Game counts with a slot for every game still going, which unlike a
+        // hash map the compiler can use. Has just enough of a map's interface
+        // for Move and Play. A game counted zero times isn't there.
+        class GameTable
+        {
+        public:
+            constexpr GameTable()
+                : counts_(Slots, 0)
+            {}
+
+            constexpr bool contains(Game const& game) const noexcept
+            {
+                return counts_[Slot(game)] != 0;
+            }
+            constexpr uint64_t& operator[](Game const& game)
+            {
+                auto& count = counts_[Slot(game)];
+                if (count == 0)
+                {
+                    games_.push_back(game);
+                }
+                return count;
+            }
+
+            constexpr bool empty() const noexcept
+            {
+                return games_.empty();
+            }
+            constexpr std::size_t size() const noexcept
+            {
+                return games_.size();
+            }
+
+            // Gives each game with its count, in the order they were added.
+            class Iterator
+            {
+            public:
+                constexpr Iterator(GameTable const& table, std::size_t index) noexcept
+                    : table_{ &table },
+                    index_{ index }
+                {}
+
+                constexpr std::pair<Game, uint64_t> operator*() const noexcept
+                {
+                    auto const& game = table_->games_[index_];
+                    return { game, table_->counts_[Slot(game)] };
+                }
+                constexpr Iterator& operator++() noexcept
+                {
+                    ++index_;
+                    return *this;
+                }
+                constexpr bool operator==(Iterator const&) const noexcept = default;
+
+            private:
+                GameTable const* table_;
+                std::size_t index_;
+            };
+
+            constexpr Iterator begin() const noexcept
+            {
+                return { *this, 0 };
+            }
+            constexpr Iterator end() const noexcept
+            {
+                return { *this, games_.size() };
+            }
+
+        private:
+            // positions 1 to 10 and scores 0 to 20, for each player
+            static std::size_t constexpr Slots = 10 * 21 * 10 * 21;
+
+            static constexpr std::size_t Slot(Game const& game) noexcept
+            {
+                auto player = [](Player const& p)
+                {
+                    assert(p.position >= 1 && p.position <= 10 && p.score >= 0 && p.score < 21);
+                    return static_cast<std::size_t>((p.position - 1) * 21 + p.score);
+                };
+                return player(game.one) * 210 + player(game.two);
+            }
+
+            std::vector<uint64_t> counts_;
+            std::vector<Game> games_;
+        };
+
+        template<typename GameFreqs>
+        constexpr auto Move(GameFreqs const &games, bool playerOne)
+        {
+            GameFreqs nextGames;
+            uint64_t wins = 0;
+
+            // how many of the 27 rolls of three dice give each total
+            constexpr std::array<std::pair<int, int>, 7> waysToRoll = { {
+                {3, 1},
+                {4, 3},
+                {5, 6},
+                {6, 7},
+                {7, 6},
+                {8, 3},
+                {9, 1}
+            } };
+
+            for (auto const& [game, count] : games)
+            {
+                for (auto const& [roll, ways] : waysToRoll)
+                {
+                    auto newGameState = MakeMove(game, roll, playerOne);
+                    auto newCount = count * ways;
+                    if (newGameState.one.score > 20 || newGameState.two.score > 20)
+                    {
+                        wins += newCount;
+                    }
+                    else
+                    {
+                        if (nextGames.contains(newGameState))
+                        {
+                            nextGames[newGameState] += newCount;
+                        }
+                        else
+                        {
+                            nextGames[newGameState] = newCount;
+                        }
+                    }
+                }
+            }
+            return std::make_pair(wins, std::move(nextGames));
+        }
+
+        // the number of universes each player wins in
+        template<typename GameFreqs>
+        constexpr std::array<uint64_t, 2> Play(int playerOnePos, int playerTwoPos)
+        {
+            GameFreqs gameCounts;
+
+            Game initial{ {playerOnePos, 0}, {playerTwoPos, 0} };
+            gameCounts[initial] = 1;
+
+            std::array<uint64_t, 2> playerWins{ 0, 0 };
+            bool playerOneTurn = true;
+
+            while (!gameCounts.empty())
+            {
+                AOC_TRACE_COUNT_CONSTEXPR("Day21 Dirac turns", 1);
+                AOC_TRACE_COUNT_CONSTEXPR("Day21 game states", gameCounts.size());
+                auto moveResult = Move(gameCounts, playerOneTurn);
+                if (playerOneTurn)
+                {
+                    playerWins[0] += moveResult.first;
+                }
+                else
+                {
+                    playerWins[1] += moveResult.first;
+                }
+                playerOneTurn = !playerOneTurn;
+                gameCounts = std::move(moveResult.second);
+            }
+
+            return playerWins;
+        }
+
+        // Play with the game counts in a FlatMap.
+        std::array<uint64_t, 2> Run(int playerOnePos, int playerTwoPos);
+    }
+
+    int PartOne(Input const& input);
+    // The number of universes won by whichever player wins in more of them.
+    uint64_t PartTwo(Input const& input);
+
+    // The straightforward versions the faster ones are checked against (aoc_diff).
+    namespace Reference
+    {
+        // Reads each position as the number after the colon, whatever comes
+        // before it. Match takes a position of 10, which the std::regex it
+        // replaced, one digit wide, did not.
+        Input ReadInput(std::string_view text);
+
+        // Keeps the game counts in a std::map rather than a FlatMap.
+        uint64_t PartTwo(Input const& input);
+    }
+}
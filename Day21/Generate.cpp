@@ -0,0 +1,16 @@
+// Generate.cpp : Writes a Day21 input, the two starting positions.
+//   Day21_gen [--seed=N]
+//
+// The game is the same size whatever the input, so there's no size to choose.
+
+#include <iostream>
+
+#include "Common/Generator.h"
+
+int main(int argc, char* argv[])
+{
+    Common::Generator gen{ argc, argv, 1 };
+
+    std::cout << "Player 1 starting position: " << gen.Uniform(1, 10) << "\n";
+    std::cout << "Player 2 starting position: " << gen.Uniform(1, 10) << "\n";
+}
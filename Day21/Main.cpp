@@ -0,0 +1,48 @@
+#include <iostream>
+
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/Input.h"
+#include "Day21.h"
+
+#ifdef AOC_EMBEDDED_INPUT
+#include "EmbeddedInput.h"
+#endif
+
+int main(int argc, char* argv[])
+{
+    if (auto batch = Common::ReadBatchOptions(argc, argv); batch.enabled)
+    {
+        return Common::RunBatch(batch, Day21::ReadInput, Day21::PartOne, Day21::PartTwo);
+    }
+
+    if (Common::EmbeddedRequested(argc, argv))
+    {
+#ifdef AOC_EMBEDDED_INPUT
+        // worked out by the compiler
+        constexpr auto input = Day21::ReadInput(Common::EmbeddedInput);
+        constexpr auto partOne = Day21::DeterministicGame::Run(input.playerOne, input.playerTwo);
+        constexpr auto playerWins = Day21::DiracGame::Play<Day21::DiracGame::GameTable>(input.playerOne, input.playerTwo);
+        std::cout << "Loser score multiplied by roll count: " << partOne << "\n";
+        std::cout << "Player one won " << playerWins[0] << " times\n";
+        std::cout << "Player two won " << playerWins[1] << " times\n";
+        return 0;
+#else
+        std::cerr << "Day21 was built without an embedded input, configure with -DAOC_EMBED_INPUTS=ON\n";
+        return 1;
+#endif
+    }
+
+    Common::Benchmark bench{ argc, argv };
+    auto buffer = Common::InputBuffer::FromCommandLine(argc, argv);
+    auto input = bench.Measure("parse", [&] { return Day21::ReadInput(buffer.Text()); }, { .bytes = buffer.Size() });
+
+    auto partOne = bench.Measure("part one", [&] { return Day21::PartOne(input); });
+    std::cout << "Loser score multiplied by roll count: " << partOne << "\n";
+
+    auto playerWins = bench.Measure("part two", [&] { return Day21::DiracGame::Run(input.playerOne, input.playerTwo); });
+    std::cout << "Player one won " << playerWins[0] << " times\n";
+    std::cout << "Player two won " << playerWins[1] << " times\n";
+
+    bench.Report(std::cout);
+}
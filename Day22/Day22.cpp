@@ -1,235 +1,237 @@
-#include <iostream>
+#include "Day22.h"
+
+#include <algorithm>
+#include <compare>
+#include <cstdio>
+#include <optional>
 #include <list>
-#include <regex>
+#include <sstream>
 #include <string>
-#include <vector>
-
-enum class State
-{
-    Off,
-    On
-};
 
-struct RebootStep
-{
-    State state;
-    int minX;
-    int maxX;
-    int minY;
-    int maxY;
-    int minZ;
-    int maxZ;
-};
-
-struct Point
-{
-    int x;
-    int y;
-    int z;
-    auto operator<=>(const Point&) const = default;
-};
-Point operator-(Point const& a, Point const& b)
-{
-    return { a.x - b.x, a.y - b.y, a.z - b.z };
-}
-Point operator+(Point const& a, Point const& b)
-{
-    return { a.x + b.x, a.y + b.y, a.z + b.z };
-}
+#include "Common/Input.h"
+#include "Common/MemoryReport.h"
+#include "Common/Pattern.h"
+#include "Common/Pipeline.h"
+#include "Common/Trace.h"
 
-class Reactor
+namespace Day22
 {
-public:
-    Reactor()
-        : cubes(101, std::vector<std::vector<State>>(101, std::vector<State>(101, State::Off)))
-    {}
+    struct Point
+    {
+        int x;
+        int y;
+        int z;
+        auto operator<=>(const Point&) const = default;
+    };
+    Point operator-(Point const& a, Point const& b)
+    {
+        return { a.x - b.x, a.y - b.y, a.z - b.z };
+    }
+    Point operator+(Point const& a, Point const& b)
+    {
+        return { a.x + b.x, a.y + b.y, a.z + b.z };
+    }
 
-    void ApplyStep(RebootStep const& step)
+    class Reactor
     {
-        if (step.minX > 50 || step.maxX < -50)
-            return;
-        if (step.minY > 50 || step.maxY < -50)
-            return;
-        if (step.minZ > 50 || step.maxZ < -50)
-            return;
-
-        for (int x = step.minX; x <= step.maxX; ++x)
+    public:
+        Reactor()
+            : cubes(101, std::vector<std::vector<State>>(101, std::vector<State>(101, State::Off)))
+        {}
+
+        void ApplyStep(RebootStep const& step)
         {
-            for (int y = step.minY; y <= step.maxY; ++y)
+            if (step.minX > 50 || step.maxX < -50)
+                return;
+            if (step.minY > 50 || step.maxY < -50)
+                return;
+            if (step.minZ > 50 || step.maxZ < -50)
+                return;
+
+            for (int x = step.minX; x <= step.maxX; ++x)
             {
-                for (int z = step.minZ; z <= step.maxZ; ++z)
+                for (int y = step.minY; y <= step.maxY; ++y)
                 {
-                    SetCubeState(x, y, z, step.state);
+                    for (int z = step.minZ; z <= step.maxZ; ++z)
+                    {
+                        SetCubeState(x, y, z, step.state);
+                    }
                 }
             }
         }
-    }
 
-    int OnCubeCount() const noexcept
-    {
-        int onCount = 0;
-        for (auto const& plane : cubes)
+        int OnCubeCount() const noexcept
         {
-            for (auto const& row : plane)
+            int onCount = 0;
+            for (auto const& plane : cubes)
             {
-                for (auto const& c : row)
+                for (auto const& row : plane)
                 {
-                    onCount += c == State::On ? 1 : 0;
+                    for (auto const& c : row)
+                    {
+                        onCount += c == State::On ? 1 : 0;
+                    }
                 }
             }
+            return onCount;
         }
-        return onCount;
-    }
 
-private:
-    void SetCubeState(int x, int y, int z, State s)
-    {
-        if (x < -50 || 50 < x)
-            return;
-        if (y < -50 || 50 < y)
-            return;
-        if (z < -50 || 50 < z)
-            return;
-
-        cubes[x + 50][y + 50][z + 50] = s;
-    }
+        auto const& Cubes() const noexcept
+        {
+            return cubes;
+        }
 
-    std::vector<std::vector<std::vector<State>>> cubes;
-};
+    private:
+        void SetCubeState(int x, int y, int z, State s)
+        {
+            if (x < -50 || 50 < x)
+                return;
+            if (y < -50 || 50 < y)
+                return;
+            if (z < -50 || 50 < z)
+                return;
 
-class Chunk
-{
-public:
-    Chunk(int minX, int maxX, int minY, int maxY, int minZ, int maxZ)
-        : origin{ minX, minY, minZ },
-        size{ Point{ maxX, maxY, maxZ } - origin }
-    {}
+            cubes[x + 50][y + 50][z + 50] = s;
+        }
+
+        std::vector<std::vector<std::vector<State>>> cubes;
+    };
 
-    bool Intersects(Chunk const& other) const noexcept
+    class Chunk
     {
-        auto otherPos = other.origin;
-        auto otherTop = other.origin + other.size;
-        auto myTop = origin + size;
+    public:
+        Chunk(int minX, int maxX, int minY, int maxY, int minZ, int maxZ)
+            : origin{ minX, minY, minZ },
+            size{ Point{ maxX, maxY, maxZ } - origin }
+        {}
 
-        return (otherTop.x >= origin.x && otherPos.x <= myTop.x) &&
-            (otherTop.y >= origin.y && otherPos.y <= myTop.y) &&
-            (otherTop.z >= origin.z && otherPos.z <= myTop.z);
-    }
+        bool Intersects(Chunk const& other) const noexcept
+        {
+            auto otherPos = other.origin;
+            auto otherTop = other.origin + other.size;
+            auto myTop = origin + size;
 
-    uint64_t BlockSize() const noexcept
-    {
-        return (static_cast<uint64_t>(size.x) + 1) * (static_cast<uint64_t>(size.y) + 1) * (static_cast<uint64_t>(size.z) + 1);
-    }
+            return (otherTop.x >= origin.x && otherPos.x <= myTop.x) &&
+                (otherTop.y >= origin.y && otherPos.y <= myTop.y) &&
+                (otherTop.z >= origin.z && otherPos.z <= myTop.z);
+        }
 
-    friend std::vector<Chunk> CutChunkToFit(Chunk const& toFit, Chunk const& toCut);
+        uint64_t BlockSize() const noexcept
+        {
+            return (static_cast<uint64_t>(size.x) + 1) * (static_cast<uint64_t>(size.y) + 1) * (static_cast<uint64_t>(size.z) + 1);
+        }
 
-private:
-    Point origin;
-    Point size;
-};
+        friend std::vector<Chunk> CutChunkToFit(Chunk const& toFit, Chunk const& toCut);
 
-std::vector<Chunk> CutChunkToFit(Chunk const& toFit, Chunk const& toCut)
-{
-    Chunk remaining = toCut;
-    std::vector<Chunk> result;
+    private:
+        Point origin;
+        Point size;
+    };
 
-    if (remaining.origin.x < toFit.origin.x)
-    {
-        auto newSize = (toFit.origin.x - remaining.origin.x) - 1;
-        Chunk newChunk(remaining.origin.x, remaining.origin.x + newSize, remaining.origin.y, remaining.origin.y + remaining.size.y, remaining.origin.z, remaining.origin.z + remaining.size.z);
-        result.push_back(newChunk);
-        remaining.origin.x += newSize + 1;
-        remaining.size.x -= newSize + 1;
-    }
-    if (remaining.origin.x + remaining.size.x > toFit.origin.x + toFit.size.x)
-    {
-        auto newSize = (remaining.origin.x + remaining.size.x) - (toFit.origin.x + toFit.size.x);
-        Chunk newChunk(toFit.origin.x + toFit.size.x + 1, remaining.origin.x + remaining.size.x, remaining.origin.y, remaining.origin.y + remaining.size.y, remaining.origin.z, remaining.origin.z + remaining.size.z);
-        result.push_back(newChunk);
-        remaining.size.x -= newSize;
-    }
-    if (remaining.origin.y < toFit.origin.y)
-    {
-        auto newSize = (toFit.origin.y - remaining.origin.y) - 1;
-        Chunk newChunk(remaining.origin.x, remaining.origin.x + remaining.size.x, remaining.origin.y, remaining.origin.y + newSize, remaining.origin.z, remaining.origin.z + remaining.size.z);
-        result.push_back(newChunk);
-        remaining.origin.y += newSize + 1;
-        remaining.size.y -= newSize + 1;
-    }
-    if (remaining.origin.y + remaining.size.y > toFit.origin.y + toFit.size.y)
-    {
-        auto newSize = (remaining.origin.y + remaining.size.y) - (toFit.origin.y + toFit.size.y);
-        Chunk newChunk(remaining.origin.x, remaining.origin.x + remaining.size.x, toFit.origin.y + toFit.size.y + 1, remaining.origin.y + remaining.size.y, remaining.origin.z, remaining.origin.z + remaining.size.z);
-        result.push_back(newChunk);
-        remaining.size.y -= newSize;
-    }
-    if (remaining.origin.z < toFit.origin.z)
-    {
-        auto newSize = (toFit.origin.z - remaining.origin.z) - 1;
-        Chunk newChunk(remaining.origin.x, remaining.origin.x + remaining.size.x, remaining.origin.y, remaining.origin.y + remaining.size.y, remaining.origin.z, remaining.origin.z + newSize);
-        result.push_back(newChunk);
-        remaining.origin.z += newSize + 1;
-        remaining.size.z -= newSize + 1;
-    }
-    if (remaining.origin.z + remaining.size.z > toFit.origin.z + toFit.size.z)
+    std::vector<Chunk> CutChunkToFit(Chunk const& toFit, Chunk const& toCut)
     {
-        auto newSize = (remaining.origin.z + remaining.size.z) - (toFit.origin.z + toFit.size.z);
-        Chunk newChunk(remaining.origin.x, remaining.origin.x + remaining.size.x, remaining.origin.y, remaining.origin.y + remaining.size.y, toFit.origin.z + toFit.size.z + 1, remaining.origin.z + remaining.size.z);
-        result.push_back(newChunk);
-        remaining.size.z -= newSize;
-    }
+        Chunk remaining = toCut;
+        std::vector<Chunk> result;
 
-    return result;
-}
+        if (remaining.origin.x < toFit.origin.x)
+        {
+            auto newSize = (toFit.origin.x - remaining.origin.x) - 1;
+            Chunk newChunk(remaining.origin.x, remaining.origin.x + newSize, remaining.origin.y, remaining.origin.y + remaining.size.y, remaining.origin.z, remaining.origin.z + remaining.size.z);
+            result.push_back(newChunk);
+            remaining.origin.x += newSize + 1;
+            remaining.size.x -= newSize + 1;
+        }
+        if (remaining.origin.x + remaining.size.x > toFit.origin.x + toFit.size.x)
+        {
+            auto newSize = (remaining.origin.x + remaining.size.x) - (toFit.origin.x + toFit.size.x);
+            Chunk newChunk(toFit.origin.x + toFit.size.x + 1, remaining.origin.x + remaining.size.x, remaining.origin.y, remaining.origin.y + remaining.size.y, remaining.origin.z, remaining.origin.z + remaining.size.z);
+            result.push_back(newChunk);
+            remaining.size.x -= newSize;
+        }
+        if (remaining.origin.y < toFit.origin.y)
+        {
+            auto newSize = (toFit.origin.y - remaining.origin.y) - 1;
+            Chunk newChunk(remaining.origin.x, remaining.origin.x + remaining.size.x, remaining.origin.y, remaining.origin.y + newSize, remaining.origin.z, remaining.origin.z + remaining.size.z);
+            result.push_back(newChunk);
+            remaining.origin.y += newSize + 1;
+            remaining.size.y -= newSize + 1;
+        }
+        if (remaining.origin.y + remaining.size.y > toFit.origin.y + toFit.size.y)
+        {
+            auto newSize = (remaining.origin.y + remaining.size.y) - (toFit.origin.y + toFit.size.y);
+            Chunk newChunk(remaining.origin.x, remaining.origin.x + remaining.size.x, toFit.origin.y + toFit.size.y + 1, remaining.origin.y + remaining.size.y, remaining.origin.z, remaining.origin.z + remaining.size.z);
+            result.push_back(newChunk);
+            remaining.size.y -= newSize;
+        }
+        if (remaining.origin.z < toFit.origin.z)
+        {
+            auto newSize = (toFit.origin.z - remaining.origin.z) - 1;
+            Chunk newChunk(remaining.origin.x, remaining.origin.x + remaining.size.x, remaining.origin.y, remaining.origin.y + remaining.size.y, remaining.origin.z, remaining.origin.z + newSize);
+            result.push_back(newChunk);
+            remaining.origin.z += newSize + 1;
+            remaining.size.z -= newSize + 1;
+        }
+        if (remaining.origin.z + remaining.size.z > toFit.origin.z + toFit.size.z)
+        {
+            auto newSize = (remaining.origin.z + remaining.size.z) - (toFit.origin.z + toFit.size.z);
+            Chunk newChunk(remaining.origin.x, remaining.origin.x + remaining.size.x, remaining.origin.y, remaining.origin.y + remaining.size.y, toFit.origin.z + toFit.size.z + 1, remaining.origin.z + remaining.size.z);
+            result.push_back(newChunk);
+            remaining.size.z -= newSize;
+        }
 
-std::vector<RebootStep> ReadInput()
-{
-    std::regex stepRegex(R"((on|off) x=(-?\d+)\.\.(-?\d+),y=(-?\d+)\.\.(-?\d+),z=(-?\d+)\.\.(-?\d+))");
+        return result;
+    }
 
-    std::vector<RebootStep> steps;
+    std::optional<RebootStep> ParseStep(std::string_view line)
+    {
+        std::string_view state;
+        RebootStep step{};
+        if (Common::Match<"{} x={}..{},y={}..{},z={}..{}">(line, state, step.minX, step.maxX, step.minY, step.maxY, step.minZ, step.maxZ)
+            && (state == "on" || state == "off"))
+        {
+            step.state = state == "on" ? State::On : State::Off;
+            return step;
+        }
+        return {};
+    }
 
-    std::string line;
-    while (std::getline(std::cin, line))
+    Input ReadInput(std::string_view text)
     {
-        if (line.empty())
-            break;
+        std::vector<RebootStep> steps;
 
-        std::smatch matches;
-        if (std::regex_match(line, matches, stepRegex))
+        Common::LineReader lines{ text };
+        std::string_view line;
+        while (lines.Next(line))
         {
-            if (matches.size() == 8)
+            if (line.empty())
+                break;
+
+            if (auto step = ParseStep(line))
             {
-                auto state = matches[1].str() == "on" ? State::On : State::Off;
-                auto minX = std::stoi(matches[2].str());
-                auto maxX = std::stoi(matches[3].str());
-                auto minY = std::stoi(matches[4].str());
-                auto maxY = std::stoi(matches[5].str());
-                auto minZ = std::stoi(matches[6].str());
-                auto maxZ = std::stoi(matches[7].str());
-                steps.emplace_back(state, minX, maxX, minY, maxY, minZ, maxZ);
+                steps.push_back(*step);
             }
         }
+        return steps;
     }
-    return steps;
-}
 
-void RunPartOne(std::vector<RebootStep> const& rebootSteps)
-{
-    Reactor r;
-    for (auto const& step : rebootSteps)
+    int PartOne(Input const& rebootSteps)
     {
-        r.ApplyStep(step);
-    }
-
-    std::cout << "Part one: After initialisation " << r.OnCubeCount() << " cubes are turned on.\n\n";
-}
+        AOC_TRACE_SCOPE("Day22 init region");
+        Reactor r;
+        for (auto const& step : rebootSteps)
+        {
+            r.ApplyStep(step);
+        }
+        AOC_NOTE_FOOTPRINT("reactor cubes", r.Cubes());
 
-void RunPartTwo(std::vector<RebootStep> const& rebootSteps)
-{
-    std::vector<Chunk> onChunks;
+        return r.OnCubeCount();
+    }
 
-    for (auto const& step : rebootSteps)
+    // Adds a step to the chunks that are on, which never overlap.
+    void PlaceStep(std::vector<Chunk>& onChunks, RebootStep const& step)
     {
+        AOC_TRACE_COUNT("Day22 chunks checked", onChunks.size());
+        AOC_NOTE_FOOTPRINT("on chunks", onChunks);
         if (step.state == State::On)
         {
             Chunk newChunk(step.minX, step.maxX, step.minY, step.maxY, step.minZ, step.maxZ);
@@ -240,6 +242,7 @@ void RunPartTwo(std::vector<RebootStep> const& rebootSteps)
                 {
                     if (placed.Intersects(*it))
                     {
+                        AOC_TRACE_COUNT("Day22 chunks cut", 1);
                         auto chunkToCut = *it;
                         it = toPlace.erase(it);
                         auto replacementChunks = CutChunkToFit(placed, chunkToCut);
@@ -261,6 +264,7 @@ void RunPartTwo(std::vector<RebootStep> const& rebootSteps)
             {
                 if (offChunk.Intersects(c))
                 {
+                    AOC_TRACE_COUNT("Day22 chunks cut", 1);
                     auto left = CutChunkToFit(offChunk, c);
                     survivingChunks.insert(survivingChunks.end(), left.begin(), left.end());
                 }
@@ -273,19 +277,123 @@ void RunPartTwo(std::vector<RebootStep> const& rebootSteps)
         }
     }
 
+    uint64_t PartTwo(Input const& rebootSteps)
+    {
+        AOC_TRACE_SCOPE("Day22 place chunks");
+        std::vector<Chunk> onChunks;
+
+        for (auto const& step : rebootSteps)
+        {
+            PlaceStep(onChunks, step);
+        }
+
+
+        uint64_t totalSize = 0;
+        for (auto const& c : onChunks)
+        {
+            totalSize += c.BlockSize();
+        }
+        return totalSize;
+    }
 
-    uint64_t totalSize = 0;
-    for (auto const& c : onChunks)
+    std::pair<int, uint64_t> SolvePipelined(std::string_view text)
     {
-        totalSize += c.BlockSize();
+        AOC_TRACE_SCOPE("Day22 pipelined");
+        Reactor r;
+        std::vector<Chunk> onChunks;
+        Common::RunPipeline(text, ParseStep,
+            [&](RebootStep const& step)
+            {
+                r.ApplyStep(step);
+                PlaceStep(onChunks, step);
+            });
+
+        uint64_t totalSize = 0;
+        for (auto const& c : onChunks)
+        {
+            totalSize += c.BlockSize();
+        }
+        return { r.OnCubeCount(), totalSize };
     }
-    std::cout << "Part two: After full setup " << totalSize << " cubes are turned on.\n\n";
-}
 
-int main()
-{
-    auto rebootSteps = ReadInput();
+    namespace Reference
+    {
+        Input ReadInput(std::string_view text)
+        {
+            Input steps;
+            std::istringstream in{ std::string{ text } };
+            std::string line;
+            while (std::getline(in, line) && !line.empty())
+            {
+                char state[4] = {};
+                RebootStep step{};
+                if (std::sscanf(line.c_str(), "%3s x=%d..%d,y=%d..%d,z=%d..%d", state, &step.minX, &step.maxX, &step.minY, &step.maxY, &step.minZ, &step.maxZ) == 7)
+                {
+                    step.state = std::string_view{ state } == "on" ? State::On : State::Off;
+                    steps.push_back(step);
+                }
+            }
+            return steps;
+        }
+
+        std::optional<RebootStep> Overlap(RebootStep const& a, RebootStep const& b)
+        {
+            RebootStep overlap{ State::On,
+                std::max(a.minX, b.minX), std::min(a.maxX, b.maxX),
+                std::max(a.minY, b.minY), std::min(a.maxY, b.maxY),
+                std::max(a.minZ, b.minZ), std::min(a.maxZ, b.maxZ) };
+            if (overlap.minX > overlap.maxX || overlap.minY > overlap.maxY || overlap.minZ > overlap.maxZ)
+            {
+                return {};
+            }
+            return overlap;
+        }
+
+        int64_t CubesOn(Input const& steps)
+        {
+            // each cuboid with +1 if its cubes are counted, -1 if taken off again
+            std::vector<std::pair<RebootStep, int>> counted;
+            for (auto const& step : steps)
+            {
+                auto size = counted.size();
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    if (auto overlap = Overlap(step, counted[i].first))
+                    {
+                        counted.emplace_back(*overlap, -counted[i].second);
+                    }
+                }
+                if (step.state == State::On)
+                {
+                    counted.emplace_back(step, 1);
+                }
+            }
+            int64_t cubes = 0;
+            for (auto const& [c, sign] : counted)
+            {
+                cubes += sign * (int64_t{ c.maxX } - c.minX + 1) * (int64_t{ c.maxY } - c.minY + 1) * (int64_t{ c.maxZ } - c.minZ + 1);
+            }
+            return cubes;
+        }
+
+        int PartOne(Input const& input)
+        {
+            RebootStep const region{ State::On, -50, 50, -50, 50, -50, 50 };
+            Input clipped;
+            for (auto const& step : input)
+            {
+                if (auto overlap = Overlap(step, region))
+                {
+                    overlap->state = step.state;
+                    clipped.push_back(*overlap);
+                }
+            }
+            return static_cast<int>(CubesOn(clipped));
+        }
 
-    RunPartOne(rebootSteps);
-    RunPartTwo(rebootSteps);
+        uint64_t PartTwo(Input const& input)
+        {
+            return static_cast<uint64_t>(CubesOn(input));
+        }
+    }
 }
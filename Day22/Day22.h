@@ -0,0 +1,54 @@
+// Day22.h : Reactor Reboot. Switches cuboids of the reactor on and off.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Day22
+{
+    enum class State
+    {
+        Off,
+        On
+    };
+
+    struct RebootStep
+    {
+        State state;
+        int minX;
+        int maxX;
+        int minY;
+        int maxY;
+        int minZ;
+        int maxZ;
+    };
+
+    using Input = std::vector<RebootStep>;
+
+    // Empty if the line isn't a step.
+    std::optional<RebootStep> ParseStep(std::string_view line);
+    Input ReadInput(std::string_view text);
+
+    // Only the cubes within 50 of the origin count for part one.
+    int PartOne(Input const& input);
+    uint64_t PartTwo(Input const& input);
+
+    // Both parts, following the steps on this thread while another parses
+    // them (--pipeline).
+    std::pair<int, uint64_t> SolvePipelined(std::string_view text);
+
+    // The straightforward versions the faster ones are checked against (aoc_diff).
+    namespace Reference
+    {
+        // Reads each step with std::sscanf.
+        Input ReadInput(std::string_view text);
+        // Both keep every overlap of the steps as a cuboid counted for or
+        // against, rather than cutting cuboids up.
+        int PartOne(Input const& input);
+        uint64_t PartTwo(Input const& input);
+    }
+}
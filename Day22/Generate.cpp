@@ -0,0 +1,44 @@
+// Generate.cpp : Writes a Day22 input of any size, one reboot step per line.
+//   Day22_gen [steps] [--scale=F] [--seed=N]
+
+#include <array>
+#include <iostream>
+
+#include "Common/Generator.h"
+
+int main(int argc, char* argv[])
+{
+    Common::Generator gen{ argc, argv, 420 };
+
+    // like the puzzle, the first steps stay inside the initialisation region and
+    // the rest are large cuboids spread across the whole reactor
+    std::size_t const initSteps = 20;
+    for (std::size_t i = 0; i < gen.Size(); ++i)
+    {
+        bool init = i < initSteps;
+        int const extent = init ? 50 : 100000;
+        int const smallest = init ? 5 : 5000;
+        int const largest = init ? 50 : 40000;
+
+        // the later steps keep clear of the initialisation region altogether
+        std::array<int, 3> low;
+        std::array<int, 3> high;
+        bool clear = init;
+        do
+        {
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                low[axis] = gen.Uniform(-extent, extent - largest);
+                high[axis] = low[axis] + gen.Uniform(smallest, largest);
+                clear = clear || high[axis] < -50 || low[axis] > 50;
+            }
+        } while (!clear);
+
+        // the first step always turns cubes on, there's nothing to turn off yet
+        bool on = i == 0 || gen.Chance(init ? 0.75 : 0.6);
+        std::cout << (on ? "on" : "off")
+            << " x=" << low[0] << ".." << high[0]
+            << ",y=" << low[1] << ".." << high[1]
+            << ",z=" << low[2] << ".." << high[2] << "\n";
+    }
+}
@@ -0,0 +1,38 @@
+#include <iostream>
+
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/Input.h"
+#include "Common/ParseCache.h"
+#include "Common/Pipeline.h"
+#include "Day22.h"
+
+int main(int argc, char* argv[])
+{
+    if (auto batch = Common::ReadBatchOptions(argc, argv); batch.enabled)
+    {
+        return Common::RunBatch(batch, Day22::ReadInput, Day22::PartOne, Day22::PartTwo);
+    }
+
+    Common::Benchmark bench{ argc, argv };
+    Common::ParseCache cache{ argc, argv };
+    auto buffer = Common::InputBuffer::FromCommandLine(argc, argv);
+    if (Common::PipelineRequested(argc, argv))
+    {
+        auto [partOne, partTwo] = bench.Measure("pipelined", [&] { return Day22::SolvePipelined(buffer.Text()); }, { .bytes = buffer.Size() });
+        std::cout << "Part one: After initialisation " << partOne << " cubes are turned on.\n\n";
+        std::cout << "Part two: After full setup " << partTwo << " cubes are turned on.\n\n";
+        bench.Report(std::cout);
+        return 0;
+    }
+
+    auto rebootSteps = bench.Measure("parse", [&] { return cache.Read("Day22", buffer.Text(), Day22::ReadInput); }, { .bytes = buffer.Size() });
+
+    auto partOne = bench.Measure("part one", [&] { return Day22::PartOne(rebootSteps); }, { .items = rebootSteps.size() });
+    std::cout << "Part one: After initialisation " << partOne << " cubes are turned on.\n\n";
+
+    auto partTwo = bench.Measure("part two", [&] { return Day22::PartTwo(rebootSteps); }, { .items = rebootSteps.size() });
+    std::cout << "Part two: After full setup " << partTwo << " cubes are turned on.\n\n";
+
+    bench.Report(std::cout);
+}
@@ -1,407 +1,477 @@
+#include "Day23.h"
+
 #include <algorithm>
-#include <array>
-#include <iostream>
-#include <optional>
 #include <map>
+#include <optional>
 #include <set>
-#include <vector>
+#include <stdexcept>
+#include <utility>
 
-enum class AmphipodType
-{
-    Unknown = -1,
-    Amber,
-    Bronze,
-    Copper,
-    Desert
-};
-
-enum class NodeType
-{
-    Unknown = -1,
-    Corridor,
-    AmberBurrow,
-    BronzeBurrow,
-    CopperBurrow,
-    DesertBurrow
-};
-
-template<int CritterCount>
-struct WorldState
-{
-    std::array<std::pair<AmphipodType, int>, CritterCount> amphipodPositions;
-    auto operator<=>(const WorldState&) const = default;
+#include "Common/FlatHash.h"
+#include "Common/Input.h"
+#include "Common/MemoryReport.h"
+#include "Common/Trace.h"
 
-    std::optional<AmphipodType> TypeInPosition(int position) const noexcept
+namespace Day23
+{
+    enum class NodeType
+    {
+        Unknown = -1,
+        Corridor,
+        AmberBurrow,
+        BronzeBurrow,
+        CopperBurrow,
+        DesertBurrow
+    };
+
+    template<int CritterCount>
+    struct WorldState
     {
-        for (auto const& [type, pos] : amphipodPositions)
+        std::array<std::pair<AmphipodType, int>, CritterCount> amphipodPositions;
+        auto operator<=>(const WorldState&) const = default;
+
+        std::optional<AmphipodType> TypeInPosition(int position) const noexcept
         {
-            if (pos == position)
+            for (auto const& [type, pos] : amphipodPositions)
             {
-                return type;
+                if (pos == position)
+                {
+                    return type;
+                }
             }
+            return {};
         }
-        return {};
-    }
-};
+    };
 
-template<int CritterCount>
-using WorldStateEnergy = std::map<WorldState<CritterCount>, uint64_t>;
+    // std::pair has padding-free ints but isn't trivially copyable, so it can't be hashed by its bytes.
+    struct WorldStateHash
+    {
+        template<int CritterCount>
+        std::uint64_t operator()(WorldState<CritterCount> const& state) const noexcept
+        {
+            return Common::Hash<decltype(state.amphipodPositions)>{}(state.amphipodPositions);
+        }
+    };
 
+    template<int CritterCount>
+    using WorldStateEnergy = Common::FlatMap<WorldState<CritterCount>, uint64_t, WorldStateHash>;
 
-template<int CritterCount>
-void InsertWorldConfiguration(WorldStateEnergy<CritterCount>& stateEnergy, WorldState<CritterCount> const& state, uint64_t newEnergy)
-{
-    if (stateEnergy.contains(state))
-    {
-        stateEnergy[state] = std::min(stateEnergy[state], newEnergy);
-    }
-    else
-    {
-        stateEnergy.insert(std::make_pair(state, newEnergy));
-    }
-}
 
-bool AmphipodInCorrectBurrow(AmphipodType amphipod, NodeType node)
-{
-    switch (amphipod)
+    // Keeps the least energy seen for each state, in a FlatMap or a std::map.
+    template<typename StateEnergy, int CritterCount>
+    void InsertWorldConfiguration(StateEnergy& stateEnergy, WorldState<CritterCount> const& state, uint64_t newEnergy)
     {
-    case AmphipodType::Amber:
-        return node == NodeType::AmberBurrow;
-    case AmphipodType::Bronze:
-        return node == NodeType::BronzeBurrow;
-    case AmphipodType::Copper:
-        return node == NodeType::CopperBurrow;
-    case AmphipodType::Desert:
-        return node == NodeType::DesertBurrow;
+        auto [it, inserted] = stateEnergy.insert(std::make_pair(state, newEnergy));
+        if (!inserted)
+        {
+            it->second = std::min(it->second, newEnergy);
+        }
     }
-    return false;
-}
 
-int AmphipodMoveCost(AmphipodType amphipod)
-{
-    switch (amphipod)
+    bool AmphipodInCorrectBurrow(AmphipodType amphipod, NodeType node)
     {
-    case AmphipodType::Amber:
-        return 1;
-    case AmphipodType::Bronze:
-        return 10;
-    case AmphipodType::Copper:
-        return 100;
-    case AmphipodType::Desert:
-        return 1000;
+        switch (amphipod)
+        {
+        case AmphipodType::Amber:
+            return node == NodeType::AmberBurrow;
+        case AmphipodType::Bronze:
+            return node == NodeType::BronzeBurrow;
+        case AmphipodType::Copper:
+            return node == NodeType::CopperBurrow;
+        case AmphipodType::Desert:
+            return node == NodeType::DesertBurrow;
+        case AmphipodType::Unknown:
+            break;
+        }
+        return false;
     }
-    return 0;
-}
 
-NodeType BurrowForAmphipod(AmphipodType type)
-{
-    switch (type)
+    int AmphipodMoveCost(AmphipodType amphipod)
     {
-    case AmphipodType::Amber:
-        return NodeType::AmberBurrow;
-    case AmphipodType::Bronze:
-        return NodeType::BronzeBurrow;
-    case AmphipodType::Copper:
-        return NodeType::CopperBurrow;
-    case AmphipodType::Desert:
-        return NodeType::DesertBurrow;
-    default:
-        return NodeType::Unknown;
+        switch (amphipod)
+        {
+        case AmphipodType::Amber:
+            return 1;
+        case AmphipodType::Bronze:
+            return 10;
+        case AmphipodType::Copper:
+            return 100;
+        case AmphipodType::Desert:
+            return 1000;
+        case AmphipodType::Unknown:
+            break;
+        }
+        return 0;
     }
-}
 
-AmphipodType AmphipodForBurrow(NodeType type)
-{
-    switch (type)
+    NodeType BurrowForAmphipod(AmphipodType type)
     {
-    case NodeType::Corridor:
-        return AmphipodType::Unknown;
-    case NodeType::AmberBurrow:
-        return AmphipodType::Amber;
-    case NodeType::BronzeBurrow:
-        return AmphipodType::Bronze;
-    case NodeType::CopperBurrow:
-        return AmphipodType::Copper;
-    case NodeType::DesertBurrow:
-        return AmphipodType::Desert;
-    default:
-        return AmphipodType::Unknown;
+        switch (type)
+        {
+        case AmphipodType::Amber:
+            return NodeType::AmberBurrow;
+        case AmphipodType::Bronze:
+            return NodeType::BronzeBurrow;
+        case AmphipodType::Copper:
+            return NodeType::CopperBurrow;
+        case AmphipodType::Desert:
+            return NodeType::DesertBurrow;
+        default:
+            return NodeType::Unknown;
+        }
     }
-}
 
-template<int CritterCount>
-class World final
-{
-    const int BurrowSize = CritterCount / 4;
-public:
-    World()
+    AmphipodType AmphipodForBurrow(NodeType type)
     {
-        for (int i = 0; i < 11; ++i)
+        switch (type)
         {
-            _nodes[i] = NodeType::Corridor;
+        case NodeType::Corridor:
+            return AmphipodType::Unknown;
+        case NodeType::AmberBurrow:
+            return AmphipodType::Amber;
+        case NodeType::BronzeBurrow:
+            return AmphipodType::Bronze;
+        case NodeType::CopperBurrow:
+            return AmphipodType::Copper;
+        case NodeType::DesertBurrow:
+            return AmphipodType::Desert;
+        default:
+            return AmphipodType::Unknown;
         }
+    }
 
-        for (int i = 0; i < 10; ++i)
+    template<int CritterCount>
+    class World final
+    {
+        const int BurrowSize = CritterCount / 4;
+    public:
+        World()
         {
-            LinkNodes(i, i + 1);
-        }
+            for (int i = 0; i < 11; ++i)
+            {
+                _nodes[i] = NodeType::Corridor;
+            }
 
-        auto makeBurrow = [this](NodeType type)
-        {
-            int burrowStart = BurrowEntryNode(type);
-            for (int i = burrowStart; i < burrowStart + BurrowSize - 1; ++i)
+            for (int i = 0; i < 10; ++i)
             {
-                _nodes[i] = type;
-                _nodes[i + 1] = type;
                 LinkNodes(i, i + 1);
             }
-            LinkNodes(burrowStart, BurrowLinkNode(type));
-        };
-        makeBurrow(NodeType::AmberBurrow);
-        makeBurrow(NodeType::BronzeBurrow);
-        makeBurrow(NodeType::CopperBurrow);
-        makeBurrow(NodeType::DesertBurrow);
-    }
 
-    // are all the amphipods in their correct burrows
-    bool IsWorldSolved(WorldState<CritterCount> const& world) const noexcept
-    {
-        for (auto const& a : world.amphipodPositions)
-        {
-            if (!AmphipodInCorrectBurrow(a.first, _nodes[a.second]))
+            auto makeBurrow = [this](NodeType type)
             {
-                return false;
-            }
+                int burrowStart = BurrowEntryNode(type);
+                for (int i = burrowStart; i < burrowStart + BurrowSize - 1; ++i)
+                {
+                    _nodes[i] = type;
+                    _nodes[i + 1] = type;
+                    LinkNodes(i, i + 1);
+                }
+                LinkNodes(burrowStart, BurrowLinkNode(type));
+            };
+            makeBurrow(NodeType::AmberBurrow);
+            makeBurrow(NodeType::BronzeBurrow);
+            makeBurrow(NodeType::CopperBurrow);
+            makeBurrow(NodeType::DesertBurrow);
         }
-        return true;
-    }
 
-    // returns list of new positions and energy cost to get there
-    std::vector<std::pair<int, uint64_t>> MovesForAmphipod(WorldState<CritterCount> const& world, int amphipodIndex) const
-    {
-        auto const& [type, position] = world.amphipodPositions[amphipodIndex];
-        bool const inCorridor = _nodes[position] == NodeType::Corridor;
-        if (!AmphipodInCorrectBurrow(type, _nodes[position])
-            || AllowOtherAmphipodOut(world, position)
-            || inCorridor)
+        // are all the amphipods in their correct burrows
+        bool IsWorldSolved(WorldState<CritterCount> const& world) const noexcept
         {
-            auto target = TargetNode(world, type);
-            if (target)
+            for (auto const& a : world.amphipodPositions)
             {
-                auto pathToTarget = FindPath(world, position, *target, {}, {});
-                if (pathToTarget)
+                if (!AmphipodInCorrectBurrow(a.first, _nodes[a.second]))
                 {
-                    auto pathLength = pathToTarget->size() - 1; // starting point is included in path
-                    return { {*target, pathLength * AmphipodMoveCost(type)} };
+                    return false;
                 }
             }
-            if (!inCorridor)
+            return true;
+        }
+
+        // returns list of new positions and energy cost to get there
+        std::vector<std::pair<int, uint64_t>> MovesForAmphipod(WorldState<CritterCount> const& world, int amphipodIndex) const
+        {
+            auto const& [type, position] = world.amphipodPositions[amphipodIndex];
+            bool const inCorridor = _nodes[position] == NodeType::Corridor;
+            if (!AmphipodInCorrectBurrow(type, _nodes[position])
+                || AllowOtherAmphipodOut(world, position)
+                || inCorridor)
             {
-                auto nodes = CorridorNodes(world);
-                std::vector<std::pair<int, uint64_t>> result;
-                for (auto const& n : nodes)
+                auto target = TargetNode(world, type);
+                if (target)
                 {
-                    auto pathToTarget = FindPath(world, position, n, {}, {});
+                    auto pathToTarget = FindPath(world, position, *target, {}, {});
                     if (pathToTarget)
                     {
                         auto pathLength = pathToTarget->size() - 1; // starting point is included in path
-                        result.emplace_back(n, pathLength * AmphipodMoveCost(type));
+                        return { {*target, pathLength * AmphipodMoveCost(type)} };
+                    }
+                }
+                if (!inCorridor)
+                {
+                    auto nodes = CorridorNodes(world);
+                    std::vector<std::pair<int, uint64_t>> result;
+                    for (auto const& n : nodes)
+                    {
+                        auto pathToTarget = FindPath(world, position, n, {}, {});
+                        if (pathToTarget)
+                        {
+                            auto pathLength = pathToTarget->size() - 1; // starting point is included in path
+                            result.emplace_back(n, pathLength * AmphipodMoveCost(type));
+                        }
                     }
+                    return result;
                 }
-                return result;
             }
+            return {};
         }
-        return {};
-    }
 
-private:
-    void LinkNodes(int n1, int n2)
-    {
-        _nodeLinks.insert(std::make_pair(n1, n2));
-        _nodeLinks.insert(std::make_pair(n2, n1));
-    }
+    private:
+        void LinkNodes(int n1, int n2)
+        {
+            _nodeLinks.insert(std::make_pair(n1, n2));
+            _nodeLinks.insert(std::make_pair(n2, n1));
+        }
 
-    int BurrowEntryNode(NodeType type) const noexcept
-    {
-        return 11 + ((static_cast<int>(type) - 1) * BurrowSize);
-    }
-    int BurrowLinkNode(NodeType type) const noexcept
-    {
-        return static_cast<int>(type) * 2;
-    }
+        int BurrowEntryNode(NodeType type) const noexcept
+        {
+            return 11 + ((static_cast<int>(type) - 1) * BurrowSize);
+        }
+        int BurrowLinkNode(NodeType type) const noexcept
+        {
+            return static_cast<int>(type) * 2;
+        }
 
-    bool AllowOtherAmphipodOut(WorldState<CritterCount> const& world, int position) const noexcept
-    {
-        auto burrowType = _nodes[position];
-        if (burrowType == NodeType::Corridor)
+        bool AllowOtherAmphipodOut(WorldState<CritterCount> const& world, int position) const noexcept
         {
+            auto burrowType = _nodes[position];
+            if (burrowType == NodeType::Corridor)
+            {
+                return false;
+            }
+            auto amphipodType = AmphipodForBurrow(burrowType);
+
+            for (int i = position + 1; i < BurrowEntryNode(burrowType) + BurrowSize; ++i)
+                if (world.TypeInPosition(i) != amphipodType)
+                    return true;
             return false;
         }
-        auto amphipodType = AmphipodForBurrow(burrowType);
 
-        for (int i = position + 1; i < BurrowEntryNode(burrowType) + BurrowSize; ++i)
-            if (world.TypeInPosition(i) != amphipodType)
-                return true;
-        return false;
-    }
-
-    std::optional<int> TargetNode(WorldState<CritterCount> const& world, AmphipodType type) const noexcept
-    {
-        auto burrowType = BurrowForAmphipod(type);
-        auto burrowStart = BurrowEntryNode(burrowType);
-        auto burrowEnd = burrowStart + BurrowSize;
-        for (int i = burrowEnd - 1; i >= burrowStart; --i)
+        std::optional<int> TargetNode(WorldState<CritterCount> const& world, AmphipodType type) const noexcept
         {
-            auto occupant = world.TypeInPosition(i);
-            if (!occupant)
+            auto burrowType = BurrowForAmphipod(type);
+            auto burrowStart = BurrowEntryNode(burrowType);
+            auto burrowEnd = burrowStart + BurrowSize;
+            for (int i = burrowEnd - 1; i >= burrowStart; --i)
             {
-                return i;
+                auto occupant = world.TypeInPosition(i);
+                if (!occupant)
+                {
+                    return i;
+                }
+                else if (occupant != type)
+                {
+                    break;
+                }
             }
-            else if (occupant != type)
+            return {};
+        }
+
+        std::vector<int> CorridorNodes(WorldState<CritterCount> const& world) const
+        {
+            std::vector<int> result;
+            for (int i = 0; i < 11; ++i)
             {
-                break;
+                if (!world.TypeInPosition(i) && _nodeLinks.count(i) < 3)
+                {
+                    result.push_back(i);
+                }
             }
+            return result;
         }
-        return {};
-    }
 
-    std::vector<int> CorridorNodes(WorldState<CritterCount> const& world) const
-    {
-        std::vector<int> result;
-        for (int i = 0; i < 11; ++i)
+        std::optional<std::vector<int>> FindPath(WorldState<CritterCount> const& world, int currentNode, int targetNode, std::vector<int> pathSoFar, std::set<int> visited) const
         {
-            if (!world.TypeInPosition(i) && _nodeLinks.count(i) < 3)
+            pathSoFar.push_back(currentNode);
+            visited.insert(currentNode);
+
+            if (currentNode == targetNode)
             {
-                result.push_back(i);
+                return pathSoFar;
+            }
+
+            auto const [nextNodesFirst, nextNodesLast] = _nodeLinks.equal_range(currentNode);
+            for (auto it = nextNodesFirst; it != nextNodesLast; ++it)
+            {
+                if (!visited.contains(it->second) && !world.TypeInPosition(it->second))
+                {
+                    auto nextPath = FindPath(world, it->second, targetNode, pathSoFar, visited);
+                    if (nextPath)
+                    {
+                        return nextPath;
+                    }
+                }
             }
+            return {};
         }
-        return result;
-    }
 
-    std::optional<std::vector<int>> FindPath(WorldState<CritterCount> const& world, int currentNode, int targetNode, std::vector<int> pathSoFar, std::set<int> visited) const
-    {
-        pathSoFar.push_back(currentNode);
-        visited.insert(currentNode);
+        std::array<NodeType, 11 + CritterCount> _nodes;
+        std::multimap<int, int> _nodeLinks;
+    };
 
-        if (currentNode == targetNode)
-        {
-            return pathSoFar;
-        }
+    template<typename StateEnergy, int CritterCount>
+    StateEnergy FindEnergyRequired(World<CritterCount> const& world, WorldState<CritterCount> initial)
+    {
+        AOC_TRACE_SCOPE("Day23 FindEnergyRequired");
+        StateEnergy currentGeneration;
+        currentGeneration.insert({ initial, 0 });
+        StateEnergy solved;
 
-        auto const [nextNodesFirst, nextNodesLast] = _nodeLinks.equal_range(currentNode);
-        for (auto it = nextNodesFirst; it != nextNodesLast; ++it)
+        while (std::any_of(currentGeneration.begin(), currentGeneration.end(), [&world](auto const& config) { return !world.IsWorldSolved(config.first); }))
         {
-            if (!visited.contains(it->second) && !world.TypeInPosition(it->second))
+            AOC_TRACE_COUNT("Day23 generations", 1);
+            AOC_TRACE_COUNT("Day23 states expanded", currentGeneration.size());
+            StateEnergy nextGeneration;
+            for (auto const& config : currentGeneration)
             {
-                auto nextPath = FindPath(world, it->second, targetNode, pathSoFar, visited);
-                if (nextPath)
+                if (world.IsWorldSolved(config.first))
+                {
+                    InsertWorldConfiguration(solved, config.first, config.second);
+                }
+                else
                 {
-                    return nextPath;
+                    for (int i = 0; i < CritterCount; ++i)
+                    {
+                        auto newMoves = world.MovesForAmphipod(config.first, i);
+                        for (auto const& [position, energy] : newMoves)
+                        {
+                            WorldState next = config.first;
+                            next.amphipodPositions[i].second = position;
+                            auto newEnergy = config.second + energy;
+                            InsertWorldConfiguration(nextGeneration, next, newEnergy);
+                        }
+                    }
                 }
             }
+            AOC_NOTE_FOOTPRINT("next generation", nextGeneration);
+            currentGeneration = std::move(nextGeneration);
         }
-        return {};
+        return solved;
     }
 
-    std::array<NodeType, 11 + CritterCount> _nodes;
-    std::multimap<int, int> _nodeLinks;
-};
-
-template<int CritterCount>
-WorldStateEnergy<CritterCount> FindEnergyRequired(World<CritterCount> const& world, WorldState<CritterCount> initial)
-{
-    WorldStateEnergy<CritterCount> currentGeneration;
-    currentGeneration.insert({ initial, 0 });
-    WorldStateEnergy<CritterCount> solved;
-
-    while (std::any_of(currentGeneration.begin(), currentGeneration.end(), [&world](auto const& config) { return !world.IsWorldSolved(config.first); }))
+    Input ReadInput(std::string_view text)
     {
-        WorldStateEnergy<CritterCount> nextGeneration;
-        for (auto const& config : currentGeneration)
+        std::vector<BurrowRow> rows;
+
+        Common::LineReader lines{ text };
+        std::string_view line;
+        while (lines.Next(line))
         {
-            if (world.IsWorldSolved(config.first))
-            {
-                InsertWorldConfiguration(solved, config.first, config.second);
-            }
-            else
+            BurrowRow row{};
+            int found = 0;
+            for (auto c : line)
             {
-                for (int i = 0; i < CritterCount; ++i)
+                if (c >= 'A' && c <= 'D' && found < 4)
                 {
-                    auto newMoves = world.MovesForAmphipod(config.first, i);
-                    for (auto const& [position, energy] : newMoves)
-                    {
-                        WorldState next = config.first;
-                        next.amphipodPositions[i].second = position;
-                        auto newEnergy = config.second + energy;
-                        InsertWorldConfiguration(nextGeneration, next, newEnergy);
-                    }
+                    row[found++] = static_cast<AmphipodType>(c - 'A');
                 }
             }
+            if (found == 4)
+            {
+                rows.push_back(row);
+            }
+        }
+
+        if (rows.size() != 2)
+        {
+            throw std::runtime_error("Expected two rows of amphipods in the input");
         }
-        currentGeneration = nextGeneration;
+        return rows;
     }
-    return solved;
-}
 
-void PartOne()
-{
-    constexpr static int CritterCount = 8;
-    World<CritterCount> theWorld;
-
-    WorldState<CritterCount> initial;
-    initial.amphipodPositions[0] = { AmphipodType::Desert, 11 };
-    initial.amphipodPositions[1] = { AmphipodType::Copper, 12 };
-    initial.amphipodPositions[2] = { AmphipodType::Copper, 13 };
-    initial.amphipodPositions[3] = { AmphipodType::Desert, 14 };
-    initial.amphipodPositions[4] = { AmphipodType::Amber, 15 };
-    initial.amphipodPositions[5] = { AmphipodType::Amber, 16 };
-    initial.amphipodPositions[6] = { AmphipodType::Bronze, 17 };
-    initial.amphipodPositions[7] = { AmphipodType::Bronze, 18 };
-
-    auto solutions = FindEnergyRequired(theWorld, initial);
-
-    for (auto const& configuration : solutions)
+    template<int CritterCount>
+    WorldState<CritterCount> MakeInitialState(std::vector<BurrowRow> const& rows)
     {
-        std::cout << "Part one - Solution using " << configuration.second << " energy.\n";
+        constexpr int BurrowSize = CritterCount / 4;
+
+        WorldState<CritterCount> initial;
+        for (int burrow = 0; burrow < 4; ++burrow)
+        {
+            for (int depth = 0; depth < BurrowSize; ++depth)
+            {
+                int index = (burrow * BurrowSize) + depth;
+                initial.amphipodPositions[index] = { rows[depth][burrow], 11 + index };
+            }
+        }
+        return initial;
     }
-}
 
-void PartTwo()
-{
-    constexpr static int CritterCount = 16;
-    World<CritterCount> theWorld;
+    template<int CritterCount, typename StateEnergy = WorldStateEnergy<CritterCount>>
+    std::vector<uint64_t> Solve(std::vector<BurrowRow> const& rows)
+    {
+        World<CritterCount> theWorld;
 
-    WorldState<CritterCount> initial;
-    initial.amphipodPositions[0] = { AmphipodType::Desert, 11 };
-    initial.amphipodPositions[1] = { AmphipodType::Desert, 12 };
-    initial.amphipodPositions[2] = { AmphipodType::Desert, 13 };
-    initial.amphipodPositions[3] = { AmphipodType::Copper, 14 };
+        auto initial = MakeInitialState<CritterCount>(rows);
 
-    initial.amphipodPositions[4] = { AmphipodType::Copper, 15 };
-    initial.amphipodPositions[5] = { AmphipodType::Copper, 16 };
-    initial.amphipodPositions[6] = { AmphipodType::Bronze, 17 };
-    initial.amphipodPositions[7] = { AmphipodType::Desert, 18 };
+        auto solutions = FindEnergyRequired<StateEnergy>(theWorld, initial);
 
-    initial.amphipodPositions[8] = { AmphipodType::Amber, 19 };
-    initial.amphipodPositions[9] = { AmphipodType::Bronze, 20 };
-    initial.amphipodPositions[10] = { AmphipodType::Amber, 21 };
-    initial.amphipodPositions[11] = { AmphipodType::Amber, 22 };
+        std::vector<uint64_t> energies;
+        for (auto const& configuration : solutions)
+        {
+            energies.push_back(configuration.second);
+        }
+        // the same order whatever order the table keeps its states in
+        std::sort(energies.begin(), energies.end());
+        return energies;
+    }
 
-    initial.amphipodPositions[12] = { AmphipodType::Bronze, 23 };
-    initial.amphipodPositions[13] = { AmphipodType::Amber, 24 };
-    initial.amphipodPositions[14] = { AmphipodType::Copper, 25 };
-    initial.amphipodPositions[15] = { AmphipodType::Bronze, 26 };
+    // the folded out part of the diagram goes between the two rows from the input
+    std::vector<BurrowRow> Unfold(std::vector<BurrowRow> const& rows)
+    {
+        return {
+            rows[0],
+            { AmphipodType::Desert, AmphipodType::Copper, AmphipodType::Bronze, AmphipodType::Amber },
+            { AmphipodType::Desert, AmphipodType::Bronze, AmphipodType::Amber, AmphipodType::Copper },
+            rows[1]
+        };
+    }
 
-    auto solutions = FindEnergyRequired(theWorld, initial);
+    std::vector<uint64_t> SolveFolded(std::vector<BurrowRow> const& rows)
+    {
+        return Solve<8>(rows);
+    }
 
-    for (auto const& configuration : solutions)
+    std::vector<uint64_t> SolveUnfolded(std::vector<BurrowRow> const& rows)
     {
-        std::cout << "Part two - Solution using " << configuration.second << " energy.\n";
+        return Solve<16>(Unfold(rows));
     }
-}
 
-int main()
-{
-    PartOne();
-    PartTwo();
+    uint64_t PartOne(Input const& input)
+    {
+        auto energies = SolveFolded(input);
+        return *std::min_element(energies.begin(), energies.end());
+    }
+
+    uint64_t PartTwo(Input const& input)
+    {
+        auto energies = SolveUnfolded(input);
+        return *std::min_element(energies.begin(), energies.end());
+    }
+
+    namespace Reference
+    {
+        template<int CritterCount>
+        using WorldStateEnergy = std::map<WorldState<CritterCount>, uint64_t>;
+
+        uint64_t PartOne(Input const& input)
+        {
+            auto energies = Solve<8, WorldStateEnergy<8>>(input);
+            return *std::min_element(energies.begin(), energies.end());
+        }
+
+        uint64_t PartTwo(Input const& input)
+        {
+            auto energies = Solve<16, WorldStateEnergy<16>>(Unfold(input));
+            return *std::min_element(energies.begin(), energies.end());
+        }
+    }
 }
@@ -0,0 +1,43 @@
+// Day23.h : Amphipod. Finds the least energy needed to sort the amphipods into their burrows.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace Day23
+{
+    enum class AmphipodType
+    {
+        Unknown = -1,
+        Amber,
+        Bronze,
+        Copper,
+        Desert
+    };
+
+    using BurrowRow = std::array<AmphipodType, 4>;
+
+    // each row holds the amphipods at one depth of the four burrows, top row first
+    using Input = std::vector<BurrowRow>;
+
+    Input ReadInput(std::string_view text);
+
+    // energy used by each way of solving the burrows, least first, as drawn
+    // in the input and with the extra rows folded out for part two
+    std::vector<uint64_t> SolveFolded(std::vector<BurrowRow> const& rows);
+    std::vector<uint64_t> SolveUnfolded(std::vector<BurrowRow> const& rows);
+
+    uint64_t PartOne(Input const& input);
+    uint64_t PartTwo(Input const& input);
+
+    // The straightforward versions the faster ones are checked against (aoc_diff).
+    namespace Reference
+    {
+        // Keeps the energy of each state in a std::map rather than a FlatMap.
+        uint64_t PartOne(Input const& input);
+        uint64_t PartTwo(Input const& input);
+    }
+}
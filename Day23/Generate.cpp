@@ -0,0 +1,27 @@
+// Generate.cpp : Writes a Day23 input, the amphipods' starting burrow.
+//   Day23_gen [--seed=N]
+//
+// The burrow is the same size whatever the input, so there's no size to choose.
+
+#include <iostream>
+#include <string>
+
+#include "Common/Generator.h"
+
+int main(int argc, char* argv[])
+{
+    Common::Generator gen{ argc, argv, 1 };
+
+    // each room has a top and a bottom amphipod, read left to right
+    std::string amphipods = "AABBCCDD";
+    do
+    {
+        gen.Shuffle(amphipods);
+    } while (amphipods.substr(0, 4) == "ABCD" && amphipods.substr(4) == "ABCD");
+
+    std::cout << "#############\n";
+    std::cout << "#...........#\n";
+    std::cout << "###" << amphipods[0] << "#" << amphipods[1] << "#" << amphipods[2] << "#" << amphipods[3] << "###\n";
+    std::cout << "  #" << amphipods[4] << "#" << amphipods[5] << "#" << amphipods[6] << "#" << amphipods[7] << "#\n";
+    std::cout << "  #########\n";
+}
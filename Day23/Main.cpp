@@ -0,0 +1,32 @@
+#include <iostream>
+
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/Input.h"
+#include "Day23.h"
+
+int main(int argc, char* argv[])
+{
+    if (auto batch = Common::ReadBatchOptions(argc, argv); batch.enabled)
+    {
+        return Common::RunBatch(batch, Day23::ReadInput, Day23::PartOne, Day23::PartTwo);
+    }
+
+    Common::Benchmark bench{ argc, argv };
+    auto buffer = Common::InputBuffer::FromCommandLine(argc, argv);
+    auto rows = bench.Measure("parse", [&] { return Day23::ReadInput(buffer.Text()); }, { .bytes = buffer.Size() });
+
+    auto partOne = bench.Measure("part one", [&] { return Day23::SolveFolded(rows); });
+    for (auto energy : partOne)
+    {
+        std::cout << "Part one - Solution using " << energy << " energy.\n";
+    }
+
+    auto partTwo = bench.Measure("part two", [&] { return Day23::SolveUnfolded(rows); });
+    for (auto energy : partTwo)
+    {
+        std::cout << "Part two - Solution using " << energy << " energy.\n";
+    }
+
+    bench.Report(std::cout);
+}
@@ -1,147 +1,146 @@
-#include <array>
-#include <iostream>
-#include <regex>
-#include <string>
-#include <vector>
+#include "Day24.h"
 
-std::vector<std::string> ReadInput()
-{
-    std::vector<std::string> result;
+#include <algorithm>
+#include <set>
+#include <sstream>
 
-    std::string input;
-    while (std::getline(std::cin, input))
+namespace Day24
+{
+    uint64_t PartOne(Input const& input)
     {
-        if (input.empty())
-        {
-            break;
-        }
-        result.push_back(input);
+        return ToNumber(MaximumNumber(GroupOperations(input)));
     }
-    return result;
-}
-
-struct Params
-{
-    int op;
-    int correction;
-    int offset;
-};
-
-auto ExtractParams(std::vector<std::string> const& input)
-{
-    std::regex regex("... . (-?\\d+)");
-    std::smatch matches;
-
-    std::array<Params, 14> result{};
 
-    for (int block = 0; block < 14; ++block)
+    uint64_t PartTwo(Input const& input)
     {
-        int inputOffset = block * 18;
-        // op = inputOffset + 4
-        std::regex_match(input[inputOffset + 4], matches, regex);
-        int op = std::stoi(matches[1].str());
-        // correction = inputOffset + 5
-        std::regex_match(input[inputOffset + 5], matches, regex);
-        int correction = std::stoi(matches[1].str());
-        // offset = inputOffset + 15
-        std::regex_match(input[inputOffset + 15], matches, regex);
-        int offset = std::stoi(matches[1].str());
-
-        result[block] = { op, correction, offset };
+        return ToNumber(MinimumNumber(GroupOperations(input)));
     }
-    return result;
-}
 
-struct OperationPair
-{
-    int addIndex;
-    int subIndex;
-    int adjustment;
-};
-
-auto GroupOperations(std::array<Params, 14> const& params)
-{
-    std::vector<std::pair<int, int>> stack;
-    std::vector<OperationPair> result;
-    for (int i = 0; i < 14; ++i)
+    namespace Reference
     {
-        auto const& [op, correction, offset] = params[i];
-        if (op == 1)
+        Input ReadInput(std::string_view text)
         {
-            stack.emplace_back(offset, i);
+            Input blocks;
+            std::istringstream in{ std::string{ text } };
+            std::string line;
+            while (std::getline(in, line) && !line.empty())
+            {
+                std::istringstream words{ line };
+                Instruction instruction{};
+                std::string target;
+                std::string argument;
+                words >> instruction.op >> target >> argument;
+                instruction.target = target[0] - 'w';
+                if (instruction.op == "inp")
+                {
+                    blocks.emplace_back();
+                }
+                else if (argument[0] >= 'w' && argument[0] <= 'z')
+                {
+                    instruction.registerArgument = true;
+                    instruction.argument = argument[0] - 'w';
+                }
+                else
+                {
+                    instruction.argument = std::stoll(argument);
+                }
+                if (blocks.empty())
+                {
+                    throw std::runtime_error("Expected the program to start with inp");
+                }
+                blocks.back().push_back(instruction);
+            }
+            if (blocks.size() != 14)
+            {
+                throw std::runtime_error("Expected fourteen inp instructions");
+            }
+            return blocks;
         }
-        else
+
+        // z after running block on digit, from z.
+        int64_t RunBlock(std::vector<Instruction> const& block, int digit, int64_t z)
         {
-            auto const& [off, in] = stack.back();
-            stack.pop_back();
-            result.emplace_back(in, i, off + correction);
+            // w, x, y and z
+            std::array<int64_t, 4> registers{ 0, 0, 0, z };
+            for (auto const& i : block)
+            {
+                auto& a = registers[i.target];
+                auto b = i.registerArgument ? registers[i.argument] : i.argument;
+                if (i.op == "inp")
+                    a = digit;
+                else if (i.op == "add")
+                    a += b;
+                else if (i.op == "mul")
+                    a *= b;
+                else if (i.op == "div")
+                    a /= b;
+                else if (i.op == "mod")
+                    a %= b;
+                else if (i.op == "eql")
+                    a = a == b ? 1 : 0;
+            }
+            return registers[3];
         }
-    }
 
-    return result;
-}
-
-auto MaximumNumber(std::vector<OperationPair> const& operationGroups)
-{
-    std::array<int, 14> number{ 0 };
-    for (auto const& op : operationGroups)
-    {
-        if (op.adjustment < 0)
+        // Each block that divides z by 26 can take at most one base 26
+        // digit off it, so z has to be below 26 to the power of how many
+        // are left for the number to be valid.
+        std::vector<int64_t> ZLimits(Input const& blocks)
         {
-            number[op.addIndex] = 9;
-            number[op.subIndex] = 9 + op.adjustment;
+            std::vector<int64_t> limits(blocks.size() + 1, 1);
+            for (auto b = blocks.size(); b-- > 0;)
+            {
+                bool divides = std::any_of(blocks[b].begin(), blocks[b].end(), [](Instruction const& i)
+                    {
+                        return i.op == "div" && i.target == 3 && !i.registerArgument && i.argument == 26;
+                    });
+                limits[b] = std::min<int64_t>(limits[b + 1] * (divides ? 26 : 1), int64_t{ 1 } << 50);
+            }
+            return limits;
         }
-        else
+
+        // The first valid number starting with the digits in number, trying
+        // each digit in the order given, or 0.
+        uint64_t FindDigits(Input const& blocks, std::vector<int64_t> const& limits, std::size_t block, int64_t z, uint64_t number,
+            std::array<int, 9> const& digits, std::set<std::pair<std::size_t, int64_t>>& deadEnds)
         {
-            number[op.subIndex] = 9;
-            number[op.addIndex] = 9 - op.adjustment;
+            if (block == blocks.size())
+            {
+                return z == 0 ? number : 0;
+            }
+            if (z >= limits[block] || deadEnds.contains({ block, z }))
+            {
+                return 0;
+            }
+            for (auto digit : digits)
+            {
+                if (auto found = FindDigits(blocks, limits, block + 1, RunBlock(blocks[block], digit, z), number * 10 + digit, digits, deadEnds))
+                {
+                    return found;
+                }
+            }
+            deadEnds.insert({ block, z });
+            return 0;
         }
-    }
-    return number;
-}
 
-auto MinimumNumber(std::vector<OperationPair> const& operationGroups)
-{
-    std::array<int, 14> number{ 0 };
-    for (auto const& op : operationGroups)
-    {
-        if (op.adjustment < 0)
+        uint64_t Search(Input const& input, std::array<int, 9> const& digits)
         {
-            number[op.addIndex] = 1 - op.adjustment;
-            number[op.subIndex] = 1;
+            std::set<std::pair<std::size_t, int64_t>> deadEnds;
+            if (auto number = FindDigits(input, ZLimits(input), 0, 0, 0, digits, deadEnds))
+            {
+                return number;
+            }
+            throw std::runtime_error("No valid model number");
         }
-        else
+
+        uint64_t PartOne(Input const& input)
         {
-            number[op.subIndex] = 1 + op.adjustment;
-            number[op.addIndex] = 1;
+            return Search(input, { 9, 8, 7, 6, 5, 4, 3, 2, 1 });
         }
-    }
-    return number;
-}
 
-void PrintNumber(std::array<int, 14> const& number)
-{
-    for (auto const& d : number)
-    {
-        std::cout << d;
+        uint64_t PartTwo(Input const& input)
+        {
+            return Search(input, { 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+        }
     }
 }
-
-int main()
-{
-    auto rawInput = ReadInput();
-
-    auto paramSet = ExtractParams(rawInput);
-
-    auto operationGroups = GroupOperations(paramSet);
-
-    auto maximum = MaximumNumber(operationGroups);
-    std::cout << "Maximum: ";
-    PrintNumber(maximum);
-    std::cout << '\n';
-
-    auto minimum = MinimumNumber(operationGroups);
-    std::cout << "Minimum: ";
-    PrintNumber(minimum);
-    std::cout << '\n';
-}
@@ -0,0 +1,188 @@
+// Day24.h : Arithmetic Logic Unit. Works out the largest and smallest valid model numbers.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Common/Input.h"
+#include "Common/Pattern.h"
+
+namespace Day24
+{
+    // The constants that differ between each of the fourteen blocks of the MONAD program.
+    struct Params
+    {
+        int op;
+        int correction;
+        int offset;
+    };
+
+    // A digit pushed by one block that has to be matched by a later one.
+    struct OperationPair
+    {
+        int addIndex;
+        int subIndex;
+        int adjustment;
+    };
+
+    using Input = std::array<Params, 14>;
+    using ModelNumber = std::array<int, 14>;
+
+    // ReadLines down to ReadInput can be run by the compiler, for AOC_EMBED_INPUTS.
+    constexpr std::vector<std::string_view> ReadLines(std::string_view text)
+    {
+        std::vector<std::string_view> result;
+
+        Common::LineReader lines{ text };
+        std::string_view input;
+        while (lines.Next(input))
+        {
+            if (input.empty())
+            {
+                break;
+            }
+            result.push_back(input);
+        }
+        return result;
+    }
+
+    constexpr Input ExtractParams(std::vector<std::string_view> const& input)
+    {
+        // the number at the end of an instruction like "add x -12"
+        auto argument = [](std::string_view line)
+        {
+            std::string_view instruction;
+            std::string_view variable;
+            int value = 0;
+            if (!Common::Match<"{} {} {}">(line, instruction, variable, value))
+            {
+                throw std::runtime_error("Expected an instruction with a number: " + std::string{ line });
+            }
+            return value;
+        };
+
+        Input result{};
+
+        for (int block = 0; block < 14; ++block)
+        {
+            int inputOffset = block * 18;
+            // op = inputOffset + 4
+            int op = argument(input[inputOffset + 4]);
+            // correction = inputOffset + 5
+            int correction = argument(input[inputOffset + 5]);
+            // offset = inputOffset + 15
+            int offset = argument(input[inputOffset + 15]);
+
+            result[block] = { op, correction, offset };
+        }
+        return result;
+    }
+
+    constexpr std::vector<OperationPair> GroupOperations(std::array<Params, 14> const& params)
+    {
+        std::vector<std::pair<int, int>> stack;
+        std::vector<OperationPair> result;
+        for (int i = 0; i < 14; ++i)
+        {
+            auto const& [op, correction, offset] = params[i];
+            if (op == 1)
+            {
+                stack.emplace_back(offset, i);
+            }
+            else
+            {
+                auto [off, in] = stack.back();
+                stack.pop_back();
+                result.emplace_back(in, i, off + correction);
+            }
+        }
+
+        return result;
+    }
+
+    constexpr ModelNumber MaximumNumber(std::vector<OperationPair> const& operationGroups)
+    {
+        ModelNumber number{ 0 };
+        for (auto const& op : operationGroups)
+        {
+            if (op.adjustment < 0)
+            {
+                number[op.addIndex] = 9;
+                number[op.subIndex] = 9 + op.adjustment;
+            }
+            else
+            {
+                number[op.subIndex] = 9;
+                number[op.addIndex] = 9 - op.adjustment;
+            }
+        }
+        return number;
+    }
+
+    constexpr ModelNumber MinimumNumber(std::vector<OperationPair> const& operationGroups)
+    {
+        ModelNumber number{ 0 };
+        for (auto const& op : operationGroups)
+        {
+            if (op.adjustment < 0)
+            {
+                number[op.addIndex] = 1 - op.adjustment;
+                number[op.subIndex] = 1;
+            }
+            else
+            {
+                number[op.subIndex] = 1 + op.adjustment;
+                number[op.addIndex] = 1;
+            }
+        }
+        return number;
+    }
+
+    constexpr uint64_t ToNumber(ModelNumber const& number)
+    {
+        uint64_t value = 0;
+        for (auto const& d : number)
+        {
+            value = (value * 10) + d;
+        }
+        return value;
+    }
+
+    constexpr Input ReadInput(std::string_view text)
+    {
+        auto rawInput = ReadLines(text);
+
+        return ExtractParams(rawInput);
+    }
+
+    uint64_t PartOne(Input const& input);
+    uint64_t PartTwo(Input const& input);
+
+    // The straightforward versions the faster ones are checked against (aoc_diff).
+    namespace Reference
+    {
+        struct Instruction
+        {
+            std::string op;
+            int target;
+            // a register, or a number if registerArgument is false
+            bool registerArgument;
+            int64_t argument;
+        };
+
+        // The program split at each inp, one block for each digit.
+        using Input = std::vector<std::vector<Instruction>>;
+
+        Input ReadInput(std::string_view text);
+        // Run the program itself on the digits, depth first, remembering
+        // the z values each block can't go on from to a valid number.
+        uint64_t PartOne(Input const& input);
+        uint64_t PartTwo(Input const& input);
+    }
+}
@@ -0,0 +1,55 @@
+// Generate.cpp : Writes a Day24 input, a MONAD program.
+//   Day24_gen [--seed=N]
+//
+// MONAD always checks 14 digits, so there's no size to choose.
+
+#include <iostream>
+#include <vector>
+
+#include "Common/Generator.h"
+
+int main(int argc, char* argv[])
+{
+    Common::Generator gen{ argc, argv, 1 };
+
+    // Seven blocks push a digit plus an offset on to z in base 26 and seven pop
+    // one back off, each comparing it with its own digit. Pops must never
+    // outnumber pushes, and the difference allowed between a pair of digits has
+    // to stay within 8 so that some model number is valid.
+    std::vector<bool> pushes;
+    int depth = 0;
+    int pushesLeft = 7;
+    while (pushes.size() < 14)
+    {
+        bool push = depth == 0 || (pushesLeft > 0 && gen.Chance(0.5));
+        pushes.push_back(push);
+        depth += push ? 1 : -1;
+        pushesLeft -= push ? 1 : 0;
+    }
+
+    std::vector<int> offsets;
+    for (bool push : pushes)
+    {
+        int divide = 1;
+        int correction = 0;
+        int offset = gen.Uniform(1, 16);
+        if (push)
+        {
+            correction = gen.Uniform(10, 16);
+            offsets.push_back(offset);
+        }
+        else
+        {
+            divide = 26;
+            correction = gen.Uniform(-8, 8) - offsets.back();
+            offsets.pop_back();
+        }
+
+        std::cout << "inp w\nmul x 0\nadd x z\nmod x 26\n"
+            << "div z " << divide << "\n"
+            << "add x " << correction << "\n"
+            << "eql x w\neql x 0\nmul y 0\nadd y 25\nmul y x\nadd y 1\nmul z y\nmul y 0\nadd y w\n"
+            << "add y " << offset << "\n"
+            << "mul y x\nadd z y\n";
+    }
+}
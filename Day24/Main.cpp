@@ -0,0 +1,46 @@
+#include <iostream>
+
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/Input.h"
+#include "Day24.h"
+
+#ifdef AOC_EMBEDDED_INPUT
+#include "EmbeddedInput.h"
+#endif
+
+int main(int argc, char* argv[])
+{
+    if (auto batch = Common::ReadBatchOptions(argc, argv); batch.enabled)
+    {
+        return Common::RunBatch(batch, Day24::ReadInput, Day24::PartOne, Day24::PartTwo);
+    }
+
+    if (Common::EmbeddedRequested(argc, argv))
+    {
+#ifdef AOC_EMBEDDED_INPUT
+        // worked out by the compiler
+        constexpr auto paramSet = Day24::ReadInput(Common::EmbeddedInput);
+        constexpr auto maximum = Day24::ToNumber(Day24::MaximumNumber(Day24::GroupOperations(paramSet)));
+        constexpr auto minimum = Day24::ToNumber(Day24::MinimumNumber(Day24::GroupOperations(paramSet)));
+        std::cout << "Maximum: " << maximum << '\n';
+        std::cout << "Minimum: " << minimum << '\n';
+        return 0;
+#else
+        std::cerr << "Day24 was built without an embedded input, configure with -DAOC_EMBED_INPUTS=ON\n";
+        return 1;
+#endif
+    }
+
+    Common::Benchmark bench{ argc, argv };
+    auto buffer = Common::InputBuffer::FromCommandLine(argc, argv);
+    auto paramSet = bench.Measure("parse", [&] { return Day24::ReadInput(buffer.Text()); }, { .bytes = buffer.Size() });
+
+    auto maximum = bench.Measure("part one", [&] { return Day24::PartOne(paramSet); });
+    std::cout << "Maximum: " << maximum << '\n';
+
+    auto minimum = bench.Measure("part two", [&] { return Day24::PartTwo(paramSet); });
+    std::cout << "Minimum: " << minimum << '\n';
+
+    bench.Report(std::cout);
+}
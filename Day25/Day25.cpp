@@ -1,166 +1,159 @@
-#include <algorithm>
-#include <iostream>
+#include "Day25.h"
+
+#include <stdexcept>
 #include <string>
-#include <vector>
+#include <utility>
 
-enum class Cell
-{
-    Empty,
-    EastMover,
-    SouthMover
-};
+#include "Common/Input.h"
+#include "Common/Trace.h"
 
-class Grid
+namespace Day25
 {
-public:
-    Grid(int width, int height)
-        : width_{ width },
-        height_{ height },
-        cells_(height_, std::vector<Cell>(width_, Cell::Empty))
-    {}
-
-    Cell At(int x, int y) const noexcept
-    {
-        return cells_[y % height_][x % width_];
-    }
-
-    void Set(int x, int y, Cell c)
+    template<typename CellGrid>
+    CellGrid ReadCells(std::string_view text)
     {
-        cells_[y % height_][x % width_] = c;
-    }
-
-    int Width() const noexcept
-    {
-        return width_;
-    }
-    int Height() const noexcept
-    {
-        return height_;
-    }
-    void Print(std::ostream& out) const
-    {
-        for (auto const& row : cells_)
+        std::vector<std::string_view> gridData;
+        Common::LineReader lines{ text };
+        std::string_view line;
+        while (lines.Next(line))
         {
-            std::transform(row.begin(), row.end(), std::ostream_iterator<char>(out), [](Cell c) { return c == Cell::Empty ? '.' : (c == Cell::EastMover ? '>' : 'v'); });
-            out << "\n";
+            if (line.empty() && !gridData.empty())
+            {
+                break;
+            }
+            if (line.empty())
+            {
+                continue;
+            }
+
+            gridData.push_back(line);
         }
-    }
 
-private:
-    int width_;
-    int height_;
-    std::vector<std::vector<Cell>> cells_;
-};
+        int width = static_cast<int>(gridData[0].size());
+        int height = static_cast<int>(gridData.size());
 
-auto ReadInput()
-{
-    std::vector<std::string> gridData;
-    std::string line;
-    while (std::getline(std::cin, line))
-    {
-        if (line.empty() && !gridData.empty())
-        {
-            break;
-        }
-        if (line.empty())
+        CellGrid result(width, height);
+
+        for (int y = 0; y < height; ++y)
         {
-            continue;
+            for (int x = 0; x < width; ++x)
+            {
+                auto cell = [](char c)
+                {
+                    switch (c)
+                    {
+                    case '.': return Cell::Empty;
+                    case '>': return Cell::EastMover;
+                    case 'v': return Cell::SouthMover;
+                    default:
+                        throw std::runtime_error(std::string{ "Bad cell in input: " } + c);
+                    }
+                }(gridData[y][x]);
+                result.Set(x, y, cell);
+            }
         }
 
-        gridData.push_back(line);
+        return result;
     }
 
-    int width = static_cast<int>(gridData[0].size());
-    int height = static_cast<int>(gridData.size());
-
-    Grid result(width, height);
+    Input ReadInput(std::string_view text)
+    {
+        return ReadCells<Grid>(text);
+    }
 
-    for (int y = 0; y < height; ++y)
+    template<typename CellGrid>
+    bool DoMoveEast(CellGrid const& movers, CellGrid& target)
     {
-        for (int x = 0; x < width; ++x)
+        bool didMove = false;
+        for (int y = 0; y < movers.Height(); ++y)
         {
-            auto cell = [](char c)
+            for (int x = 0; x < movers.Width(); ++x)
             {
-                switch (c)
+                if (movers.At(x, y) == Cell::EastMover && movers.At(x + 1, y) == Cell::Empty)
+                {
+                    target.Set(x, y, Cell::Empty);
+                    target.Set(x + 1, y, Cell::EastMover);
+                    // now skip the the cell just moved into
+                    ++x;
+                    didMove = true;
+                }
+                else
                 {
-                case '.': return Cell::Empty;
-                case '>': return Cell::EastMover;
-                case 'v': return Cell::SouthMover;
+                    target.Set(x, y, movers.At(x, y));
                 }
-            }(gridData[y][x]);
-            result.Set(x, y, cell);
+            }
         }
+        return didMove;
     }
 
-    return result;
-}
-
-bool DoMoveEast(Grid const& movers, Grid& target)
-{
-    bool didMove = false;
-    for (int y = 0; y < movers.Height(); ++y)
+    template<typename CellGrid>
+    bool DoMoveSouth(CellGrid const& movers, CellGrid& target)
     {
+        bool didMove = false;
         for (int x = 0; x < movers.Width(); ++x)
         {
-            if (movers.At(x, y) == Cell::EastMover && movers.At(x + 1, y) == Cell::Empty)
-            {
-                target.Set(x, y, Cell::Empty);
-                target.Set(x + 1, y, Cell::EastMover);
-                // now skip the the cell just moved into
-                ++x;
-                didMove = true;
-            }
-            else
+            for (int y = 0; y < movers.Height(); ++y)
             {
-                target.Set(x, y, movers.At(x, y));
+                if (movers.At(x, y) == Cell::SouthMover && movers.At(x, y + 1) == Cell::Empty)
+                {
+                    target.Set(x, y, Cell::Empty);
+                    target.Set(x, y + 1, Cell::SouthMover);
+                    // now skip the the cell just moved into
+                    ++y;
+                    didMove = true;
+                }
+                else
+                {
+                    target.Set(x, y, movers.At(x, y));
+                }
             }
         }
+        return didMove;
     }
-    return didMove;
-}
 
-bool DoMoveSouth(Grid const& movers, Grid& target)
-{
-    bool didMove = false;
-    for (int x = 0; x < movers.Width(); ++x)
+
+    template<typename CellGrid>
+    int CountSteps(CellGrid moveEast)
     {
-        for (int y = 0; y < movers.Height(); ++y)
-        {
-            if (movers.At(x, y) == Cell::SouthMover && movers.At(x, y + 1) == Cell::Empty)
-            {
-                target.Set(x, y, Cell::Empty);
-                target.Set(x, y + 1, Cell::SouthMover);
-                // now skip the the cell just moved into
-                ++y;
-                didMove = true;
-            }
-            else
-            {
-                target.Set(x, y, movers.At(x, y));
-            }
-        }
-    }
-    return didMove;
-}
+        CellGrid moveSouth(moveEast.Width(), moveEast.Height());
 
+        bool didMoveEast = false;
+        bool didMoveSouth = false;
+        AOC_TRACE_SCOPE("Day25 StepsUntilStopped");
+        int steps = 0;
 
-int main()
-{
-    auto moveEast = ReadInput();
-    Grid moveSouth(moveEast.Width(), moveEast.Height());
+        do
+        {
+            AOC_TRACE_COUNT("Day25 herd steps", 1);
+            didMoveEast = DoMoveEast(moveEast, moveSouth);
+            didMoveSouth = DoMoveSouth(moveSouth, moveEast);
+            ++steps;
+        } while (didMoveEast || didMoveSouth);
+
+        //moveEast.Print(std::cout);
+        return steps;
+    }
 
-    bool didMoveEast = false;
-    bool didMoveSouth = false;
-    int steps = 0;
+    int StepsUntilStopped(Grid moveEast)
+    {
+        return CountSteps(std::move(moveEast));
+    }
 
-    do
+    int PartOne(Input const& input)
     {
-        didMoveEast = DoMoveEast(moveEast, moveSouth);
-        didMoveSouth = DoMoveSouth(moveSouth, moveEast);
-        ++steps;
-    } while (didMoveEast || didMoveSouth);
+        return StepsUntilStopped(input);
+    }
 
-    std::cout << "Sea cucumbers stopped moving after " << steps << " steps.\n";
+    namespace Reference
+    {
+        Input ReadInput(std::string_view text)
+        {
+            return ReadCells<Grid>(text);
+        }
 
-    //moveEast.Print(std::cout);
+        int PartOne(Input const& input)
+        {
+            return CountSteps(input);
+        }
+    }
 }
@@ -0,0 +1,114 @@
+// Day25.h : Sea Cucumber. Moves the herds until they stop.
+
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include "Common/Grid2D.h"
+
+namespace Day25
+{
+    enum class Cell
+    {
+        Empty,
+        EastMover,
+        SouthMover
+    };
+
+    class Grid
+    {
+    public:
+        Grid(int width, int height)
+            : cells_(width, height, Cell::Empty)
+        {}
+
+        // Off the right or bottom edge wraps round to the other side.
+        Cell At(int x, int y) const noexcept
+        {
+            return cells_(x % Width(), y % Height());
+        }
+
+        void Set(int x, int y, Cell c)
+        {
+            cells_(x % Width(), y % Height()) = c;
+        }
+
+        int Width() const noexcept
+        {
+            return cells_.Width();
+        }
+        int Height() const noexcept
+        {
+            return cells_.Height();
+        }
+        void Print(std::ostream& out) const
+        {
+            for (int y = 0; y < Height(); ++y)
+            {
+                auto row = cells_.Row(y);
+                std::transform(row.begin(), row.end(), std::ostream_iterator<char>(out), [](Cell c) { return c == Cell::Empty ? '.' : (c == Cell::EastMover ? '>' : 'v'); });
+                out << "\n";
+            }
+        }
+
+    private:
+        Common::Grid2D<Cell> cells_;
+    };
+
+    using Input = Grid;
+
+    Input ReadInput(std::string_view text);
+
+    int StepsUntilStopped(Grid moveEast);
+
+    int PartOne(Input const& input);
+
+    // The straightforward versions the faster ones are checked against (aoc_diff).
+    namespace Reference
+    {
+        // The same wrapping grid over a vector of rows.
+        class Grid
+        {
+        public:
+            Grid(int width, int height)
+                : width_{ width },
+                height_{ height },
+                cells_(height_, std::vector<Cell>(width_, Cell::Empty))
+            {}
+
+            Cell At(int x, int y) const noexcept
+            {
+                return cells_[y % height_][x % width_];
+            }
+
+            void Set(int x, int y, Cell c)
+            {
+                cells_[y % height_][x % width_] = c;
+            }
+
+            int Width() const noexcept
+            {
+                return width_;
+            }
+            int Height() const noexcept
+            {
+                return height_;
+            }
+
+        private:
+            int width_;
+            int height_;
+            std::vector<std::vector<Cell>> cells_;
+        };
+
+        using Input = Grid;
+
+        Input ReadInput(std::string_view text);
+
+        int PartOne(Input const& input);
+    }
+}
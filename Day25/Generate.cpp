@@ -0,0 +1,23 @@
+// Generate.cpp : Writes a Day25 input of any size, a square map of the sea cucumbers.
+//   Day25_gen [side] [--scale=F] [--seed=N]
+
+#include <iostream>
+#include <string>
+
+#include "Common/Generator.h"
+
+int main(int argc, char* argv[])
+{
+    Common::Generator gen{ argc, argv, 137 };
+
+    std::string row(gen.Size(), '.');
+    for (std::size_t y = 0; y < gen.Size(); ++y)
+    {
+        for (auto& c : row)
+        {
+            auto roll = gen.Uniform(0.0, 1.0);
+            c = roll < 0.35 ? '>' : roll < 0.7 ? 'v' : '.';
+        }
+        std::cout << row << "\n";
+    }
+}
@@ -0,0 +1,25 @@
+#include <cstddef>
+#include <iostream>
+
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/Input.h"
+#include "Day25.h"
+
+int main(int argc, char* argv[])
+{
+    if (auto batch = Common::ReadBatchOptions(argc, argv); batch.enabled)
+    {
+        return Common::RunBatch(batch, Day25::ReadInput, Day25::PartOne);
+    }
+
+    Common::Benchmark bench{ argc, argv };
+    auto buffer = Common::InputBuffer::FromCommandLine(argc, argv);
+    auto moveEast = bench.Measure("parse", [&] { return Day25::ReadInput(buffer.Text()); }, { .bytes = buffer.Size() });
+
+    auto steps = bench.Measure("part one", [&] { return Day25::PartOne(moveEast); }, { .items = static_cast<std::size_t>(moveEast.Width()) * moveEast.Height() });
+
+    std::cout << "Sea cucumbers stopped moving after " << steps << " steps.\n";
+
+    bench.Report(std::cout);
+}
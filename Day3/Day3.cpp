@@ -1,103 +1,358 @@
+#include "Day3.h"
+
 #include <algorithm>
-#include <iostream>
+#include <cstring>
+#include <iterator>
 #include <string>
-#include <vector>
 
-std::vector<std::string> ReadInput()
+#include "Common/CpuFeatures.h"
+#include "Common/Input.h"
+#include "Common/Trace.h"
+
+#ifdef AOC_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace Day3
 {
-    std::vector<std::string> commands;
+    Input ReadInput(std::string_view text)
+    {
+        std::vector<std::string_view> commands;
+
+        Common::LineReader lines{ text };
+        std::string_view input;
+        while (lines.Next(input))
+        {
+            if (input.empty())
+            {
+                break;
+            }
+            commands.push_back(input);
+        }
+        return commands;
+    }
+
+    auto CountBitsInPos(std::vector<std::string_view> const& input, int pos, char bit)
+    {
+        auto bitCount = std::count_if(input.begin(), input.end(),
+            [pos, bit](std::string_view s)
+            {
+                return s[pos] == bit;
+            });
+        return bitCount;
+    }
 
-    std::string input;
-    while (std::getline(std::cin, input))
+    void CountOnesScalar(std::span<std::string_view const> rows, std::span<std::uint32_t> ones)
     {
-        if (input.empty())
+        for (auto row : rows)
         {
-            break;
+            auto const width = std::min(row.size(), ones.size());
+            for (std::size_t col = 0; col < width; ++col)
+            {
+                ones[col] += row[col] == '1';
+            }
         }
-        commands.push_back(input);
     }
-    return commands;
-}
 
-auto CountBitsInPos(std::vector<std::string> const& input, int pos, char bit)
-{
-    auto bitCount = std::count_if(input.begin(), input.end(),
-        [pos, bit](std::string const& s)
+#ifdef AOC_SIMD_X86
+    // The SIMD versions keep a byte counter per column in registers and
+    // compare a whole row at once, so they only take rows 8 to 64 wide.
+    // The counters are added to ones every 255 rows, before they can wrap.
+    std::size_t constexpr MaxSimdWidth = 64;
+    std::size_t constexpr RowsPerFlush = 255;
+
+    // SSE and AVX2 build each row from 8 byte words, as reading a whole
+    // vector from a short row could run off the end of the input. The last
+    // word ends at the end of the row, overlapping the one before, and its
+    // lanes for the columns already counted are masked off. Words past the
+    // last one just load it again, entirely masked off.
+    struct RowWords
+    {
+        std::size_t offsets[8];
+        std::uint64_t keep[8];
+    };
+
+    RowWords SplitRow(std::size_t width) noexcept
+    {
+        RowWords words{};
+        auto const count = (width + 7) / 8;
+        for (std::size_t i = 0; i < 8; ++i)
         {
-            return s[pos] == bit;
-        });
-    return bitCount;
-}
+            words.offsets[i] = std::min(8 * i, width - 8);
+            if (i + 1 < count)
+            {
+                words.keep[i] = ~std::uint64_t{ 0 };
+            }
+            else if (i + 1 == count)
+            {
+                // bytes are in memory order, so the low ones are the overlap
+                auto const overlap = 8 * i - words.offsets[i];
+                words.keep[i] = overlap == 0 ? ~std::uint64_t{ 0 } : ~std::uint64_t{ 0 } << (8 * overlap);
+            }
+        }
+        return words;
+    }
 
-auto ValuesWithBitInPos(std::vector<std::string> const& input, int pos, char bit)
-{
-    std::vector<std::string> result;
-    std::copy_if(input.begin(), input.end(), std::back_inserter(result),
-        [pos, bit](std::string const& s)
+    std::uint64_t LoadWord(char const* from) noexcept
+    {
+        std::uint64_t word;
+        std::memcpy(&word, from, sizeof(word));
+        return word;
+    }
+
+    // Adds the byte counters, laid out word by word as in RowWords, to ones.
+    void AddCounts(std::uint8_t const* counts, RowWords const& words, std::span<std::uint32_t> ones) noexcept
+    {
+        for (std::size_t i = 0; i < 8 && 8 * i < ones.size(); ++i)
         {
-            return s[pos] == bit;
-        });
-    return result;
-}
+            for (std::size_t b = 0; b < 8; ++b)
+            {
+                // masked off lanes never count, so adding them is harmless
+                ones[words.offsets[i] + b] += counts[8 * i + b];
+            }
+        }
+    }
 
-auto FindOxygenRating(std::vector<std::string> const& input)
-{
-    int bitLength = input[0].size();
-    auto values = input;
-    for (int pos = 0; pos < bitLength && values.size() > 1; ++pos)
+    AOC_TARGET_SSE42 void CountOnesSse42(std::span<std::string_view const> rows, std::span<std::uint32_t> ones)
     {
-        int zeroBits = CountBitsInPos(values, pos, '0');
-        int oneBits = CountBitsInPos(values, pos, '1');
+        auto const width = ones.size();
+        if (width < 8 || width > MaxSimdWidth)
+        {
+            return CountOnesScalar(rows, ones);
+        }
+        auto const words = SplitRow(width);
+        auto const vectors = (width + 15) / 16;
+        __m128i const one = _mm_set1_epi8('1');
+        __m128i keep[4];
+        for (std::size_t v = 0; v < 4; ++v)
+        {
+            keep[v] = _mm_set_epi64x(static_cast<long long>(words.keep[2 * v + 1]), static_cast<long long>(words.keep[2 * v]));
+        }
+        alignas(16) std::uint8_t counts[MaxSimdWidth];
 
-        auto mostCommon = oneBits >= zeroBits ? '1' : '0';
-        values = ValuesWithBitInPos(values, pos, mostCommon);
+        for (std::size_t done = 0; done < rows.size(); )
+        {
+            auto const batch = std::min(RowsPerFlush, rows.size() - done);
+            __m128i sums[4] = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+            for (auto row : rows.subspan(done, batch))
+            {
+                if (row.size() < width)
+                {
+                    CountOnesScalar({ &row, 1 }, ones);
+                    continue;
+                }
+                for (std::size_t v = 0; v < vectors; ++v)
+                {
+                    auto bytes = _mm_set_epi64x(
+                        static_cast<long long>(LoadWord(row.data() + words.offsets[2 * v + 1])),
+                        static_cast<long long>(LoadWord(row.data() + words.offsets[2 * v])));
+                    // a match is all ones, -1
+                    sums[v] = _mm_sub_epi8(sums[v], _mm_and_si128(_mm_cmpeq_epi8(bytes, one), keep[v]));
+                }
+            }
+            for (std::size_t v = 0; v < 4; ++v)
+            {
+                _mm_store_si128(reinterpret_cast<__m128i*>(counts + 16 * v), sums[v]);
+            }
+            AddCounts(counts, words, ones);
+            done += batch;
+        }
     }
-    return values[0];
-}
 
-auto FindScrubberRating(std::vector<std::string> const& input)
-{
-    int bitLength = input[0].size();
-    auto values = input;
-    for (int pos = 0; pos < bitLength && values.size() > 1; ++pos)
+    AOC_TARGET_AVX2 void CountOnesAvx2(std::span<std::string_view const> rows, std::span<std::uint32_t> ones)
+    {
+        auto const width = ones.size();
+        if (width < 8 || width > MaxSimdWidth)
+        {
+            return CountOnesScalar(rows, ones);
+        }
+        auto const words = SplitRow(width);
+        auto const vectors = (width + 31) / 32;
+        __m256i const one = _mm256_set1_epi8('1');
+        __m256i keep[2];
+        for (std::size_t v = 0; v < 2; ++v)
+        {
+            keep[v] = _mm256_set_epi64x(
+                static_cast<long long>(words.keep[4 * v + 3]), static_cast<long long>(words.keep[4 * v + 2]),
+                static_cast<long long>(words.keep[4 * v + 1]), static_cast<long long>(words.keep[4 * v]));
+        }
+        alignas(32) std::uint8_t counts[MaxSimdWidth];
+
+        for (std::size_t done = 0; done < rows.size(); )
+        {
+            auto const batch = std::min(RowsPerFlush, rows.size() - done);
+            __m256i sums[2] = { _mm256_setzero_si256(), _mm256_setzero_si256() };
+            for (auto row : rows.subspan(done, batch))
+            {
+                if (row.size() < width)
+                {
+                    CountOnesScalar({ &row, 1 }, ones);
+                    continue;
+                }
+                for (std::size_t v = 0; v < vectors; ++v)
+                {
+                    auto bytes = _mm256_set_epi64x(
+                        static_cast<long long>(LoadWord(row.data() + words.offsets[4 * v + 3])),
+                        static_cast<long long>(LoadWord(row.data() + words.offsets[4 * v + 2])),
+                        static_cast<long long>(LoadWord(row.data() + words.offsets[4 * v + 1])),
+                        static_cast<long long>(LoadWord(row.data() + words.offsets[4 * v])));
+                    sums[v] = _mm256_sub_epi8(sums[v], _mm256_and_si256(_mm256_cmpeq_epi8(bytes, one), keep[v]));
+                }
+            }
+            for (std::size_t v = 0; v < 2; ++v)
+            {
+                _mm256_store_si256(reinterpret_cast<__m256i*>(counts + 32 * v), sums[v]);
+            }
+            AddCounts(counts, words, ones);
+            done += batch;
+        }
+    }
+
+    // A masked load doesn't touch the bytes past the row, so AVX-512 reads
+    // the row as it is, and takes any width up to 64.
+    AOC_TARGET_AVX512 void CountOnesAvx512(std::span<std::string_view const> rows, std::span<std::uint32_t> ones)
     {
-        int zeroBits = CountBitsInPos(values, pos, '0');
-        int oneBits = CountBitsInPos(values, pos, '1');
+        auto const width = ones.size();
+        if (width > MaxSimdWidth)
+        {
+            return CountOnesScalar(rows, ones);
+        }
+        __m512i const one = _mm512_set1_epi8('1');
+        __m512i const increment = _mm512_set1_epi8(1);
+        alignas(64) std::uint8_t counts[MaxSimdWidth];
 
-        auto leastCommon = zeroBits <= oneBits ? '0' : '1';
-        values = ValuesWithBitInPos(values, pos, leastCommon);
+        for (std::size_t done = 0; done < rows.size(); )
+        {
+            auto const batch = std::min(RowsPerFlush, rows.size() - done);
+            __m512i sums = _mm512_setzero_si512();
+            for (auto row : rows.subspan(done, batch))
+            {
+                auto const length = std::min(row.size(), width);
+                __mmask64 const inRow = length == 64 ? ~__mmask64{ 0 } : (__mmask64{ 1 } << length) - 1;
+                auto bytes = _mm512_maskz_loadu_epi8(inRow, row.data());
+                sums = _mm512_mask_add_epi8(sums, _mm512_cmpeq_epi8_mask(bytes, one), sums, increment);
+            }
+            _mm512_store_si512(counts, sums);
+            for (std::size_t col = 0; col < width; ++col)
+            {
+                ones[col] += counts[col];
+            }
+            done += batch;
+        }
     }
-    return values[0];
-}
+#endif
 
-int main()
-{
-    auto input = ReadInput();
-    int bitLength = input[0].size();
+    void CountOnesPerColumn(std::span<std::string_view const> rows, std::span<std::uint32_t> ones)
+    {
+#ifdef AOC_SIMD_X86
+        static Common::SimdKernel<void(std::span<std::string_view const>, std::span<std::uint32_t>)> const kernel{
+            CountOnesScalar, CountOnesSse42, CountOnesAvx2, CountOnesAvx512 };
+        kernel(rows, ones);
+#else
+        CountOnesScalar(rows, ones);
+#endif
+    }
 
-    std::vector<char> gammaBits;
-    std::vector<char> epsilonBits;
+    auto ValuesWithBitInPos(std::vector<std::string_view> const& input, int pos, char bit)
+    {
+        std::vector<std::string_view> result;
+        std::copy_if(input.begin(), input.end(), std::back_inserter(result),
+            [pos, bit](std::string_view s)
+            {
+                return s[pos] == bit;
+            });
+        return result;
+    }
 
-    for (int pos = 0; pos < bitLength; ++pos)
+    std::string_view FindOxygenRating(std::vector<std::string_view> const& input)
     {
-        int zeroBits = CountBitsInPos(input, pos, '0');
-        int oneBits = CountBitsInPos(input, pos, '1');
+        AOC_TRACE_SCOPE("Day3 FindOxygenRating");
+        int bitLength = input[0].size();
+        auto values = input;
+        for (int pos = 0; pos < bitLength && values.size() > 1; ++pos)
+        {
+            AOC_TRACE_COUNT("Day3 values filtered", values.size());
+            int zeroBits = CountBitsInPos(values, pos, '0');
+            int oneBits = CountBitsInPos(values, pos, '1');
 
-        gammaBits.push_back(zeroBits > oneBits ? '0' : '1');
-        epsilonBits.push_back(zeroBits < oneBits ? '0' : '1');
+            auto mostCommon = oneBits >= zeroBits ? '1' : '0';
+            values = ValuesWithBitInPos(values, pos, mostCommon);
+        }
+        return values[0];
     }
 
-    std::string gamma(gammaBits.begin(), gammaBits.end());
-    std::string epsilon(epsilonBits.begin(), epsilonBits.end());
+    std::string_view FindScrubberRating(std::vector<std::string_view> const& input)
+    {
+        AOC_TRACE_SCOPE("Day3 FindScrubberRating");
+        int bitLength = input[0].size();
+        auto values = input;
+        for (int pos = 0; pos < bitLength && values.size() > 1; ++pos)
+        {
+            AOC_TRACE_COUNT("Day3 values filtered", values.size());
+            int zeroBits = CountBitsInPos(values, pos, '0');
+            int oneBits = CountBitsInPos(values, pos, '1');
 
-    int gammaVal = std::stoi(gamma, nullptr, 2);
-    int epsilonVal = std::stoi(epsilon, nullptr, 2);
+            auto leastCommon = zeroBits <= oneBits ? '0' : '1';
+            values = ValuesWithBitInPos(values, pos, leastCommon);
+        }
+        return values[0];
+    }
+
+    PowerRates FindPowerRates(std::vector<std::string_view> const& input)
+    {
+        AOC_TRACE_SCOPE("Day3 FindPowerRates");
+        int bitLength = input[0].size();
+
+        std::vector<char> gammaBits;
+        std::vector<char> epsilonBits;
+
+        std::vector<std::uint32_t> ones(bitLength);
+        CountOnesPerColumn(input, ones);
+        for (int pos = 0; pos < bitLength; ++pos)
+        {
+            int oneBits = static_cast<int>(ones[pos]);
+            int zeroBits = static_cast<int>(input.size()) - oneBits;
+
+            gammaBits.push_back(zeroBits > oneBits ? '0' : '1');
+            epsilonBits.push_back(zeroBits < oneBits ? '0' : '1');
+        }
+
+        std::string gamma(gammaBits.begin(), gammaBits.end());
+        std::string epsilon(epsilonBits.begin(), epsilonBits.end());
+
+        int gammaVal = std::stoi(gamma, nullptr, 2);
+        int epsilonVal = std::stoi(epsilon, nullptr, 2);
+        return PowerRates{ gammaVal, epsilonVal };
+    }
 
-    std::cout << "Gamma: " << gammaVal << " - Epsilon: " << epsilonVal << " - multiplied: " << gammaVal * epsilonVal << "\n";
+    int PartOne(Input const& input)
+    {
+        auto [gammaVal, epsilonVal] = FindPowerRates(input);
+        return gammaVal * epsilonVal;
+    }
+
+    int PartTwo(Input const& input)
+    {
+        auto oxygenRating = FindOxygenRating(input);
+        auto scrubberRating = FindScrubberRating(input);
+        return Common::ToNumber(oxygenRating, 2) * Common::ToNumber(scrubberRating, 2);
+    }
 
-    auto oxygenRating = FindOxygenRating(input);
-    auto scrubberRating = FindScrubberRating(input);
-    auto oxygenVal = std::stoi(oxygenRating, nullptr, 2);
-    auto scrubberVal = std::stoi(scrubberRating, nullptr, 2);
-    std::cout << "Oxygen rating: " << oxygenVal << " - Scrubber rating: " << scrubberVal << " - mulitpled: " << oxygenVal * scrubberVal << "\n";
+    namespace Reference
+    {
+        int PartOne(Input const& input)
+        {
+            int bitLength = input[0].size();
+            int gamma = 0;
+            int epsilon = 0;
+            for (int pos = 0; pos < bitLength; ++pos)
+            {
+                int zeroBits = CountBitsInPos(input, pos, '0');
+                int oneBits = CountBitsInPos(input, pos, '1');
+                gamma = gamma * 2 + (zeroBits > oneBits ? 0 : 1);
+                epsilon = epsilon * 2 + (zeroBits < oneBits ? 0 : 1);
+            }
+            return gamma * epsilon;
+        }
+    }
 }
@@ -0,0 +1,40 @@
+// Day3.h : Binary Diagnostic. Works out rates and ratings from the report bits.
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace Day3
+{
+    // Each line of the report, viewing the text passed to ReadInput.
+    using Input = std::vector<std::string_view>;
+
+    struct PowerRates
+    {
+        int gamma;
+        int epsilon;
+    };
+
+    Input ReadInput(std::string_view text);
+
+    // Adds the number of '1's in each column of the rows to ones, which has an
+    // entry per column. Uses the widest SIMD the CPU has (Common/CpuFeatures.h).
+    void CountOnesPerColumn(std::span<std::string_view const> rows, std::span<std::uint32_t> ones);
+
+    PowerRates FindPowerRates(std::vector<std::string_view> const& input);
+    std::string_view FindOxygenRating(std::vector<std::string_view> const& input);
+    std::string_view FindScrubberRating(std::vector<std::string_view> const& input);
+
+    int PartOne(Input const& input);
+    int PartTwo(Input const& input);
+
+    // The straightforward versions the faster ones are checked against (aoc_diff).
+    namespace Reference
+    {
+        // Counts each column with its own pass over the rows.
+        int PartOne(Input const& input);
+    }
+}
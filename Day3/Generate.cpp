@@ -0,0 +1,34 @@
+// Generate.cpp : Writes a Day3 input of any size, one binary number per line.
+//   Day3_gen [numbers] [--scale=F] [--seed=N]
+
+#include <bit>
+#include <iostream>
+#include <set>
+#include <string>
+
+#include "Common/Generator.h"
+
+int main(int argc, char* argv[])
+{
+    Common::Generator gen{ argc, argv, 1000 };
+
+    // the ratings need every number to be different, so make room for them all
+    auto width = std::max<int>(12, std::bit_width(gen.Size()) + 1);
+    auto count = gen.Size();
+
+    std::set<std::uint64_t> seen;
+    std::string line(width, '0');
+    while (seen.size() < count)
+    {
+        auto value = gen.Uniform<std::uint64_t>(0, (std::uint64_t{ 1 } << width) - 1);
+        if (!seen.insert(value).second)
+        {
+            continue;
+        }
+        for (int bit = 0; bit < width; ++bit)
+        {
+            line[width - 1 - bit] = (value >> bit) & 1 ? '1' : '0';
+        }
+        std::cout << line << "\n";
+    }
+}
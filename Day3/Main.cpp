@@ -0,0 +1,33 @@
+#include <iostream>
+#include <utility>
+
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/Input.h"
+#include "Day3.h"
+
+int main(int argc, char* argv[])
+{
+    if (auto batch = Common::ReadBatchOptions(argc, argv); batch.enabled)
+    {
+        return Common::RunBatch(batch, Day3::ReadInput, Day3::PartOne, Day3::PartTwo);
+    }
+
+    Common::Benchmark bench{ argc, argv };
+    auto buffer = Common::InputBuffer::FromCommandLine(argc, argv);
+    auto input = bench.Measure("parse", [&] { return Day3::ReadInput(buffer.Text()); }, { .bytes = buffer.Size() });
+
+    auto [gammaVal, epsilonVal] = bench.Measure("part one", [&] { return Day3::FindPowerRates(input); }, { .items = input.size() });
+
+    std::cout << "Gamma: " << gammaVal << " - Epsilon: " << epsilonVal << " - multiplied: " << gammaVal * epsilonVal << "\n";
+
+    auto [oxygenVal, scrubberVal] = bench.Measure("part two", [&]
+        {
+            auto oxygenRating = Day3::FindOxygenRating(input);
+            auto scrubberRating = Day3::FindScrubberRating(input);
+            return std::make_pair(Common::ToNumber(oxygenRating, 2), Common::ToNumber(scrubberRating, 2));
+        }, { .items = input.size() });
+    std::cout << "Oxygen rating: " << oxygenVal << " - Scrubber rating: " << scrubberVal << " - mulitpled: " << oxygenVal * scrubberVal << "\n";
+
+    bench.Report(std::cout);
+}
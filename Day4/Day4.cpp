@@ -1,209 +1,230 @@
+#include "Day4.h"
+
 #include <algorithm>
-#include <array>
-#include <iostream>
-#include <string>
-#include <sstream>
-#include <vector>
+#include <stdexcept>
+#include <utility>
 
-struct BingoNumber
-{
-    int value = 0;
-    bool marked = false;
-};
+#include "Common/Input.h"
+#include "Common/Sequence.h"
+#include "Common/Trace.h"
 
-struct BingoCard
+namespace Day4
 {
-    std::array<std::array<BingoNumber, 5>, 5> numbers = { 0 };
+    std::vector<int> ReadBingoNumbers(std::string_view input)
+    {
+        return Common::ToVector(Common::Numbers(input));
+    }
 
-    bool HasWinningRow() const
+    Common::Sequence<BingoCard> ReadBingoCards(std::string_view input)
     {
-        for (int row = 0; row < 5; ++row)
+        for (auto values : Common::Chunked(Common::Numbers(input, ' '), 25))
         {
-            bool win = true;
-            for (int col = 0; col < 5; ++col)
+            if (values.size() < 25)
             {
-                win = win && numbers[row][col].marked;
+                throw std::runtime_error("The last bingo card is cut short");
             }
-            if (win)
+            BingoCard card;
+            for (int i = 0; i < 25; ++i)
             {
-                return true;
+                card.numbers[i / 5][i % 5].value = values[i];
             }
+            co_yield card;
         }
-        return false;
     }
 
-    bool HasWinningColumn() const
+    Input ReadInput(std::string_view text)
     {
-        for (int col = 0; col < 5; ++col)
-        {
-            bool win = true;
-            for (int row = 0; row < 5; ++row)
-            {
-                win = win && numbers[row][col].marked;
-            }
-            if (win)
-            {
-                return true;
-            }
-        }
-        return false;
+        Common::LineReader lines{ text };
+
+        std::string_view bingoNumbers;
+        lines.Next(bingoNumbers);
+        auto numbers = ReadBingoNumbers(bingoNumbers);
+
+        return { std::move(numbers), lines.Remaining() };
     }
 
-    bool HasWon() const
+    DrawOrder::DrawOrder(std::vector<int> const& numbers)
     {
-        return HasWinningRow() || HasWinningColumn();
+        turns_.reserve(numbers.size());
+        for (int turn = 0; turn < static_cast<int>(numbers.size()); ++turn)
+        {
+            // insert leaves a number drawn twice with its first turn
+            turns_.insert({ numbers[turn], turn });
+        }
     }
 
-    void MarkNumber(int val)
+    CardResult PlayCard(BingoCard const& card, std::vector<int> const& numbers, DrawOrder const& order)
     {
+        std::array<std::array<int, 5>, 5> turns;
         for (int row = 0; row < 5; ++row)
         {
             for (int col = 0; col < 5; ++col)
             {
-                if (numbers[row][col].value == val)
+                auto value = card.numbers[row][col].value;
+                turns[row][col] = order.TurnOf(value);
+                // MarkNumber only ever marks the first of a repeated value
+                for (int before = 0; before < row * 5 + col; ++before)
                 {
-                    numbers[row][col].marked = true;
-                    return;
+                    if (card.numbers[before / 5][before % 5].value == value)
+                    {
+                        turns[row][col] = DrawOrder::NotDrawn;
+                        break;
+                    }
                 }
             }
         }
-    }
 
-    int SumUnmarkedNumbers() const
-    {
-        int sum = 0;
+        // a line is complete on the last of its turns, the card on its first line
+        int winningTurn = DrawOrder::NotDrawn;
+        for (int i = 0; i < 5; ++i)
+        {
+            int rowTurn = 0;
+            int colTurn = 0;
+            for (int j = 0; j < 5; ++j)
+            {
+                rowTurn = std::max(rowTurn, turns[i][j]);
+                colTurn = std::max(colTurn, turns[j][i]);
+            }
+            winningTurn = std::min({ winningTurn, rowTurn, colTurn });
+        }
+        if (winningTurn == DrawOrder::NotDrawn)
+        {
+            return { winningTurn, 0 };
+        }
+
+        int sumUnmarked = 0;
         for (int row = 0; row < 5; ++row)
         {
             for (int col = 0; col < 5; ++col)
             {
-                if (!numbers[row][col].marked)
+                if (turns[row][col] > winningTurn)
                 {
-                    sum += numbers[row][col].value;
+                    sumUnmarked += card.numbers[row][col].value;
                 }
             }
         }
-        return sum;
+        return { winningTurn, sumUnmarked * numbers[winningTurn] };
     }
-};
 
-std::vector<int> ReadBingoNumbers(std::string const &input)
-{
-    std::stringstream in{ input };
 
-    std::vector<int> result;
-    while (in)
+    int PartOne(Input const& input)
     {
-        int val;
-        in >> val;
-        result.push_back(val);
-        char ignore;
-        if (in.peek() == ',')
+        AOC_TRACE_SCOPE("Day4 first winner");
+        DrawOrder order{ input.numbers };
+        // no line is complete before its fifth number
+        int constexpr EarliestWin = 4;
+        CardResult first{ DrawOrder::NotDrawn, 0 };
+        for (auto const& card : ReadBingoCards(input.cardText))
         {
-            in >> ignore;
+            AOC_TRACE_COUNT("Day4 cards played", 1);
+            auto result = PlayCard(card, input.numbers, order);
+            if (result.winningTurn < first.winningTurn)
+            {
+                first = result;
+                if (first.winningTurn == EarliestWin)
+                {
+                    break;
+                }
+            }
         }
-        else
+        return first.score;
+    }
+
+    int PartTwo(Input const& input)
+    {
+        AOC_TRACE_SCOPE("Day4 last winner");
+        DrawOrder order{ input.numbers };
+        CardResult last{ -1, 0 };
+        bool tied = false;
+        for (auto const& card : ReadBingoCards(input.cardText))
         {
-            break;
+            AOC_TRACE_COUNT("Day4 cards played", 1);
+            auto result = PlayCard(card, input.numbers, order);
+            if (result.winningTurn > last.winningTurn)
+            {
+                last = result;
+                tied = false;
+            }
+            else if (result.winningTurn == last.winningTurn)
+            {
+                tied = true;
+            }
         }
+        // the puzzle's last winner is the one card still playing after all the others won
+        return tied || last.winningTurn == DrawOrder::NotDrawn ? 0 : last.score;
     }
-    return result;
-}
 
-std::vector<BingoCard> ReadBingoCards()
-{
-    std::vector<BingoCard> cards;
-
-    bool inputGood = true;
-    while (inputGood)
+    namespace Reference
     {
-        BingoCard card;
-        for (int row = 0; row < 5 && inputGood; ++row)
+        int FindFirstWinner(std::vector<int> const& numbers, std::vector<BingoCard> cards)
         {
-            for (int col = 0; col < 5 && inputGood; ++col)
+            AOC_TRACE_SCOPE("Day4 FindFirstWinner");
+            for (auto const v : numbers)
             {
-                int val;
-                std::cin >> val;
-                card.numbers[row][col].value = val;
-                if (std::cin.eof())
+                AOC_TRACE_COUNT("Day4 numbers drawn", 1);
+                std::for_each(cards.begin(), cards.end(),
+                    [v](BingoCard& card)
+                    {
+                        card.MarkNumber(v);
+                    });
+
+                auto winner = std::find_if(cards.begin(), cards.end(),
+                    [](BingoCard const& card)
+                    {
+                        return card.HasWon();
+                    });
+                if (winner != cards.end())
                 {
-                    inputGood = false;
+                    int sumUnmarked = winner->SumUnmarkedNumbers();
+                    return sumUnmarked * v;
                 }
             }
+            return 0;
         }
-        if (inputGood)
-        {
-            cards.push_back(card);
-        }
-    }
 
-    return cards;
-}
-
-void FindFirstWinner(std::vector<int> const& numbers, std::vector<BingoCard> cards)
-{
-    for (auto const v : numbers)
-    {
-        std::for_each(cards.begin(), cards.end(),
-            [v](BingoCard& card)
+        int FindLastWinner(std::vector<int> const& numbers, std::vector<BingoCard> cards)
+        {
+            AOC_TRACE_SCOPE("Day4 FindLastWinner");
+            std::vector<BingoCard>::iterator lastCard = cards.end();
+            for (auto const v : numbers)
             {
-                card.MarkNumber(v);
-            });
+                AOC_TRACE_COUNT("Day4 numbers drawn", 1);
+                auto cardsRemaining = std::count_if(cards.begin(), cards.end(),
+                    [](BingoCard const& card)
+                    {
+                        return !card.HasWon();
+                    });
+                if (cardsRemaining == 1)
+                {
+                    lastCard = std::find_if(cards.begin(), cards.end(),
+                        [](BingoCard const& card)
+                        {
+                            return !card.HasWon();
+                        });
+                }
+                std::for_each(cards.begin(), cards.end(),
+                    [v](BingoCard& card)
+                    {
+                        card.MarkNumber(v);
+                    });
 
-        auto winner = std::find_if(cards.begin(), cards.end(),
-            [](BingoCard const& card)
-            {
-                return card.HasWon();
-            });
-        if (winner != cards.end())
-        {
-            int sumUnmarked = winner->SumUnmarkedNumbers();
-            std::cout << "First winning card score is " << sumUnmarked * v << "\n";
-            break;
+                if (lastCard != cards.end() && lastCard->HasWon())
+                {
+                    int sumUnmarked = lastCard->SumUnmarkedNumbers();
+                    return sumUnmarked * v;
+                }
+            }
+            return 0;
         }
-    }
-}
 
-void FindLastWinner(std::vector<int> const& numbers, std::vector<BingoCard> cards)
-{
-    std::vector<BingoCard>::iterator lastCard = cards.end();
-    for (auto const v : numbers)
-    {
-        auto cardsRemaining = std::count_if(cards.begin(), cards.end(),
-            [](BingoCard const& card)
-            {
-                return !card.HasWon();
-            });
-        if (cardsRemaining == 1)
+        int PartOne(Input const& input)
         {
-            lastCard = std::find_if(cards.begin(), cards.end(),
-                [](BingoCard const& card)
-                {
-                    return !card.HasWon();
-                });
+            return FindFirstWinner(input.numbers, Common::ToVector(ReadBingoCards(input.cardText)));
         }
-        std::for_each(cards.begin(), cards.end(),
-            [v](BingoCard& card)
-            {
-                card.MarkNumber(v);
-            });
 
-        if (lastCard != cards.end() && lastCard->HasWon())
+        int PartTwo(Input const& input)
         {
-            int sumUnmarked = lastCard->SumUnmarkedNumbers();
-            std::cout << "Last winning card score is " << sumUnmarked * v << "\n";
-            break;
+            return FindLastWinner(input.numbers, Common::ToVector(ReadBingoCards(input.cardText)));
         }
     }
 }
-
-int main()
-{
-    std::string bingoNumbers;
-    std::getline(std::cin, bingoNumbers);
-    auto numbers = ReadBingoNumbers(bingoNumbers);
-
-    auto cards = ReadBingoCards();
-
-    FindFirstWinner(numbers, cards);
-    FindLastWinner(numbers, cards);
-}
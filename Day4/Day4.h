@@ -0,0 +1,155 @@
+// Day4.h : Giant Squid. Plays bingo to find the first and last cards to win.
+
+#pragma once
+
+#include <array>
+#include <climits>
+#include <string_view>
+#include <vector>
+
+#include "Common/FlatHash.h"
+#include "Common/Sequence.h"
+
+namespace Day4
+{
+    struct BingoNumber
+    {
+        int value = 0;
+        bool marked = false;
+    };
+
+    struct BingoCard
+    {
+        std::array<std::array<BingoNumber, 5>, 5> numbers = { 0 };
+
+        bool HasWinningRow() const
+        {
+            for (int row = 0; row < 5; ++row)
+            {
+                bool win = true;
+                for (int col = 0; col < 5; ++col)
+                {
+                    win = win && numbers[row][col].marked;
+                }
+                if (win)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool HasWinningColumn() const
+        {
+            for (int col = 0; col < 5; ++col)
+            {
+                bool win = true;
+                for (int row = 0; row < 5; ++row)
+                {
+                    win = win && numbers[row][col].marked;
+                }
+                if (win)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool HasWon() const
+        {
+            return HasWinningRow() || HasWinningColumn();
+        }
+
+        void MarkNumber(int val)
+        {
+            for (int row = 0; row < 5; ++row)
+            {
+                for (int col = 0; col < 5; ++col)
+                {
+                    if (numbers[row][col].value == val)
+                    {
+                        numbers[row][col].marked = true;
+                        return;
+                    }
+                }
+            }
+        }
+
+        int SumUnmarkedNumbers() const
+        {
+            int sum = 0;
+            for (int row = 0; row < 5; ++row)
+            {
+                for (int col = 0; col < 5; ++col)
+                {
+                    if (!numbers[row][col].marked)
+                    {
+                        sum += numbers[row][col].value;
+                    }
+                }
+            }
+            return sum;
+        }
+    };
+
+    struct Input
+    {
+        std::vector<int> numbers;
+        // The cards' part of the text passed to ReadInput, which is viewed
+        // rather than copied. The parts read the cards from it as they go.
+        std::string_view cardText;
+    };
+
+    std::vector<int> ReadBingoNumbers(std::string_view input);
+    // Reads each card only when it's asked for.
+    Common::Sequence<BingoCard> ReadBingoCards(std::string_view input);
+    Input ReadInput(std::string_view text);
+
+    // The turn each number is first drawn on. Hashed rather than indexed, so
+    // one huge number can't make the table huge too.
+    class DrawOrder
+    {
+    public:
+        static int constexpr NotDrawn = INT_MAX;
+
+        explicit DrawOrder(std::vector<int> const& numbers);
+
+        int TurnOf(int number) const noexcept
+        {
+            auto it = turns_.find(number);
+            return it != turns_.end() ? it->second : NotDrawn;
+        }
+
+    private:
+        Common::FlatMap<int, int> turns_;
+    };
+
+    struct CardResult
+    {
+        // DrawOrder::NotDrawn if the card never wins.
+        int winningTurn;
+        int score;
+    };
+
+    // When a card would win and its score then, worked out from the draw
+    // order alone, so each card can be played on its own as it's read.
+    CardResult PlayCard(BingoCard const& card, std::vector<int> const& numbers, DrawOrder const& order);
+
+    // Part one stops reading cards once one wins as early as any card can.
+    // Both return the winning card's score, or 0 if no card wins (or for part
+    // two, if the last cards to win tie).
+    int PartOne(Input const& input);
+    int PartTwo(Input const& input);
+
+    // The straightforward versions the faster ones are checked against (aoc_diff).
+    namespace Reference
+    {
+        // Mark every card with each number in turn until the winner is found.
+        int FindFirstWinner(std::vector<int> const& numbers, std::vector<BingoCard> cards);
+        int FindLastWinner(std::vector<int> const& numbers, std::vector<BingoCard> cards);
+
+        int PartOne(Input const& input);
+        int PartTwo(Input const& input);
+    }
+}
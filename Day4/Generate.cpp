@@ -0,0 +1,40 @@
+// Generate.cpp : Writes a Day4 input of any size: the draw order, then the cards.
+//   Day4_gen [cards] [--scale=F] [--seed=N]
+
+#include <cstdio>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+#include "Common/Generator.h"
+
+int main(int argc, char* argv[])
+{
+    Common::Generator gen{ argc, argv, 100 };
+
+    // every number gets drawn, so every card wins eventually
+    std::vector<int> numbers(100);
+    std::iota(numbers.begin(), numbers.end(), 0);
+    gen.Shuffle(numbers);
+    for (std::size_t i = 0; i < numbers.size(); ++i)
+    {
+        std::cout << (i == 0 ? "" : ",") << numbers[i];
+    }
+    std::cout << "\n";
+
+    char cell[4];
+    for (std::size_t card = 0; card < gen.Size(); ++card)
+    {
+        gen.Shuffle(numbers);
+        std::cout << "\n";
+        for (int row = 0; row < 5; ++row)
+        {
+            for (int col = 0; col < 5; ++col)
+            {
+                std::snprintf(cell, sizeof(cell), col == 0 ? "%2d" : " %2d", numbers[row * 5 + col]);
+                std::cout << cell;
+            }
+            std::cout << "\n";
+        }
+    }
+}
@@ -0,0 +1,26 @@
+#include <iostream>
+
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/Input.h"
+#include "Day4.h"
+
+int main(int argc, char* argv[])
+{
+    if (auto batch = Common::ReadBatchOptions(argc, argv); batch.enabled)
+    {
+        return Common::RunBatch(batch, Day4::ReadInput, Day4::PartOne, Day4::PartTwo);
+    }
+
+    Common::Benchmark bench{ argc, argv };
+    auto buffer = Common::InputBuffer::FromCommandLine(argc, argv);
+    auto input = bench.Measure("parse", [&] { return Day4::ReadInput(buffer.Text()); }, { .bytes = buffer.Size() });
+
+    auto firstScore = bench.Measure("part one", [&] { return Day4::PartOne(input); }, { .bytes = input.cardText.size() });
+    std::cout << "First winning card score is " << firstScore << "\n";
+
+    auto lastScore = bench.Measure("part two", [&] { return Day4::PartTwo(input); }, { .bytes = input.cardText.size() });
+    std::cout << "Last winning card score is " << lastScore << "\n";
+
+    bench.Report(std::cout);
+}
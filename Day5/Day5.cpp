@@ -1,217 +1,239 @@
+#include "Day5.h"
+
 #include <algorithm>
-#include <iostream>
-#include <string>
-#include <sstream>
-#include <vector>
+#include <cstddef>
+#include <iterator>
 
-struct Point
-{
-    int x;
-    int y;
-    auto operator<=>(const Point&) const = default;
-};
+#include "Common/Grid2D.h"
+#include "Common/Input.h"
+#include "Common/Pipeline.h"
+#include "Common/Trace.h"
 
-struct Line
+namespace Day5
 {
-    Point start;
-    Point end;
-    auto operator<=>(const Line&) const = default;
-
-    constexpr bool IsHorizontal() const noexcept
-    {
-        return start.y == end.y;
-    }
-    constexpr bool IsVertical() const noexcept
-    {
-        return start.x == end.x;
-    }
-    constexpr bool IsDiagonalUp() const noexcept
-    {
-        return start.x != end.x && start.y < end.y;
-    }
-    constexpr bool IsDiagonalDown() const noexcept
+    struct LineIterator
     {
-        return start.x != end.x && start.y > end.y;
-    }
-};
+        Line line;
+        Point loc{ 0,0 };
 
-struct LineIterator
-{
-    Line line;
-    Point loc{ 0,0 };
+        using value_type = Point;
+        using pointer = Point*;
+        using reference = Point&;
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
 
-    using value_type = Point;
-    using pointer = Point*;
-    using reference = Point&;
-    using iterator_category = std::forward_iterator_tag;
-    using difference_type = std::ptrdiff_t;
+        constexpr LineIterator& operator++() noexcept
+        {
+            if (line.IsHorizontal())
+            {
+                ++loc.x;
+            }
+            else if (line.IsVertical())
+            {
+                ++loc.y;
+            }
+            else if (line.IsDiagonalUp())
+            {
+                ++loc.x;
+                ++loc.y;
+            }
+            else
+            {
+                ++loc.x;
+                --loc.y;
+            }
+            return *this;
+        }
+        constexpr LineIterator operator++(int) noexcept
+        {
+            auto const prev = *this;
+            ++(*this);
+            return prev;
+        }
 
-    constexpr LineIterator& operator++() noexcept
+        [[nodiscard]] constexpr bool operator!=(LineIterator const& other) const noexcept
+        {
+            return loc != other.loc;
+        }
+        [[nodiscard]] constexpr Point const& operator*() const noexcept
+        {
+            return loc;
+        }
+        [[nodiscard]] constexpr Point& operator*() noexcept
+        {
+            return loc;
+        }
+    };
+    [[nodiscard]] constexpr LineIterator begin(Line const& l) noexcept
     {
-        if (line.IsHorizontal())
+        return LineIterator{ l, { l.start } };
+    }
+    [[nodiscard]] constexpr LineIterator end(Line const& l) noexcept
+    {
+        if (l.IsHorizontal())
         {
-            ++loc.x;
+            return LineIterator{ l, { l.end.x + 1, l.end.y } };
         }
-        else if (line.IsVertical())
+        else if (l.IsVertical())
         {
-            ++loc.y;
+            return LineIterator{ l, { l.end.x, l.end.y + 1 } };
         }
-        else if (line.IsDiagonalUp())
+        else if (l.IsDiagonalUp())
         {
-            ++loc.x;
-            ++loc.y;
+            return LineIterator{ l, { l.end.x + 1, l.end.y + 1 } };
         }
         else
         {
-            ++loc.x;
-            --loc.y;
+            return LineIterator{ l, { l.end.x + 1, l.end.y - 1 } };
         }
-        return *this;
-    }
-    constexpr LineIterator operator++(int) noexcept
-    {
-        auto const prev = *this;
-        ++(*this);
-        return prev;
     }
 
-    [[nodiscard]] constexpr bool operator!=(LineIterator const& other) const noexcept
-    {
-        return loc != other.loc;
-    }
-    [[nodiscard]] constexpr Point const& operator*() const noexcept
-    {
-        return loc;
-    }
-    [[nodiscard]] constexpr Point& operator*() noexcept
+    Line ParseLine(std::string_view inLine)
     {
-        return loc;
+        int x1 = Common::ToNumber(Common::NextField(inLine, ','));
+        int y1 = Common::ToNumber(Common::NextField(inLine, ' '));
+        Common::NextField(inLine, ' '); // ->
+        int x2 = Common::ToNumber(Common::NextField(inLine, ','));
+        int y2 = Common::ToNumber(inLine);
+
+        Point p1{ x1, y1 };
+        Point p2{ x2, y2 };
+        return p1 < p2 ? Line{ p1, p2 } : Line{ p2, p1 };
     }
-};
-[[nodiscard]] constexpr LineIterator begin(Line const& l) noexcept
-{
-    return LineIterator{ l, { l.start } };
-}
-[[nodiscard]] constexpr LineIterator end(Line const& l) noexcept
-{
-    if (l.IsHorizontal())
+
+    Input ReadInput(std::string_view text)
     {
-        return LineIterator{ l, { l.end.x + 1, l.end.y } };
+        std::vector<Line> result;
+
+        Common::LineReader lines{ text };
+        std::string_view inLine;
+        while (lines.Next(inLine))
+        {
+            if (inLine.empty())
+            {
+                break;
+            }
+            result.push_back(ParseLine(inLine));
+        }
+
+        return result;
     }
-    else if (l.IsVertical())
+
+    int MaximumWidth(std::vector<Line> const& lines)
     {
-        return LineIterator{ l, { l.end.x, l.end.y + 1 } };
+        int maxWidth = 0;
+        for (auto const& l : lines)
+        {
+            if (l.end.x > maxWidth)
+            {
+                maxWidth = l.end.x;
+            }
+        }
+        return maxWidth + 1;
     }
-    else if (l.IsDiagonalUp())
+
+    int MaximumHeight(std::vector<Line> const& lines)
     {
-        return LineIterator{ l, { l.end.x + 1, l.end.y + 1 } };
+        int maxHeight = 0;
+        for (auto const& l : lines)
+        {
+            // a diagonal down starts lower than it ends
+            maxHeight = std::max({ maxHeight, l.start.y, l.end.y });
+        }
+        return maxHeight + 1;
     }
-    else
+
+    int CountDangerPoints(std::vector<Line> const& lines)
     {
-        return LineIterator{ l, { l.end.x + 1, l.end.y - 1 } };
-    }
-}
+        AOC_TRACE_SCOPE("Day5 CountDangerPoints");
+        auto maxWidth = MaximumWidth(lines);
+        auto maxHeight = MaximumHeight(lines);
 
-std::vector<Line> ReadInput()
-{
-    std::vector<Line> result;
+        Common::Grid2D<int> grid(maxWidth, maxHeight);
 
-    std::string inLine;
-    while (std::getline(std::cin, inLine))
-    {
-        if (inLine.empty())
+        for (auto const& l : lines)
         {
-            break;
+            //if (l.IsHorizontal() || l.IsVertical())
+            {
+                AOC_TRACE_COUNT("Day5 lines drawn", 1);
+                std::for_each(begin(l), end(l),
+                    [&grid](Point const& p)
+                    {
+                        ++grid(p.x, p.y);
+                    });
+            }
         }
 
-        std::stringstream in{ inLine };
-        int x1;
-        int y1;
-        char comma;
-        in >> x1;
-        in >> comma; //,
-        in >> y1;
-        std::string arrow;
-        in >> arrow; // ->
-        int x2;
-        int y2;
-        in >> x2;
-        in >> comma; //,
-        in >> y2;
-
-        Point p1{ x1, y1 };
-        Point p2{ x2, y2 };
-        p1 < p2 ?
-            result.emplace_back(p1, p2) :
-            result.emplace_back(p2, p1);
+        auto cells = grid.Cells();
+        return static_cast<int>(std::count_if(cells.begin(), cells.end(), [](int overlaps) { return overlaps > 1; }));
     }
 
-    return result;
-}
-
-int MaximumWidth(std::vector<Line> const& lines)
-{
-    int maxWidth = 0;
-    for (auto const& l : lines)
+    int PartTwo(Input const& input)
     {
-        if (l.end.x > maxWidth)
-        {
-            maxWidth = l.end.x;
-        }
+        return CountDangerPoints(input);
     }
-    return maxWidth + 1;
-}
 
-int MaximumHeight(std::vector<Line> const& lines)
-{
-    int maxHeight = 0;
-    for (auto const& l : lines)
+    void VentMap::Draw(Line const& l)
     {
-        if (l.end.y > maxHeight)
+        // start.x <= end.x, but a diagonal down starts lower than it ends
+        int const width = l.end.x + 1;
+        int const height = std::max(l.start.y, l.end.y) + 1;
+        if (width > grid_.Width() || height > grid_.Height())
         {
-            maxHeight = l.end.y;
+            Common::Grid2D<int> bigger(std::max(width, grid_.Width() * 2), std::max(height, grid_.Height() * 2));
+            for (int y = 0; y < grid_.Height(); ++y)
+            {
+                auto row = grid_.Row(y);
+                std::copy(row.begin(), row.end(), bigger.Row(y).begin());
+            }
+            grid_ = std::move(bigger);
         }
-    }
-    return maxHeight + 1;
-}
 
-int main()
-{
-    auto lines = ReadInput();
-
-    auto maxWidth = MaximumWidth(lines);
-    auto maxHeight = MaximumHeight(lines);
+        std::for_each(begin(l), end(l),
+            [this](Point const& p)
+            {
+                ++grid_(p.x, p.y);
+            });
+    }
 
-    std::vector<std::vector<int>> grid;
-    grid.reserve(maxWidth);
-    for (int i = 0; i < maxWidth; ++i)
+    int VentMap::DangerPoints() const
     {
-        grid.emplace_back(maxHeight, 0);
+        auto cells = grid_.Cells();
+        return static_cast<int>(std::count_if(cells.begin(), cells.end(), [](int overlaps) { return overlaps > 1; }));
     }
 
-    for (auto const& l : lines)
+    int SolvePipelined(std::string_view text)
     {
-        //if (l.IsHorizontal() || l.IsVertical())
-        {
-            std::for_each(begin(l), end(l),
-                [&grid](Point const& p)
-                {
-                    ++grid[p.x][p.y];
-                });
-        }
+        VentMap map;
+        Common::RunPipeline(text,
+            [](std::string_view line) { return std::optional{ ParseLine(line) }; },
+            [&map](Line const& line) { map.Draw(line); });
+        return map.DangerPoints();
     }
 
-    int dangerPoints = 0;
-    for (int x = 0; x < maxWidth; ++x)
+    namespace Reference
     {
-        for (int y = 0; y < maxHeight; ++y)
+        int PartTwo(Input const& input)
         {
-            if (grid[x][y] > 1)
+            auto maxWidth = MaximumWidth(input);
+            auto maxHeight = MaximumHeight(input);
+
+            std::vector<std::vector<int>> grid(maxWidth, std::vector<int>(maxHeight, 0));
+            for (auto const& l : input)
             {
-                ++dangerPoints;
+                std::for_each(begin(l), end(l),
+                    [&grid](Point const& p)
+                    {
+                        ++grid[p.x][p.y];
+                    });
             }
+
+            int dangerPoints = 0;
+            for (auto const& column : grid)
+            {
+                dangerPoints += static_cast<int>(std::count_if(column.begin(), column.end(), [](int overlaps) { return overlaps > 1; }));
+            }
+            return dangerPoints;
         }
     }
-
-    std::cout << "There are " << dangerPoints << " points with overlap.\n";
 }
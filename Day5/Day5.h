@@ -0,0 +1,77 @@
+// Day5.h : Hydrothermal Venture. Counts the points where vent lines overlap.
+
+#pragma once
+
+#include <compare>
+#include <string_view>
+
+#include "Common/Grid2D.h"
+#include <vector>
+
+namespace Day5
+{
+    struct Point
+    {
+        int x;
+        int y;
+        auto operator<=>(const Point&) const = default;
+    };
+
+    struct Line
+    {
+        Point start;
+        Point end;
+        auto operator<=>(const Line&) const = default;
+
+        constexpr bool IsHorizontal() const noexcept
+        {
+            return start.y == end.y;
+        }
+        constexpr bool IsVertical() const noexcept
+        {
+            return start.x == end.x;
+        }
+        constexpr bool IsDiagonalUp() const noexcept
+        {
+            return start.x != end.x && start.y < end.y;
+        }
+        constexpr bool IsDiagonalDown() const noexcept
+        {
+            return start.x != end.x && start.y > end.y;
+        }
+    };
+
+    // Lines are stored with start < end.
+    using Input = std::vector<Line>;
+
+    // One "x1,y1 -> x2,y2" line.
+    Line ParseLine(std::string_view text);
+    Input ReadInput(std::string_view text);
+
+    // Diagonal lines are included, which is the part two rule.
+    int CountDangerPoints(std::vector<Line> const& lines);
+
+    int PartTwo(Input const& input);
+
+    // The straightforward versions the faster ones are checked against (aoc_diff).
+    namespace Reference
+    {
+        // Counts on a vector of columns rather than a Grid2D.
+        int PartTwo(Input const& input);
+    }
+
+    // Draws lines as they come, for when the size of the map isn't known up
+    // front. The map doubles whenever a line falls off its edge.
+    class VentMap
+    {
+    public:
+        void Draw(Line const& line);
+        int DangerPoints() const;
+
+    private:
+        Common::Grid2D<int> grid_;
+    };
+
+    // Part two, drawing on this thread while another parses (--pipeline).
+    int SolvePipelined(std::string_view text);
+}
@@ -0,0 +1,41 @@
+// Generate.cpp : Writes a Day5 input of any size, one vent line per line.
+//   Day5_gen [lines] [--scale=F] [--seed=N]
+
+#include <iostream>
+
+#include "Common/Generator.h"
+
+int main(int argc, char* argv[])
+{
+    Common::Generator gen{ argc, argv, 500 };
+
+    // horizontal, vertical or diagonal at 45 degrees, all inside the 1000x1000 floor
+    int const limit = 999;
+    for (std::size_t i = 0; i < gen.Size(); ++i)
+    {
+        int x1 = gen.Uniform(0, limit);
+        int y1 = gen.Uniform(0, limit);
+        int x2 = x1;
+        int y2 = y1;
+        switch (gen.Uniform(0, 2))
+        {
+        case 0:
+            x2 = gen.Uniform(0, limit);
+            break;
+        case 1:
+            y2 = gen.Uniform(0, limit);
+            break;
+        default:
+        {
+            int dx = gen.Chance(0.5) ? 1 : -1;
+            int dy = gen.Chance(0.5) ? 1 : -1;
+            int room = std::min(dx > 0 ? limit - x1 : x1, dy > 0 ? limit - y1 : y1);
+            int length = gen.Uniform(0, room);
+            x2 = x1 + dx * length;
+            y2 = y1 + dy * length;
+            break;
+        }
+        }
+        std::cout << x1 << "," << y1 << " -> " << x2 << "," << y2 << "\n";
+    }
+}
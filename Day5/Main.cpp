@@ -0,0 +1,35 @@
+#include <iostream>
+
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/Input.h"
+#include "Common/ParseCache.h"
+#include "Common/Pipeline.h"
+#include "Day5.h"
+
+int main(int argc, char* argv[])
+{
+    if (auto batch = Common::ReadBatchOptions(argc, argv); batch.enabled)
+    {
+        return Common::RunBatch(batch, Day5::ReadInput, Day5::PartTwo);
+    }
+
+    Common::Benchmark bench{ argc, argv };
+    Common::ParseCache cache{ argc, argv };
+    auto buffer = Common::InputBuffer::FromCommandLine(argc, argv);
+    if (Common::PipelineRequested(argc, argv))
+    {
+        auto dangerPoints = bench.Measure("pipelined", [&] { return Day5::SolvePipelined(buffer.Text()); }, { .bytes = buffer.Size() });
+        std::cout << "There are " << dangerPoints << " points with overlap.\n";
+        bench.Report(std::cout);
+        return 0;
+    }
+
+    auto lines = bench.Measure("parse", [&] { return cache.Read("Day5", buffer.Text(), Day5::ReadInput); }, { .bytes = buffer.Size() });
+
+    auto dangerPoints = bench.Measure("part two", [&] { return Day5::PartTwo(lines); }, { .items = lines.size() });
+
+    std::cout << "There are " << dangerPoints << " points with overlap.\n";
+
+    bench.Report(std::cout);
+}
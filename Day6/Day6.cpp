@@ -1,51 +1,57 @@
-#include <algorithm>
-#include <array>
-#include <iostream>
-#include <list>
-#include <vector>
+#include "Day6.h"
 
-std::array<uint64_t, 9> ReadFishTimers()
+#include "Common/Trace.h"
+
+namespace Day6
 {
-    std::array<uint64_t, 9> result = { 0 };
-    while (std::cin)
+    std::vector<uint64_t> SimulateFish(std::array<uint64_t, 9> fishTimers, int days)
     {
-        int val;
-        std::cin >> val;
-        result[val]++;
-        char ignore;
-        if (std::cin.peek() == ',')
-        {
-            std::cin >> ignore;
-        }
-        else
+        AOC_TRACE_SCOPE("Day6 SimulateFish");
+        std::vector<uint64_t> result;
+        result.reserve(days);
+
+        for (int day = 0; day < days; ++day)
         {
-            break;
+            AOC_TRACE_COUNT("Day6 days simulated", 1);
+            AdvanceDay(fishTimers);
+
+            uint64_t totalFish = 0;
+            for (int i = 0; i < 9; ++i)
+            {
+                totalFish += fishTimers[i];
+            }
+            result.push_back(totalFish);
         }
+        return result;
     }
-    return result;
-}
 
-int main()
-{
-    auto fishTimers = ReadFishTimers();
-
-    for (int day = 0; day < 256; ++day)
+    namespace Reference
     {
-        auto fishToAdd = fishTimers[0];
-
-        for (int i = 0; i < 8; ++i)
+        uint64_t PartOne(Input const& input)
         {
-            fishTimers[i] = fishTimers[i + 1];
-        }
-
-        fishTimers[6] += fishToAdd;
-        fishTimers[8] = fishToAdd;
+            std::vector<int> fish;
+            for (int timer = 0; timer < 9; ++timer)
+            {
+                fish.insert(fish.end(), input[timer], timer);
+            }
 
-        uint64_t totalFish = 0;
-        for (int i = 0; i < 9; ++i)
-        {
-            totalFish += fishTimers[i];
+            for (int day = 0; day < 80; ++day)
+            {
+                auto const count = fish.size();
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    if (fish[i] == 0)
+                    {
+                        fish[i] = 6;
+                        fish.push_back(8);
+                    }
+                    else
+                    {
+                        --fish[i];
+                    }
+                }
+            }
+            return fish.size();
         }
-        std::cout << "After " << day + 1 << " days there are " << totalFish << " fish.\n";
     }
 }
@@ -0,0 +1,86 @@
+// Day6.h : Lanternfish. Counts the fish population as it grows.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "Common/Input.h"
+#include "Common/Trace.h"
+
+namespace Day6
+{
+    // How many fish there are with each timer value.
+    using Input = std::array<uint64_t, 9>;
+
+    // ReadInput down to PartTwo can be run by the compiler, for AOC_EMBED_INPUTS.
+    // The same parse as Common::Numbers, through the NumberReader underneath
+    // it, as the compiler can't run a coroutine.
+    constexpr Input ReadInput(std::string_view input)
+    {
+        Input result = { 0 };
+        Common::NumberReader numbers{ input };
+        int timer = 0;
+        while (numbers.Next(timer))
+        {
+            if (timer < 0 || timer >= static_cast<int>(result.size()))
+            {
+                throw std::out_of_range("A lanternfish timer must be from 0 to 8");
+            }
+            result[timer]++;
+        }
+        return result;
+    }
+
+    // The fish at 0 go back to 6, each adding a new fish at 8, and the rest count down.
+    constexpr void AdvanceDay(Input& fishTimers) noexcept
+    {
+        auto fishToAdd = fishTimers[0];
+
+        for (int i = 0; i < 8; ++i)
+        {
+            fishTimers[i] = fishTimers[i + 1];
+        }
+
+        fishTimers[6] += fishToAdd;
+        fishTimers[8] = fishToAdd;
+    }
+
+    constexpr uint64_t CountFish(Input fishTimers, int days) noexcept
+    {
+        for (int day = 0; day < days; ++day)
+        {
+            AOC_TRACE_COUNT_CONSTEXPR("Day6 days simulated", 1);
+            AdvanceDay(fishTimers);
+        }
+        uint64_t totalFish = 0;
+        for (auto count : fishTimers)
+        {
+            totalFish += count;
+        }
+        return totalFish;
+    }
+
+    constexpr uint64_t PartOne(Input const& input)
+    {
+        return CountFish(input, 80);
+    }
+
+    constexpr uint64_t PartTwo(Input const& input)
+    {
+        return CountFish(input, 256);
+    }
+
+    // total number of fish at the end of each day
+    std::vector<uint64_t> SimulateFish(std::array<uint64_t, 9> fishTimers, int days);
+
+    // The straightforward versions the faster ones are checked against (aoc_diff).
+    namespace Reference
+    {
+        // Keeps every fish, the way the puzzle tells it, so only part one is feasible.
+        uint64_t PartOne(Input const& input);
+    }
+}
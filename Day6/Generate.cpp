@@ -0,0 +1,17 @@
+// Generate.cpp : Writes a Day6 input of any size, a single line of timers.
+//   Day6_gen [fish] [--scale=F] [--seed=N]
+
+#include <iostream>
+
+#include "Common/Generator.h"
+
+int main(int argc, char* argv[])
+{
+    Common::Generator gen{ argc, argv, 300 };
+
+    for (std::size_t i = 0; i < gen.Size(); ++i)
+    {
+        std::cout << (i == 0 ? "" : ",") << gen.Uniform(1, 5);
+    }
+    std::cout << "\n";
+}
@@ -0,0 +1,47 @@
+#include <iostream>
+
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/Input.h"
+#include "Day6.h"
+
+#ifdef AOC_EMBEDDED_INPUT
+#include "EmbeddedInput.h"
+#endif
+
+int main(int argc, char* argv[])
+{
+    if (auto batch = Common::ReadBatchOptions(argc, argv); batch.enabled)
+    {
+        return Common::RunBatch(batch, Day6::ReadInput, Day6::PartOne, Day6::PartTwo);
+    }
+
+    if (Common::EmbeddedRequested(argc, argv))
+    {
+#ifdef AOC_EMBEDDED_INPUT
+        // worked out by the compiler
+        constexpr auto fishTimers = Day6::ReadInput(Common::EmbeddedInput);
+        constexpr auto partOne = Day6::PartOne(fishTimers);
+        constexpr auto partTwo = Day6::PartTwo(fishTimers);
+        std::cout << "After 80 days there are " << partOne << " fish.\n";
+        std::cout << "After 256 days there are " << partTwo << " fish.\n";
+        return 0;
+#else
+        std::cerr << "Day6 was built without an embedded input, configure with -DAOC_EMBED_INPUTS=ON\n";
+        return 1;
+#endif
+    }
+
+    Common::Benchmark bench{ argc, argv };
+    auto buffer = Common::InputBuffer::FromCommandLine(argc, argv);
+    auto fishTimers = bench.Measure("parse", [&] { return Day6::ReadInput(buffer.Text()); }, { .bytes = buffer.Size() });
+
+    auto totals = bench.Measure("part two", [&] { return Day6::SimulateFish(fishTimers, 256); }, { .items = 256 });
+
+    for (int day = 0; day < 256; ++day)
+    {
+        std::cout << "After " << day + 1 << " days there are " << totals[day] << " fish.\n";
+    }
+
+    bench.Report(std::cout);
+}
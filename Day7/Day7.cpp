@@ -1,91 +1,134 @@
+#include "Day7.h"
+
 #include <algorithm>
-#include <iostream>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
 #include <numeric>
-#include <vector>
+#include <sstream>
+#include <string>
+
+#include "Common/Input.h"
+#include "Common/Sequence.h"
+#include "Common/Trace.h"
 
-std::vector<int> ReadCrabPositions()
+namespace Day7
 {
-    std::vector<int> result;
-    while (std::cin)
+    std::vector<int> ReadCrabPositions(std::string_view input)
+    {
+        return Common::ToVector(Common::Numbers(input));
+    }
+
+    Input ReadInput(std::string_view text)
     {
-        int val;
-        std::cin >> val;
-        result.push_back(val);
-        char ignore;
-        if (std::cin.peek() == ',')
+        auto positions = ReadCrabPositions(text);
+        std::sort(positions.begin(), positions.end());
+        return positions;
+    }
+
+    Alignment AlignOnMedian(std::vector<int> const& crabPositions)
+    {
+        AOC_TRACE_SCOPE("Day7 AlignOnMedian");
+        // get the median of the positions
+
+        int median = 0;
+        if (crabPositions.size() % 2 == 0)
         {
-            std::cin >> ignore;
+            auto mid1 = crabPositions[crabPositions.size() / 2 - 1];
+            auto mid2 = crabPositions[crabPositions.size() / 2];
+            median = (mid1 + mid2) / 2;
         }
         else
         {
-            break;
+            median = crabPositions[crabPositions.size() / 2];
         }
-    }
-    return result;
-}
 
-void PartOne(std::vector<int> const& crabPositions)
-{
-    // get the median of the positions
+        // now sum the distances to the median
+        int sumDistances = 0;
+        for (auto e : crabPositions)
+        {
+            sumDistances += std::abs(e - median);
+        }
 
-    int median = 0;
-    if (crabPositions.size() % 2 == 0)
-    {
-        auto mid1 = crabPositions[crabPositions.size() / 2 - 1];
-        auto mid2 = crabPositions[crabPositions.size() / 2];
-        median = (mid1 + mid2) / 2;
+        return { median, sumDistances };
     }
-    else
+
+    int PartOne(Input const& input)
     {
-        median = crabPositions[crabPositions.size() / 2];
+        return AlignOnMedian(input).fuel;
     }
 
-    // now sum the distances to the median
-    int sumDistances = 0;
-    for (auto e : crabPositions)
+    int PartTwo(Input const& crabPositions)
     {
-        sumDistances += std::abs(e - median);
-    }
+        AOC_TRACE_SCOPE("Day7 search positions");
+        int maxPos = *std::max_element(crabPositions.begin(), crabPositions.end());
 
-    std::cout << "The Part 1 fuel cost to align on " << median << " is " << sumDistances << " units.\n";
-}
+        int bestFuel = std::numeric_limits<int>::max();
+        for (int i = 0; i < maxPos; ++i)
+        {
+            AOC_TRACE_COUNT("Day7 positions tried", 1);
+            std::vector<int> fuelCosts;
+            fuelCosts.reserve(crabPositions.size());
 
-void PartTwo(std::vector<int> const& crabPositions)
-{
-    int maxPos = *std::max_element(crabPositions.begin(), crabPositions.end());
+            std::transform(crabPositions.begin(), crabPositions.end(), std::back_inserter(fuelCosts),
+                [i](int pos)
+                {
+                    int dist = std::abs(pos - i);
+                    return dist * (dist + 1) / 2;
+                });
+            auto totalCost = std::accumulate(fuelCosts.begin(), fuelCosts.end(), 0);
+            if (totalCost < bestFuel)
+            {
+                bestFuel = totalCost;
+            }
+            else if (totalCost > bestFuel)
+            {
+                break;
+            }
+        }
+        return bestFuel;
+    }
 
-    int bestFuel = std::numeric_limits<int>::max();
-    for (int i = 0; i < maxPos; ++i)
+    namespace Reference
     {
-        std::vector<int> fuelCosts;
-        fuelCosts.reserve(crabPositions.size());
+        Input ReadInput(std::string_view text)
+        {
+            std::vector<int> positions;
+            std::istringstream in{ std::string{ text } };
+            std::string field;
+            while (std::getline(in, field, ','))
+            {
+                positions.push_back(std::stoi(field));
+            }
+            std::sort(positions.begin(), positions.end());
+            return positions;
+        }
 
-        std::transform(crabPositions.begin(), crabPositions.end(), std::back_inserter(fuelCosts),
-            [i](int pos)
+        template<typename Cost>
+        int CheapestPosition(Input const& input, Cost cost)
+        {
+            auto [lowest, highest] = std::minmax_element(input.begin(), input.end());
+            int best = std::numeric_limits<int>::max();
+            for (int target = *lowest; target <= *highest; ++target)
             {
-                int dist = std::abs(pos - i);
-                return dist * (dist + 1) / 2;
-            });
-        auto totalCost = std::accumulate(fuelCosts.begin(), fuelCosts.end(), 0);
-        if (totalCost < bestFuel)
+                int fuel = 0;
+                for (auto position : input)
+                {
+                    fuel += cost(std::abs(position - target));
+                }
+                best = std::min(best, fuel);
+            }
+            return best;
+        }
+
+        int PartOne(Input const& input)
         {
-            bestFuel = totalCost;
+            return CheapestPosition(input, [](int distance) { return distance; });
         }
-        else if (totalCost > bestFuel)
+
+        int PartTwo(Input const& input)
         {
-            break;
+            return CheapestPosition(input, [](int distance) { return distance * (distance + 1) / 2; });
         }
     }
-    std::cout << "The part 2 fuel cost is " << bestFuel << " units.\n";
 }
-
-int main()
-{
-    auto crabPositions = ReadCrabPositions();
-
-    std::sort(crabPositions.begin(), crabPositions.end());
-
-    PartOne(crabPositions);
-    PartTwo(crabPositions);
-}
-
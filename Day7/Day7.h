@@ -0,0 +1,36 @@
+// Day7.h : The Treachery of Whales. Finds the cheapest position to line the crabs up on.
+
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+namespace Day7
+{
+    // Crab positions, sorted.
+    using Input = std::vector<int>;
+
+    struct Alignment
+    {
+        int position;
+        int fuel;
+    };
+
+    std::vector<int> ReadCrabPositions(std::string_view input);
+    Input ReadInput(std::string_view text);
+
+    // Both expect the positions to be sorted.
+    Alignment AlignOnMedian(std::vector<int> const& crabPositions);
+    int PartOne(Input const& input);
+    int PartTwo(Input const& input);
+
+    // The straightforward versions the faster ones are checked against (aoc_diff).
+    namespace Reference
+    {
+        // Splits the line on commas with std::getline.
+        Input ReadInput(std::string_view text);
+        // Both try every position between the outermost crabs.
+        int PartOne(Input const& input);
+        int PartTwo(Input const& input);
+    }
+}
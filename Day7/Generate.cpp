@@ -0,0 +1,17 @@
+// Generate.cpp : Writes a Day7 input of any size, a single line of positions.
+//   Day7_gen [crabs] [--scale=F] [--seed=N]
+
+#include <iostream>
+
+#include "Common/Generator.h"
+
+int main(int argc, char* argv[])
+{
+    Common::Generator gen{ argc, argv, 1000 };
+
+    for (std::size_t i = 0; i < gen.Size(); ++i)
+    {
+        std::cout << (i == 0 ? "" : ",") << gen.Uniform(0, 1999);
+    }
+    std::cout << "\n";
+}
@@ -0,0 +1,28 @@
+#include <iostream>
+
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/Input.h"
+#include "Common/ParseCache.h"
+#include "Day7.h"
+
+int main(int argc, char* argv[])
+{
+    if (auto batch = Common::ReadBatchOptions(argc, argv); batch.enabled)
+    {
+        return Common::RunBatch(batch, Day7::ReadInput, Day7::PartOne, Day7::PartTwo);
+    }
+
+    Common::Benchmark bench{ argc, argv };
+    Common::ParseCache cache{ argc, argv };
+    auto buffer = Common::InputBuffer::FromCommandLine(argc, argv);
+    auto crabPositions = bench.Measure("parse", [&] { return cache.Read("Day7", buffer.Text(), Day7::ReadInput); }, { .bytes = buffer.Size() });
+
+    auto [median, sumDistances] = bench.Measure("part one", [&] { return Day7::AlignOnMedian(crabPositions); }, { .items = crabPositions.size() });
+    std::cout << "The Part 1 fuel cost to align on " << median << " is " << sumDistances << " units.\n";
+
+    auto bestFuel = bench.Measure("part two", [&] { return Day7::PartTwo(crabPositions); }, { .items = crabPositions.size() });
+    std::cout << "The part 2 fuel cost is " << bestFuel << " units.\n";
+
+    bench.Report(std::cout);
+}
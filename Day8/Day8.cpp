@@ -1,51 +1,50 @@
+#include "Day8.h"
+
 #include <algorithm>
-#include <array>
-#include <iostream>
-#include <string>
-#include <sstream>
-#include <vector>
+#include <numeric>
 
-struct Entry
-{
-    std::array<std::string, 10> signalPattern;
-    std::array<std::string, 4> outputValue;
-};
+#include "Common/Input.h"
+#include "Common/Pipeline.h"
+#include "Common/Trace.h"
 
-std::vector<Entry> ReadInput()
+namespace Day8
 {
-    std::vector<Entry> result;
-    std::string inLine;
-    while (std::getline(std::cin, inLine))
+    Entry ParseEntry(std::string_view inLine)
     {
-        if (inLine.empty())
-        {
-            break;
-        }
-
-        std::stringstream in{ inLine };
         Entry e;
         for (int i = 0; i < 10; ++i)
         {
-            in >> e.signalPattern[i];
+            e.signalPattern[i] = Common::NextWord(inLine);
             std::sort(e.signalPattern[i].begin(), e.signalPattern[i].end());
         }
-        char pipe;
-        in >> pipe; // '|'
+        Common::NextWord(inLine); // '|'
         for (int i = 0; i < 4; ++i)
         {
-            in >> e.outputValue[i];
+            e.outputValue[i] = Common::NextWord(inLine);
             std::sort(e.outputValue[i].begin(), e.outputValue[i].end());
         }
-        result.push_back(e);
+        return e;
     }
-    return result;
-}
 
-void PartOne(std::vector<Entry> const& entries)
-{
-    int uniqueOutputCount = 0;
-    for (auto const& e : entries)
+    Input ReadInput(std::string_view text)
     {
+        std::vector<Entry> result;
+        Common::LineReader lines{ text };
+        std::string_view inLine;
+        while (lines.Next(inLine))
+        {
+            if (inLine.empty())
+            {
+                break;
+            }
+            result.push_back(ParseEntry(inLine));
+        }
+        return result;
+    }
+
+    int UniqueOutputCount(Entry const& e)
+    {
+        int uniqueOutputCount = 0;
         for (auto const& s : e.outputValue)
         {
             auto length = s.length();
@@ -54,26 +53,32 @@ void PartOne(std::vector<Entry> const& entries)
                 ++uniqueOutputCount;
             }
         }
+        return uniqueOutputCount;
     }
-    std::cout << "Unique output digits = " << uniqueOutputCount << "\n";
-}
 
-bool ContainsCharacters(std::string const& target, std::string const& chars)
-{
-    for (auto c : chars)
+    int PartOne(Input const& entries)
     {
-        if (target.find(c) == std::string::npos)
+        int uniqueOutputCount = 0;
+        for (auto const& e : entries)
         {
-            return false;
+            uniqueOutputCount += UniqueOutputCount(e);
         }
+        return uniqueOutputCount;
     }
-    return true;
-}
 
-void PartTwo(std::vector<Entry> const& entries)
-{
-    int outputSum = 0;
-    for (const auto& e : entries)
+    bool ContainsCharacters(std::string const& target, std::string const& chars)
+    {
+        for (auto c : chars)
+        {
+            if (target.find(c) == std::string::npos)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    int DecodeOutput(Entry const& e)
     {
         auto onePattern = *std::find_if(e.signalPattern.begin(), e.signalPattern.end(), [](const auto& s) { return s.length() == 2; });
         auto fourPattern = *std::find_if(e.signalPattern.begin(), e.signalPattern.end(), [](const auto& s) { return s.length() == 4; });
@@ -101,17 +106,40 @@ void PartTwo(std::vector<Entry> const& entries)
                 }
             }
         }
-        std::cout << "Output value " << output << "\n";
-        outputSum += output;
+        return output;
     }
 
-    std::cout << "Sum of output values = " << outputSum << "\n";
-}
+    std::vector<int> DecodeOutputs(std::vector<Entry> const& entries)
+    {
+        AOC_TRACE_SCOPE("Day8 DecodeOutputs");
+        AOC_TRACE_COUNT("Day8 entries decoded", entries.size());
+        std::vector<int> outputs;
+        outputs.reserve(entries.size());
+        for (const auto& e : entries)
+        {
+            outputs.push_back(DecodeOutput(e));
+        }
+        return outputs;
+    }
 
-int main()
-{
-    auto entries = ReadInput();
 
-    PartOne(entries);
-    PartTwo(entries);
+    int PartTwo(Input const& input)
+    {
+        auto outputs = DecodeOutputs(input);
+        return std::accumulate(outputs.begin(), outputs.end(), 0);
+    }
+
+    std::pair<int, int> SolvePipelined(std::string_view text)
+    {
+        int uniqueOutputCount = 0;
+        int outputTotal = 0;
+        Common::RunPipeline(text,
+            [](std::string_view line) { return std::optional{ ParseEntry(line) }; },
+            [&](Entry const& e)
+            {
+                uniqueOutputCount += UniqueOutputCount(e);
+                outputTotal += DecodeOutput(e);
+            });
+        return { uniqueOutputCount, outputTotal };
+    }
 }
@@ -0,0 +1,43 @@
+// Day8.h : Seven Segment Search. Decodes the scrambled display wiring.
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Day8
+{
+    // The letters of each pattern are sorted so they can be compared directly.
+    struct Entry
+    {
+        std::array<std::string, 10> signalPattern;
+        std::array<std::string, 4> outputValue;
+    };
+
+    template<typename Archive>
+    void Serialise(Archive& archive, Entry& entry)
+    {
+        archive(entry.signalPattern, entry.outputValue);
+    }
+
+    using Input = std::vector<Entry>;
+
+    Entry ParseEntry(std::string_view line);
+    Input ReadInput(std::string_view text);
+
+    // how many output digits use a segment count only one digit has
+    int UniqueOutputCount(Entry const& entry);
+    int DecodeOutput(Entry const& entry);
+
+    // the decoded output value of each entry
+    std::vector<int> DecodeOutputs(std::vector<Entry> const& entries);
+
+    int PartOne(Input const& input);
+    int PartTwo(Input const& input);
+
+    // Both parts, decoding on this thread while another parses (--pipeline).
+    std::pair<int, int> SolvePipelined(std::string_view text);
+}
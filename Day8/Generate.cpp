@@ -0,0 +1,46 @@
+// Generate.cpp : Writes a Day8 input of any size, one display per line.
+//   Day8_gen [displays] [--scale=F] [--seed=N]
+
+#include <array>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "Common/Generator.h"
+
+int main(int argc, char* argv[])
+{
+    Common::Generator gen{ argc, argv, 200 };
+
+    std::array<std::string_view, 10> const digits{ "abcefg", "cf", "acdeg", "acdfg", "bcdf", "abdfg", "abdefg", "acf", "abcdefg", "abcdfg" };
+
+    // each display has its own wiring, and the segments of a pattern come in any order
+    auto wired = [&](std::string const& wiring, std::string_view segments)
+    {
+        std::string result;
+        for (auto c : segments)
+        {
+            result += wiring[c - 'a'];
+        }
+        gen.Shuffle(result);
+        return result;
+    };
+
+    std::string wiring = "abcdefg";
+    std::array<int, 10> order{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    for (std::size_t i = 0; i < gen.Size(); ++i)
+    {
+        gen.Shuffle(wiring);
+        gen.Shuffle(order);
+        for (auto digit : order)
+        {
+            std::cout << wired(wiring, digits[digit]) << " ";
+        }
+        std::cout << "|";
+        for (int j = 0; j < 4; ++j)
+        {
+            std::cout << " " << wired(wiring, digits[gen.Uniform(0, 9)]);
+        }
+        std::cout << "\n";
+    }
+}
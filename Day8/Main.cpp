@@ -0,0 +1,45 @@
+#include <iostream>
+
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/Input.h"
+#include "Common/ParseCache.h"
+#include "Common/Pipeline.h"
+#include "Day8.h"
+
+int main(int argc, char* argv[])
+{
+    if (auto batch = Common::ReadBatchOptions(argc, argv); batch.enabled)
+    {
+        return Common::RunBatch(batch, Day8::ReadInput, Day8::PartOne, Day8::PartTwo);
+    }
+
+    Common::Benchmark bench{ argc, argv };
+    Common::ParseCache cache{ argc, argv };
+    auto buffer = Common::InputBuffer::FromCommandLine(argc, argv);
+    if (Common::PipelineRequested(argc, argv))
+    {
+        auto [uniqueOutputCount, outputSum] = bench.Measure("pipelined", [&] { return Day8::SolvePipelined(buffer.Text()); }, { .bytes = buffer.Size() });
+        std::cout << "Unique output digits = " << uniqueOutputCount << "\n";
+        std::cout << "Sum of output values = " << outputSum << "\n";
+        bench.Report(std::cout);
+        return 0;
+    }
+
+    auto entries = bench.Measure("parse", [&] { return cache.Read("Day8", buffer.Text(), Day8::ReadInput); }, { .bytes = buffer.Size() });
+
+    auto uniqueOutputCount = bench.Measure("part one", [&] { return Day8::PartOne(entries); }, { .items = entries.size() });
+    std::cout << "Unique output digits = " << uniqueOutputCount << "\n";
+
+    auto outputs = bench.Measure("part two", [&] { return Day8::DecodeOutputs(entries); }, { .items = entries.size() });
+
+    int outputSum = 0;
+    for (auto output : outputs)
+    {
+        std::cout << "Output value " << output << "\n";
+        outputSum += output;
+    }
+    std::cout << "Sum of output values = " << outputSum << "\n";
+
+    bench.Report(std::cout);
+}
@@ -1,149 +1,256 @@
+#include "Day9.h"
+
 #include <algorithm>
-#include <iostream>
+#include <functional>
 #include <set>
 #include <stack>
-#include <string>
-#include <sstream>
-#include <vector>
+#include <utility>
 
-struct Point
-{
-    int x;
-    int y;
-    auto operator<=>(const Point&) const = default;
-};
+#include "Common/FlatHash.h"
+#include "Common/Input.h"
+#include "Common/Trace.h"
 
-auto ReadInput()
+namespace Day9
 {
-    std::vector<std::vector<int>> result;
-
-    std::string inLine;
-    while (std::getline(std::cin, inLine))
+    Input ReadInput(std::string_view text)
     {
-        if (inLine.empty())
-            break;
+        std::vector<std::string_view> rows;
 
-        std::stringstream in{ inLine };
-        std::vector<int> row{ std::istreambuf_iterator<char>{in}, {} };
-        std::transform(row.begin(), row.end(), row.begin(), [](int v) {return v - '0'; });
-        result.push_back(row);
-    }
+        Common::LineReader lines{ text };
+        std::string_view inLine;
+        while (lines.Next(inLine))
+        {
+            if (inLine.empty())
+                break;
 
-    return result;
-}
+            rows.push_back(inLine);
+        }
 
-auto FindLowPoints(std::vector<std::vector<int>> const& grid)
-{
-    std::vector<Point> result;
+        Grid result(rows.empty() ? 0 : static_cast<int>(rows[0].size()), static_cast<int>(rows.size()), 9);
+        for (int y = 0; y < result.Height(); ++y)
+        {
+            std::transform(rows[y].begin(), rows[y].end(), result.Row(y).begin(), [](char c) { return c - '0'; });
+        }
+        return result;
+    }
 
-    for (int y = 0; y < grid.size(); ++y)
+    std::vector<Point> FindLowPoints(Grid const& grid)
     {
-        for (int x = 0; x < grid[y].size(); ++x)
-        {
-            int curVal = grid[y][x];
-            bool lowerThanNorth = y == 0 || curVal < grid[y - 1][x];
-            bool lowerThanSouth = y == (grid.size() - 1) || curVal < grid[y + 1][x];
-            bool lowerThanWest = x == 0 || curVal < grid[y][x - 1];
-            bool lowerThanEast = x == (grid[y].size() - 1) || curVal < grid[y][x + 1];
+        AOC_TRACE_SCOPE("Day9 FindLowPoints");
+        std::vector<Point> result;
 
-            if (lowerThanNorth && lowerThanSouth && lowerThanWest && lowerThanEast)
+        for (int y = 0; y < grid.Height(); ++y)
+        {
+            for (int x = 0; x < grid.Width(); ++x)
             {
-                result.emplace_back(x, y);
+                // the border is all 9s, which nothing is higher than
+                int curVal = grid(x, y);
+                bool lowerThanNorth = curVal < grid(x, y - 1);
+                bool lowerThanSouth = curVal < grid(x, y + 1);
+                bool lowerThanWest = curVal < grid(x - 1, y);
+                bool lowerThanEast = curVal < grid(x + 1, y);
+
+                if (lowerThanNorth && lowerThanSouth && lowerThanWest && lowerThanEast)
+                {
+                    result.emplace_back(x, y);
+                }
             }
         }
+        return result;
     }
-    return result;
-}
 
-auto SumRiskLevels(std::vector<std::vector<int>> const& grid, std::vector<Point> const& lowPoints)
-{
-    int riskScore = 0;
-    for (auto const& p : lowPoints)
+    int SumRiskLevels(Grid const& grid, std::vector<Point> const& lowPoints)
     {
-        riskScore += 1 + grid[p.y][p.x];
+        int riskScore = 0;
+        for (auto const& p : lowPoints)
+        {
+            riskScore += 1 + grid(p.x, p.y);
+        }
+        return riskScore;
     }
-    return riskScore;
-}
 
-auto GetBasinSize(std::vector<std::vector<int>> const& grid, Point const& p)
-{
-    std::stack<Point> pointsToVisit;
-    std::set<Point> basinPoints;
-
-    pointsToVisit.push(p);
-    basinPoints.insert(p);
-
-    while (!pointsToVisit.empty())
+    template<typename PointSet>
+    std::size_t BasinSize(Grid const& grid, Point const& p)
     {
-        auto curPoint = pointsToVisit.top();
-        pointsToVisit.pop();
+        std::stack<Point> pointsToVisit;
+        PointSet basinPoints;
 
-        if (curPoint.x > 0 && grid[curPoint.y][curPoint.x - 1] != 9)
+        pointsToVisit.push(p);
+        basinPoints.insert(p);
+
+        while (!pointsToVisit.empty())
         {
-            Point newP{ curPoint.x - 1, curPoint.y };
-            if (!basinPoints.contains(newP))
+            AOC_TRACE_COUNT("Day9 basin points visited", 1);
+            auto curPoint = pointsToVisit.top();
+            pointsToVisit.pop();
+
+            if (grid(curPoint.x - 1, curPoint.y) != 9)
             {
-                basinPoints.insert(newP);
-                pointsToVisit.push(newP);
+                Point newP{ curPoint.x - 1, curPoint.y };
+                if (!basinPoints.contains(newP))
+                {
+                    basinPoints.insert(newP);
+                    pointsToVisit.push(newP);
+                }
             }
-        }
-        if (curPoint.x < grid[0].size() - 1 && grid[curPoint.y][curPoint.x + 1] != 9)
-        {
-            Point newP{ curPoint.x + 1, curPoint.y };
-            if (!basinPoints.contains(newP))
+            if (grid(curPoint.x + 1, curPoint.y) != 9)
             {
-                basinPoints.insert(newP);
-                pointsToVisit.push(newP);
+                Point newP{ curPoint.x + 1, curPoint.y };
+                if (!basinPoints.contains(newP))
+                {
+                    basinPoints.insert(newP);
+                    pointsToVisit.push(newP);
+                }
             }
-        }
-        if (curPoint.y > 0 && grid[curPoint.y - 1][curPoint.x] != 9)
-        {
-            Point newP{ curPoint.x, curPoint.y - 1 };
-            if (!basinPoints.contains(newP))
+            if (grid(curPoint.x, curPoint.y - 1) != 9)
             {
-                basinPoints.insert(newP);
-                pointsToVisit.push(newP);
+                Point newP{ curPoint.x, curPoint.y - 1 };
+                if (!basinPoints.contains(newP))
+                {
+                    basinPoints.insert(newP);
+                    pointsToVisit.push(newP);
+                }
             }
-        }
-        if (curPoint.y < grid.size() - 1 && grid[curPoint.y + 1][curPoint.x] != 9)
-        {
-            Point newP{ curPoint.x, curPoint.y + 1 };
-            if (!basinPoints.contains(newP))
+            if (grid(curPoint.x, curPoint.y + 1) != 9)
             {
-                basinPoints.insert(newP);
-                pointsToVisit.push(newP);
+                Point newP{ curPoint.x, curPoint.y + 1 };
+                if (!basinPoints.contains(newP))
+                {
+                    basinPoints.insert(newP);
+                    pointsToVisit.push(newP);
+                }
             }
         }
+        return basinPoints.size();
     }
-    return basinPoints.size();
-}
 
-auto GetAllBasinSizes(std::vector<std::vector<int>> const& grid, std::vector<Point> const& lowPoints)
-{
-    std::vector<int> basinSizes;
-    for (auto const& p : lowPoints)
+    std::size_t GetBasinSize(Grid const& grid, Point const& p)
     {
-        auto basinSize = GetBasinSize(grid, p);
-        basinSizes.push_back(basinSize);
+        return BasinSize<Common::FlatSet<Point>>(grid, p);
     }
-    return basinSizes;
-}
 
-int main()
-{
-    auto grid = ReadInput();
+    std::vector<int> GetAllBasinSizes(Grid const& grid, std::vector<Point> const& lowPoints)
+    {
+        AOC_TRACE_SCOPE("Day9 GetAllBasinSizes");
+        std::vector<int> basinSizes;
+        for (auto const& p : lowPoints)
+        {
+            auto basinSize = GetBasinSize(grid, p);
+            basinSizes.push_back(basinSize);
+        }
+        return basinSizes;
+    }
 
-    auto lowPoints = FindLowPoints(grid);
+    int PartOne(Input const& input)
+    {
+        auto lowPoints = FindLowPoints(input);
+        return SumRiskLevels(input, lowPoints);
+    }
 
-    auto riskScore = SumRiskLevels(grid, lowPoints);
+    int ProductOfLargestThree(std::vector<int> basinSizes)
+    {
+        std::sort(basinSizes.begin(), basinSizes.end(), std::greater{});
+
+        return basinSizes[0] * basinSizes[1] * basinSizes[2];
+    }
 
-    std::cout << "Sum of risk levels is " << riskScore << "\n";
+    int PartTwo(Input const& input)
+    {
+        auto lowPoints = FindLowPoints(input);
+        return ProductOfLargestThree(GetAllBasinSizes(input, lowPoints));
+    }
 
-    auto basinSizes = GetAllBasinSizes(grid, lowPoints);
+    namespace Reference
+    {
+        Input ReadInput(std::string_view text)
+        {
+            Input result;
 
-    std::sort(basinSizes.begin(), basinSizes.end(), std::greater{});
+            Common::LineReader lines{ text };
+            std::string_view inLine;
+            while (lines.Next(inLine))
+            {
+                if (inLine.empty())
+                    break;
 
-    int threeLargest = basinSizes[0] * basinSizes[1] * basinSizes[2];
+                std::vector<int> row(inLine.size());
+                std::transform(inLine.begin(), inLine.end(), row.begin(), [](char c) { return c - '0'; });
+                result.push_back(std::move(row));
+            }
+
+            return result;
+        }
+
+        std::vector<Point> FindLowPoints(Input const& grid)
+        {
+            std::vector<Point> result;
+            for (std::size_t y = 0; y < grid.size(); ++y)
+            {
+                for (std::size_t x = 0; x < grid[y].size(); ++x)
+                {
+                    int curVal = grid[y][x];
+                    bool lowerThanNorth = y == 0 || curVal < grid[y - 1][x];
+                    bool lowerThanSouth = y == (grid.size() - 1) || curVal < grid[y + 1][x];
+                    bool lowerThanWest = x == 0 || curVal < grid[y][x - 1];
+                    bool lowerThanEast = x == (grid[y].size() - 1) || curVal < grid[y][x + 1];
+
+                    if (lowerThanNorth && lowerThanSouth && lowerThanWest && lowerThanEast)
+                    {
+                        result.push_back({ static_cast<int>(x), static_cast<int>(y) });
+                    }
+                }
+            }
+            return result;
+        }
 
-    std::cout << "Product of 3 largest basin sizes is " << threeLargest << "\n";
+        std::size_t GetBasinSize(Input const& grid, Point const& p)
+        {
+            std::stack<Point> pointsToVisit;
+            std::set<Point> basinPoints;
+
+            pointsToVisit.push(p);
+            basinPoints.insert(p);
+
+            auto const width = static_cast<int>(grid[0].size());
+            auto const height = static_cast<int>(grid.size());
+            auto visit = [&](int x, int y)
+                {
+                    if (x >= 0 && x < width && y >= 0 && y < height && grid[y][x] != 9 && basinPoints.insert({ x, y }).second)
+                    {
+                        pointsToVisit.push({ x, y });
+                    }
+                };
+            while (!pointsToVisit.empty())
+            {
+                auto curPoint = pointsToVisit.top();
+                pointsToVisit.pop();
+
+                visit(curPoint.x - 1, curPoint.y);
+                visit(curPoint.x + 1, curPoint.y);
+                visit(curPoint.x, curPoint.y - 1);
+                visit(curPoint.x, curPoint.y + 1);
+            }
+            return basinPoints.size();
+        }
+
+        int PartOne(Input const& input)
+        {
+            int riskScore = 0;
+            for (auto const& p : FindLowPoints(input))
+            {
+                riskScore += 1 + input[p.y][p.x];
+            }
+            return riskScore;
+        }
+
+        int PartTwo(Input const& input)
+        {
+            std::vector<int> basinSizes;
+            for (auto const& p : FindLowPoints(input))
+            {
+                basinSizes.push_back(static_cast<int>(GetBasinSize(input, p)));
+            }
+            return ProductOfLargestThree(std::move(basinSizes));
+        }
+    }
 }
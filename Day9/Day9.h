@@ -0,0 +1,47 @@
+// Day9.h : Smoke Basin. Finds the low points of the height map and the basins around them.
+
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "Common/Grid2D.h"
+
+namespace Day9
+{
+    struct Point
+    {
+        int x;
+        int y;
+        auto operator<=>(const Point&) const = default;
+    };
+
+    // Heights indexed (x, y), with a border of 9s so every point has four neighbours.
+    using Grid = Common::Grid2D<int, 1>;
+    using Input = Grid;
+
+    Input ReadInput(std::string_view text);
+
+    std::vector<Point> FindLowPoints(Grid const& grid);
+    int SumRiskLevels(Grid const& grid, std::vector<Point> const& lowPoints);
+    std::size_t GetBasinSize(Grid const& grid, Point const& p);
+    std::vector<int> GetAllBasinSizes(Grid const& grid, std::vector<Point> const& lowPoints);
+
+    int PartOne(Input const& input);
+    int PartTwo(Input const& input);
+
+    // The straightforward versions the faster ones are checked against (aoc_diff).
+    namespace Reference
+    {
+        // Heights indexed [y][x], with no border, so every step checks the edges.
+        using Input = std::vector<std::vector<int>>;
+
+        Input ReadInput(std::string_view text);
+
+        int PartOne(Input const& input);
+        // Finds the basins with a std::set rather than a FlatSet.
+        int PartTwo(Input const& input);
+    }
+}
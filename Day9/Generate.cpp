@@ -0,0 +1,23 @@
+// Generate.cpp : Writes a Day9 input of any size, a square height map.
+//   Day9_gen [side] [--scale=F] [--seed=N]
+
+#include <iostream>
+#include <string>
+
+#include "Common/Generator.h"
+
+int main(int argc, char* argv[])
+{
+    Common::Generator gen{ argc, argv, 100 };
+
+    // plenty of 9s so the map breaks up into basins
+    std::string row(gen.Size(), '0');
+    for (std::size_t y = 0; y < gen.Size(); ++y)
+    {
+        for (auto& c : row)
+        {
+            c = gen.Chance(0.25) ? '9' : static_cast<char>('0' + gen.Uniform(0, 8));
+        }
+        std::cout << row << "\n";
+    }
+}
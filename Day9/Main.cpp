@@ -0,0 +1,31 @@
+#include <iostream>
+
+#include "Common/Batch.h"
+#include "Common/Benchmark.h"
+#include "Common/Input.h"
+#include "Common/ParseCache.h"
+#include "Day9.h"
+
+int main(int argc, char* argv[])
+{
+    if (auto batch = Common::ReadBatchOptions(argc, argv); batch.enabled)
+    {
+        return Common::RunBatch(batch, Day9::ReadInput, Day9::PartOne, Day9::PartTwo);
+    }
+
+    Common::Benchmark bench{ argc, argv };
+    Common::ParseCache cache{ argc, argv };
+    auto buffer = Common::InputBuffer::FromCommandLine(argc, argv);
+    auto grid = bench.Measure("parse", [&] { return cache.Read("Day9", buffer.Text(), Day9::ReadInput); }, { .bytes = buffer.Size() });
+    auto cells = grid.Size();
+
+    auto riskScore = bench.Measure("part one", [&] { return Day9::PartOne(grid); }, { .items = cells });
+
+    std::cout << "Sum of risk levels is " << riskScore << "\n";
+
+    auto threeLargest = bench.Measure("part two", [&] { return Day9::PartTwo(grid); }, { .items = cells });
+
+    std::cout << "Product of 3 largest basin sizes is " << threeLargest << "\n";
+
+    bench.Report(std::cout);
+}
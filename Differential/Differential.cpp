@@ -0,0 +1,315 @@
+// Differential.cpp : Runs each day's optimised parts and the straightforward
+// versions kept in DayN::Reference on the same inputs, and fails if they disagree.
+//   aoc_diff [input dir]
+// Every DayN.txt or DayN-*.txt in the folder (inputs/ by default) is an input
+// for day N. The diff_check target fills a folder from the generators first.
+// The optimised side runs once for each SIMD level the CPU supports.
+// Days with a --pipeline mode are also checked against parsing first.
+// A few fixed inputs for edge cases are checked on every run too.
+
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common/Batch.h"
+#include "Common/CpuFeatures.h"
+#include "Common/Input.h"
+
+#include "Day1.h"
+#include "Day2.h"
+#include "Day3.h"
+#include "Day4.h"
+#include "Day5.h"
+#include "Day6.h"
+#include "Day7.h"
+#include "Day8.h"
+#include "Day9.h"
+#include "Day10.h"
+#include "Day11.h"
+#include "Day12.h"
+#include "Day13.h"
+#include "Day14.h"
+#include "Day15.h"
+#include "Day16.h"
+#include "Day17.h"
+#include "Day18.h"
+#include "Day19.h"
+#include "Day20.h"
+#include "Day21.h"
+#include "Day22.h"
+#include "Day23.h"
+#include "Day24.h"
+#include "Day25.h"
+
+struct Answers
+{
+    std::string reference;
+    std::string optimised;
+};
+
+struct Check
+{
+    int day;
+    std::string name;
+    std::function<Answers(std::string_view)> run;
+    // How many of the folder's inputs for the day to run on, or 0 for all.
+    std::size_t inputLimit;
+};
+
+template<typename Read, typename Reference, typename Optimised>
+Check MakeCheck(int day, std::string name, Read read, Reference reference, Optimised optimised)
+{
+    return { day, std::move(name), [=](std::string_view text)
+        {
+            auto input = read(text);
+            Answers answers{ Common::ToText(reference(input)), {} };
+            for (int level = 0; level <= static_cast<int>(Common::DetectedSimdLevel()); ++level)
+            {
+                Common::ForceSimdLevel(static_cast<Common::SimdLevel>(level));
+                auto answer = Common::ToText(optimised(input));
+                if (answer != answers.reference)
+                {
+                    answers.optimised = answer + " (" + std::string{ Common::ToString(static_cast<Common::SimdLevel>(level)) } + ")";
+                    return answers;
+                }
+                answers.optimised = answer;
+            }
+            return answers;
+        }, 0 };
+}
+
+// For a reference too slow to run on every input.
+Check OnFirstInputs(std::size_t inputs, Check check)
+{
+    check.inputLimit = inputs;
+    return check;
+}
+
+std::string_view WholeText(std::string_view text)
+{
+    return text;
+}
+
+// Every part's answer from parsing the whole input and then solving.
+template<typename Read, typename... Parts>
+auto ReadThenSolve(Read read, Parts... parts)
+{
+    return [=](std::string_view text)
+        {
+            auto input = read(text);
+            std::string answers;
+            ((answers += Common::ToText(parts(input)) + " "), ...);
+            return answers;
+        };
+}
+
+// The same from a SolvePipelined, which gives a pair when a day has two parts.
+template<typename Solve>
+auto Pipelined(Solve solve)
+{
+    return [=](std::string_view text)
+        {
+            auto answers = solve(text);
+            if constexpr (requires { answers.second; })
+            {
+                return Common::ToText(answers.first) + " " + Common::ToText(answers.second) + " ";
+            }
+            else
+            {
+                return Common::ToText(answers) + " ";
+            }
+        };
+}
+
+std::vector<Check> const& Checks()
+{
+    static std::vector<Check> const checks{
+        MakeCheck(1, "part one", Day1::ReadInput, Day1::Reference::PartOne, Day1::PartOne),
+        MakeCheck(1, "part two", Day1::ReadInput, Day1::Reference::PartTwo, Day1::PartTwo),
+        MakeCheck(1, "windows", WholeText, ReadThenSolve(Day1::ReadInput, Day1::Reference::PartOne, Day1::Reference::PartTwo), [](std::string_view text)
+            {
+                std::size_t const sizes[] = { 1, 3 };
+                auto summaries = Day1::SummariseWindows(Day1::ReadInput(text), sizes);
+                return Common::ToText(summaries[0].increases) + " " + Common::ToText(summaries[1].increases) + " ";
+            }),
+        MakeCheck(1, "pipelined", WholeText, ReadThenSolve(Day1::ReadInput, Day1::PartOne, Day1::PartTwo), Pipelined(Day1::SolvePipelined)),
+        MakeCheck(1, "parallel", WholeText, ReadThenSolve(Day1::ReadInput, Day1::PartOne, Day1::PartTwo), [](std::string_view text)
+            {
+                // a dozen chunks, so small inputs get cuts a depth or two apart
+                static Common::WorkStealingPool pool{ 3 };
+                auto count = Day1::SolveParallel(text, pool);
+                return Common::ToText(count.increases) + " " + Common::ToText(count.windowIncreases) + " ";
+            }),
+        MakeCheck(2, "part two", WholeText, ReadThenSolve(Day2::Reference::ReadInput, Day2::Reference::PartTwo), ReadThenSolve(Day2::ReadInput, Day2::PartTwo)),
+        MakeCheck(2, "pipelined", WholeText, ReadThenSolve(Day2::ReadInput, Day2::PartTwo), Pipelined(Day2::SolvePipelined)),
+        MakeCheck(3, "part one", Day3::ReadInput, Day3::Reference::PartOne, Day3::PartOne),
+        MakeCheck(4, "part one", Day4::ReadInput, Day4::Reference::PartOne, Day4::PartOne),
+        MakeCheck(4, "part two", Day4::ReadInput, Day4::Reference::PartTwo, Day4::PartTwo),
+        MakeCheck(5, "part two", Day5::ReadInput, Day5::Reference::PartTwo, Day5::PartTwo),
+        MakeCheck(5, "pipelined", WholeText, ReadThenSolve(Day5::ReadInput, Day5::PartTwo), Pipelined(Day5::SolvePipelined)),
+        MakeCheck(6, "part one", Day6::ReadInput, Day6::Reference::PartOne, Day6::PartOne),
+        MakeCheck(7, "part one", WholeText, ReadThenSolve(Day7::Reference::ReadInput, Day7::Reference::PartOne), ReadThenSolve(Day7::ReadInput, Day7::PartOne)),
+        MakeCheck(7, "part two", WholeText, ReadThenSolve(Day7::Reference::ReadInput, Day7::Reference::PartTwo), ReadThenSolve(Day7::ReadInput, Day7::PartTwo)),
+        MakeCheck(8, "pipelined", WholeText, ReadThenSolve(Day8::ReadInput, Day8::PartOne, Day8::PartTwo), Pipelined(Day8::SolvePipelined)),
+        MakeCheck(9, "part one", WholeText, ReadThenSolve(Day9::Reference::ReadInput, Day9::Reference::PartOne), ReadThenSolve(Day9::ReadInput, Day9::PartOne)),
+        MakeCheck(9, "part two", WholeText, ReadThenSolve(Day9::Reference::ReadInput, Day9::Reference::PartTwo), ReadThenSolve(Day9::ReadInput, Day9::PartTwo)),
+        MakeCheck(10, "pipelined", WholeText, ReadThenSolve(Day10::ReadInput, Day10::PartOne, Day10::PartTwo), Pipelined(Day10::SolvePipelined)),
+        MakeCheck(11, "part one", WholeText, ReadThenSolve(Day11::Reference::ReadInput, Day11::Reference::PartOne), ReadThenSolve(Day11::ReadInput, Day11::PartOne)),
+        MakeCheck(11, "part two", WholeText, ReadThenSolve(Day11::Reference::ReadInput, Day11::Reference::PartTwo), ReadThenSolve(Day11::ReadInput, Day11::PartTwo)),
+        MakeCheck(12, "part one", WholeText, ReadThenSolve(Day12::Reference::ReadInput, Day12::Reference::PartOne), ReadThenSolve(Day12::ReadInput, Day12::PartOne)),
+        MakeCheck(12, "part two", WholeText, ReadThenSolve(Day12::Reference::ReadInput, Day12::Reference::PartTwo), ReadThenSolve(Day12::ReadInput, Day12::PartTwo)),
+        MakeCheck(13, "part one", Day13::ReadInput, Day13::Reference::PartOne, Day13::PartOne),
+        MakeCheck(13, "part two", Day13::ReadInput, Day13::Reference::PartTwo, Day13::PartTwo),
+        MakeCheck(14, "part one", Day14::ReadInput, Day14::Reference::PartOne, Day14::PartOne),
+        MakeCheck(14, "part two", Day14::ReadInput, Day14::Reference::PartTwo, Day14::PartTwo),
+        MakeCheck(15, "part one", WholeText, ReadThenSolve(Day15::Reference::ReadInput, Day15::Reference::PartOne), ReadThenSolve(Day15::ReadInput, Day15::PartOne)),
+        MakeCheck(15, "part two", WholeText, ReadThenSolve(Day15::Reference::ReadInput, Day15::Reference::PartTwo), ReadThenSolve(Day15::ReadInput, Day15::PartTwo)),
+        MakeCheck(16, "part one", WholeText, ReadThenSolve(Day16::Reference::ReadInput, Day16::Reference::PartOne), ReadThenSolve(Day16::ReadInput, Day16::PartOne)),
+        MakeCheck(16, "part two", WholeText, ReadThenSolve(Day16::Reference::ReadInput, Day16::Reference::PartTwo), ReadThenSolve(Day16::ReadInput, Day16::PartTwo)),
+        MakeCheck(17, "part one", WholeText, ReadThenSolve(Day17::Reference::ReadInput, Day17::Reference::PartOne), ReadThenSolve(Day17::ReadInput, Day17::PartOne)),
+        MakeCheck(17, "part two", WholeText, ReadThenSolve(Day17::Reference::ReadInput, Day17::Reference::PartTwo), ReadThenSolve(Day17::ReadInput, Day17::PartTwo)),
+        MakeCheck(18, "part one", WholeText, ReadThenSolve(Day18::Reference::ReadInput, Day18::Reference::PartOne), ReadThenSolve(Day18::ReadInput, Day18::PartOne)),
+        MakeCheck(18, "part two", WholeText, ReadThenSolve(Day18::Reference::ReadInput, Day18::Reference::PartTwo), ReadThenSolve(Day18::ReadInput, Day18::PartTwo)),
+        MakeCheck(19, "part one", Day19::ReadInput, Day19::Reference::PartOne, Day19::PartOne),
+        MakeCheck(19, "part two", Day19::ReadInput, Day19::Reference::PartTwo, Day19::PartTwo),
+        MakeCheck(20, "part one", WholeText, ReadThenSolve(Day20::Reference::ReadInput, Day20::Reference::PartOne), ReadThenSolve(Day20::ReadInput, Day20::PartOne)),
+        MakeCheck(20, "part two", WholeText, ReadThenSolve(Day20::Reference::ReadInput, Day20::Reference::PartTwo), ReadThenSolve(Day20::ReadInput, Day20::PartTwo)),
+        MakeCheck(21, "read input", WholeText, [](std::string_view text)
+            {
+                auto input = Day21::Reference::ReadInput(text);
+                return Common::ToText(input.playerOne) + " " + Common::ToText(input.playerTwo);
+            }, [](std::string_view text)
+            {
+                auto input = Day21::ReadInput(text);
+                return Common::ToText(input.playerOne) + " " + Common::ToText(input.playerTwo);
+            }),
+        MakeCheck(21, "part two", Day21::ReadInput, Day21::Reference::PartTwo, Day21::PartTwo),
+        MakeCheck(21, "game table", Day21::ReadInput, Day21::Reference::PartTwo, [](Day21::Input const& input)
+            {
+                auto playerWins = Day21::DiracGame::Play<Day21::DiracGame::GameTable>(input.playerOne, input.playerTwo);
+                return std::max(playerWins[0], playerWins[1]);
+            }),
+        MakeCheck(22, "part one", WholeText, ReadThenSolve(Day22::Reference::ReadInput, Day22::Reference::PartOne), ReadThenSolve(Day22::ReadInput, Day22::PartOne)),
+        MakeCheck(22, "part two", WholeText, ReadThenSolve(Day22::Reference::ReadInput, Day22::Reference::PartTwo), ReadThenSolve(Day22::ReadInput, Day22::PartTwo)),
+        MakeCheck(22, "pipelined", WholeText, ReadThenSolve(Day22::ReadInput, Day22::PartOne, Day22::PartTwo), Pipelined(Day22::SolvePipelined)),
+        MakeCheck(23, "part one", Day23::ReadInput, Day23::Reference::PartOne, Day23::PartOne),
+        // about half a minute an input
+        OnFirstInputs(2, MakeCheck(23, "part two", Day23::ReadInput, Day23::Reference::PartTwo, Day23::PartTwo)),
+        MakeCheck(24, "part one", WholeText, ReadThenSolve(Day24::Reference::ReadInput, Day24::Reference::PartOne), ReadThenSolve(Day24::ReadInput, Day24::PartOne)),
+        MakeCheck(24, "part two", WholeText, ReadThenSolve(Day24::Reference::ReadInput, Day24::Reference::PartTwo), ReadThenSolve(Day24::ReadInput, Day24::PartTwo)),
+        MakeCheck(25, "part one", WholeText, ReadThenSolve(Day25::Reference::ReadInput, Day25::Reference::PartOne), ReadThenSolve(Day25::ReadInput, Day25::PartOne)),
+    };
+    return checks;
+}
+
+// Inputs at the edges of what a day allows, which the generators may not
+// happen to write, checked on every run as well as the folder's.
+struct FixedInput
+{
+    int day;
+    std::string_view name;
+    std::string_view text;
+};
+
+std::vector<FixedInput> const& FixedInputs()
+{
+    static std::vector<FixedInput> const inputs{
+        { 21, "position 10", "Player 1 starting position: 10\nPlayer 2 starting position: 10\n" },
+        { 21, "positions 10 and 1", "Player 1 starting position: 10\nPlayer 2 starting position: 1\n" },
+    };
+    return inputs;
+}
+
+// The day an input file is for, from DayN.txt or DayN-anything.txt, or 0.
+int DayOf(std::filesystem::path const& path)
+{
+    auto name = path.filename().string();
+    if (path.extension() != ".txt" || !name.starts_with("Day"))
+    {
+        return 0;
+    }
+    std::string_view rest{ name };
+    rest.remove_prefix(3);
+    auto digits = std::find_if(rest.begin(), rest.end(), [](char c) { return c < '0' || c > '9'; }) - rest.begin();
+    if (digits == 0 || (rest[digits] != '.' && rest[digits] != '-'))
+    {
+        return 0;
+    }
+    return Common::ToNumber(rest.substr(0, digits));
+}
+
+int main(int argc, char* argv[])
+{
+    std::filesystem::path folder = argc > 1 ? argv[1] : "inputs";
+    if (!std::filesystem::is_directory(folder))
+    {
+        std::cerr << "No input folder at " << folder.string() << "\n";
+        return 1;
+    }
+
+    std::vector<std::filesystem::path> inputs;
+    for (auto const& entry : std::filesystem::directory_iterator(folder))
+    {
+        if (entry.is_regular_file() && DayOf(entry.path()) != 0)
+        {
+            inputs.push_back(entry.path());
+        }
+    }
+    std::sort(inputs.begin(), inputs.end());
+
+    int compared = 0;
+    int failed = 0;
+    for (auto const& check : Checks())
+    {
+        int checkInputs = 0;
+        // answersOf reads the input and runs the check on it
+        auto compare = [&](std::string const& source, auto answersOf)
+            {
+                ++checkInputs;
+                ++compared;
+                try
+                {
+                    auto answers = answersOf();
+                    if (answers.reference != answers.optimised)
+                    {
+                        ++failed;
+                        std::cout << "MISMATCH Day" << check.day << " " << check.name << " on " << source
+                            << ": reference " << answers.reference << ", optimised " << answers.optimised << "\n";
+                    }
+                }
+                catch (std::exception const& e)
+                {
+                    ++failed;
+                    std::cout << "ERROR Day" << check.day << " " << check.name << " on " << source << ": " << e.what() << "\n";
+                }
+            };
+        std::size_t folderInputs = 0;
+        for (auto const& path : inputs)
+        {
+            if (DayOf(path) == check.day && (check.inputLimit == 0 || folderInputs++ < check.inputLimit))
+            {
+                compare(path.string(), [&]
+                    {
+                        auto buffer = Common::InputBuffer::FromFile(path.string());
+                        return check.run(buffer.Text());
+                    });
+            }
+        }
+        for (auto const& fixed : FixedInputs())
+        {
+            if (fixed.day == check.day)
+            {
+                compare(std::string{ fixed.name }, [&] { return check.run(fixed.text); });
+            }
+        }
+        std::cout << "Day" << check.day << " " << check.name << ": " << checkInputs << " input" << (checkInputs == 1 ? "" : "s") << "\n";
+    }
+
+    std::cout << compared << " comparisons, " << failed << " failed\n";
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+// PerfHistory.cpp : Compares the latest timings in a benchmark history file
+// with a baseline and fails if any phase got slower by more than a threshold.
+//   aoc_history <history file> [--baseline=<label>] [--threshold=<percent>]
+// Phases are matched by day, input and phase name. The latest record of each
+// is compared with the one before it, or with the latest one labelled
+// <label> if a baseline is given. Medians are compared.
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "Common/BenchHistory.h"
+#include "Common/Benchmark.h"
+
+// Phases quicker than this in the baseline are shown but never fail, as
+// their timings are mostly noise.
+std::chrono::nanoseconds constexpr NoiseFloor{ 10'000 };
+
+using PhaseKey = std::tuple<std::string, std::string, std::string>;
+
+int main(int argc, char* argv[])
+{
+    std::string path;
+    std::string baselineLabel;
+    double threshold = 10.0;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view arg{ argv[i] };
+        if (arg.starts_with("--baseline="))
+        {
+            baselineLabel = arg.substr(11);
+        }
+        else if (arg.starts_with("--threshold="))
+        {
+            threshold = std::stod(std::string{ arg.substr(12) });
+        }
+        else if (!arg.starts_with("-"))
+        {
+            path = arg;
+        }
+    }
+    if (path.empty())
+    {
+        std::cerr << "Usage: aoc_history <history file> [--baseline=<label>] [--threshold=<percent>]\n";
+        return 2;
+    }
+
+    auto records = Common::ReadHistory(path);
+
+    // For each phase, the latest record and the baseline to compare it with.
+    std::map<PhaseKey, std::pair<Common::HistoryRecord const*, Common::HistoryRecord const*>> phases;
+    for (auto const& record : records)
+    {
+        auto& [latest, baseline] = phases[{ record.day, record.input, record.phase }];
+        if (latest && (baselineLabel.empty() || latest->label == baselineLabel))
+        {
+            baseline = latest;
+        }
+        latest = &record;
+    }
+
+    char line[200];
+    std::snprintf(line, sizeof(line), "%-8s %-12s %11s %11s %9s  %s\n", "Day", "Phase", "Baseline", "Latest", "Change", "Input");
+    std::cout << line;
+    int compared = 0;
+    int regressed = 0;
+    for (auto const& [key, pair] : phases)
+    {
+        auto const& [latest, baseline] = pair;
+        if (!baseline)
+        {
+            continue;
+        }
+        ++compared;
+        std::chrono::nanoseconds before{ baseline->medianNs };
+        std::chrono::nanoseconds after{ latest->medianNs };
+        double change = before.count() > 0 ? 100.0 * (static_cast<double>(after.count()) / static_cast<double>(before.count()) - 1.0) : 0.0;
+        bool failed = change > threshold && before >= NoiseFloor;
+        regressed += failed ? 1 : 0;
+
+        char changeText[32];
+        std::snprintf(changeText, sizeof(changeText), "%+.1f%%", change);
+        std::snprintf(line, sizeof(line), "%-8s %-12s %11s %11s %9s  %s%s\n",
+            latest->day.c_str(),
+            latest->phase.c_str(),
+            Common::FormatDuration(before).c_str(),
+            Common::FormatDuration(after).c_str(),
+            changeText,
+            latest->input.c_str(),
+            failed ? "  REGRESSED" : "");
+        std::cout << line;
+    }
+
+    if (compared == 0)
+    {
+        std::cout << "Nothing to compare yet" << (baselineLabel.empty() ? "" : " against " + baselineLabel) << " in " << path << "\n";
+        return 0;
+    }
+    std::cout << compared << " phases compared, " << regressed << " slower by more than " << threshold << "%\n";
+    return regressed == 0 ? 0 : 1;
+}